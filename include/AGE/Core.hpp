@@ -12,6 +12,22 @@
  * @date 20120512 - Add new Asset Handler classes
  * @date 20120702 - Add new EventManager and IEvent classes
  * @date 20120720 - Moved PropertyManager to Core library from Entity library
+ * @date 20261018 - Added new TraceManager include file
+ * @date 20261018 - Added new Histogram include file
+ * @date 20261018 - Added new InputRecorder include file
+ * @date 20261018 - Added new MemoryMappedFile and StringRef include files
+ * @date 20261018 - Added new StringPool and Symbol include files
+ * @date 20261018 - Added new AssetManifest, IJob and JobManager include files
+ * @date 20261018 - Added new SoundManager include file
+ * @date 20261018 - Added new MemoryStream and ReadAheadStream include files
+ * @date 20261018 - Added new SoundBank include file
+ * @date 20261018 - Added new AssetDownloader include file
+ * @date 20261018 - Added new ReplicationManager and BitStream include files
+ * @date 20261018 - Added new RollbackManager include file
+ * @date 20261018 - Added new FrameArena include file
+ * @date 20261018 - Added new ObjectPool include file
+ * @date 20261018 - Added new MemoryTracker include file
+ * @date 20261018 - Added new SizeClassPool include file
  */
 #ifndef   AGE_CORE_HPP_INCLUDED
 #define   AGE_CORE_HPP_INCLUDED
@@ -32,15 +48,31 @@
 #include <AGE/Core/assets/MusicHandler.hpp>
 #include <AGE/Core/assets/SoundAsset.hpp>
 #include <AGE/Core/assets/SoundHandler.hpp>
+#include <AGE/Core/classes/AssetDownloader.hpp>
 #include <AGE/Core/classes/AssetManager.hpp>
+#include <AGE/Core/classes/AssetManifest.hpp>
 #include <AGE/Core/classes/ConfigReader.hpp>
 #include <AGE/Core/classes/EventManager.hpp>
+#include <AGE/Core/classes/FrameArena.hpp>
+#include <AGE/Core/classes/Histogram.hpp>
+#include <AGE/Core/classes/InputRecorder.hpp>
+#include <AGE/Core/classes/JobManager.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
+#include <AGE/Core/classes/ObjectPool.hpp>
 #include <AGE/Core/classes/PropertyManager.hpp>
+#include <AGE/Core/classes/ReplicationManager.hpp>
+#include <AGE/Core/classes/RollbackManager.hpp>
+#include <AGE/Core/classes/SizeClassPool.hpp>
+#include <AGE/Core/classes/SoundBank.hpp>
+#include <AGE/Core/classes/SoundManager.hpp>
 #include <AGE/Core/classes/StatManager.hpp>
 #include <AGE/Core/classes/StateManager.hpp>
+#include <AGE/Core/classes/StringPool.hpp>
+#include <AGE/Core/classes/TraceManager.hpp>
 #include <AGE/Core/interfaces/Game.hpp>
 #include <AGE/Core/interfaces/IAssetHandler.hpp>
 #include <AGE/Core/interfaces/IEvent.hpp>
+#include <AGE/Core/interfaces/IJob.hpp>
 #include <AGE/Core/interfaces/ILogger.hpp>
 #include <AGE/Core/interfaces/IProperty.hpp>
 #include <AGE/Core/interfaces/IState.hpp>
@@ -55,7 +87,13 @@
 #include <AGE/Core/loggers/StringLogger.hpp>
 #include <AGE/Core/loggers/onullstream>
 #include <AGE/Core/states/SplashState.hpp>
+#include <AGE/Core/utils/BitStream.hpp>
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
+#include <AGE/Core/utils/MemoryStream.hpp>
+#include <AGE/Core/utils/ReadAheadStream.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
 #include <AGE/Core/utils/StringUtil.hpp>
+#include <AGE/Core/utils/Symbol.hpp>
 
 #endif // AGE_CORE_HPP_INCLUDED
 
@@ -16,6 +16,23 @@
  * @date 20120630 - Added new GraphicRange enumeration
  * @date 20120702 - Add new EventManager and Event ID typedef
  * @date 20120720 - Moved PropertyManager to Core library from Entity library
+ * @date 20261018 - Added new TraceManager forward declaration
+ * @date 20261018 - Added new Histogram forward declaration
+ * @date 20261018 - Added new RunMode enumeration for headless game loops
+ * @date 20261018 - Added new InputRecorder forward declaration
+ * @date 20261018 - Added new MemoryMappedFile and StringRef forward declarations
+ * @date 20261018 - Added StringPool and Symbol, assetID is now an interned Symbol
+ * @date 20261018 - Added new AssetManifest, IJob and JobManager forward declarations
+ * @date 20261018 - Added new SoundManager forward declaration
+ * @date 20261018 - Added new MemoryStream and ReadAheadStream forward declarations
+ * @date 20261018 - Added new SoundBank forward declaration
+ * @date 20261018 - Added new AssetDownloader forward declaration
+ * @date 20261018 - Added ReplicationRole and new ReplicationManager and BitStream declarations
+ * @date 20261018 - Added new RollbackManager forward declaration
+ * @date 20261018 - Added new FrameArena forward declaration
+ * @date 20261018 - Added new ObjectPool forward declaration
+ * @date 20261018 - Added new MemoryTracker forward declaration
+ * @date 20261018 - Added new SizeClassPool forward declaration
  */
 #ifndef   AGE_CORE_TYPES_HPP_INCLUDED
 #define   AGE_CORE_TYPES_HPP_INCLUDED
@@ -40,6 +57,22 @@ namespace AGE {
         HighRange = 2 ///< Recommend using HighRange graphics (128x128 pixels)
     };
 
+    /// Enumeration of Game run modes
+
+    enum RunMode {
+        RunWindowed = 0, ///< Open a window, process input and draw each frame
+        RunHeadless = 1, ///< No window, update at the fixed update rate
+        RunHeadlessBatch = 2 ///< No window, update as fast as possible
+    };
+
+    /// Enumeration of ReplicationManager roles
+
+    enum ReplicationRole {
+        ReplicationNone = 0, ///< Not replicating
+        ReplicationServer = 1, ///< Sending snapshots to clients
+        ReplicationClient = 2 ///< Receiving snapshots from a server
+    };
+
     /// Enumeration of AssetLoadTime
 
     enum AssetLoadTime {
@@ -95,16 +128,32 @@ namespace AGE {
     class Game;
     class IAssetHandler;
     class IEvent;
+    class IJob;
     class ILogger;
     class IProperty;
     class IState;
 
     // Forward declare AGE core classes provided
+    class AssetDownloader;
     class AssetManager;
+    class AssetManifest;
     class ConfigReader;
     class EventManager;
+    class FrameArena;
+    class Histogram;
+    class InputRecorder;
+    class JobManager;
+    class MemoryTracker;
+    class ObjectPool;
     class PropertyManager;
+    class ReplicationManager;
+    class RollbackManager;
+    class SizeClassPool;
+    class SoundBank;
+    class SoundManager;
     class StateManager;
+    class StringPool;
+    class TraceManager;
 
     // Forward declare AGE core assets provided
     class ConfigAsset;
@@ -129,8 +178,16 @@ namespace AGE {
     class MenuState;
     class SplashState;
 
+    // Forward declare AGE core utils provided
+    class BitStream;
+    class MemoryMappedFile;
+    class MemoryStream;
+    class ReadAheadStream;
+    class StringRef;
+    class Symbol;
+
     /// Declare Asset ID typedef which is used for identifying Asset objects
-    typedef std::string assetID;
+    typedef Symbol assetID;
 
     typedef Uint32 Id;
 
@@ -5,6 +5,8 @@
  * @file include/AGE/Core/assets/FontHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Defer releases made away from the owner thread
+ * @date 20261018 - Share one decoded asset between files with identical content
  */
 #ifndef   CORE_FONT_HANDLER_HPP_INCLUDED
 #define   CORE_FONT_HANDLER_HPP_INCLUDED
@@ -60,6 +62,20 @@ namespace AGE
      */
     virtual bool loadFromNetwork(const assetID theAssetID, sf::Font& theAsset);
 
+    /**
+     * IsReleaseDeferred will return true since fonts own OpenGL textures that
+     * must be released by the thread that created this handler.
+     * @return true because releases are deferred
+     */
+    virtual bool isReleaseDeferred(void) const;
+
+    /**
+     * IsDeduplicated will return true since fonts are never modified after
+     * they are loaded and can be shared by identical files.
+     * @return true because identical fonts are shared
+     */
+    virtual bool isDeduplicated(void) const;
+
   private:
   }; // class FontHandler
 } // namespace AGE
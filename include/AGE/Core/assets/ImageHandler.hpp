@@ -5,6 +5,9 @@
  * @file include/AGE/Core/assets/ImageHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Defer releases made away from the owner thread
+ * @date 20261018 - Share one decoded asset between files with identical content
+ * @date 20261018 - Never share images since textures may be modified
  */
 #pragma once//added to make MSVC 2010 stop complaining.
 #ifndef   CORE_IMAGE_HANDLER_HPP_INCLUDED
@@ -78,6 +81,29 @@ namespace AGE
     virtual bool loadFromNetwork(const assetID theAssetID, sf::Texture& theAsset);
 #endif
 
+    /**
+     * IsReleaseDeferred will return true since images own OpenGL textures that
+     * must be released by the thread that created this handler.
+     * @return true because releases are deferred
+     */
+    virtual bool isReleaseDeferred(void) const;
+
+    /**
+     * IsDeduplicated will return false since a texture may be modified after
+     * it is loaded (e.g. sf::Texture::update or setSmooth), which must not
+     * change the images loaded from other identical files.
+     * @return false because identical images are never shared
+     */
+    virtual bool isDeduplicated(void) const;
+
+    /**
+     * GetAssetBytes will return the memory used by the RGBA pixels of
+     * theAsset provided.
+     * @param[in] theAsset that was loaded
+     * @return the bytes used by theAsset
+     */
+    virtual Uint64 getAssetBytes(const sf::Texture& theAsset) const;
+
   private:
   }; // class ImageHandler
 } // namespace AGE
@@ -5,6 +5,8 @@
  * @file include/AGE/Core/assets/MusicHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Stream music through read ahead and memory mapped streams
+ * @date 20261018 - Delete the streamed music created by AcquireAsset
  */
 #ifndef   CORE_MUSIC_HANDLER_HPP_INCLUDED
 #define   CORE_MUSIC_HANDLER_HPP_INCLUDED
@@ -30,6 +32,21 @@ namespace AGE
     virtual ~MusicHandler();
  
   protected:
+    /**
+     * AcquireAsset will create the sf::Music derived asset which owns the
+     * sf::InputStream it streams from.
+     * @param[in] theAssetID of the asset to acquire
+     * @return a pointer to the newly created asset
+     */
+    virtual sf::Music* acquireAsset(const assetID theAssetID);
+
+    /**
+     * ReleaseAsset will delete theAsset created by AcquireAsset.
+     * @param[in] theAssetID of the asset to be released
+     * @param[in] theAsset to be released
+     */
+    virtual void releaseAsset(const assetID theAssetID, sf::Music* theAsset);
+
     /**
      * LoadFromFile is responsible for loading theAsset from a file and must
      * be defined by the derived class since the interface for TYPE is
@@ -61,6 +78,19 @@ namespace AGE
     virtual bool loadFromNetwork(const assetID theAssetID, sf::Music& theAsset);
 
   private:
+    /**
+     * ParseFilename will split theFilename provided into the file to open and
+     * the region within it. Music packed inside a bundled data file is
+     * addressed as "file#offset,size" (size may be 0 for the rest of the
+     * file); any other filename refers to the whole file.
+     * @param[in] theFilename to parse
+     * @param[out] theFile to open
+     * @param[out] theOffset of the region in bytes
+     * @param[out] theSize of the region in bytes or 0 for the rest of the file
+     * @return true if theFilename could be parsed, false otherwise
+     */
+    static bool parseFilename(const std::string& theFilename, std::string& theFile,
+      Uint64& theOffset, Uint64& theSize);
   }; // class MusicHandler
 } // namespace AGE
 
@@ -72,6 +102,11 @@ namespace AGE
  * The MusicHandler class is used to reference count and manage all sf::Image
  * classes used in a AGE application.
  *
+ * Music loaded from a file is streamed through a ReadAheadStream so the
+ * thread decoding it never waits on the disk, and music loaded from memory
+ * is streamed through a MemoryStream over a memory mapped file. Either may
+ * refer to a region of a bundled data file (see ParseFilename).
+ *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -5,6 +5,7 @@
  * @file include/AGE/Core/assets/MusicHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Share one decoded asset between files with identical content
  */
 #ifndef   CORE_SOUND_HANDLER_HPP_INCLUDED
 #define   CORE_SOUND_HANDLER_HPP_INCLUDED
@@ -60,6 +61,21 @@ namespace AGE
      */
     virtual bool loadFromNetwork(const assetID theAssetID, sf::SoundBuffer& theAsset);
 
+    /**
+     * IsDeduplicated will return true since sound buffers are never modified
+     * after they are loaded and can be shared by identical files.
+     * @return true because identical sound buffers are shared
+     */
+    virtual bool isDeduplicated(void) const;
+
+    /**
+     * GetAssetBytes will return the memory used by the 16 bit samples of
+     * theAsset provided.
+     * @param[in] theAsset that was loaded
+     * @return the bytes used by theAsset
+     */
+    virtual Uint64 getAssetBytes(const sf::SoundBuffer& theAsset) const;
+
   private:
   }; // class SoundHandler
 } // namespace AGE
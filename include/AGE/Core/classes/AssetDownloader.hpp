@@ -0,0 +1,233 @@
+/**
+ * Provides the AssetDownloader class in the AGE namespace which is
+ * responsible for downloading assets over HTTP into an on-disk cache.
+ *
+ * @file include/AGE/Core/classes/AssetDownloader.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Only create the cache directory when a base URL is set
+ */
+#ifndef   CORE_ASSET_DOWNLOADER_HPP_INCLUDED
+#define   CORE_ASSET_DOWNLOADER_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include <SFML/Network.hpp>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides the HTTP downloads used by AssetLoadFromNetwork
+  class AGE_API AssetDownloader
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default number of bytes requested at a time
+      static const Uint32 DEFAULT_CHUNK_SIZE = 1048576;
+      /// Default number of seconds to wait for each response
+      static const Uint32 DEFAULT_TIMEOUT = 10;
+      /// Maximum number of idle sf::Http objects kept for reuse
+      static const Uint32 MAX_IDLE = 8;
+
+      /**
+       * AssetDownloader constructor
+       */
+      AssetDownloader();
+
+      /**
+       * AssetDownloader deconstructor
+       */
+      virtual ~AssetDownloader();
+
+      /**
+       * DoInit will set the URL asset filenames are relative to and the
+       * directory the downloaded assets are cached in (which is created if
+       * it doesn't exist and theBaseURL is not empty).
+       * @param[in] theBaseURL such as "http://localhost:8080/dlc/"
+       * @param[in] theCacheDir such as "cache/"
+       * @param[in] theChunkSize is the number of bytes requested at a time
+       * @param[in] theTimeout is the number of seconds to wait for a response
+       */
+      void doInit(const std::string& theBaseURL, const std::string& theCacheDir,
+        Uint32 theChunkSize = DEFAULT_CHUNK_SIZE, Uint32 theTimeout = DEFAULT_TIMEOUT);
+
+      /**
+       * DeInit will delete the sf::Http objects kept for reuse.
+       */
+      void deInit(void);
+
+      /**
+       * Download will make sure the cache holds the current contents of
+       * theFilename provided and return the cached file to load. A cached
+       * file is validated with its ETag, a partial download is resumed with
+       * a range request, and large files are downloaded CHUNK_SIZE bytes at
+       * a time. If the server can't be reached the cached file is used even
+       * if it might be stale. Several threads may download at once.
+       * @param[in] theFilename relative to the base URL or an absolute URL
+       * @param[out] theCachedFilename of the file to load
+       * @return true if theCachedFilename can be loaded, false otherwise
+       */
+      bool download(const std::string& theFilename, std::string& theCachedFilename);
+
+      /**
+       * GetURL will return the URL theFilename provided is downloaded from.
+       * @param[in] theFilename relative to the base URL or an absolute URL
+       * @return the URL to download theFilename from
+       */
+      std::string getURL(const std::string& theFilename) const;
+
+      /**
+       * GetDownloadCount will return the number of files downloaded (or
+       * resumed) since DoInit.
+       * @return the number of files downloaded
+       */
+      Uint32 getDownloadCount(void) const;
+
+      /**
+       * GetCacheHitCount will return the number of cached files the server
+       * confirmed were current since DoInit.
+       * @return the number of cache hits
+       */
+      Uint32 getCacheHitCount(void) const;
+
+      /**
+       * GetFallbackCount will return the number of cached files used because
+       * the server couldn't be reached since DoInit.
+       * @return the number of stale cached files used
+       */
+      Uint32 getFallbackCount(void) const;
+
+      /**
+       * GetBytesDownloaded will return the number of bytes downloaded since
+       * DoInit.
+       * @return the number of bytes downloaded
+       */
+      Uint64 getBytesDownloaded(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each idle sf::Http object kept for reuse
+      struct typeConnection
+      {
+        std::string    host; ///< Host the sf::Http object was created for
+        unsigned short port; ///< Port the sf::Http object was created for
+        sf::Http*      http; ///< The sf::Http object
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// URL asset filenames are relative to
+      std::string                 mBaseURL;
+      /// Directory downloaded assets are cached in
+      std::string                 mCacheDir;
+      /// Number of bytes requested at a time
+      Uint32                      mChunkSize;
+      /// Number of seconds to wait for each response
+      Uint32                      mTimeout;
+      /// Idle sf::Http objects kept for reuse
+      std::vector<typeConnection> mIdle;
+      /// URLs currently being downloaded
+      std::set<std::string>       mActive;
+      /// Mutex protecting mIdle and mActive
+      std::mutex                  mMutex;
+      /// Signaled when a download finishes
+      std::condition_variable     mFinished;
+      /// Number of files downloaded
+      std::atomic<Uint32>         mDownloads;
+      /// Number of cached files confirmed current
+      std::atomic<Uint32>         mCacheHits;
+      /// Number of stale cached files used
+      std::atomic<Uint32>         mFallbacks;
+      /// Number of bytes downloaded
+      std::atomic<Uint64>         mBytes;
+
+      /**
+       * Fetch will download theURI from the server into theCachedFilename,
+       * called by Download once no other thread is downloading it.
+       * @param[in] theHost to download from
+       * @param[in] thePort to download from
+       * @param[in] theURI to download
+       * @param[in] theCachedFilename to download into
+       * @return true if theCachedFilename is current, false otherwise
+       */
+      bool fetch(const std::string& theHost, const unsigned short thePort,
+        const std::string& theURI, const std::string& theCachedFilename);
+
+      /**
+       * AcquireHttp will return an idle sf::Http object for theHost and
+       * thePort provided or create a new one.
+       * @param[in] theHost to connect to
+       * @param[in] thePort to connect to
+       * @return the sf::Http object to use or NULL
+       */
+      sf::Http* acquireHttp(const std::string& theHost, const unsigned short thePort);
+
+      /**
+       * ReleaseHttp will keep theHttp object provided for reuse.
+       * @param[in] theHost theHttp was created for
+       * @param[in] thePort theHttp was created for
+       * @param[in] theHttp to keep
+       */
+      void releaseHttp(const std::string& theHost, const unsigned short thePort,
+        sf::Http* theHttp);
+
+      /**
+       * AssetDownloader copy constructor is private because we do not allow
+       * copies of our class
+       */
+      AssetDownloader(const AssetDownloader&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      AssetDownloader& operator=(const AssetDownloader&); // Intentionally undefined
+  }; // class AssetDownloader
+} // namespace AGE
+
+#endif // CORE_ASSET_DOWNLOADER_HPP_INCLUDED
+
+/**
+ * @class AGE::AssetDownloader
+ * @ingroup Core
+ * The AssetDownloader class is used by the LoadFromNetwork method of each
+ * asset handler (see IAssetHandler::downloadAsset) to ship new content
+ * without a new build. Each URL is cached in its own file named after the
+ * CRC32 of the URL, next to a file holding its ETag. A cached file is only
+ * downloaded again when the server no longer returns 304 Not Modified for
+ * its ETag. Downloads are requested in ranges of the chunk size, which keeps
+ * the memory used by each response small and lets an interrupted download
+ * continue where it stopped (If-Range makes sure the file didn't change in
+ * the meantime). Assets loaded by an AssetManifest are downloaded by the
+ * JobManager worker threads, so several downloads run in the background at
+ * once.
+ *
+ * SFML 2.3 closes the connection after every sf::Http request, so keep-alive
+ * connections aren't possible. The sf::Http objects (and the host addresses
+ * they resolved) are kept and reused instead.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
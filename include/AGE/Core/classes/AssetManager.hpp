@@ -13,12 +13,19 @@
  * @date 20110218 - Change to system include style
  * @date 20110627 - Remove extra , from enum and extra ; from namespace
  * @date 20120503 - Redo AssetManager to be more flexible and use RAII techniques
+ * @date 20261018 - Use TAssetHandler::getHandlerID instead of hashing typeid names
+ * @date 20261018 - Find TAssetHandler classes by type slot instead of by map
+ * @date 20261018 - Added ProcessReleases for releases deferred by other threads
+ * @date 20261018 - Register handlers by type name for asset manifests
+ * @date 20261018 - Added GetSavedBytes for assets shared by identical files
  */
 #ifndef   CORE_ASSET_MANAGER_HPP_INCLUDED
 #define   CORE_ASSET_MANAGER_HPP_INCLUDED
 
 #include <map>
+#include <string>
 #include <typeinfo>
+#include <vector>
 #include <AGE/Core/interfaces/TAssetHandler.hpp>
 #include <AGE/Core/Core_types.hpp>
 #include <AGE/Core/utils/CRC32.hpp>
@@ -48,14 +55,22 @@ namespace AGE
       template<class TYPE>
       TAssetHandler<TYPE>& getHandler() const
       {
+        // The type slot is a dense index so most lookups are an array load
+        const Uint32 anSlot = TAssetHandler<TYPE>::getHandlerSlot();
+        if(anSlot < mSlots.size() && NULL != mSlots[anSlot])
+        {
+          return *static_cast<TAssetHandler<TYPE>*>(mSlots[anSlot]);
+        }
+
         // The TAssetHandler<TYPE> derived class that will be returned
         TAssetHandler<TYPE>* anResult = NULL;
 
         // Iterator to the asset if found
         std::map<const Id, IAssetHandler*>::const_iterator iter;
 
-        // Try to find the asset using theAssetID as the key
-        iter = mHandlers.find(ID(typeid(TYPE).name()));
+        // Fall back to the handler ID for handlers created with a different
+        // type slot (e.g. from another module with its own template statics)
+        iter = mHandlers.find(TAssetHandler<TYPE>::getHandlerID());
 
         // Found asset? increment the count and return the reference
         if(iter != mHandlers.end())
@@ -88,8 +103,18 @@ namespace AGE
        * derived class with the AssetManager. These handlers are used to manage
        * various asset types used by game states and other entities.
        * @param[in] theAssetHandler pointer to register
+       * @param[in] theName of the asset type used by AssetManifest (optional)
+       */
+      void registerHandler(IAssetHandler* theAssetHandler,
+        const std::string& theName = std::string());
+
+      /**
+       * FindHandler is responsible for returning the IAssetHandler derived
+       * class previously registered under the asset type theName provided.
+       * @param[in] theName of the asset type to find
+       * @return the IAssetHandler found or NULL if not found
        */
-      void registerHandler(IAssetHandler* theAssetHandler);
+      IAssetHandler* findHandler(const std::string& theName) const;
 
       /**
        * LoadAllAssets is responsible for loading all unloaded assets for every
@@ -99,6 +124,21 @@ namespace AGE
        */
       bool loadAllAssets(void);
 
+      /**
+       * ProcessReleases is responsible for releasing every asset whose last
+       * reference was dropped by another thread for every IAssetHandler
+       * derived class registered, called once each frame by the Game loop.
+       */
+      void processReleases(void);
+
+      /**
+       * GetSavedBytes is responsible for returning the memory saved by every
+       * IAssetHandler derived class registered by sharing one decoded asset
+       * between asset IDs whose files have identical contents.
+       * @return the number of bytes saved
+       */
+      Uint64 getSavedBytes(void) const;
+
     private:
       // Constants
       ///////////////////////////////////////////////////////////////////////////
@@ -107,6 +147,10 @@ namespace AGE
       ///////////////////////////////////////////////////////////////////////////
       /// Map to hold all IAssetHandler derived classes that manage assets
       std::map<const Id, IAssetHandler*> mHandlers;
+      /// Handlers registered indexed by IAssetHandler::getTypeSlot()
+      std::vector<IAssetHandler*> mSlots;
+      /// Handlers registered by asset type name for AssetManifest
+      std::map<std::string, IAssetHandler*> mNames;
 
       /**
        * AssetManager copy constructor is private because we do not allow copies
@@ -0,0 +1,227 @@
+/**
+ * Provides the AssetManifest class in the AGE namespace which is responsible
+ * for prefetching a list of assets and their dependencies in the background.
+ *
+ * @file include/AGE/Core/classes/AssetManifest.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Count the assets that failed to load separately
+ */
+#ifndef   CORE_ASSET_MANIFEST_HPP_INCLUDED
+#define   CORE_ASSET_MANIFEST_HPP_INCLUDED
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/Symbol.hpp>
+
+namespace AGE
+{
+  /// Provides a list of assets that are loaded in the background
+  class AGE_API AssetManifest
+  {
+    public:
+      /**
+       * AssetManifest constructor
+       * @param[in] theAssetManager to find the IAssetHandler of each asset
+       * @param[in] theJobManager to load the assets with
+       */
+      AssetManifest(AssetManager& theAssetManager, JobManager& theJobManager);
+
+      /**
+       * AssetManifest deconstructor will release every asset reference held
+       */
+      virtual ~AssetManifest();
+
+      /**
+       * LoadFromFile will add every asset listed in theSection of the
+       * configuration file provided (see LoadFromConfig).
+       * @param[in] theFilename of the configuration file to read
+       * @param[in] theSection listing the assets
+       * @return true if every asset listed was added, false otherwise
+       */
+      bool loadFromFile(const std::string& theFilename, const std::string& theSection);
+
+      /**
+       * LoadFromConfig will add every asset listed in theSection of theConfig
+       * provided. Each name is an asset ID and each value is the type name
+       * the IAssetHandler was registered with (see
+       * AssetManager::registerHandler) optionally followed by a comma
+       * separated list of the asset IDs it depends on, for example:
+       *   resources/level1.cfg = config, resources/tiles.png
+       *   resources/tiles.png = image
+       * @param[in] theConfig to read the assets from
+       * @param[in] theSection listing the assets
+       * @return true if every asset listed was added, false otherwise
+       */
+      bool loadFromConfig(const ConfigReader& theConfig, const std::string& theSection);
+
+      /**
+       * AddAsset will add theAssetID provided to this manifest.
+       * @param[in] theType name of the IAssetHandler for the asset
+       * @param[in] theAssetID to add
+       * @return true if theType was found, false otherwise
+       */
+      bool addAsset(const std::string& theType, const assetID theAssetID);
+
+      /**
+       * AddDependency will make sure theDependencyID is loaded before
+       * theAssetID (both must be added using AddAsset before Prefetch).
+       * @param[in] theAssetID that depends on theDependencyID
+       * @param[in] theDependencyID to load first
+       */
+      void addDependency(const assetID theAssetID, const assetID theDependencyID);
+
+      /**
+       * Prefetch will obtain a reference to every asset in this manifest and
+       * start loading the assets that have no dependencies using the
+       * JobManager. Update must then be called (once each frame) to start
+       * loading the assets that depend on them.
+       */
+      void prefetch(void);
+
+      /**
+       * Update will start loading the next group of assets once every asset
+       * they depend on has been loaded.
+       */
+      void update(void);
+
+      /**
+       * Release will wait for any assets still being loaded and then drop
+       * every asset reference obtained by Prefetch.
+       */
+      void release(void);
+
+      /**
+       * IsEmpty will return true if no assets have been added.
+       * @return true if this manifest is empty, false otherwise
+       */
+      bool isEmpty(void) const;
+
+      /**
+       * IsReady will return true if every asset in this manifest has
+       * finished loading (successfully or not, see HasFailed).
+       * @return true if every asset has finished loading, false otherwise
+       */
+      bool isReady(void) const;
+
+      /**
+       * HasFailed will return true if any asset in this manifest failed to
+       * load (or was never loaded because the JobManager was stopped).
+       * @return true if any asset is missing, false otherwise
+       */
+      bool hasFailed(void) const;
+
+      /**
+       * GetProgress will return the percentage (0 to 100) of the assets in
+       * this manifest that have finished loading (successfully or not).
+       * @return the percentage of assets loaded
+       */
+      float getProgress(void) const;
+
+    private:
+      /// Job that loads one asset of this manifest
+      class LoadJob;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each asset in this manifest
+      struct typeEntry
+      {
+        assetID             id;           ///< Asset ID to load
+        IAssetHandler*      handler;      ///< Handler that owns the asset
+        std::vector<Uint32> dependencies; ///< Index of each asset to load first
+        Uint32              level;        ///< Load group (after its dependencies)
+        bool                referenced;   ///< True if AddReference succeeded
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// AssetManager used to find each IAssetHandler
+      AssetManager&           mAssetManager;
+      /// JobManager used to load the assets
+      JobManager&             mJobManager;
+      /// Every asset in this manifest in the order added
+      std::vector<typeEntry>  mEntries;
+      /// Next load group to start or the number of groups when done
+      Uint32                  mNextLevel;
+      /// Number of load groups found by Prefetch
+      Uint32                  mLevels;
+      /// True between Prefetch and Release
+      bool                    mPrefetched;
+      /// Number of assets in the started groups that haven't finished
+      std::atomic<Uint32>     mLoading;
+      /// Number of assets that have been loaded
+      std::atomic<Uint32>     mLoaded;
+      /// Number of assets that failed to load
+      std::atomic<Uint32>     mFailed;
+
+      /**
+       * FindEntry will return the index of theAssetID in mEntries.
+       * @param[in] theAssetID to find
+       * @return the index found or mEntries.size() if not found
+       */
+      Uint32 findEntry(const assetID theAssetID) const;
+
+      /**
+       * GetLevel will return the load group of the entry at theIndex which is
+       * one more than the highest load group of its dependencies.
+       * @param[in] theIndex of the entry
+       * @param[in] theDepth of the recursion used to detect cycles
+       * @return the load group of the entry
+       */
+      Uint32 getLevel(const Uint32 theIndex, const Uint32 theDepth);
+
+      /**
+       * StartLevel will add a LoadJob for every asset in the next load group.
+       */
+      void startLevel(void);
+
+      /**
+       * AssetManifest copy constructor is private because we do not allow
+       * copies of our class
+       */
+      AssetManifest(const AssetManifest&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      AssetManifest& operator=(const AssetManifest&); // Intentionally undefined
+  }; // class AssetManifest
+} // namespace AGE
+
+#endif // CORE_ASSET_MANIFEST_HPP_INCLUDED
+
+/**
+ * @class AGE::AssetManifest
+ * @ingroup Core
+ * The AssetManifest class lists the assets a state needs so they can be
+ * loaded by the JobManager before the state becomes active (see
+ * StateManager::addActiveStateWhenReady). Assets are loaded in groups: an
+ * asset is only loaded once every asset it depends on has been loaded, and
+ * assets in the same group are loaded in parallel. The references obtained
+ * by Prefetch keep the assets resident until Release is called or the
+ * manifest is destroyed, so the TAsset objects created by the state later
+ * find their assets already loaded.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
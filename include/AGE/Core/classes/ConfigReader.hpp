@@ -17,13 +17,19 @@
  * @date 20110820 - Moved private Parse methods to StringUtil.hpp/cpp
  * @date 20110820 - Changed Read to LoadFromFile to match SFML style
  * @date 20110820 - Removed GetColor, use GetString and ParseColor instead
+ * @date 20261018 - Memory mapped one pass parser without the line length limit
+ * @date 20261018 - Flat hashed section/name table with ID overloads and typed value cache
+ * @date 20261018 - Added binary compiled cache of parsed configuration files
+ * @date 20261018 - Added GetNames for listing every name in a section
+ * @date 20261018 - Parse typed values when stored so getters never write
  */
 #ifndef   CORE_CONFIG_READER_HPP_INCLUDED
 #define   CORE_CONFIG_READER_HPP_INCLUDED
 
-#include <map>
 #include <string>
+#include <vector>
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
 
 namespace AGE
 {
@@ -49,12 +55,37 @@ namespace AGE
       virtual ~ConfigReader();
 
       /**
-       * IsSectionEmpty determines if theSection provided exists and has 1 or
-       * more name, value pairs to retrieve.
+       * IsSectionEmpty determines if theSection provided exists but has no
+       * name, value pairs to retrieve.
        * @param[in] theSection to check
-       * @return true if theSection provided exists
+       * @return true if theSection provided exists and is empty
        */
-      bool isSectionEmpty(const std::string theSection) const;
+      bool isSectionEmpty(const std::string& theSection) const;
+
+      /**
+       * IsSectionEmpty determines if theSection ID provided (see ID()) exists
+       * but has no name, value pairs to retrieve.
+       * @param[in] theSection ID to check
+       * @return true if theSection provided exists and is empty
+       */
+      bool isSectionEmpty(const Id theSection) const;
+
+      /**
+       * GetNames will add every name found in theSection provided to
+       * theNames in the order they were read.
+       * @param[in] theSection to list the names of
+       * @param[out] theNames to add each name to
+       */
+      void getNames(const std::string& theSection,
+          std::vector<std::string>& theNames) const;
+
+      /**
+       * GetNames will add every name found in theSection ID provided (see
+       * ID()) to theNames in the order they were read.
+       * @param[in] theSection ID to list the names of
+       * @param[out] theNames to add each name to
+       */
+      void getNames(const Id theSection, std::vector<std::string>& theNames) const;
 
       /**
        * GetBool will return the boolean value for theSection and theName
@@ -66,7 +97,18 @@ namespace AGE
        * @param[in] theDefault to use if the value is not found (optional)
        * @return the value found or theDefault if not found or correct
        */
-      bool getBool(const std::string theSection, const std::string theName,
+      bool getBool(const std::string& theSection, const std::string& theName,
+          const bool theDefault = false) const;
+
+      /**
+       * GetBool will return the boolean value for theSection and theName IDs
+       * (see ID()) specified or theDefault(false) if not found or correct.
+       * @param[in] theSection ID to use for finding the value to return
+       * @param[in] theName ID to use for finding the value to return
+       * @param[in] theDefault to use if the value is not found (optional)
+       * @return the value found or theDefault if not found or correct
+       */
+      bool getBool(const Id theSection, const Id theName,
           const bool theDefault = false) const;
 
       /**
@@ -78,7 +120,18 @@ namespace AGE
        * @param[in] theDefault to use if the value is not found (optional)
        * @return the value found or theDefault if not found or correct
        */
-      float getFloat(const std::string theSection, const std::string theName,
+      float getFloat(const std::string& theSection, const std::string& theName,
+          const float theDefault = 0.f) const;
+
+      /**
+       * GetFloat will return a floating point number for theSection and
+       * theName IDs (see ID()) specified or theDefault(0.f) if not found.
+       * @param[in] theSection ID to use for finding theName
+       * @param[in] theName ID to use for finding the value to return
+       * @param[in] theDefault to use if the value is not found (optional)
+       * @return the value found or theDefault if not found or correct
+       */
+      float getFloat(const Id theSection, const Id theName,
           const float theDefault = 0.f) const;
 
       /**
@@ -89,8 +142,19 @@ namespace AGE
        * @param[in] theDefault to use if the value is not found (optional)
        * @return the value found or theDefault if not found
        */
-      std::string getString(const std::string theSection,
-          const std::string theName, const std::string theDefault = "") const;
+      std::string getString(const std::string& theSection,
+          const std::string& theName, const std::string theDefault = "") const;
+
+      /**
+       * GetString will return the string value for theSection and theName IDs
+       * (see ID()) specified or theDefault("") if not found.
+       * @param[in] theSection ID to use for finding theName
+       * @param[in] theName ID to use for finding the value to return
+       * @param[in] theDefault to use if the value is not found (optional)
+       * @return the value found or theDefault if not found
+       */
+      std::string getString(const Id theSection, const Id theName,
+          const std::string theDefault = "") const;
 
       /**
        * GetUint32 will return an unsigned 32 bit number for theSection and
@@ -101,17 +165,41 @@ namespace AGE
        * @param[in] theDefault to use if the value is not found (optional)
        * @return the value found or theDefault if not found
        */
-      Uint32 getUint32(const std::string theSection, const std::string theName,
+      Uint32 getUint32(const std::string& theSection, const std::string& theName,
           const Uint32 theDefault = 0) const;
 
       /**
-       * LoadFromFile will open and read the configuration file specified into
-       * internal maps that can be later retrieved using the Get* options above.
+       * GetUint32 will return an unsigned 32 bit number for theSection and
+       * theName IDs (see ID()) specified or theDefault(0) if not found.
+       * @param[in] theSection ID to use for finding theName
+       * @param[in] theName ID to use for finding the value to return
+       * @param[in] theDefault to use if the value is not found (optional)
+       * @return the value found or theDefault if not found
+       */
+      Uint32 getUint32(const Id theSection, const Id theName,
+          const Uint32 theDefault = 0) const;
+
+      /**
+       * LoadFromFile will memory map and read the configuration file specified
+       * into internal maps that can be later retrieved using the Get* options
+       * above. Lines may be of any length. If caching is enabled and a valid
+       * binary cache of theFilename exists it is memory mapped and used
+       * directly instead, otherwise the cache is written after parsing.
        * @param[in] theFilename to use as the configuration file to read
        * @result true if theFilename was found and opened successfully
        */
       bool loadFromFile(const std::string theFilename);
 
+      /**
+       * LoadFromMemory will read the configuration file contents provided
+       * into internal maps that can be later retrieved using the Get* options
+       * above.
+       * @param[in] theData containing the configuration file contents
+       * @param[in] theSize of theData in bytes
+       * @result true if theData was read successfully
+       */
+      bool loadFromMemory(const char* theData, const size_t theSize);
+
       /**
        * Assignment operator will duplicate the information found in theRight
        * into this ConfigReader class.
@@ -120,36 +208,196 @@ namespace AGE
        */
       ConfigReader& operator=(const ConfigReader& theRight);
 
+      /**
+       * SetCacheEnabled will enable or disable the binary cache used by
+       * LoadFromFile for every ConfigReader (enabled by default).
+       * @param[in] theEnabled true to use and write binary caches
+       */
+      static void setCacheEnabled(const bool theEnabled);
+
+      /**
+       * SetCacheDirectory will set the directory binary caches are written
+       * to. If empty (default) each cache is written next to its source file
+       * as <filename>.bin.
+       * @param[in] theDirectory to write binary caches to (must exist)
+       */
+      static void setCacheDirectory(const std::string& theDirectory);
+
+      /**
+       * GetCacheFilename will return the binary cache filename used for the
+       * configuration file theFilename.
+       * @param[in] theFilename of the configuration file
+       * @return the binary cache filename
+       */
+      static std::string getCacheFilename(const std::string& theFilename);
+
     private:
-      // Constants
-      ///////////////////////////////////////////////////////////////////////////
-      static const unsigned short MAX_CHARS = 100;
+      /// Flags for each typed value that has been parsed into the cache
+      enum ParsedFlags
+      {
+        ParsedBool   = 0x01, ///< asBool has been parsed
+        ParsedFloat  = 0x02, ///< asFloat has been parsed
+        ParsedUint32 = 0x04  ///< asUint32 has been parsed
+      };
+
+      /// Name, value pair stored in the flat hash table
+      struct typeEntry
+      {
+        Uint64         key;       ///< Section ID << 32 | name ID
+        Uint32         name;      ///< Offset of the name in mStrings
+        Uint32         value;     ///< Offset of the value in mStrings
+        Uint32         size;      ///< Length of the value
+        Uint8          parsed;    ///< ParsedFlags for the typed values
+        Uint8          valid;     ///< ParsedFlags for values that parsed ok
+        bool           asBool;    ///< Value parsed as a bool
+        float          asFloat;   ///< Value parsed as a float
+        Uint32         asUint32;  ///< Value parsed as an unsigned 32 bit number
+      };
+
+      /// Section found in the configuration file
+      struct typeSection
+      {
+        Id     id;     ///< Section ID
+        Uint32 name;   ///< Offset of the section name in mStrings
+        Uint32 count;  ///< Number of name, value pairs in this section
+      };
 
       // Variables
       ///////////////////////////////////////////////////////////////////////////
-      /// Map to store all the sections and their corresponding name=value pairs
-      std::map<const std::string, typeNameValue*> mSections;
+      /// Every name, value pair stored in the order they were read
+      std::vector<typeEntry>   mEntries;
+      /// Open addressed hash table of mEntries index + 1 (0 means empty)
+      std::vector<Uint32>      mTable;
+      /// Every section found in the order they were read
+      std::vector<typeSection> mSections;
+      /// Owned buffer of null terminated section names, names and values
+      std::vector<char>        mStrings;
+      /// Binary cache the views below point into (NULL if not from a cache)
+      MemoryMappedFile*        mImage;
+      /// View of the name, value pairs (mEntries or the binary cache)
+      const typeEntry*         mEntryData;
+      /// Number of name, value pairs in mEntryData
+      Uint32                   mEntryCount;
+      /// View of the hash table (mTable or the binary cache)
+      const Uint32*            mTableData;
+      /// Number of slots in mTableData
+      Uint32                   mTableSize;
+      /// View of the sections (mSections or the binary cache)
+      const typeSection*       mSectionData;
+      /// Number of sections in mSectionData
+      Uint32                   mSectionCount;
+      /// View of the strings (mStrings or the binary cache)
+      const char*              mStringData;
+      /// Number of bytes in mStringData
+      Uint32                   mStringSize;
+      /// True if LoadFromFile should use and write binary caches
+      static bool              gCacheEnabled;
+      /// Directory to write binary caches to (empty means next to the source)
+      static std::string       gCacheDirectory;
 
       /**
-       * ParseLine will parse the line provided by the Read method above.
-       * @param theLine to be parsed.
-       * @param theCount is the line number currently being processed
-       * @param theSection to be used if name, value pair is parsed
-       * @return string representing the new section name if section name was parsed
+       * Parse will tokenize theData provided in a single pass, storing each
+       * name, value pair found into its section.
+       * @param theData to be parsed
+       * @param theSize of theData in bytes
        */
-      std::string parseLine(const char* theLine, const unsigned long theCount,
-          const std::string theSection);
+      void parse(const char* theData, const size_t theSize);
 
       /**
-       * StoreNameValue will store theName and theValue pair into theSection.
-       * If theSection name value map doesn't yet exist, then it will be created.
-       * @param theSection is used to find the name, value pair map
+       * Trim will return the characters between theBegin and theEnd without
+       * any preceeding or trailing spaces.
+       * @param theBegin of the characters to trim
+       * @param theEnd of the characters to trim
+       * @return the trimmed characters
+       */
+      static StringRef trim(const char* theBegin, const char* theEnd);
+
+      /**
+       * GetId will return the ID (see ID()) of theString provided.
+       * @param theString to compute the ID of
+       * @return the ID of theString
+       */
+      static Id getId(const StringRef theString);
+
+      /**
+       * StoreString will copy theString into mStrings with a null terminator.
+       * @param theString to store
+       * @return the offset of the string in mStrings
+       */
+      Uint32 storeString(const StringRef theString);
+
+      /**
+       * StoreSection will add theSection to mSections if it doesn't yet
+       * exist.
+       * @param theSection name to add
+       * @return the index of theSection in mSections
+       */
+      size_t storeSection(const StringRef theSection);
+
+      /**
+       * StoreNameValue will store theName and theValue pair into theSection
+       * unless theName already exists.
+       * @param theSection index in mSections to store the pair into
        * @param theName to be stored as the key for theValue below
        * @param theValue to be stored in the current section name
+       * @return true if the pair was stored, false otherwise
        */
-      void storeNameValue(const std::string theSection,
-          const std::string theName, const std::string theValue);
+      bool storeNameValue(const size_t theSection, const StringRef theName,
+          const StringRef theValue);
 
+      /**
+       * FindEntry will return the name, value pair for theKey provided.
+       * @param theKey (section ID << 32 | name ID) to find
+       * @return pointer to the pair found or NULL if not found
+       */
+      const typeEntry* findEntry(const Uint64 theKey) const;
+
+      /**
+       * InsertEntry will add theIndex of a pair in mEntries to mTable,
+       * growing mTable if needed.
+       * @param theIndex of the pair in mEntries
+       */
+      void insertEntry(const Uint32 theIndex);
+
+      /**
+       * Refresh will point the views at the owned vectors after they change.
+       */
+      void refresh(void);
+
+      /**
+       * Detach will copy the binary cache into the owned vectors and release
+       * it so more name, value pairs can be added.
+       */
+      void detach(void);
+
+      /**
+       * LoadCache will memory map theCacheFilename and use it if it was
+       * compiled from theSource provided.
+       * @param theCacheFilename to load
+       * @param theSource configuration file the cache must match
+       * @return true if the cache is valid and is now being used
+       */
+      bool loadCache(const std::string& theCacheFilename,
+          const MemoryMappedFile& theSource);
+
+      /**
+       * WriteCache will write the binary cache of theSource, including the
+       * typed values of every entry, to theCacheFilename.
+       * @param theCacheFilename to write
+       * @param theSource configuration file the cache was compiled from
+       */
+      void writeCache(const std::string& theCacheFilename,
+          const MemoryMappedFile& theSource);
+
+      /**
+       * ParseValue will parse theValue of theEntry provided as theType into
+       * the typed values of theEntry.
+       * @param theEntry to parse
+       * @param theValue of theEntry
+       * @param theType of ParsedFlags to parse
+       */
+      static void parseValue(typeEntry& theEntry, const StringRef theValue,
+          const ParsedFlags theType);
   }; // class ConfigReader
 } // namespace AGE
 
@@ -160,7 +408,21 @@ namespace AGE
  * @ingroup Core
  * The ConfigReader class is used to read from configuration files those
  * settings needed for the program.  For now these files are basic .INI
- * type files.
+ * type files.  Every name, value pair is stored in one flat open addressed
+ * hash table keyed by the ID of its section and name, so the ID overloads of
+ * the Get* methods (e.g. getUint32(ID("window"), ID("width"))) need no
+ * string hashing at all.  Each value is parsed as a bool, float and Uint32
+ * when it is stored, so the Get* methods never modify the ConfigReader and
+ * may be called from multiple threads at once once it is loaded.
+ *
+ * After a file is parsed by LoadFromFile the whole table, including the
+ * typed values, is written as a binary cache
+ * (<filename>.bin or into the directory given to SetCacheDirectory). The
+ * next LoadFromFile of the same file memory maps that cache and uses it
+ * directly if the size and modification time of the source still match
+ * (or its CRC32 matches when only the modification time changed). The
+ * cache stores native structures so it is only valid for the platform and
+ * build that wrote it.
  *
  * Copyright (c) 2010-2011 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
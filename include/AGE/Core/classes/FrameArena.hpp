@@ -0,0 +1,266 @@
+/**
+ * Provides the FrameArena class in the AGE namespace which is responsible
+ * for handing out memory that only needs to live for the current and next
+ * frame without touching the heap, and the TFrameAllocator adapter that lets
+ * STL containers use it.
+ *
+ * @file include/AGE/Core/classes/FrameArena.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_FRAME_ARENA_HPP_INCLUDED
+#define   CORE_FRAME_ARENA_HPP_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a double buffered bump allocator reset every frame
+  class AGE_API FrameArena
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default size in bytes of each of the two buffers
+      static const size_t DEFAULT_SIZE = 1048576;
+      /// Default alignment in bytes of each allocation
+      static const size_t DEFAULT_ALIGNMENT = 16;
+
+      /**
+       * FrameArena constructor
+       */
+      FrameArena();
+
+      /**
+       * FrameArena deconstructor
+       */
+      virtual ~FrameArena();
+
+      /**
+       * DoInit will allocate both buffers of theSize bytes provided,
+       * discarding anything previously allocated from the arena.
+       * @param[in] theSize in bytes of each buffer
+       * @return true if the buffers were allocated, false otherwise
+       */
+      bool doInit(const size_t theSize = DEFAULT_SIZE);
+
+      /**
+       * DeInit will free both buffers and anything allocated from them.
+       */
+      void deInit(void);
+
+      /**
+       * Allocate will return theSize bytes aligned to theAlignment provided
+       * which remain valid until the end of the next frame. Requests that
+       * don't fit in the current buffer are taken from the heap (and freed at
+       * the same time) and counted by GetOverflowCount.
+       * @param[in] theSize in bytes to allocate
+       * @param[in] theAlignment of the memory, must be a power of 2
+       * @return pointer to the memory or NULL if the heap is out of memory
+       */
+      void* allocate(const size_t theSize, const size_t theAlignment = DEFAULT_ALIGNMENT);
+
+      /**
+       * NextFrame is called by the game loop at the end of each frame. It
+       * makes the buffer used two frames ago current again, discarding
+       * everything allocated from it.
+       */
+      void nextFrame(void);
+
+      /**
+       * GetCapacity will return the size of each buffer.
+       * @return the size of each buffer in bytes
+       */
+      size_t getCapacity(void) const;
+
+      /**
+       * GetUsed will return the number of bytes allocated so far this frame.
+       * @return the number of bytes used this frame
+       */
+      size_t getUsed(void) const;
+
+      /**
+       * GetPeak will return the most bytes allocated in any one frame
+       * (including overflow), which is the size each buffer should be.
+       * @return the high water mark in bytes
+       */
+      size_t getPeak(void) const;
+
+      /**
+       * GetOverflowCount will return the number of allocations that didn't fit
+       * in the buffer and were taken from the heap instead.
+       * @return the number of allocations that overflowed
+       */
+      Uint32 getOverflowCount(void) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The two buffers, allocations alternate between them each frame
+      char*              mBuffers[2];
+      /// Size of each buffer in bytes
+      size_t             mCapacity;
+      /// Index of the buffer used this frame
+      Uint32             mCurrent;
+      /// Bytes used in the current buffer
+      size_t             mUsed;
+      /// Bytes taken from the heap this frame
+      size_t             mOverflowUsed;
+      /// Most bytes allocated in any one frame
+      size_t             mPeak;
+      /// Number of allocations that overflowed onto the heap
+      Uint32             mOverflowCount;
+      /// Heap allocations made when each buffer was full
+      std::vector<char*> mOverflow[2];
+
+      /**
+       * Release will free every overflow allocation made while theBuffer
+       * provided was current.
+       * @param[in] theBuffer index to release the overflow allocations of
+       */
+      void release(const Uint32 theBuffer);
+
+      /**
+       * FrameArena copy constructor is private because we do not allow copies
+       * of our class
+       */
+      FrameArena(const FrameArena&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      FrameArena& operator=(const FrameArena&); // Intentionally undefined
+  }; // class FrameArena
+
+  /// Provides an STL allocator that allocates from a FrameArena
+  template<class TYPE>
+  class TFrameAllocator
+  {
+    public:
+      typedef TYPE           value_type;
+      typedef TYPE*          pointer;
+      typedef const TYPE*    const_pointer;
+      typedef TYPE&          reference;
+      typedef const TYPE&    const_reference;
+      typedef size_t         size_type;
+      typedef std::ptrdiff_t difference_type;
+
+      /// Provides the same allocator for another type
+      template<class OTHER>
+      struct rebind
+      {
+        typedef TFrameAllocator<OTHER> other;
+      };
+
+      /**
+       * TFrameAllocator constructor
+       * @param[in] theArena to allocate from
+       */
+      explicit TFrameAllocator(FrameArena& theArena) :
+        mArena(&theArena)
+      {
+      }
+
+      /**
+       * TFrameAllocator rebind constructor
+       * @param[in] theOther allocator to use the arena of
+       */
+      template<class OTHER>
+      TFrameAllocator(const TFrameAllocator<OTHER>& theOther) :
+        mArena(theOther.getArena())
+      {
+      }
+
+      /**
+       * Allocate will return room for theCount values from the arena.
+       * @param[in] theCount of values to allocate
+       * @return pointer to the first value
+       */
+      TYPE* allocate(const size_t theCount)
+      {
+        return static_cast<TYPE*>(mArena->allocate(theCount * sizeof(TYPE),
+          alignof(TYPE)));
+      }
+
+      /**
+       * Deallocate does nothing, the arena frees everything at once.
+       */
+      void deallocate(TYPE*, const size_t)
+      {
+      }
+
+      /**
+       * GetArena will return the arena this allocator allocates from.
+       * @return pointer to the FrameArena
+       */
+      FrameArena* getArena(void) const
+      {
+        return mArena;
+      }
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The arena to allocate from
+      FrameArena* mArena;
+  }; // class TFrameAllocator
+
+  template<class LEFT, class RIGHT>
+  bool operator==(const TFrameAllocator<LEFT>& theLeft, const TFrameAllocator<RIGHT>& theRight)
+  {
+    return theLeft.getArena() == theRight.getArena();
+  }
+
+  template<class LEFT, class RIGHT>
+  bool operator!=(const TFrameAllocator<LEFT>& theLeft, const TFrameAllocator<RIGHT>& theRight)
+  {
+    return theLeft.getArena() != theRight.getArena();
+  }
+
+  /// A string whose characters are allocated from a FrameArena
+  typedef std::basic_string<char, std::char_traits<char>, TFrameAllocator<char> > FrameString;
+} // namespace AGE
+
+#endif // CORE_FRAME_ARENA_HPP_INCLUDED
+
+/**
+ * @class AGE::FrameArena
+ * @ingroup Core
+ * The FrameArena class is owned by the Game class (see Game::mFrameArena) and
+ * is used for transient work done each frame, such as building strings for
+ * display or temporary lists of objects to draw. Allocating is a pointer bump
+ * and nothing is ever freed individually, instead the game loop calls
+ * NextFrame at the end of each frame. There are two buffers so anything
+ * allocated in one frame can still be used during the next one (e.g. data
+ * produced by one update and consumed by the following draw).
+ *
+ * The arena is only meant to be used from the game loop thread. GetPeak
+ * reports the high water mark so the [arena] size setting can be tuned, and
+ * allocations that don't fit still succeed using the heap.
+ *
+ * TFrameAllocator lets STL containers and FrameString use the arena, the
+ * container must not be used after the end of the next frame.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,145 @@
+/**
+ * Provides the Histogram class in the AGE namespace which is responsible for
+ * recording time values into log-linear (HDR style) buckets so percentiles
+ * can be computed with a fixed relative error and no allocations.
+ *
+ * @file include/AGE/Core/classes/Histogram.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_HISTOGRAM_HPP_INCLUDED
+#define   CORE_HISTOGRAM_HPP_INCLUDED
+
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a fixed size log-linear histogram for time values
+  class AGE_API Histogram
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of bits used for the linear sub buckets (32 sub buckets, ~3% error)
+      static const Uint32 SUB_BUCKET_BITS = 5;
+      /// Number of linear sub buckets in each power of two range
+      static const Uint32 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+      /// Total number of buckets needed to cover every Uint32 value
+      static const Uint32 BUCKETS = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+      /**
+       * Histogram constructor
+       */
+      Histogram();
+
+      /**
+       * Reset will remove every value recorded so far.
+       */
+      void reset(void);
+
+      /**
+       * Record will add theValue provided to the histogram.
+       * @param[in] theValue to record (typically microseconds)
+       */
+      void record(Uint32 theValue);
+
+      /**
+       * Merge will add every value recorded by theOther histogram to this
+       * histogram.
+       * @param[in] theOther histogram to merge into this histogram
+       */
+      void merge(const Histogram& theOther);
+
+      /**
+       * GetCount will return the number of values recorded.
+       * @return the number of values recorded
+       */
+      Uint64 getCount(void) const;
+
+      /**
+       * GetMin will return the smallest value recorded or 0 if empty.
+       * @return the smallest value recorded
+       */
+      Uint32 getMin(void) const;
+
+      /**
+       * GetMax will return the largest value recorded or 0 if empty.
+       * @return the largest value recorded
+       */
+      Uint32 getMax(void) const;
+
+      /**
+       * GetMean will return the average of every value recorded.
+       * @return the average value recorded or 0 if empty
+       */
+      double getMean(void) const;
+
+      /**
+       * GetPercentile will return the value at thePercentile provided. The
+       * value returned is the upper bound of the bucket containing the
+       * percentile, limited to the largest value recorded.
+       * @param[in] thePercentile to find in the range [0,100]
+       * @return the value at thePercentile or 0 if empty
+       */
+      Uint32 getPercentile(float thePercentile) const;
+
+      /**
+       * GetBucket will return the bucket index for theValue provided.
+       * @param[in] theValue to find the bucket index for
+       * @return the bucket index for theValue
+       */
+      static Uint32 getBucket(Uint32 theValue);
+
+      /**
+       * GetBucketLimit will return the largest value that falls in theBucket
+       * index provided.
+       * @param[in] theBucket index to find the largest value for
+       * @return the largest value stored in theBucket
+       */
+      static Uint32 getBucketLimit(Uint32 theBucket);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of values recorded in each bucket
+      Uint32 mBuckets[BUCKETS];
+      /// Number of values recorded
+      Uint64 mCount;
+      /// Sum of every value recorded (used for the mean)
+      Uint64 mTotal;
+      /// Smallest value recorded
+      Uint32 mMin;
+      /// Largest value recorded
+      Uint32 mMax;
+  }; // class Histogram
+} // namespace AGE
+
+#endif // CORE_HISTOGRAM_HPP_INCLUDED
+
+/**
+ * @class AGE::Histogram
+ * @ingroup Core
+ * The Histogram class is used by the StatManager class to record frame,
+ * update and render times. Values below 64 are stored exactly, larger
+ * values are stored in 32 linear buckets per power of two which bounds the
+ * percentile error to about 3% while using a fixed amount of memory.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,206 @@
+/**
+ * Provides the InputRecorder class in the AGE namespace which is responsible
+ * for recording the sf::Event stream of the game loop, stamped with update
+ * tick indices, into a compact binary file and replaying it later.
+ *
+ * @file include/AGE/Core/classes/InputRecorder.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_INPUT_RECORDER_HPP_INCLUDED
+#define   CORE_INPUT_RECORDER_HPP_INCLUDED
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <SFML/Window.hpp>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides deterministic input recording and replay for the game loop
+  class AGE_API InputRecorder
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Magic value at the start of every input recording file ("AGEI")
+      static const Uint32 FILE_MAGIC = 0x49454741;
+      /// Version of the input recording file format
+      static const Uint16 FILE_VERSION = 1;
+      /// Entry type used to mark the tick the recording was stopped on
+      static const Uint8 END_OF_RECORDING = 0xFF;
+
+      /// The mode the InputRecorder is currently in
+      enum InputMode
+      {
+        InputIdle       = 0, ///< Neither recording nor replaying
+        InputRecording  = 1, ///< Recording events to a file
+        InputReplaying  = 2  ///< Replaying events from a file
+      };
+
+      /**
+       * InputRecorder constructor
+       */
+      InputRecorder();
+
+      /**
+       * InputRecorder deconstructor
+       */
+      virtual ~InputRecorder();
+
+      /**
+       * StartRecording will create theFilename provided and record every
+       * event passed to RecordEvent until Stop is called.
+       * @param[in] theFilename to record events into
+       * @param[in] theUpdateRate in milliseconds used by the game loop
+       * @return true if the file was created, false otherwise
+       */
+      bool startRecording(const std::string& theFilename, Uint32 theUpdateRate);
+
+      /**
+       * StartReplay will read every event in theFilename provided so they can
+       * be returned by ReplayEvent at the same update ticks they were
+       * recorded on.
+       * @param[in] theFilename to replay events from
+       * @return true if the file was read, false otherwise
+       */
+      bool startReplay(const std::string& theFilename);
+
+      /**
+       * Stop will stop recording (writing the end of recording marker for
+       * theTick provided) or replaying events.
+       * @param[in] theTick the game loop is currently on
+       */
+      void stop(Uint32 theTick);
+
+      /**
+       * GetMode will return the current mode of the InputRecorder.
+       * @return the current InputMode value
+       */
+      InputMode getMode(void) const;
+
+      /**
+       * IsActive will return true if events are being recorded or replayed.
+       * @return true if recording or replaying, false otherwise
+       */
+      bool isActive(void) const;
+
+      /**
+       * IsReplaying will return true if events are being replayed.
+       * @return true if replaying, false otherwise
+       */
+      bool isReplaying(void) const;
+
+      /**
+       * GetUpdateRate will return the update rate stored in the file being
+       * recorded or replayed.
+       * @return the update rate in milliseconds
+       */
+      Uint32 getUpdateRate(void) const;
+
+      /**
+       * RecordEvent will append theEvent provided for theTick to the
+       * recording.
+       * @param[in] theTick the event was received on
+       * @param[in] theEvent to record
+       */
+      void recordEvent(Uint32 theTick, const sf::Event& theEvent);
+
+      /**
+       * ReplayEvent will return the next event recorded for theTick provided.
+       * @param[in] theTick the game loop is currently on
+       * @param[out] theEvent to fill with the recorded event
+       * @return true if theEvent was filled, false if no more events remain
+       *         for theTick
+       */
+      bool replayEvent(Uint32 theTick, sf::Event& theEvent);
+
+      /**
+       * IsFinished will return true if the replay has reached the tick the
+       * recording was stopped on.
+       * @param[in] theTick the game loop is currently on
+       * @return true if the replay is finished, false otherwise
+       */
+      bool isFinished(Uint32 theTick) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The current mode of the InputRecorder
+      InputMode         mMode;
+      /// The file being recorded to (NULL when not recording)
+      FILE*             mFile;
+      /// Update rate in milliseconds stored in the file header
+      Uint32            mUpdateRate;
+      /// Buffer of entries waiting to be written or replayed
+      std::vector<char> mBuffer;
+      /// Offset of the next entry in mBuffer to replay
+      size_t            mOffset;
+      /// Tick the recording was stopped on (replay ends on this tick)
+      Uint32            mEndTick;
+
+      /**
+       * GetPayloadSize will return the number of bytes of the sf::Event
+       * union member used by theType of event provided.
+       * @param[in] theType of event
+       * @return the number of payload bytes (0 for events without data)
+       */
+      static size_t getPayloadSize(Uint8 theType);
+
+      /**
+       * Flush will write any buffered entries to the file being recorded.
+       */
+      void flush(void);
+
+      /**
+       * InputRecorder copy constructor is private because we do not allow
+       * copies of our class
+       */
+      InputRecorder(const InputRecorder&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      InputRecorder& operator=(const InputRecorder&); // Intentionally undefined
+  }; // class InputRecorder
+} // namespace AGE
+
+#endif // CORE_INPUT_RECORDER_HPP_INCLUDED
+
+/**
+ * @class AGE::InputRecorder
+ * @ingroup Core
+ * The InputRecorder class is used by the Game class to record the sf::Event
+ * stream polled from the window into a binary file (--record file) and to
+ * replay it later in place of polling the window (--replay file). Each entry
+ * holds the update tick it was received on, the event type and only the
+ * bytes of the sf::Event union member that type uses. While recording or
+ * replaying the game loop runs exactly one fixed update per frame, so a
+ * replay is frame-identical to the session it was recorded from and can be
+ * used as a reproducible performance scenario (also in headless modes).
+ *
+ * The file stores the raw event bytes in native byte order, so the header
+ * records the byte order and recordings are only replayed on machines with
+ * the same byte order.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,150 @@
+/**
+ * Provides the JobManager class in the AGE namespace which is responsible
+ * for running IJob derived classes on a pool of worker threads.
+ *
+ * @file include/AGE/Core/classes/JobManager.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_JOB_MANAGER_HPP_INCLUDED
+#define   CORE_JOB_MANAGER_HPP_INCLUDED
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides the pool of worker threads used for background work
+  class AGE_API JobManager
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Maximum number of worker threads that will be started
+      static const Uint32 MAX_WORKERS = 16;
+
+      /**
+       * JobManager constructor, no worker threads are started until DoInit
+       */
+      JobManager();
+
+      /**
+       * JobManager deconstructor
+       */
+      virtual ~JobManager();
+
+      /**
+       * DoInit will start theWorkers worker threads provided. If theWorkers
+       * is 0 then one less than the number of hardware threads will be
+       * started (but at least one).
+       * @param[in] theWorkers is the number of worker threads to start
+       */
+      void doInit(Uint32 theWorkers = 0);
+
+      /**
+       * DeInit will stop every worker thread after it finishes the job it is
+       * currently running. Jobs that haven't been started are deleted
+       * without being run.
+       */
+      void deInit(void);
+
+      /**
+       * AddJob will queue theJob provided to be run by the next available
+       * worker thread. The JobManager takes ownership of theJob and deletes
+       * it after it has been run. If no worker threads have been started
+       * theJob is run immediately by the calling thread.
+       * @param[in] theJob to run
+       */
+      void addJob(IJob* theJob);
+
+      /**
+       * WaitAll will wait until every job added has been run.
+       */
+      void waitAll(void);
+
+      /**
+       * GetWorkerCount will return the number of worker threads started.
+       * @return the number of worker threads
+       */
+      Uint32 getWorkerCount(void) const;
+
+      /**
+       * GetPendingCount will return the number of jobs that are waiting to
+       * be run or are being run right now.
+       * @return the number of jobs not yet finished
+       */
+      Uint32 getPendingCount(void) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Worker threads started by DoInit
+      std::vector<std::thread> mWorkers;
+      /// Jobs waiting for a worker thread in the order they were added
+      std::deque<IJob*>        mQueue;
+      /// Number of jobs being run by the worker threads right now
+      Uint32                   mRunning;
+      /// True while DeInit is stopping the worker threads
+      bool                     mStopping;
+      /// Mutex protecting mQueue, mRunning and mStopping
+      mutable std::mutex       mMutex;
+      /// Signaled when a job is added or the workers should stop
+      std::condition_variable  mWake;
+      /// Signaled when the last pending job has finished
+      std::condition_variable  mIdle;
+
+      /**
+       * WorkerLoop is run by each worker thread and runs jobs from mQueue
+       * until DeInit is called.
+       */
+      void workerLoop(void);
+
+      /**
+       * JobManager copy constructor is private because we do not allow copies
+       * of our class
+       */
+      JobManager(const JobManager&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      JobManager& operator=(const JobManager&); // Intentionally undefined
+  }; // class JobManager
+} // namespace AGE
+
+#endif // CORE_JOB_MANAGER_HPP_INCLUDED
+
+/**
+ * @class AGE::JobManager
+ * @ingroup Core
+ * The JobManager class runs IJob derived classes on a small pool of worker
+ * threads owned by the Game class (see Game::mJobManager) so asset loading
+ * and other slow work can happen while the game loop keeps running. Jobs are
+ * run in the order they were added but may finish in any order. The worker
+ * threads use std::thread and std::condition_variable since SFML provides
+ * no way for a thread to sleep until it is signaled.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,169 @@
+/**
+ * Provides the MemoryTracker class in the AGE namespace which is responsible
+ * for keeping track of the memory used by each subsystem of the application.
+ *
+ * @file include/AGE/Core/classes/MemoryTracker.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - WriteReport notes a tag expected to still be allocated
+ */
+#ifndef   CORE_MEMORY_TRACKER_HPP_INCLUDED
+#define   CORE_MEMORY_TRACKER_HPP_INCLUDED
+
+#include <atomic>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides the application wide memory accounting for each subsystem
+  class AGE_API MemoryTracker
+  {
+    public:
+      /// Enumeration of the subsystems whose memory is tracked
+      enum MemoryTag
+      {
+        MemoryAssets = 0,     ///< Assets without a more specific tag
+        MemoryTextures = 1,   ///< Decoded sf::Texture assets
+        MemorySounds = 2,     ///< Decoded sf::SoundBuffer assets
+        MemoryFonts = 3,      ///< Loaded sf::Font assets
+        MemoryProperties = 4, ///< IProperty derived classes
+        MemoryEvents = 5,     ///< IEvent derived classes
+        MemoryLoggers = 6,    ///< Messages buffered by the loggers
+        MemoryTagCount = 7    ///< Number of subsystems tracked
+      };
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Memory used by one subsystem
+      struct typeStats
+      {
+        const char* name;    ///< Name of the subsystem
+        Int64       current; ///< Bytes currently allocated
+        Int64       peak;    ///< Most bytes ever allocated at once
+        Int64       count;   ///< Allocations not yet released
+      };
+
+      /**
+       * GetInstance will return the application wide MemoryTracker which is
+       * created the first time it is needed and remains usable during static
+       * destruction.
+       * @return the MemoryTracker instance
+       */
+      static MemoryTracker& getInstance(void);
+
+      /**
+       * GetName will return the name of theTag provided.
+       * @param[in] theTag to get the name of
+       * @return the name of theTag
+       */
+      static const char* getName(const MemoryTag theTag);
+
+      /**
+       * Allocate will record a new allocation of theBytes for theTag.
+       * @param[in] theTag of the subsystem making the allocation
+       * @param[in] theBytes allocated
+       */
+      void allocate(const MemoryTag theTag, const Uint64 theBytes);
+
+      /**
+       * Release will record that an allocation of theBytes previously
+       * recorded by Allocate for theTag has been released.
+       * @param[in] theTag of the subsystem releasing the allocation
+       * @param[in] theBytes released
+       */
+      void release(const MemoryTag theTag, const Uint64 theBytes);
+
+      /**
+       * Resize will record that an existing allocation for theTag has grown
+       * (or shrunk if negative) by theBytes.
+       * @param[in] theTag of the subsystem resizing the allocation
+       * @param[in] theBytes added to the allocation
+       */
+      void resize(const MemoryTag theTag, const Int64 theBytes);
+
+      /**
+       * GetStats will return the memory used by theTag provided.
+       * @param[in] theTag of the subsystem to get
+       * @param[out] theStats to fill in
+       */
+      void getStats(const MemoryTag theTag, typeStats& theStats) const;
+
+      /**
+       * GetCurrent will return the bytes currently allocated by every tag.
+       * @return the total bytes currently allocated
+       */
+      Int64 getCurrent(void) const;
+
+      /**
+       * WriteReport will write the memory still allocated by each tag to the
+       * log file, as a warning for each tag with outstanding allocations.
+       * @param[in] theExpectedTag that may still be allocated (e.g. the
+       *            logger writing the report) and is only noted as info
+       * @return true if nothing else is still allocated, false otherwise
+       */
+      bool writeReport(const MemoryTag theExpectedTag = MemoryTagCount) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Bytes currently allocated by each tag
+      std::atomic<Int64> mCurrent[MemoryTagCount];
+      /// Most bytes ever allocated at once by each tag
+      std::atomic<Int64> mPeak[MemoryTagCount];
+      /// Allocations not yet released by each tag
+      std::atomic<Int64> mCount[MemoryTagCount];
+
+      /**
+       * MemoryTracker constructor is private, use GetInstance instead. There
+       * is intentionally no deconstructor so the instance can still be used
+       * by objects deleted during static destruction.
+       */
+      MemoryTracker();
+
+      /**
+       * MemoryTracker copy constructor is private because we do not allow
+       * copies of our class
+       */
+      MemoryTracker(const MemoryTracker&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      MemoryTracker& operator=(const MemoryTracker&); // Intentionally undefined
+  }; // class MemoryTracker
+} // namespace AGE
+
+#endif // CORE_MEMORY_TRACKER_HPP_INCLUDED
+
+/**
+ * @class AGE::MemoryTracker
+ * @ingroup Core
+ * The MemoryTracker class keeps the current and peak bytes allocated by each
+ * subsystem (see MemoryTag) using atomic counters so it can be updated from
+ * any thread without taking a lock. Asset handlers record the estimated
+ * decoded size of each asset they load, IProperty and IEvent record the
+ * ObjectPool blocks they are allocated from and the StringLogger records the
+ * messages it buffers. The StatManager can draw the values as an overlay and
+ * the Game writes a report of anything still allocated once all of its
+ * members have been destroyed.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,194 @@
+/**
+ * Provides the ObjectPool class in the AGE namespace which is responsible
+ * for allocating fixed size blocks for small objects from slabs of memory
+ * using a free list.
+ *
+ * @file include/AGE/Core/classes/ObjectPool.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_OBJECT_POOL_HPP_INCLUDED
+#define   CORE_OBJECT_POOL_HPP_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <SFML/System.hpp>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a pool of fixed size blocks allocated from slabs
+  class AGE_API ObjectPool
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default number of blocks in each slab
+      static const Uint32 DEFAULT_SLAB_BLOCKS = 64;
+      /// Alignment in bytes of every block
+      static const size_t BLOCK_ALIGNMENT = 16;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Statistics about each ObjectPool
+      struct typeStats
+      {
+        const char* name;      ///< Name of the pool
+        size_t      blockSize; ///< Size of each block in bytes
+        Uint32      used;      ///< Number of blocks in use
+        Uint32      peak;      ///< Most blocks ever in use at once
+        Uint32      capacity;  ///< Number of blocks in all slabs
+      };
+
+      /**
+       * ObjectPool constructor
+       * @param[in] theName of the pool shown in the statistics
+       * @param[in] theBlockSize in bytes of each object allocated
+       * @param[in] theSlabBlocks is the number of blocks to add to the pool
+       *            each time it runs out
+       */
+      ObjectPool(const char* theName, const size_t theBlockSize,
+        const Uint32 theSlabBlocks = DEFAULT_SLAB_BLOCKS);
+
+      /**
+       * ObjectPool deconstructor
+       */
+      virtual ~ObjectPool();
+
+      /**
+       * Allocate will return a block from the pool, adding a slab if there
+       * are no free blocks.
+       * @return pointer to the block or NULL if out of memory
+       */
+      void* allocate(void);
+
+      /**
+       * Release will return theBlock provided to the pool.
+       * @param[in] theBlock returned by Allocate (NULL is ignored)
+       */
+      void release(void* theBlock);
+
+      /**
+       * Owns will return true if theBlock provided belongs to this pool.
+       * @param[in] theBlock to look for
+       * @return true if theBlock is in one of our slabs, false otherwise
+       */
+      bool owns(const void* theBlock) const;
+
+      /**
+       * Create will construct a TYPE object in a block from the pool.
+       * @return pointer to the new object or NULL if out of memory
+       */
+      template<class TYPE>
+      TYPE* create(void)
+      {
+        void* anBlock = (sizeof(TYPE) <= mBlockSize) ? allocate() : NULL;
+        return (NULL != anBlock) ? new(anBlock) TYPE() : NULL;
+      }
+
+      /**
+       * Destroy will destruct theObject provided and return its block to
+       * the pool.
+       * @param[in] theObject returned by Create (NULL is ignored)
+       */
+      template<class TYPE>
+      void destroy(TYPE* theObject)
+      {
+        if(NULL != theObject)
+        {
+          theObject->~TYPE();
+          release(theObject);
+        }
+      }
+
+      /**
+       * GetStats will return the current statistics for this pool.
+       * @param[out] theStats to fill
+       */
+      void getStats(typeStats& theStats) const;
+
+      /**
+       * GetAllStats will return the statistics for every pool that exists.
+       * @param[out] theStats to add the statistics of each pool to
+       */
+      static void getAllStats(std::vector<typeStats>& theStats);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Name of the pool shown in the statistics
+      const char*        mName;
+      /// Size of each block in bytes
+      const size_t       mBlockSize;
+      /// Number of blocks in each slab
+      const Uint32       mSlabBlocks;
+      /// Slabs of blocks allocated so far
+      std::vector<char*> mSlabs;
+      /// First free block, each free block holds a pointer to the next one
+      void*              mFree;
+      /// Number of blocks in use
+      Uint32             mUsed;
+      /// Most blocks ever in use at once
+      Uint32             mPeak;
+      /// Next pool in the list of every pool
+      ObjectPool*        mNext;
+      /// Mutex protecting the free list so any thread may use the pool
+      mutable sf::Mutex  mMutex;
+
+      /**
+       * AddSlab will add a slab of blocks to the free list. The caller must
+       * hold mMutex.
+       * @return true if the slab was added, false if out of memory
+       */
+      bool addSlab(void);
+
+      /**
+       * ObjectPool copy constructor is private because we do not allow copies
+       * of our class
+       */
+      ObjectPool(const ObjectPool&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      ObjectPool& operator=(const ObjectPool&); // Intentionally undefined
+  }; // class ObjectPool
+} // namespace AGE
+
+#endif // CORE_OBJECT_POOL_HPP_INCLUDED
+
+/**
+ * @class AGE::ObjectPool
+ * @ingroup Core
+ * The ObjectPool class hands out blocks of one size for small objects that
+ * are created and destroyed often, such as IEvent and IProperty derived
+ * classes (see SizeClassPool) and the assets and control blocks of each
+ * TAssetHandler. Blocks are carved from slabs of DEFAULT_SLAB_BLOCKS so
+ * objects created together sit next to each other in memory, and allocating
+ * or releasing a block just pops or pushes the free list. Slabs are only
+ * freed when the pool is destroyed.
+ *
+ * Every pool is kept in a list so the StatManager can report how many blocks
+ * each one uses (see StatManager::getPoolStats).
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,525 @@
+/**
+ * Provides the ReplicationManager class in the AGE namespace which is
+ * responsible for replicating entity state from a server to its clients
+ * using delta compressed snapshots sent over UDP.
+ *
+ * @file include/AGE/Core/classes/ReplicationManager.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_REPLICATION_MANAGER_HPP_INCLUDED
+#define   CORE_REPLICATION_MANAGER_HPP_INCLUDED
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <SFML/Network.hpp>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/BitStream.hpp>
+
+namespace AGE
+{
+  /// Provides snapshot replication of entity fields over UDP
+  class AGE_API ReplicationManager
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Maximum number of fields each entity can replicate
+      static const Uint32 MAX_FIELDS = 16;
+      /// Maximum number of clients a server will accept
+      static const Uint32 MAX_CLIENTS = 32;
+      /// Number of snapshots a server remembers the contents of
+      static const Uint32 SNAPSHOT_COUNT = 32;
+      /// Number of versions of each entity clients keep as delta baselines
+      static const Uint32 HISTORY_COUNT = 8;
+      /// Maximum size of each packet in bytes (below the typical MTU)
+      static const Uint32 MAX_PACKET_SIZE = 1200;
+      /// Default number of snapshots sent each second
+      static const Uint32 DEFAULT_TICK_RATE = 20;
+      /// Default number of bytes each client may be sent each second
+      static const Uint32 DEFAULT_BANDWIDTH = 16384;
+      /// Default number of ticks clients render behind the newest snapshot
+      static const Uint32 DEFAULT_DELAY = 2;
+      /// Scale used to store float values as fixed point fields
+      static const Int32 FIXED_SCALE = 256;
+      /// Seconds without a packet before a client or server is dropped
+      static const float TIMEOUT;
+      /// Seconds between connect requests sent by a client
+      static const float CONNECT_INTERVAL;
+
+      /**
+       * ReplicationManager constructor
+       */
+      ReplicationManager();
+
+      /**
+       * ReplicationManager deconstructor
+       */
+      virtual ~ReplicationManager();
+
+      /**
+       * Listen will start a server on thePort provided which sends a snapshot
+       * to each connected client theTickRate times each second.
+       * @param[in] thePort to listen on (0 picks any free port)
+       * @param[in] theTickRate is the number of snapshots sent each second
+       * @return true if the port could be bound, false otherwise
+       */
+      bool listen(const unsigned short thePort,
+        const Uint32 theTickRate = DEFAULT_TICK_RATE);
+
+      /**
+       * Connect will start a client that receives snapshots from the server
+       * at theAddress and thePort provided.
+       * @param[in] theAddress of the server
+       * @param[in] thePort of the server
+       * @param[in] theTickRate the server sends snapshots at
+       * @return true if a local port could be bound, false otherwise
+       */
+      bool connect(const sf::IpAddress& theAddress, const unsigned short thePort,
+        const Uint32 theTickRate = DEFAULT_TICK_RATE);
+
+      /**
+       * Disconnect will tell the other side we are leaving, close the socket
+       * and forget every entity and client.
+       */
+      void disconnect(void);
+
+      /**
+       * GetRole will return whether this is a server, client or neither.
+       * @return the current ReplicationRole
+       */
+      ReplicationRole getRole(void) const;
+
+      /**
+       * IsConnected will return true if this is a server or a client that
+       * has received a snapshot recently.
+       * @return true if connected, false otherwise
+       */
+      bool isConnected(void) const;
+
+      /**
+       * GetLocalPort will return the port the socket is bound to.
+       * @return the local port or 0 if not bound
+       */
+      unsigned short getLocalPort(void) const;
+
+      /**
+       * Update will receive every packet waiting and, for a server, send a
+       * snapshot to each client once each tick. Clients advance the time
+       * used to interpolate between snapshots. Call once each frame.
+       * @param[in] theElapsedTime in seconds since the last call
+       */
+      void update(const float theElapsedTime);
+
+      /**
+       * AddEntity will start replicating theEntityID provided with
+       * theFieldCount fields that all start at 0 (server only).
+       * @param[in] theEntityID to replicate
+       * @param[in] theFieldCount from 1 to MAX_FIELDS
+       */
+      void addEntity(const Uint32 theEntityID, const Uint32 theFieldCount);
+
+      /**
+       * RemoveEntity will stop replicating theEntityID provided and remove
+       * it from every client (server only).
+       * @param[in] theEntityID to remove
+       */
+      void removeEntity(const Uint32 theEntityID);
+
+      /**
+       * SetField will change theField of theEntityID to theValue provided,
+       * which is sent to clients with the next snapshot (server only).
+       * @param[in] theEntityID to change
+       * @param[in] theField to change
+       * @param[in] theValue to replicate
+       */
+      void setField(const Uint32 theEntityID, const Uint32 theField, const Int32 theValue);
+
+      /**
+       * SetFloat will change theField of theEntityID to theValue provided
+       * stored as a fixed point value using FIXED_SCALE (server only).
+       * @param[in] theEntityID to change
+       * @param[in] theField to change
+       * @param[in] theValue to replicate
+       */
+      void setFloat(const Uint32 theEntityID, const Uint32 theField, const float theValue);
+
+      /**
+       * HasEntity will return true if theEntityID provided is replicated.
+       * @param[in] theEntityID to look for
+       * @return true if theEntityID exists, false otherwise
+       */
+      bool hasEntity(const Uint32 theEntityID) const;
+
+      /**
+       * GetEntityIDs will return the ID of each entity replicated, for a
+       * client these are the entities in the newest snapshot received.
+       * @param[out] theEntityIDs to fill in ascending order
+       */
+      void getEntityIDs(std::vector<Uint32>& theEntityIDs) const;
+
+      /**
+       * GetField will return theField of theEntityID from the newest
+       * snapshot (on a client) or as last set (on a server).
+       * @param[in] theEntityID to query
+       * @param[in] theField to query
+       * @return the value of theField or 0 if it doesn't exist
+       */
+      Int32 getField(const Uint32 theEntityID, const Uint32 theField) const;
+
+      /**
+       * GetFloat will return theField of theEntityID as a float. Clients
+       * interpolate between the two snapshots around the render time, which
+       * trails the newest snapshot by the interpolation delay.
+       * @param[in] theEntityID to query
+       * @param[in] theField to query
+       * @return the value of theField or 0 if it doesn't exist
+       */
+      float getFloat(const Uint32 theEntityID, const Uint32 theField) const;
+
+      /**
+       * SetBandwidth will set the number of bytes each client may be sent
+       * each second. Changes that don't fit are sent in later snapshots,
+       * the longest waiting first (server only).
+       * @param[in] theBytesPerSecond each client may be sent
+       */
+      void setBandwidth(const Uint32 theBytesPerSecond);
+
+      /**
+       * SetDelay will set the number of ticks clients render behind the
+       * newest snapshot, more ticks hide more lost or late snapshots.
+       * @param[in] theTicks to render behind
+       */
+      void setDelay(const Uint32 theTicks);
+
+      /**
+       * SetSimulation will drop and delay packets sent from this side to
+       * test on loopback as if on a real network.
+       * @param[in] theLoss is the fraction of packets to drop from 0 to 1
+       * @param[in] theLatency in seconds to delay each packet
+       * @param[in] theJitter in seconds of extra random delay
+       * @param[in] theSeed for the random number generator
+       */
+      void setSimulation(const float theLoss, const float theLatency,
+        const float theJitter = 0.0f, const Uint32 theSeed = 1);
+
+      /**
+       * GetClientCount will return the number of clients connected.
+       * @return the number of clients
+       */
+      Uint32 getClientCount(void) const;
+
+      /**
+       * GetTick will return the newest tick sent (server) or received
+       * (client).
+       * @return the newest tick
+       */
+      Uint32 getTick(void) const;
+
+      /**
+       * GetBytesSent will return the number of bytes sent since started.
+       * @return the number of bytes sent
+       */
+      Uint64 getBytesSent(void) const;
+
+      /**
+       * GetBytesReceived will return the number of bytes received since
+       * started.
+       * @return the number of bytes received
+       */
+      Uint64 getBytesReceived(void) const;
+
+      /**
+       * GetSendRate will return the number of bytes sent each second,
+       * measured over the last full second.
+       * @return the bytes sent per second
+       */
+      Uint32 getSendRate(void) const;
+
+      /**
+       * GetDroppedCount will return the number of packets dropped by the
+       * simulation or that couldn't be decoded.
+       * @return the number of packets dropped
+       */
+      Uint32 getDroppedCount(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// The state of an entity (a count of 0 marks a removed entity)
+      struct typeEntity
+      {
+        Uint32 id;                 ///< ID of the entity
+        Uint32 count;              ///< Number of fields used
+        Int32  fields[MAX_FIELDS]; ///< Value of each field
+      };
+      /// Entities sorted by ID
+      typedef std::vector<typeEntity> typeState;
+
+      /// What a server knows a client has of each entity
+      struct typeRemote
+      {
+        Uint32 count;                 ///< Number of fields acknowledged
+        Int32  acked[MAX_FIELDS];     ///< Fields the client acknowledged
+        Uint32 ackedSequence;         ///< Snapshot acknowledged (0 if none)
+        Uint32 resetSequence;         ///< Last snapshot with a full entry or removal
+        Int32  sent[MAX_FIELDS];      ///< Fields last sent
+        Uint32 sentCount;             ///< Number of fields last sent (0 if removed)
+        Uint32 sentSequence[HISTORY_COUNT]; ///< Newest snapshots sent in
+        Uint32 waited;                ///< Ticks spent waiting to be sent
+      };
+
+      /// The entries sent in each snapshot
+      struct typeRecord
+      {
+        Uint32    sequence; ///< Sequence number of the snapshot (0 if unused)
+        typeState entries;  ///< Entities sent (count of 0 if removed)
+      };
+
+      /// Each client connected to a server
+      struct typeClient
+      {
+        sf::IpAddress  address;  ///< Address of the client
+        unsigned short port;     ///< Port of the client
+        Uint32         sequence; ///< Sequence number of the last snapshot sent
+        float          idle;     ///< Seconds since the last packet received
+        float          roundTrip; ///< Ticks between sending and acknowledgement
+        std::map<Uint32, typeRemote> remotes; ///< What the client has
+        typeRecord     records[SNAPSHOT_COUNT]; ///< Snapshots sent by sequence
+      };
+
+      /// Each version of an entity received by a client
+      struct typeVersion
+      {
+        Uint32 sequence;           ///< Snapshot the version came in
+        Uint32 tick;               ///< Server tick of the snapshot
+        Int32  fields[MAX_FIELDS]; ///< Value of each field
+      };
+
+      /// The newest versions of an entity received by a client
+      struct typeHistory
+      {
+        Uint32      count;    ///< Number of fields
+        Uint32      newest;   ///< Index of the newest version
+        typeVersion versions[HISTORY_COUNT]; ///< Newest versions received
+      };
+
+      /// Each packet delayed by the simulation
+      struct typePacket
+      {
+        float              time;    ///< Time to send the packet
+        sf::IpAddress      address; ///< Address to send the packet to
+        unsigned short     port;    ///< Port to send the packet to
+        std::vector<Uint8> data;    ///< Contents of the packet
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Socket used to send and receive every packet
+      sf::UdpSocket             mSocket;
+      /// Whether this is a server, client or neither
+      ReplicationRole           mRole;
+      /// Snapshots sent each second
+      Uint32                    mTickRate;
+      /// Bytes each client may be sent each second
+      Uint32                    mBandwidth;
+      /// Ticks clients render behind the newest snapshot
+      Uint32                    mDelay;
+      /// Newest tick sent or received
+      Uint32                    mTick;
+      /// Seconds accumulated towards the next tick (server) or connect request
+      float                     mAccumulator;
+      /// Seconds since started, used to time delayed packets
+      float                     mTime;
+      /// Entities replicated by a server sorted by ID
+      typeState                 mEntities;
+      /// Clients connected to a server
+      std::vector<typeClient*>  mClients;
+      /// Address of the server a client connected to
+      sf::IpAddress             mServerAddress;
+      /// Port of the server a client connected to
+      unsigned short            mServerPort;
+      /// Seconds since a client received a packet from the server
+      float                     mServerIdle;
+      /// Entities received by a client
+      std::map<Uint32, typeHistory> mHistory;
+      /// Sequence number of the newest snapshot received (0 if none)
+      Uint32                    mNewest;
+      /// Which of the 32 snapshots before mNewest were received
+      Uint32                    mReceived;
+      /// Tick (with fraction) clients are rendering
+      float                     mRenderTick;
+      /// Fraction of packets to drop
+      float                     mLoss;
+      /// Seconds to delay each packet
+      float                     mLatency;
+      /// Seconds of extra random delay for each packet
+      float                     mJitter;
+      /// State of the simulation random number generator
+      Uint32                    mRandom;
+      /// Packets delayed by the simulation in the order they are due
+      std::deque<typePacket>    mDelayed;
+      /// Stream reused to build and decode packets
+      BitStream                 mStream;
+      /// Bytes sent since started
+      Uint64                    mBytesSent;
+      /// Bytes received since started
+      Uint64                    mBytesReceived;
+      /// Bytes sent during the current second
+      Uint32                    mRateBytes;
+      /// Seconds measured for the current second
+      float                     mRateTime;
+      /// Bytes sent during the last full second
+      Uint32                    mSendRate;
+      /// Packets dropped by the simulation or that couldn't be decoded
+      Uint32                    mDropped;
+
+      /**
+       * Receive will handle every packet waiting on the socket.
+       */
+      void receive(void);
+
+      /**
+       * SendSnapshots will take a snapshot of the entities and send it to
+       * each client delta compressed against the last snapshot it
+       * acknowledged (server only).
+       */
+      void sendSnapshots(void);
+
+      /**
+       * WriteSnapshot will write the entities that differ from what
+       * theClient acknowledged into mStream, longest waiting first, until the
+       * bandwidth for one tick is used.
+       * @param[in] theClient to write the snapshot for
+       * @param[out] theRecord of the entities written
+       */
+      void writeSnapshot(typeClient& theClient, typeRecord& theRecord);
+
+      /**
+       * ReadAck will update what theClient has from the snapshots it
+       * acknowledged (server only).
+       * @param[in] theClient that sent the acknowledgement
+       */
+      void readAck(typeClient& theClient);
+
+      /**
+       * ReadSnapshot will decode the snapshot in mStream and acknowledge it
+       * (client only).
+       */
+      void readSnapshot(void);
+
+      /**
+       * Send will send mStream to theAddress and thePort provided, dropping
+       * or delaying it if simulating a network.
+       * @param[in] theAddress to send to
+       * @param[in] thePort to send to
+       */
+      void send(const sf::IpAddress& theAddress, const unsigned short thePort);
+
+      /**
+       * SendPacket will send theSize bytes of theData to theAddress and
+       * thePort provided and count them.
+       * @param[in] theData to send
+       * @param[in] theSize of theData in bytes
+       * @param[in] theAddress to send to
+       * @param[in] thePort to send to
+       */
+      void sendPacket(const void* theData, const Uint32 theSize,
+        const sf::IpAddress& theAddress, const unsigned short thePort);
+
+      /**
+       * GetRandom will return the next simulation random number.
+       * @return a random number from 0 to 1
+       */
+      float getRandom(void);
+
+      /**
+       * FindEntity will return the entity with theEntityID (server only) or
+       * NULL if it doesn't exist.
+       * @param[in] theEntityID to find
+       * @return pointer to the entity or NULL
+       */
+      const typeEntity* findEntity(const Uint32 theEntityID) const;
+
+      /**
+       * FindVersion will return the newest version of theEntityID received
+       * (client only) or NULL if it doesn't exist.
+       * @param[in] theEntityID to find
+       * @param[out] theCount of fields of the entity
+       * @return pointer to the newest version or NULL
+       */
+      const typeVersion* findVersion(const Uint32 theEntityID, Uint32& theCount) const;
+
+      /**
+       * FindClient will return the client at theAddress and thePort provided
+       * or NULL if it isn't connected.
+       * @param[in] theAddress of the client
+       * @param[in] thePort of the client
+       * @return pointer to the client or NULL
+       */
+      typeClient* findClient(const sf::IpAddress& theAddress, const unsigned short thePort);
+
+      /**
+       * ReplicationManager copy constructor is private because we do not
+       * allow copies of our class
+       */
+      ReplicationManager(const ReplicationManager&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      ReplicationManager& operator=(const ReplicationManager&); // Intentionally undefined
+  }; // class ReplicationManager
+} // namespace AGE
+
+#endif // CORE_REPLICATION_MANAGER_HPP_INCLUDED
+
+/**
+ * @class AGE::ReplicationManager
+ * @ingroup Core
+ * The ReplicationManager class replicates the fields of server entities to
+ * every connected client. An entity is an ID with up to MAX_FIELDS integer
+ * fields (floats are stored as fixed point), which a game fills from its own
+ * objects or properties each update.
+ *
+ * Every tick the server writes a snapshot for each client containing only
+ * the entities that differ from the version of them that client last
+ * acknowledged. Each entity is encoded as a bit packed delta against its own
+ * acknowledged version, so an unchanged entity costs nothing and a small move
+ * costs a few bits. Lost snapshots are never resent, the entities in them
+ * simply stay changed until a later snapshot carrying them is acknowledged.
+ * Each client is only sent its share of the bandwidth per tick. Changes that
+ * don't fit wait for a later snapshot, the longest waiting first, so
+ * bandwidth stays bounded as the number of entities grows and every entity
+ * is still eventually updated.
+ *
+ * Clients keep the newest HISTORY_COUNT versions of each entity to decode
+ * deltas against, acknowledge each snapshot they decode and render slightly
+ * behind the newest one, interpolating between versions with GetFloat.
+ * SetSimulation drops and delays outgoing packets so all of this can be
+ * tested on loopback.
+ *
+ * Games create a ReplicationManager when they start or join a session and
+ * call Update once each frame.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
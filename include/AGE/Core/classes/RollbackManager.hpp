@@ -0,0 +1,273 @@
+/**
+ * Provides the RollbackManager class in the AGE namespace which is
+ * responsible for saving the simulation state each update tick into a
+ * preallocated buffer and rolling back and re-simulating from an earlier
+ * tick when corrected input arrives.
+ *
+ * @file include/AGE/Core/classes/RollbackManager.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_ROLLBACK_MANAGER_HPP_INCLUDED
+#define   CORE_ROLLBACK_MANAGER_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/PropertyManager.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Provides whole state snapshots and re-simulation for rollback netcode
+  class AGE_API RollbackManager
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of ticks that can be rolled back to
+      static const Uint32 SNAPSHOT_COUNT = 16;
+      /// Alignment in bytes of each region within a snapshot
+      static const Uint32 REGION_ALIGNMENT = 16;
+
+      /**
+       * RollbackManager constructor
+       */
+      RollbackManager();
+
+      /**
+       * RollbackManager deconstructor
+       */
+      virtual ~RollbackManager();
+
+      /**
+       * AddData will add theSize bytes at theData provided to the state saved
+       * every tick. The memory must be plain old data (no pointers to memory
+       * owned by it) and stay valid until RemoveData or Clear is called.
+       * Adding or removing data discards every saved snapshot.
+       * @param[in] theData to save and restore
+       * @param[in] theSize of theData in bytes
+       * @return true if theData was added, false otherwise
+       */
+      bool addData(void* theData, const size_t theSize);
+
+      /**
+       * AddValue will add theValue provided to the state saved every tick
+       * (e.g. the state of a random number generator).
+       * @param[in] theValue to save and restore, must be plain old data
+       * @return true if theValue was added, false otherwise
+       */
+      template<class TYPE>
+      bool addValue(TYPE& theValue)
+      {
+        return addData(&theValue, sizeof(TYPE));
+      }
+
+      /**
+       * AddProperty will add the value of thePropertyID in theProperties
+       * provided to the state saved every tick.
+       * @param[in] theProperties holding the property
+       * @param[in] thePropertyID of the property, its TYPE must be plain
+       *            old data
+       * @return true if the property value was added, false otherwise
+       */
+      template<class TYPE>
+      bool addProperty(PropertyManager& theProperties, const Id thePropertyID)
+      {
+        if(!theProperties.hasID(thePropertyID))
+        {
+          ELOG() << "RollbackManager::addProperty(" << thePropertyID
+            << ") property not found" << std::endl;
+          return false;
+        }
+        TYPE* anValue = theProperties.getPointer<TYPE>(thePropertyID);
+        return NULL != anValue && addData(anValue, sizeof(TYPE));
+      }
+
+      /**
+       * RemoveData will remove theData provided from the state saved every
+       * tick, states should do this in HandleCleanup for anything they added.
+       * @param[in] theData previously added
+       */
+      void removeData(const void* theData);
+
+      /**
+       * Clear will remove everything added and discard every saved snapshot.
+       */
+      void clear(void);
+
+      /**
+       * IsActive will return true if any data has been added, the game loop
+       * then uses a fixed elapsed time and saves a snapshot every tick.
+       * @return true if any data has been added, false otherwise
+       */
+      bool isActive(void) const;
+
+      /**
+       * GetSnapshotSize will return the number of bytes saved each tick.
+       * @return the size of each snapshot in bytes
+       */
+      size_t getSnapshotSize(void) const;
+
+      /**
+       * SaveTick will copy every region added into the snapshot for theTick
+       * provided, replacing the oldest snapshot.
+       * @param[in] theTick the state is being saved for
+       */
+      void saveTick(const Uint32 theTick);
+
+      /**
+       * LoadTick will copy the snapshot for theTick provided back into every
+       * region added.
+       * @param[in] theTick to restore the state of
+       * @return true if the snapshot was restored, false if it isn't saved
+       */
+      bool loadTick(const Uint32 theTick);
+
+      /**
+       * HasTick will return true if the snapshot for theTick is saved.
+       * @param[in] theTick to look for
+       * @return true if theTick can be restored, false otherwise
+       */
+      bool hasTick(const Uint32 theTick) const;
+
+      /**
+       * RequestRollback will ask for the state to be rolled back to the start
+       * of theTick provided (e.g. when late input for theTick arrives) and
+       * re-simulated up to the current tick before the next update. The
+       * earliest tick requested before the next update is used.
+       * @param[in] theTick to roll back to
+       * @return true if theTick can be rolled back to, false otherwise
+       */
+      bool requestRollback(const Uint32 theTick);
+
+      /**
+       * Update is called by the game loop before each tick is simulated. It
+       * will perform any rollback requested by calling UpdateVariable on
+       * theState for each tick being re-simulated and then save the snapshot
+       * for theTick provided.
+       * @param[in] theState to re-simulate
+       * @param[in] theTick about to be simulated
+       * @param[in] theElapsedTime to pass to UpdateVariable for each tick
+       */
+      void update(IState& theState, const Uint32 theTick, const float theElapsedTime);
+
+      /**
+       * GetTick will return the tick being simulated, which is earlier than
+       * the current tick while re-simulating. States use this to look up
+       * the input for the tick they are simulating.
+       * @return the tick being simulated
+       */
+      Uint32 getTick(void) const;
+
+      /**
+       * IsResimulating will return true while a rollback is re-simulating
+       * ticks, states can use this to skip sounds and other effects.
+       * @return true if re-simulating, false otherwise
+       */
+      bool isResimulating(void) const;
+
+      /**
+       * GetRollbackCount will return the number of rollbacks performed.
+       * @return the number of rollbacks
+       */
+      Uint32 getRollbackCount(void) const;
+
+      /**
+       * GetLastRollbackTime will return how long the last rollback (restore
+       * and re-simulation) took.
+       * @return the time in microseconds
+       */
+      Int64 getLastRollbackTime(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each region of memory saved every tick
+      struct typeRegion
+      {
+        void*  data;   ///< The memory to save and restore
+        size_t size;   ///< Number of bytes in data
+        size_t offset; ///< Offset of this region within each snapshot
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Regions saved every tick in the order they were added
+      std::vector<typeRegion> mRegions;
+      /// Buffer of SNAPSHOT_COUNT snapshots, each mSnapshotSize bytes
+      char*                   mBuffer;
+      /// Size of each snapshot in bytes
+      size_t                  mSnapshotSize;
+      /// Tick plus one saved in each snapshot (0 if the snapshot is empty)
+      Uint32                  mSaved[SNAPSHOT_COUNT];
+      /// Tick being simulated
+      Uint32                  mTick;
+      /// Earliest tick plus one a rollback was requested for (0 if none)
+      Uint32                  mRequested;
+      /// True while re-simulating ticks
+      bool                    mResimulating;
+      /// Number of rollbacks performed
+      Uint32                  mRollbacks;
+      /// Time in microseconds the last rollback took
+      Int64                   mRollbackTime;
+
+      /**
+       * Layout will compute the offset of each region, allocate the buffer
+       * for every snapshot and discard any snapshots saved.
+       */
+      void layout(void);
+
+      /**
+       * RollbackManager copy constructor is private because we do not allow
+       * copies of our class
+       */
+      RollbackManager(const RollbackManager&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      RollbackManager& operator=(const RollbackManager&); // Intentionally undefined
+  }; // class RollbackManager
+} // namespace AGE
+
+#endif // CORE_ROLLBACK_MANAGER_HPP_INCLUDED
+
+/**
+ * @class AGE::RollbackManager
+ * @ingroup Core
+ * The RollbackManager class is used by the Game class to save the simulation
+ * state at the start of every update tick and to roll it back when input for
+ * an earlier tick turns out to be different than predicted (e.g. a remote
+ * player's input arriving late). States add the plain old data they simulate
+ * (property values, their own simulation structures and the state of their
+ * random number generator) in DoInit and remove it in HandleCleanup.
+ *
+ * Each snapshot is a copy of every region at a fixed offset in one buffer
+ * allocated when regions are added, so saving and restoring a tick is one
+ * memcpy per region and never allocates. To roll back, a state calls
+ * RequestRollback with the tick whose input changed and the game loop then
+ * restores that tick and calls UpdateVariable once for each tick up to the
+ * current one with the fixed update rate, saving each tick again on the way.
+ * GetTick tells the state which tick's input to use.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,135 @@
+/**
+ * Provides the SizeClassPool class in the AGE namespace which is responsible
+ * for allocating small objects of varying sizes from a set of ObjectPools,
+ * one for each size class.
+ *
+ * @file include/AGE/Core/classes/SizeClassPool.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_SIZE_CLASS_POOL_HPP_INCLUDED
+#define   CORE_SIZE_CLASS_POOL_HPP_INCLUDED
+
+#include <cstddef>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
+
+namespace AGE
+{
+  /// Provides a set of ObjectPools for objects of up to 256 bytes
+  class AGE_API SizeClassPool
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of size classes (64, 128 and 256 bytes)
+      static const Uint32 POOL_COUNT = 3;
+      /// Block size of the smallest size class, each one doubles it
+      static const size_t SMALLEST_BLOCK_SIZE = 64;
+
+      /**
+       * SizeClassPool constructor
+       * @param[in] theName of each pool shown in the statistics
+       * @param[in] theMemoryTag to record the blocks allocated under
+       */
+      SizeClassPool(const char* theName,
+        const MemoryTracker::MemoryTag theMemoryTag);
+
+      /**
+       * SizeClassPool deconstructor
+       */
+      virtual ~SizeClassPool();
+
+      /**
+       * Allocate will return a block of at least theSize bytes from the
+       * pool of its size class, or from the heap if theSize is too large.
+       * @param[in] theSize in bytes of the object to allocate
+       * @return pointer to the block or NULL if out of memory
+       */
+      void* allocate(const size_t theSize);
+
+      /**
+       * Release will return theBlock provided of theSize bytes to the pool
+       * it was allocated from.
+       * @param[in] theBlock returned by Allocate (NULL is ignored)
+       * @param[in] theSize that was provided to Allocate
+       */
+      void release(void* theBlock, const size_t theSize);
+
+      /**
+       * Release will return theBlock provided to the pool that owns it when
+       * its size isn't known. Blocks from the heap can't be sized, so they
+       * stay recorded with the MemoryTracker.
+       * @param[in] theBlock returned by Allocate (NULL is ignored)
+       */
+      void release(void* theBlock);
+
+      /**
+       * GetBlockSize will return the bytes actually allocated for an object
+       * of theSize provided, which is the block size of its size class.
+       * @param[in] theSize in bytes of the object
+       * @return the bytes allocated
+       */
+      static size_t getBlockSize(const size_t theSize);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// One pool for each size class (entries may be NULL)
+      ObjectPool*                    mPools[POOL_COUNT];
+      /// Tag to record the blocks allocated under
+      const MemoryTracker::MemoryTag mMemoryTag;
+
+      /**
+       * GetPool will return the pool for the size class of theSize provided.
+       * @param[in] theSize in bytes of the object
+       * @return the pool to use or NULL to use the heap
+       */
+      ObjectPool* getPool(const size_t theSize) const;
+
+      /**
+       * SizeClassPool copy constructor is private because we do not allow
+       * copies of our class
+       */
+      SizeClassPool(const SizeClassPool&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      SizeClassPool& operator=(const SizeClassPool&); // Intentionally undefined
+  }; // class SizeClassPool
+} // namespace AGE
+
+#endif // CORE_SIZE_CLASS_POOL_HPP_INCLUDED
+
+/**
+ * @class AGE::SizeClassPool
+ * @ingroup Core
+ * The SizeClassPool class rounds each allocation up to a size class of 64,
+ * 128 or 256 bytes and hands out a block from the ObjectPool for that size
+ * class, falling back to the heap for anything larger. It is used by the
+ * class specific operator new and delete of IEvent and IProperty, which keep
+ * their SizeClassPool for the life of the application so objects can be
+ * deleted at any time, even during static destruction. Every block is
+ * recorded with the MemoryTracker under the tag provided.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
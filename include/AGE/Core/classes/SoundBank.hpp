@@ -0,0 +1,191 @@
+/**
+ * Provides the SoundBank class in the AGE namespace which is responsible for
+ * decoding a list of sound effects in parallel and installing them into the
+ * sf::SoundBuffer asset handler once every one has been decoded.
+ *
+ * @file include/AGE/Core/classes/SoundBank.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_SOUND_BANK_HPP_INCLUDED
+#define   CORE_SOUND_BANK_HPP_INCLUDED
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/interfaces/TAssetHandler.hpp>
+#include <AGE/Core/utils/Symbol.hpp>
+
+namespace AGE
+{
+  /// Provides a list of sound effects that are decoded in the background
+  class AGE_API SoundBank
+  {
+    public:
+      /**
+       * SoundBank constructor
+       * @param[in] theSoundHandler to install the decoded sound effects into
+       * @param[in] theJobManager to decode the sound effects with
+       */
+      SoundBank(TAssetHandler<sf::SoundBuffer>& theSoundHandler,
+        JobManager& theJobManager);
+
+      /**
+       * SoundBank deconstructor will release every sound effect reference
+       * held
+       */
+      virtual ~SoundBank();
+
+      /**
+       * LoadFromFile will add every sound effect listed in theSection of the
+       * configuration file provided (see LoadFromConfig).
+       * @param[in] theFilename of the configuration file to read
+       * @param[in] theSection listing the sound effects
+       * @return true if the configuration file was read, false otherwise
+       */
+      bool loadFromFile(const std::string& theFilename, const std::string& theSection);
+
+      /**
+       * LoadFromConfig will add every sound effect listed in theSection of
+       * theConfig provided. Each name is an asset ID and each value is the
+       * file to decode it from, or empty if the asset ID is the filename,
+       * for example:
+       *   sfx/jump = resources/sounds/jump.ogg
+       *   resources/sounds/land.ogg =
+       * @param[in] theConfig to read the sound effects from
+       * @param[in] theSection listing the sound effects
+       */
+      void loadFromConfig(const ConfigReader& theConfig, const std::string& theSection);
+
+      /**
+       * AddSound will add theAssetID provided to this sound bank.
+       * @param[in] theAssetID to add
+       * @param[in] theFilename to decode or empty to use theAssetID
+       */
+      void addSound(const assetID theAssetID, const std::string& theFilename = "");
+
+      /**
+       * Prefetch will start decoding every sound effect in this sound bank
+       * using the JobManager. Update must then be called (once each frame)
+       * to install them once every one has been decoded.
+       */
+      void prefetch(void);
+
+      /**
+       * Update will install every decoded sound effect into the
+       * sf::SoundBuffer asset handler once all of them have been decoded.
+       */
+      void update(void);
+
+      /**
+       * Release will wait for any sound effects still being decoded and then
+       * drop every sound effect reference obtained by Update.
+       */
+      void release(void);
+
+      /**
+       * IsEmpty will return true if no sound effects have been added.
+       * @return true if this sound bank is empty, false otherwise
+       */
+      bool isEmpty(void) const;
+
+      /**
+       * IsReady will return true if every sound effect in this sound bank
+       * has been installed (successfully decoded or not).
+       * @return true if every sound effect is installed, false otherwise
+       */
+      bool isReady(void) const;
+
+      /**
+       * GetProgress will return the percentage (0 to 100) of the sound
+       * effects in this sound bank that have finished decoding.
+       * @return the percentage of sound effects decoded
+       */
+      float getProgress(void) const;
+
+    private:
+      /// Job that decodes one sound effect of this sound bank
+      class DecodeJob;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each sound effect in this sound bank
+      struct typeEntry
+      {
+        assetID          id;         ///< Asset ID to install the sound effect as
+        Symbol           filename;   ///< File to decode the sound effect from
+        sf::SoundBuffer* buffer;     ///< Decoded sound effect or NULL on failure
+        bool             referenced; ///< True if InstallAsset added a reference
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Handler the decoded sound effects are installed into
+      TAssetHandler<sf::SoundBuffer>& mSoundHandler;
+      /// JobManager used to decode the sound effects
+      JobManager&             mJobManager;
+      /// Every sound effect in this sound bank in the order added
+      std::vector<typeEntry>  mEntries;
+      /// True between Prefetch and Release
+      bool                    mPrefetched;
+      /// True once Update has installed the sound effects
+      bool                    mInstalled;
+      /// Number of sound effects that haven't finished decoding
+      std::atomic<Uint32>     mDecoding;
+      /// Number of sound effects that have finished decoding
+      std::atomic<Uint32>     mDecoded;
+
+      /**
+       * Install will install every decoded sound effect, called by Update.
+       */
+      void install(void);
+
+      /**
+       * SoundBank copy constructor is private because we do not allow
+       * copies of our class
+       */
+      SoundBank(const SoundBank&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      SoundBank& operator=(const SoundBank&); // Intentionally undefined
+  }; // class SoundBank
+} // namespace AGE
+
+#endif // CORE_SOUND_BANK_HPP_INCLUDED
+
+/**
+ * @class AGE::SoundBank
+ * @ingroup Core
+ * The SoundBank class is used to preload large groups of sound effects
+ * without decoding them on the main thread. Prefetch gives each sound effect
+ * to the JobManager, which decodes it into a private sf::SoundBuffer, and
+ * GetProgress reports how many have finished. Once every one has finished,
+ * Update installs them all into the sf::SoundBuffer asset handler at once
+ * (see TAssetHandler::installAsset), so the SoundAsset objects created later
+ * find them already loaded and no sound effect of the bank is ever seen half
+ * decoded. Sound effects that were already loaded keep their existing asset.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,504 @@
+/**
+ * Provides the SoundManager class in the AGE namespace which is responsible
+ * for playing SoundAsset objects using a fixed pool of preallocated voices.
+ *
+ * @file include/AGE/Core/classes/SoundManager.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Added spatial grid of emitters bound to the loudest voices
+ */
+#ifndef   CORE_SOUND_MANAGER_HPP_INCLUDED
+#define   CORE_SOUND_MANAGER_HPP_INCLUDED
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/interfaces/TAssetHandler.hpp>
+
+namespace AGE
+{
+  /// Provides the pool of voices used to play sound effects
+  class AGE_API SoundManager
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default number of voices to preallocate
+      static const Uint32 DEFAULT_VOICES = 32;
+      /// Maximum number of voices that can be preallocated
+      static const Uint32 MAX_VOICES = 256;
+      /// Number of sound categories (e.g. weapons, footsteps, voices)
+      static const Uint32 MAX_CATEGORIES = 8;
+      /// Voice handle returned by Play when the sound wasn't played
+      static const Uint32 INVALID_VOICE = 0;
+      /// Emitter handle returned by AddEmitter when no emitter was added
+      static const Uint32 INVALID_EMITTER = 0;
+      /// Default number of voices emitters may be bound to at once
+      static const Uint32 DEFAULT_EMITTER_VOICES = 16;
+      /// Default size of each cell of the emitter grid
+      static const float DEFAULT_CELL_SIZE;
+      /// Default distance beyond which an emitter is never heard
+      static const float DEFAULT_EMITTER_RANGE;
+      /// Emitters quieter than this volume (0 to 100) are not bound to voices
+      static const float MIN_AUDIBLE_VOLUME;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Parameters used to play each sound
+      struct typeSoundParams
+      {
+        Uint32       category; ///< Category used for concurrency limits
+        Int32        priority; ///< Higher priority sounds steal lower ones
+        float        volume;   ///< Volume from 0 to 100
+        float        pitch;    ///< Pitch where 1 is unchanged
+        bool         loop;     ///< Loop until stopped?
+        bool         relative; ///< Is position relative to the listener?
+        sf::Vector3f position; ///< Position of the sound
+        float        minDistance; ///< Distance heard at full volume
+        float        attenuation; ///< How fast the volume drops beyond minDistance
+
+        /**
+         * typeSoundParams constructor will default to a non spatial sound
+         * in category 0 with priority 0 at full volume.
+         */
+        typeSoundParams() :
+          category(0),
+          priority(0),
+          volume(100.0f),
+          pitch(1.0f),
+          loop(false),
+          relative(true),
+          position(0.0f, 0.0f, 0.0f),
+          minDistance(1.0f),
+          attenuation(1.0f)
+        {
+        }
+      };
+
+      /**
+       * SoundManager constructor, no voices are allocated until DoInit
+       */
+      SoundManager();
+
+      /**
+       * SoundManager deconstructor
+       */
+      virtual ~SoundManager();
+
+      /**
+       * DoInit will preallocate theVoices voices provided. If theNullDevice
+       * is true no audio device is used and the voices only keep track of
+       * how long each sound would play for (e.g. for headless modes).
+       * @param[in] theVoices is the number of voices to preallocate
+       * @param[in] theNullDevice to play sounds without an audio device
+       */
+      void doInit(Uint32 theVoices = DEFAULT_VOICES, bool theNullDevice = false);
+
+      /**
+       * DeInit will stop every voice and release every voice allocated.
+       */
+      void deInit(void);
+
+      /**
+       * Play will play theSound provided on a free voice using theParams
+       * provided. If every voice is in use (or the category limit has been
+       * reached) the voice playing the lowest priority sound is stolen,
+       * preferring the sound farthest from the listener and then the oldest
+       * sound. The sound isn't played if every candidate has a higher
+       * priority. Play never allocates memory for the voice.
+       * @param[in] theSound to play
+       * @param[in] theParams to play theSound with
+       * @return the handle of the voice used or INVALID_VOICE
+       */
+      Uint32 play(SoundAsset& theSound,
+        const typeSoundParams& theParams = typeSoundParams());
+
+      /**
+       * Stop will stop the voice specified by theVoice handle provided.
+       * @param[in] theVoice handle returned by Play
+       */
+      void stop(const Uint32 theVoice);
+
+      /**
+       * StopAll will stop every voice.
+       */
+      void stopAll(void);
+
+      /**
+       * IsPlaying will return true if the voice specified by theVoice handle
+       * is still playing the sound it was returned for.
+       * @param[in] theVoice handle returned by Play
+       * @return true if still playing, false otherwise
+       */
+      bool isPlaying(const Uint32 theVoice) const;
+
+      /**
+       * SetPosition will move the sound playing on theVoice provided.
+       * @param[in] theVoice handle returned by Play
+       * @param[in] thePosition to move the sound to
+       */
+      void setPosition(const Uint32 theVoice, const sf::Vector3f& thePosition);
+
+      /**
+       * SetListenerPosition will move the listener used for spatial sounds
+       * and for choosing which voice to steal.
+       * @param[in] thePosition of the listener
+       */
+      void setListenerPosition(const sf::Vector3f& thePosition);
+
+      /**
+       * AddEmitter will add a looping sound emitter at the position found in
+       * theParams provided (which is never relative to the listener). Update
+       * only binds an emitter to a voice while it is one of the loudest
+       * emitters that can be heard (see SetEmitterVoices).
+       * @param[in] theSound to loop
+       * @param[in] theParams to play theSound with
+       * @param[in] theRange beyond which the emitter is never heard
+       * @return the handle of the emitter or INVALID_EMITTER
+       */
+      Uint32 addEmitter(SoundAsset& theSound, const typeSoundParams& theParams,
+        const float theRange = DEFAULT_EMITTER_RANGE);
+
+      /**
+       * RemoveEmitter will remove theEmitter provided, stopping its voice.
+       * @param[in] theEmitter handle returned by AddEmitter
+       */
+      void removeEmitter(const Uint32 theEmitter);
+
+      /**
+       * RemoveAllEmitters will remove every emitter.
+       */
+      void removeAllEmitters(void);
+
+      /**
+       * SetEmitterPosition will move theEmitter provided. The voice it is
+       * bound to (if any) is moved by the next Update.
+       * @param[in] theEmitter handle returned by AddEmitter
+       * @param[in] thePosition to move the emitter to
+       */
+      void setEmitterPosition(const Uint32 theEmitter, const sf::Vector3f& thePosition);
+
+      /**
+       * SetEmitterVolume will change the volume of theEmitter provided. The
+       * voice it is bound to (if any) is changed by the next Update.
+       * @param[in] theEmitter handle returned by AddEmitter
+       * @param[in] theVolume from 0 to 100
+       */
+      void setEmitterVolume(const Uint32 theEmitter, const float theVolume);
+
+      /**
+       * SetEmitterVoices will set the maximum number of voices emitters may
+       * be bound to at once (DEFAULT_EMITTER_VOICES by default).
+       * @param[in] theVoices is the maximum number of voices for emitters
+       */
+      void setEmitterVoices(const Uint32 theVoices);
+
+      /**
+       * SetEmitterGrid will set the size of each cell of the emitter grid,
+       * which should be about the range of a typical emitter. Every emitter
+       * is moved into the new grid.
+       * @param[in] theCellSize of each cell in world units
+       */
+      void setEmitterGrid(const float theCellSize);
+
+      /**
+       * SetCategoryLimit will set the maximum number of voices theCategory
+       * provided may use at once (MAX_VOICES by default).
+       * @param[in] theCategory to limit
+       * @param[in] theLimit is the maximum number of voices
+       */
+      void setCategoryLimit(const Uint32 theCategory, const Uint32 theLimit);
+
+      /**
+       * Update will free the voices whose sounds have finished playing and
+       * bind the loudest emitters that can be heard to voices, called once
+       * each frame by the Game loop.
+       * @param[in] theElapsedTime in milliseconds since the last Update
+       */
+      void update(float theElapsedTime);
+
+      /**
+       * GetVoiceCount will return the number of voices preallocated.
+       * @return the number of voices
+       */
+      Uint32 getVoiceCount(void) const;
+
+      /**
+       * GetActiveCount will return the number of voices currently playing.
+       * @return the number of voices playing
+       */
+      Uint32 getActiveCount(void) const;
+
+      /**
+       * GetStolenCount will return the number of voices stolen since DoInit.
+       * @return the number of voices stolen
+       */
+      Uint32 getStolenCount(void) const;
+
+      /**
+       * GetRejectedCount will return the number of sounds not played since
+       * DoInit because every candidate voice had a higher priority.
+       * @return the number of sounds rejected
+       */
+      Uint32 getRejectedCount(void) const;
+
+      /**
+       * GetEmitterCount will return the number of emitters added.
+       * @return the number of emitters
+       */
+      Uint32 getEmitterCount(void) const;
+
+      /**
+       * GetAudibleCount will return the number of emitters that could be
+       * heard during the last Update.
+       * @return the number of audible emitters
+       */
+      Uint32 getAudibleCount(void) const;
+
+      /**
+       * GetBoundCount will return the number of emitters bound to a voice.
+       * @return the number of emitters playing
+       */
+      Uint32 getBoundCount(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each voice in the pool
+      struct typeVoice
+      {
+        sf::Sound*   sound;      ///< Sound source or NULL for the null device
+        TAssetHandler<sf::SoundBuffer>* handler; ///< Handler for data
+        TAssetHandler<sf::SoundBuffer>::typeAssetData* data; ///< Buffer held
+        Uint32       generation; ///< Incremented each time the voice is played
+        Uint32       started;    ///< Play order used to find the oldest voice
+        Uint32       category;   ///< Category of the sound playing
+        Int32        priority;   ///< Priority of the sound playing
+        float        remaining;  ///< Milliseconds left for the null device
+        float        distance;   ///< Squared distance from the listener
+        bool         relative;   ///< Is position relative to the listener?
+        sf::Vector3f position;   ///< Position of the sound playing
+        bool         loop;       ///< Is the sound looping?
+        bool         active;     ///< Is the voice playing?
+      };
+
+      /// Each emitter added
+      struct typeEmitter
+      {
+        TAssetHandler<sf::SoundBuffer>* handler; ///< Handler for data
+        TAssetHandler<sf::SoundBuffer>::typeAssetData* data; ///< Buffer held
+        typeSoundParams params;     ///< Parameters to play the buffer with
+        float           range;      ///< Distance beyond which it is never heard
+        float           loudness;   ///< Volume heard during the last Update
+        Uint64          cell;       ///< Key of the grid cell holding it
+        Uint32          cellIndex;  ///< Index within the grid cell
+        Uint32          generation; ///< Incremented each time the slot is used
+        Uint32          voice;      ///< Voice handle or INVALID_VOICE if not bound
+        Uint32          selected;   ///< Update number when last chosen to play
+        bool            dirty;      ///< Position or volume changed since Update
+        bool            active;     ///< Is this slot in use?
+      };
+
+      /// The emitter grid cells, only cells holding emitters are kept
+      typedef std::map<Uint64, std::vector<Uint32> > typeCellMap;
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Every voice preallocated by DoInit
+      std::vector<typeVoice> mVoices;
+      /// Number of voices in use by each category
+      Uint32                 mCategoryCounts[MAX_CATEGORIES];
+      /// Maximum number of voices each category may use
+      Uint32                 mCategoryLimits[MAX_CATEGORIES];
+      /// Position of the listener
+      sf::Vector3f           mListener;
+      /// Number of sounds played, used to order the voices by age
+      Uint32                 mPlayed;
+      /// Number of voices playing
+      Uint32                 mActive;
+      /// Number of voices stolen
+      Uint32                 mStolen;
+      /// Number of sounds rejected
+      Uint32                 mRejected;
+      /// True if no audio device is used
+      bool                   mNullDevice;
+      /// Every emitter slot, free slots are listed in mFreeEmitters
+      std::vector<typeEmitter> mEmitters;
+      /// Emitter slots that can be reused
+      std::vector<Uint32>    mFreeEmitters;
+      /// Emitters currently bound to a voice
+      std::vector<Uint32>    mBound;
+      /// Loudness and index of each audible emitter, reused every Update
+      std::vector<std::pair<float, Uint32> > mAudible;
+      /// Emitter grid cells
+      typeCellMap            mCells;
+      /// Size of each grid cell
+      float                  mCellSize;
+      /// Largest range of any emitter added
+      float                  mEmitterRange;
+      /// Maximum number of voices emitters may be bound to
+      Uint32                 mEmitterVoices;
+      /// Number of emitters added
+      Uint32                 mEmitterCount;
+      /// Number of times the emitters have been updated
+      Uint32                 mEmitterUpdates;
+
+      /**
+       * PlayData will play the sound buffer held by theData provided on a
+       * free voice using theParams provided (see Play).
+       * @param[in] theHandler that owns theData
+       * @param[in] theData holding the sound buffer to play
+       * @param[in] theParams to play the sound buffer with
+       * @param[in] theSteal is true if another voice may be stolen
+       * @return the handle of the voice used or INVALID_VOICE
+       */
+      Uint32 playData(TAssetHandler<sf::SoundBuffer>& theHandler,
+        TAssetHandler<sf::SoundBuffer>::typeAssetData* theData,
+        const typeSoundParams& theParams, const bool theSteal);
+
+      /**
+       * FindEmitter will return the emitter specified by theEmitter handle if
+       * it hasn't been removed.
+       * @param[in] theEmitter handle returned by AddEmitter
+       * @return the emitter found or NULL if not found
+       */
+      typeEmitter* findEmitter(const Uint32 theEmitter);
+
+      /**
+       * GetCell will return the key of the grid cell holding thePosition.
+       * @param[in] thePosition to find the cell for
+       * @return the key of the grid cell
+       */
+      Uint64 getCell(const sf::Vector3f& thePosition) const;
+
+      /**
+       * AddToCell will add the emitter at theIndex to the grid cell holding
+       * its position.
+       * @param[in] theIndex of the emitter
+       */
+      void addToCell(const Uint32 theIndex);
+
+      /**
+       * RemoveFromCell will remove the emitter at theIndex from its grid cell.
+       * @param[in] theIndex of the emitter
+       */
+      void removeFromCell(const Uint32 theIndex);
+
+      /**
+       * AddAudible will add each emitter in theCell provided that is within
+       * range of the listener and loud enough to be heard to mAudible.
+       * @param[in] theCell of the emitter grid to check
+       */
+      void addAudible(const std::vector<Uint32>& theCell);
+
+      /**
+       * UpdateEmitters will bind the loudest emitters that can be heard to
+       * voices, unbind the rest and push the position and volume changes of
+       * the emitters still bound to their voices.
+       */
+      void updateEmitters(void);
+
+      /**
+       * FindVoice will return the voice specified by theVoice handle if it
+       * is still playing the sound it was returned for.
+       * @param[in] theVoice handle returned by Play
+       * @return the voice found or NULL if not found
+       */
+      const typeVoice* findVoice(const Uint32 theVoice) const;
+
+      /**
+       * FindVictim will return the index of the voice to steal for a sound
+       * with thePriority and theDistance provided.
+       * @param[in] theCategory to steal from or MAX_CATEGORIES for any
+       * @param[in] thePriority of the sound to play
+       * @param[in] theDistance of the sound to play from the listener
+       * @return the index of the voice to steal or mVoices.size() if none
+       */
+      Uint32 findVictim(const Uint32 theCategory, const Int32 thePriority,
+        const float theDistance) const;
+
+      /**
+       * GetDistance will return the squared distance of thePosition from the
+       * listener.
+       * @param[in] theRelative is true if thePosition is relative to the listener
+       * @param[in] thePosition to measure
+       * @return the squared distance from the listener
+       */
+      float getDistance(const bool theRelative, const sf::Vector3f& thePosition) const;
+
+      /**
+       * IsFinished will return true if theVoice has finished playing.
+       * @param[in] theVoice to check
+       * @return true if finished, false otherwise
+       */
+      bool isFinished(const typeVoice& theVoice) const;
+
+      /**
+       * ReleaseVoice will stop theVoice provided and drop its reference to
+       * the sound buffer it was playing.
+       * @param[in] theVoice to release
+       */
+      void releaseVoice(typeVoice& theVoice);
+
+      /**
+       * SoundManager copy constructor is private because we do not allow
+       * copies of our class
+       */
+      SoundManager(const SoundManager&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      SoundManager& operator=(const SoundManager&); // Intentionally undefined
+  }; // class SoundManager
+} // namespace AGE
+
+#endif // CORE_SOUND_MANAGER_HPP_INCLUDED
+
+/**
+ * @class AGE::SoundManager
+ * @ingroup Core
+ * The SoundManager class owns a fixed pool of sf::Sound voices created by
+ * DoInit, so playing a sound effect never creates or destroys an OpenAL
+ * source. Each voice holds a reference to the sound buffer it is playing so
+ * the buffer can't be released underneath it. When no voice is free (or the
+ * category of the sound has reached its limit) the lowest priority voice is
+ * stolen, then the farthest from the listener, then the oldest. With the
+ * null device no sf::Sound objects are created at all and each voice just
+ * counts down the duration of its sound buffer during Update, which allows
+ * the voice stealing to be tested in headless modes.
+ *
+ * Emitters are looping sounds at fixed places in the world (fires, rivers,
+ * machines) that may number in the hundreds. They are kept in a grid of
+ * cells over x and y, so Update only looks at the cells within range of the
+ * listener and estimates how loud each emitter there would be using the same
+ * attenuation model as OpenAL. Only the loudest DEFAULT_EMITTER_VOICES (see
+ * SetEmitterVoices) are bound to voices, an emitter already playing is
+ * slightly preferred so emitters of equal loudness don't keep swapping, and
+ * emitters only take free voices (sounds played with Play may still steal
+ * theirs). Position and volume changes are pushed to the bound voices once per
+ * Update. The cost of emitters therefore grows with the number that can be
+ * heard rather than with the number added.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
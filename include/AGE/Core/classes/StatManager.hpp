@@ -15,13 +15,22 @@
  * @date 20110627 - Removed extra ; from namespace
  * @date 20120421 - Use arial.ttf font since SFML 2 crashes on exit when using default font
  * @date 20120518 - Use sf::Font instead of FontAsset to remove circular dependency
+ * @date 20261018 - Add frame, update and render time histograms and percentiles
+ * @date 20261018 - Add GetPoolStats for reporting ObjectPool usage
+ * @date 20261018 - Add the MemoryTracker overlay shown by SetShowMemory
+ * @date 20261018 - Don't export the time statistics unless a filename is set
  */
 #ifndef   CORE_STAT_MANAGER_HPP_INCLUDED
 #define   CORE_STAT_MANAGER_HPP_INCLUDED
 
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/Histogram.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
+#include <AGE/Core/classes/ObjectPool.hpp>
 
 namespace AGE
 {
@@ -29,6 +38,21 @@ namespace AGE
   class AGE_API StatManager
   {
     public:
+      /// Enumeration of the time statistics collected in microseconds
+      enum StatType
+      {
+        StatFrameTime = 0,  ///< Time spent in an entire game loop iteration
+        StatUpdateTime = 1, ///< Time spent in each IState::updateVariable call
+        StatRenderTime = 2, ///< Time spent drawing and displaying each frame
+        StatTypeCount = 3   ///< Number of time statistics collected
+      };
+
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of one second slices kept for the sliding window statistics
+      static const Uint32 WINDOW_SLICES = 10;
+      /// Suggested filename for exporting the time statistics at DeInit
+      static const char* DEFAULT_EXPORT_FILENAME;
 
       /**
        * StatManager constructor
@@ -65,6 +89,20 @@ namespace AGE
        */
       void setShow(bool theShow);
 
+      /**
+       * IsShowingMemory will return true if the memory used by each
+       * MemoryTracker tag is being displayed.
+       * @return true if memory is being displayed, false otherwise
+       */
+      bool isShowingMemory(void) const;
+
+      /**
+       * SetShowMemory will either enable or disable the showing of the
+       * current and peak memory used by each MemoryTracker tag.
+       * @param[in] theShow is the new show memory value
+       */
+      void setShowMemory(bool theShow);
+
       /**
        * GetUpdate will return the current update number which is the number of
        * updates that have been called since the application started.
@@ -79,6 +117,69 @@ namespace AGE
        */
       Uint32 getFrames(void) const;
 
+      /**
+       * RecordTime will add theMicroseconds provided to the histograms kept
+       * for theType of time statistic specified.
+       * @param[in] theType of time statistic to record
+       * @param[in] theMicroseconds to record
+       */
+      void recordTime(StatType theType, Int64 theMicroseconds);
+
+      /**
+       * GetPercentile will return the time in microseconds at thePercentile
+       * provided for theType of time statistic specified.
+       * @param[in] theType of time statistic to use
+       * @param[in] thePercentile to find in the range [0,100]
+       * @param[in] theWindow if true use the sliding window only, otherwise
+       *            use every value recorded since DoInit was called
+       * @return the time in microseconds at thePercentile
+       */
+      Uint32 getPercentile(StatType theType, float thePercentile,
+          bool theWindow = true) const;
+
+      /**
+       * GetMaxTime will return the largest time in microseconds recorded for
+       * theType of time statistic specified.
+       * @param[in] theType of time statistic to use
+       * @param[in] theWindow if true use the sliding window only, otherwise
+       *            use every value recorded since DoInit was called
+       * @return the largest time in microseconds recorded
+       */
+      Uint32 getMaxTime(StatType theType, bool theWindow = true) const;
+
+      /**
+       * GetPoolStats will return the number of blocks used, the most ever
+       * used and the number allocated for every ObjectPool (such as those
+       * used for IEvent, IProperty and asset objects).
+       * @param[out] thePools to fill with the statistics of each pool
+       */
+      void getPoolStats(std::vector<ObjectPool::typeStats>& thePools) const;
+
+      /**
+       * GetExportFilename will return the filename the time statistics will
+       * be written to when DeInit is called, which is empty by default.
+       * @return the export filename or an empty string if disabled
+       */
+      const std::string& getExportFilename(void) const;
+
+      /**
+       * SetExportFilename will set the filename the time statistics will be
+       * written to when DeInit is called. A filename ending in .json will be
+       * written as JSON, otherwise CSV will be used. An empty filename will
+       * disable the export.
+       * @param[in] theFilename to write the time statistics to
+       */
+      void setExportFilename(const std::string theFilename);
+
+      /**
+       * WriteToFile will write the count, min, mean, p50, p95, p99 and max
+       * values for every time statistic (both the sliding window and the
+       * entire run) to theFilename provided as either JSON or CSV.
+       * @param[in] theFilename to write the time statistics to
+       * @return true if the file was written, false otherwise
+       */
+      bool writeToFile(const std::string theFilename) const;
+
       /**
        * RegisterApp will register a pointer to the App class so it can be used
        * by the StatManager for error handling and log reporting.
@@ -108,6 +209,8 @@ namespace AGE
       Game*       mApp;
       /// Allow the current statistics to be displayed?
       bool        mShow;
+      /// Allow the memory used by each MemoryTracker tag to be displayed?
+      bool        mShowMemory;
       /// Total number of frames drawn since DoInit was called
       Uint32      mFrames;
       /// Frame clock for displaying Frames per second value
@@ -131,6 +234,27 @@ namespace AGE
 #else
       sf::Text*   mUPS;
 #endif
+      /// Debug string to display that shows the memory used by each tag
+      sf::Text*   mMemory;
+
+      /// Time histograms for every value recorded since DoInit was called
+      Histogram   mTotal[StatTypeCount];
+      /// Time histograms for each one second slice of the sliding window
+      Histogram   mWindow[StatTypeCount][WINDOW_SLICES];
+      /// Current slice of the sliding window being recorded
+      Uint32      mSlice;
+      /// Slice clock for advancing the sliding window each second
+      sf::Clock   mSliceClock;
+      /// Filename to write the time statistics to during DeInit
+      std::string mExportFilename;
+
+      /**
+       * GetWindow will return the sliding window histogram for theType of
+       * time statistic specified by merging every slice together.
+       * @param[in] theType of time statistic to use
+       * @param[out] theHistogram to merge every slice into
+       */
+      void getWindow(StatType theType, Histogram& theHistogram) const;
 
       /**
        * StatManager copy constructor is private because we do not allow copies
@@ -157,6 +281,9 @@ namespace AGE
  * application.  These statistics include but are not limited to:
  * Update() method calls per second, Draw() method calls per second,
  * Overall elapsed time, individual elapsed time per game state, etc.
+ * Frame, update and render times are kept in histograms so the p50, p95,
+ * p99 and max values can be reported for the last WINDOW_SLICES seconds
+ * and for the entire run.
  * These statistics can be reported back to the publisher or written to
  * a file for debug, development, or sale purposes.
  *
@@ -18,6 +18,9 @@
  * @date 20110627 - Removed extra ; from namespace
  * @date 20110810 - Return address not pointer for GetActiveState method
  * @date 20120702 - Rename HandleCleanup to Cleanup.
+ * @date 20261018 - Added WhenReady methods to switch states once assets are loaded
+ * @date 20261018 - AddActiveStateWhenReady always lets UpdatePending add the state
+ * @date 20261018 - Drop a pending state whose assets failed to load
  */
 #ifndef   CORE_STATE_MANAGER_HPP_INCLUDED
 #define   CORE_STATE_MANAGER_HPP_INCLUDED
@@ -128,6 +131,41 @@ namespace AGE
        */
       void setActiveState(Id theStateID);
 
+      /**
+       * AddActiveStateWhenReady will start loading the AssetManifest of
+       * theState provided in the background and add it as the current active
+       * state (see AddActiveState) once every asset has been loaded. The
+       * current active state keeps running until then. If there is no active
+       * state then the Game loop only loads the assets until it is added.
+       * @param[in] theState to set as the current state when ready
+       */
+      void addActiveStateWhenReady(IState* theState);
+
+      /**
+       * SetActiveStateWhenReady will start loading the AssetManifest of the
+       * state specified by theStateID in the background and make it the
+       * current active state (see SetActiveState) once every asset has been
+       * loaded.
+       * @param[in] theStateID is the ID of the State to make active when ready
+       */
+      void setActiveStateWhenReady(Id theStateID);
+
+      /**
+       * GetPendingState will return the state waiting for its assets to be
+       * loaded (see GetLoadProgress) so a loading screen can be drawn.
+       * @return pointer to the pending state or NULL if there isn't one
+       */
+      IState* getPendingState(void);
+
+      /**
+       * UpdatePending is responsible for loading the next group of assets of
+       * the pending state and switching to it once every asset has been
+       * loaded, called once each frame by the Game loop. A pending state
+       * whose assets failed to load is dropped instead (see
+       * AssetManifest::hasFailed).
+       */
+      void updatePending(void);
+
       /**
        * Cleanup is responsible for dealing with the cleanup of recently
        * dropped states.
@@ -148,6 +186,23 @@ namespace AGE
       std::vector<IState*>  mDead;
       /// The event manager to store cleanup events
       EventManager          mCleanupEvents;
+      /// State waiting for its assets to be loaded or NULL if none
+      IState*               mPending;
+      /// True if mPending will be added, false if it is already on mStack
+      bool                  mPendingAdd;
+
+      /**
+       * FindState will return the state on the stack specified by theStateID.
+       * @param[in] theStateID is the ID of the State to find
+       * @return pointer to the state found or NULL if not found
+       */
+      IState* findState(Id theStateID);
+
+      /**
+       * ClearPending will forget the pending state, deleting it if it was
+       * never added to the stack.
+       */
+      void clearPending(void);
 
       /**
        * StateManager copy constructor is private because we do not allow copies
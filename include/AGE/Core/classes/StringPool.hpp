@@ -0,0 +1,159 @@
+/**
+ * Provides the StringPool class in the AGE namespace which is responsible
+ * for interning strings so each unique string is stored once and can be
+ * referred to by a stable 32 bit handle.
+ *
+ * @file include/AGE/Core/classes/StringPool.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_STRING_POOL_HPP_INCLUDED
+#define   CORE_STRING_POOL_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
+
+namespace AGE
+{
+  /// Provides the application wide pool of interned strings
+  class AGE_API StringPool
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of strings stored in each page of the pool
+      static const Uint32 PAGE_SIZE = 1024;
+      /// Maximum number of pages (and so PAGE_SIZE * MAX_PAGES strings)
+      static const Uint32 MAX_PAGES = 4096;
+      /// Handle of the empty string which is always interned
+      static const Uint32 EMPTY_HANDLE = 0;
+
+      /**
+       * GetInstance will return the application wide StringPool which is
+       * created the first time it is needed.
+       * @return the StringPool instance
+       */
+      static StringPool& getInstance(void);
+
+      /**
+       * Intern will return the handle of theString provided, adding a copy of
+       * theString to the pool if it hasn't been interned before.
+       * @param[in] theString to intern
+       * @return the handle for theString
+       */
+      Uint32 intern(const StringRef theString);
+
+      /**
+       * GetString will return the string interned under theHandle provided.
+       * The reference remains valid until the application exits.
+       * @param[in] theHandle returned by Intern
+       * @return the string for theHandle
+       */
+      const std::string& getString(const Uint32 theHandle) const
+      {
+        return mPages[theHandle / PAGE_SIZE][theHandle % PAGE_SIZE].text;
+      }
+
+      /**
+       * GetHash will return the CRC32 (matching ID()) of the string interned
+       * under theHandle provided without hashing it again.
+       * @param[in] theHandle returned by Intern
+       * @return the CRC32 of the string for theHandle
+       */
+      Uint32 getHash(const Uint32 theHandle) const
+      {
+        return mPages[theHandle / PAGE_SIZE][theHandle % PAGE_SIZE].hash;
+      }
+
+      /**
+       * GetCount will return the number of strings interned so far
+       * (including the empty string).
+       * @return the number of strings in the pool
+       */
+      Uint32 getCount(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Each string interned and its hash
+      struct typeEntry
+      {
+        std::string text; ///< The characters interned
+        Uint32      hash; ///< CRC32 of text
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Pages of interned strings, a page is never moved once created
+      typeEntry*          mPages[MAX_PAGES];
+      /// Number of strings interned
+      Uint32              mCount;
+      /// Open addressed hash table of handle + 1 (0 marks an empty slot)
+      std::vector<Uint32> mTable;
+      /// Mutex protecting everything except the contents of mPages
+      mutable sf::Mutex   mMutex;
+
+      /**
+       * StringPool constructor is private, use GetInstance instead
+       */
+      StringPool();
+
+      /**
+       * StringPool deconstructor
+       */
+      ~StringPool();
+
+      /**
+       * Insert will add theHandle provided to mTable.
+       * @param[in] theHandle to add
+       */
+      void insert(const Uint32 theHandle);
+
+      /**
+       * StringPool copy constructor is private because we do not allow copies
+       * of our class
+       */
+      StringPool(const StringPool&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      StringPool& operator=(const StringPool&); // Intentionally undefined
+  }; // class StringPool
+} // namespace AGE
+
+#endif // CORE_STRING_POOL_HPP_INCLUDED
+
+/**
+ * @class AGE::StringPool
+ * @ingroup Core
+ * The StringPool class stores a single copy of every string interned by the
+ * Symbol class (such as asset IDs and filenames). Strings are never removed,
+ * so the handle returned by Intern and the reference returned by GetString
+ * remain valid for the life of the application. Interning takes a lock, but
+ * GetString and GetHash do not since pages are never moved or changed once a
+ * handle into them has been returned.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
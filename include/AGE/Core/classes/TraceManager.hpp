@@ -0,0 +1,297 @@
+/**
+ * Provides the TraceManager class in the AGE namespace which is responsible
+ * for recording timeline events (begin/end scopes) into a preallocated ring
+ * buffer that can be written out as Chrome trace-event JSON on demand.
+ *
+ * @file include/AGE/Core/classes/TraceManager.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Publish each trace event with a per slot sequence number
+ */
+#ifndef   CORE_TRACE_MANAGER_HPP_INCLUDED
+#define   CORE_TRACE_MANAGER_HPP_INCLUDED
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <SFML/System.hpp>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a low overhead timeline recorder for frame and asset scopes
+  class AGE_API TraceManager
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default number of trace events kept in the ring buffer
+      static const Uint32 DEFAULT_CAPACITY = 65536;
+      /// Maximum number of characters kept for each trace event detail
+      static const size_t MAX_DETAIL = 48;
+
+      /**
+       * TraceManager constructor
+       */
+      TraceManager();
+
+      /**
+       * TraceManager deconstructor
+       */
+      virtual ~TraceManager();
+
+      /**
+       * GetInstance will return the most recent TraceManager class that was
+       * created so it can be used by the TRACE_SCOPE macros. NULL will be
+       * returned if none is available.
+       * @return pointer to the most recent TraceManager or NULL
+       */
+      static TraceManager* getInstance(void);
+
+      /**
+       * DoInit will preallocate the ring buffer using theCapacity provided
+       * (rounded up to a power of two) and restart the trace clock.
+       * @param[in] theCapacity is the number of events to keep
+       */
+      void doInit(Uint32 theCapacity = DEFAULT_CAPACITY);
+
+      /**
+       * DeInit will release the ring buffer and disable recording.
+       */
+      void deInit(void);
+
+      /**
+       * IsEnabled will return true if trace events are being recorded.
+       * @return true if recording is enabled, false otherwise
+       */
+      bool isEnabled(void) const;
+
+      /**
+       * SetEnabled will either enable or disable the recording of trace
+       * events. Recording can only be enabled after DoInit has been called.
+       * @param[in] theEnabled is the new enabled value
+       */
+      void setEnabled(bool theEnabled);
+
+      /**
+       * GetTimestamp will return the number of microseconds since DoInit was
+       * called which is the time base used for every trace event.
+       * @return the current trace timestamp in microseconds
+       */
+      Int64 getTimestamp(void) const;
+
+      /**
+       * Record will store a completed trace event in the ring buffer, the
+       * oldest event is overwritten once the ring buffer is full.
+       * @param[in] theName of the event which must be a string literal
+       * @param[in] theCategory of the event which must be a string literal
+       * @param[in] theStart timestamp of the event in microseconds
+       * @param[in] theDuration of the event in microseconds
+       * @param[in] theDetail is an optional string copied into the event
+       */
+      void record(const char* theName, const char* theCategory,
+          Int64 theStart, Int64 theDuration, const char* theDetail = NULL);
+
+      /**
+       * RequestDump will ask the game loop to write the ring buffer to disk
+       * at the end of the current frame. This method only sets a flag and can
+       * be called from a signal handler.
+       */
+      void requestDump(void);
+
+      /**
+       * IsDumpRequested will return true if RequestDump was called since the
+       * last time the ring buffer was written and clear the request.
+       * @return true if a dump was requested, false otherwise
+       */
+      bool isDumpRequested(void);
+
+      /**
+       * RegisterSignal will install a SIGUSR1 handler (on POSIX systems) that
+       * calls RequestDump on the current TraceManager.
+       */
+      void registerSignal(void);
+
+      /**
+       * WriteToFile will write every event in the ring buffer to theFilename
+       * provided in the Chrome trace-event JSON format which can be opened in
+       * chrome://tracing or ui.perfetto.dev.
+       * @param[in] theFilename to write the trace events to
+       * @return true if the file was written, false otherwise
+       */
+      bool writeToFile(const std::string theFilename) const;
+
+    private:
+      /// Single trace event stored in the ring buffer
+      struct typeTraceEvent
+      {
+        std::atomic<Uint64> sequence; ///< Index + 1 once written, 0 while being written
+        const char* name;             ///< Name of the event (string literal)
+        const char* category;         ///< Category of the event (string literal)
+        Int64       start;            ///< Start timestamp in microseconds
+        Int64       duration;         ///< Duration in microseconds
+        Uint32      thread;           ///< Small thread number of the event
+        char        detail[MAX_DETAIL]; ///< Optional detail (asset ID, etc)
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Instance variable assigned at construction time
+      static TraceManager*   gInstance;
+      /// Ring buffer of trace events
+      typeTraceEvent*        mEvents;
+      /// Number of events in the ring buffer (always a power of two)
+      Uint32                 mCapacity;
+      /// Total number of events recorded since DoInit was called
+      std::atomic<Uint64>    mNext;
+      /// Is recording currently enabled?
+      std::atomic<bool>      mEnabled;
+      /// Has a dump been requested by a key press or signal?
+      std::atomic<bool>      mDumpRequested;
+      /// Clock used as the time base for every trace event
+      sf::Clock              mClock;
+
+      /**
+       * GetThread will return a small number that identifies the calling
+       * thread which is used as the tid value in the JSON output.
+       * @return the small thread number of the calling thread
+       */
+      static Uint32 getThread(void);
+
+      /**
+       * WriteString will write theString provided to theFile as a JSON
+       * string, escaping any characters that are not allowed in JSON.
+       * @param[in] theFile to write theString to
+       * @param[in] theString to be written
+       */
+      static void writeString(FILE* theFile, const char* theString);
+
+      /**
+       * TraceManager copy constructor is private because we do not allow
+       * copies of our class
+       */
+      TraceManager(const TraceManager&);             // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      TraceManager& operator=(const TraceManager&);  // Intentionally undefined
+  }; // class TraceManager
+
+  /// Provides a RAII trace scope that records an event when it is destroyed
+  class AGE_API TraceScope
+  {
+    public:
+      /**
+       * TraceScope constructor will record the start time of the scope.
+       * @param[in] theName of the scope which must be a string literal
+       * @param[in] theCategory of the scope which must be a string literal
+       * @param[in] theDetail is an optional string copied into the event
+       */
+      TraceScope(const char* theName, const char* theCategory = "age",
+          const char* theDetail = NULL) :
+        mTrace(TraceManager::getInstance()),
+        mName(theName),
+        mCategory(theCategory),
+        mDetail(theDetail),
+        mStart(0)
+      {
+        if(NULL != mTrace && mTrace->isEnabled())
+        {
+          mStart = mTrace->getTimestamp();
+        }
+        else
+        {
+          mTrace = NULL;
+        }
+      }
+
+      /**
+       * TraceScope deconstructor will record the completed scope.
+       */
+      ~TraceScope()
+      {
+        if(NULL != mTrace)
+        {
+          mTrace->record(mName, mCategory, mStart,
+              mTrace->getTimestamp() - mStart, mDetail);
+        }
+      }
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// TraceManager to record to or NULL if recording is disabled
+      TraceManager* mTrace;
+      /// Name of the scope
+      const char*   mName;
+      /// Category of the scope
+      const char*   mCategory;
+      /// Optional detail string for the scope
+      const char*   mDetail;
+      /// Start timestamp of the scope in microseconds
+      Int64         mStart;
+
+      TraceScope(const TraceScope&);             // Intentionally undefined
+
+      TraceScope& operator=(const TraceScope&);  // Intentionally undefined
+  }; // class TraceScope
+} // namespace AGE
+
+/**
+ * Define AGE_STRIP_TRACE when compiling the AGE Libraries or AGE based game
+ * engines to remove every TRACE_SCOPE macro from the library or executable.
+ */
+#define AGE_TRACE_CONCAT_IMPL(a, b) a##b
+#define AGE_TRACE_CONCAT(a, b) AGE_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef AGE_STRIP_TRACE
+/**
+ * TRACE_SCOPE macro will record the time spent between the macro and the end
+ * of the enclosing scope using theName (a string literal) provided.
+ */
+#define TRACE_SCOPE(theName) \
+  AGE::TraceScope AGE_TRACE_CONCAT(_trace_scope_, __LINE__)(theName)
+/**
+ * TRACE_SCOPE_DETAIL macro is like TRACE_SCOPE but will also store theDetail
+ * string (copied and truncated) with the event, i.e. the asset ID loaded.
+ */
+#define TRACE_SCOPE_DETAIL(theName, theCategory, theDetail) \
+  AGE::TraceScope AGE_TRACE_CONCAT(_trace_scope_, __LINE__)(theName, theCategory, theDetail)
+#else
+#define TRACE_SCOPE(theName) do {} while(false)
+#define TRACE_SCOPE_DETAIL(theName, theCategory, theDetail) do {} while(false)
+#endif
+
+#endif // CORE_TRACE_MANAGER_HPP_INCLUDED
+
+/**
+ * @class AGE::TraceManager
+ * @ingroup Core
+ * The TraceManager class is used by the Game class to record a timeline of
+ * the game loop phases, asset loads and any user scopes marked with the
+ * TRACE_SCOPE macro. Events are stored as completed events in a fixed size
+ * ring buffer so recording never allocates and always holds the most recent
+ * events. Press F12 or send SIGUSR1 to write the ring buffer to a
+ * trace-<timestamp>.json file that can be opened in chrome://tracing.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -19,6 +19,19 @@
  *                  improved gameloop.
  * @date 20120630 - Add new SetGraphicRange and CalculateGraphicRange methods
  * @date 20120720 - Add new PropertyManager to Game class for storing app wide properties
+ * @date 20261018 - Add new TraceManager to Game class for recording frame timelines
+ * @date 20261018 - Add InitStatManager for configuring the time statistics export
+ * @date 20261018 - Add headless run modes and create the window only when needed
+ * @date 20261018 - Add InputRecorder for deterministic input record and replay
+ * @date 20261018 - Add JobManager for loading assets on worker threads
+ * @date 20261018 - Add SoundManager for playing sounds from a pool of voices
+ * @date 20261018 - Add AssetDownloader for loading assets from the network
+ * @date 20261018 - Add RollbackManager for rolling back and re-simulating ticks
+ * @date 20261018 - Add FrameArena for allocations that only live for a frame
+ * @date 20261018 - Use GetWindow instead of the Render window member
+ * @date 20261018 - Write the MemoryTracker report after every member is destroyed
+ * @date 20261018 - Only initialize the AssetDownloader when a base URL is set
+ * @date 20261018 - Keep the game loop running while the first state is loading
  */
 #ifndef   CORE_APP_HPP_INCLUDED
 #define   CORE_APP_HPP_INCLUDED
@@ -29,10 +42,17 @@
 #include <vector>
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
+#include <AGE/Core/classes/AssetDownloader.hpp>
 #include <AGE/Core/classes/AssetManager.hpp>
+#include <AGE/Core/classes/FrameArena.hpp>
+#include <AGE/Core/classes/InputRecorder.hpp>
+#include <AGE/Core/classes/JobManager.hpp>
 #include <AGE/Core/classes/PropertyManager.hpp>
+#include <AGE/Core/classes/RollbackManager.hpp>
+#include <AGE/Core/classes/SoundManager.hpp>
 #include <AGE/Core/classes/StatManager.hpp>
 #include <AGE/Core/classes/StateManager.hpp>
+#include <AGE/Core/classes/TraceManager.hpp>
 #include <AGE/Core/Core_types.hpp>
 
 namespace AGE {
@@ -51,14 +71,26 @@ namespace AGE {
         /// Default application wide settings file string
         static const char* APP_SETTINGS;
 
+        // Structures
+        /////////////////////////////////////////////////////////////////////////
+        /// Writes the MemoryTracker report when it is destroyed
+        struct MemoryReport
+        {
+          /**
+           * MemoryReport deconstructor
+           */
+          ~MemoryReport();
+        };
+
         // Variables
         /////////////////////////////////////////////////////////////////////////
+        /// Memory report, declared first so it is destroyed after every other
+        /// member has released its memory
+        MemoryReport mMemoryReport;
         /// Title to use for Window
         std::string mTitle;
         /// Video Mode to use (width, height, bpp)
         sf::VideoMode mVideoMode;
-        /// Render window to draw to
-        sf::RenderWindow mWindow;
         /// Window settings to use when creating Render window
         sf::ContextSettings mContextSettings;
         /// Window style to use when creating Render window
@@ -67,12 +99,26 @@ namespace AGE {
         GraphicRange mGraphicRange;
         /// AssetManager for managing assets
         AssetManager mAssetManager;
+        /// JobManager for running jobs (like asset loads) on worker threads
+        JobManager mJobManager;
+        /// SoundManager for playing sounds using a pool of voices
+        SoundManager mSoundManager;
+        /// AssetDownloader for downloading assets into the on-disk cache
+        AssetDownloader mAssetDownloader;
+        /// FrameArena for allocations that only live for the current and next frame
+        FrameArena mFrameArena;
         /// PropertyManager for managing Game propertiesP
         PropertyManager mProperties;
         /// StatManager for managing game statistics
         StatManager mStatManager;
         /// StateManager for managing states
         StateManager mStateManager;
+        /// TraceManager for recording frame timelines
+        TraceManager mTraceManager;
+        /// InputRecorder for recording and replaying the input event stream
+        InputRecorder mInputRecorder;
+        /// RollbackManager for saving, rolling back and re-simulating ticks
+        RollbackManager mRollbackManager;
 
         /**
          * Game deconstructor
@@ -102,6 +148,49 @@ namespace AGE {
          */
         int run(void);
 
+        /**
+         * GetRunMode will return the current run mode of the game loop.
+         * @return the current RunMode value
+         */
+        RunMode getRunMode(void) const;
+
+        /**
+         * SetRunMode will set the run mode to use for the game loop. It must
+         * be called before Run (or given as --headless or --batch on the
+         * command line). In the headless modes no window is created, input
+         * is not processed and IState::draw is never called.
+         * @param[in] theRunMode to use for the game loop
+         */
+        void setRunMode(RunMode theRunMode);
+
+        /**
+         * IsHeadless will return true if the game loop runs without a window.
+         * @return true if the RunMode is RunHeadless or RunHeadlessBatch
+         */
+        bool isHeadless(void) const;
+
+        /**
+         * GetWindow will return the Render window to draw to. The window is
+         * only created by InitRenderer when not in a headless mode, so this
+         * replaces the mWindow member previously used to draw to it.
+         * @return the Render window or NULL if no window was created
+         */
+        sf::RenderWindow* getWindow(void) const;
+
+        /**
+         * GetTicks will return the number of IState::updateVariable calls
+         * made by the game loop since Run was called.
+         * @return the current update tick
+         */
+        Uint32 getTicks(void) const;
+
+        /**
+         * SetMaxTicks will cause the game loop to quit after theMaxTicks
+         * updates have been made, which is useful for simulation and CI runs.
+         * @param[in] theMaxTicks to run or 0 (default) to run forever
+         */
+        void setMaxTicks(Uint32 theMaxTicks);
+
         /**
          * IsRunning will return true if the Application is still running.
          * @return true if Application is running, false otherwise
@@ -175,6 +264,22 @@ namespace AGE {
          */
         virtual void gameLoop(void);
 
+        /**
+         * HeadlessLoop is responsible for calling IState::updateVariable at
+         * the fixed update rate (or as fast as possible in RunHeadlessBatch
+         * mode) until IsRunning returns false. It is called by GameLoop when
+         * no window is available.
+         */
+        virtual void headlessLoop(void);
+
+        /**
+         * WaitForPendingState is responsible for loading the assets of the
+         * pending state (see StateManager::addActiveStateWhenReady) while
+         * there is no active state, called by GameLoop and HeadlessLoop
+         * instead of updating a state until it is added.
+         */
+        void waitForPendingState(void);
+
         /**
          * ProcessInput is responsible for performing all input processing for
          * the game loop.
@@ -199,6 +304,18 @@ namespace AGE {
         sf::Int32 mUpdateRate;
         /// Maximum sequential UpdateFixed calls allowed to still meet minimum frame rate
         Uint32 mMaxUpdates;
+        /// Run mode to use for the game loop (windowed or headless)
+        RunMode mRunMode;
+        /// Render window to draw to (NULL until InitRenderer and in headless modes)
+        sf::RenderWindow* mWindow;
+        /// Number of IState::updateVariable calls made since Run was called
+        Uint32 mTicks;
+        /// Quit after this many updates have been made (0 means run forever)
+        Uint32 mMaxTicks;
+        /// Filename to record input events into (--record)
+        std::string mRecordFilename;
+        /// Filename to replay input events from (--replay)
+        std::string mReplayFilename;
 
         /**
          * CalculateRange is responsible for returning the best GraphicRange
@@ -215,12 +332,78 @@ namespace AGE {
          */
         void initSettingsConfig(void);
 
+        /**
+         * InitJobManager is responsible for starting the JobManager worker
+         * threads using the [jobs] section of the application wide settings
+         * file (threads = 0 uses one less than the number of hardware threads).
+         */
+        void initJobManager(void);
+
+        /**
+         * InitSoundManager is responsible for allocating the SoundManager
+         * voices using the [sound] section of the application wide settings
+         * file. The null audio device is used in headless modes.
+         */
+        void initSoundManager(void);
+
+        /**
+         * InitAssetDownloader is responsible for setting the URL and cache
+         * directory used by AssetLoadFromNetwork assets from the [network]
+         * section of the application wide settings file. Nothing is done if
+         * no base URL is set.
+         */
+        void initAssetDownloader(void);
+
+        /**
+         * InitFrameArena is responsible for allocating the buffers of the
+         * FrameArena using the size from the [arena] section of the
+         * application wide settings file.
+         */
+        void initFrameArena(void);
+
         /**
          * InitRenderer is responsible for initializing the Rendering window that
          * will be used to display the games graphics.
          */
         void initRenderer(void);
 
+        /**
+         * InitStatManager is responsible for initializing the StatManager
+         * using the [stats] section of the application wide settings file.
+         * The time statistics are only exported if export = <filename> is
+         * set there or mStatManager.setExportFilename() is called.
+         */
+        void initStatManager(void);
+
+        /**
+         * InitTraceManager is responsible for initializing the TraceManager
+         * using the [trace] section of the application wide settings file.
+         * Recording is only started if enabled = true is set there, otherwise
+         * call mTraceManager.doInit() from InitScreenFactory to record.
+         */
+        void initTraceManager(void);
+
+        /**
+         * InitInputRecorder is responsible for starting the InputRecorder if
+         * a recording or replay file was given on the command line. A replay
+         * uses the update rate stored in the recording.
+         */
+        void initInputRecorder(void);
+
+        /**
+         * DispatchEvent is responsible for handling theEvent provided that
+         * was either polled from the window or replayed by the InputRecorder.
+         * @param[in] theState that is currently active
+         * @param[in] theEvent to handle
+         */
+        void dispatchEvent(IState& theState, sf::Event& theEvent);
+
+        /**
+         * WriteTrace is responsible for writing the TraceManager ring buffer
+         * to a trace-<timestamp>.json file in the current working directory.
+         */
+        void writeTrace(void);
+
         /**
          * Cleanup is responsible for performing any last minute Application
          * cleanup steps before exiting the Application.
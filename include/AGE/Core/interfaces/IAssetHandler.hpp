@@ -5,12 +5,19 @@
  * @file include/AGE/Core/interfaces/IAssetHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Asset IDs and filenames are interned Symbols
+ * @date 20261018 - Added type slots for constant time handler lookup
+ * @date 20261018 - Added ProcessReleases for releases deferred by other threads
+ * @date 20261018 - Added AddReference for prefetching assets by ID
+ * @date 20261018 - Added GetSavedBytes for assets shared by identical files
+ * @date 20261018 - Added DownloadAsset for loading assets from the network
  */
 #ifndef   CORE_IASSET_HANDLER_HPP_INCLUDED
 #define   CORE_IASSET_HANDLER_HPP_INCLUDED
 
 #include <map>
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/Symbol.hpp>
 
 namespace AGE
 {
@@ -18,11 +25,18 @@ namespace AGE
   class AGE_API IAssetHandler
   {
     public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Type slot used by IAssetHandler classes that don't have one
+      static const Uint32 NO_TYPE_SLOT = 0xFFFFFFFF;
+
       /**
        * IAssetHandler default constructor.
        * @param[in] theAssetHandlerID to use for this Resource Handler
+       * @param[in] theTypeSlot for this Resource Handler (see AllocateTypeSlot)
        */
-      IAssetHandler(const Id theAssetHandlerID);
+      IAssetHandler(const Id theAssetHandlerID,
+        const Uint32 theTypeSlot = NO_TYPE_SLOT);
 
       /**
        * IAssetHandler deconstructor
@@ -36,6 +50,29 @@ namespace AGE
        */
       const AGE::Id getID(void) const;
 
+      /**
+       * GetTypeSlot will return the type slot used by the AssetManager to
+       * find this IAssetHandler object without a map lookup.
+       * @return the type slot or NO_TYPE_SLOT if none was provided
+       */
+      Uint32 getTypeSlot(void) const;
+
+      /**
+       * AllocateTypeSlot will return the next unused type slot. Each slot is
+       * a small index so the AssetManager can keep its handlers in an array.
+       * @return a type slot that has never been returned before
+       */
+      static Uint32 allocateTypeSlot(void);
+
+      /**
+       * AddReference will increment the reference counter for theAssetID
+       * specified (creating the asset if needed) without loading it so it
+       * stays resident until DropReference is called.
+       * @param[in] theAssetID to add the reference for
+       * @return true if the asset exists or was created, false otherwise
+       */
+      virtual bool addReference(const assetID theAssetID) = 0;
+
       /**
        * DropReference will decrement the reference counter for theAssetID
        * specified and optionally call the ReleaseAsset virtual function to
@@ -59,8 +96,9 @@ namespace AGE
        * GetFilename is responsible for retrieving the filename to use when
        * loading theAssetID specified.
        * @param[in] theAssetID to get filename for
+       * @return the interned filename or an empty string if not found
        */
-      virtual const std::string getFilename(const assetID theAssetID) const = 0;
+      virtual const std::string& getFilename(const assetID theAssetID) const = 0;
 
       /**
        * SetFilename is responsible for noting the filename to use when loading
@@ -68,7 +106,7 @@ namespace AGE
        * @param[in] theAssetID to set filename for
        * @param[in] theFilename to use when loading this asset from a file
        */
-      virtual void setFilename(const assetID theAssetID, std::string theFilename) = 0;
+      virtual void setFilename(const assetID theAssetID, const Symbol theFilename) = 0;
 
       /**
        * GetLoadStyle allows someone to find out the loading style of
@@ -119,13 +157,38 @@ namespace AGE
        */
       virtual bool loadAllAssets(void) = 0;
 
+      /**
+       * ProcessReleases is responsible for releasing assets whose last
+       * reference was dropped by another thread but must be released by the
+       * thread that created this IAssetHandler derived class.
+       */
+      virtual void processReleases(void) = 0;
+
+      /**
+       * GetSavedBytes will return the memory saved by sharing one decoded
+       * asset between asset IDs whose files have identical contents.
+       * @return the number of bytes saved
+       */
+      virtual Uint64 getSavedBytes(void) const = 0;
+
     protected:
+      /**
+       * DownloadAsset will download the file for theAssetID provided using
+       * the Game AssetDownloader and return the cached file to load it from,
+       * which is used by the LoadFromNetwork method of derived classes.
+       * @param[in] theAssetID of the asset to download
+       * @param[out] theFilename of the cached file to load
+       * @return true if theFilename can be loaded, false otherwise
+       */
+      bool downloadAsset(const assetID theAssetID, std::string& theFilename) const;
 
     private:
       // Variables
       ///////////////////////////////////////////////////////////////////////////
       /// ID specified for this IAssetHandler
       const Id mAssetHandlerID;
+      /// Type slot specified for this IAssetHandler
+      const Uint32 mTypeSlot;
 
       /**
        * Our copy constructor is private because we do not allow copies of our
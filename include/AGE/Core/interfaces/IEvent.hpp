@@ -4,10 +4,13 @@
  * @file include/AGE/Core/interfaces/IEvent.hpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Allocate derived classes from size class ObjectPools
  */
 #ifndef IEVENT_HPP_INCLUDED
 #define IEVENT_HPP_INCLUDED
 
+#include <cstddef>
+#include <new>
 #include <AGE/Core/Core_types.hpp>
 
 namespace AGE
@@ -41,6 +44,37 @@ namespace AGE
        */
       virtual ~IEvent();
 
+      /**
+       * Operator new will allocate IEvent derived classes from the ObjectPool
+       * for their size so events are packed together in memory.
+       * @param[in] theSize of the derived class being created
+       * @return pointer to the memory for the new object
+       */
+      static void* operator new(std::size_t theSize);
+
+      /**
+       * Operator new will allocate IEvent derived classes from the ObjectPool
+       * for their size, returning NULL if out of memory.
+       * @param[in] theSize of the derived class being created
+       * @return pointer to the memory for the new object or NULL
+       */
+      static void* operator new(std::size_t theSize, const std::nothrow_t&) throw();
+
+      /**
+       * Operator delete will return theEvent (of theSize provided) to the
+       * ObjectPool it was allocated from.
+       * @param[in] theEvent memory to release
+       * @param[in] theSize of the derived class being deleted
+       */
+      static void operator delete(void* theEvent, std::size_t theSize);
+
+      /**
+       * Operator delete is only used if a constructor throws after
+       * operator new(std::nothrow) and releases theEvent provided.
+       * @param[in] theEvent memory to release
+       */
+      static void operator delete(void* theEvent, const std::nothrow_t&) throw();
+
       /**
        * GetType will return the Type_t type for this property
        * @return the Type_t class for this property
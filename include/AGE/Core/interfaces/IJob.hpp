@@ -0,0 +1,92 @@
+/**
+ * Provides the IJob interface class for work done by the JobManager worker
+ * threads.
+ *
+ * @file include/AGE/Core/interfaces/IJob.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_IJOB_HPP_INCLUDED
+#define   CORE_IJOB_HPP_INCLUDED
+
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides the interface for all work done by the JobManager
+  class AGE_API IJob
+  {
+    public:
+      /**
+       * IJob default constructor
+       * @param[in] theJobID to use for this IJob
+       */
+      IJob(const Id theJobID);
+
+      /**
+       * IJob destructor
+       */
+      virtual ~IJob();
+
+      /**
+       * GetID will return the ID used for this job.
+       * @return the job ID for this job
+       */
+      const Id getID(void) const;
+
+      /**
+       * DoJob will be called from one of the JobManager worker threads (or
+       * the thread that called AddJob if there are no workers) to perform the
+       * work defined by the derived IJob class.
+       */
+      virtual void doJob(void) = 0;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The job ID assigned to this IJob derived class
+      const Id mJobID;
+
+      /**
+       * Our copy constructor is private because we do not allow copies of our
+       * class
+       */
+      IJob(const IJob&);  // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies of our
+       * class
+       */
+      IJob& operator=(const IJob&); // Intentionally undefined
+  }; // class IJob
+} // namespace AGE
+
+#endif // CORE_IJOB_HPP_INCLUDED
+
+/**
+ * @class AGE::IJob
+ * @ingroup Core
+ * The IJob class provides an interface for the JobManager class to run work
+ * on its worker threads. The JobManager takes ownership of each IJob derived
+ * class given to AddJob and deletes it once DoJob returns, so any results
+ * should be stored somewhere the IJob points to.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -4,10 +4,13 @@
  * @file include/AGE/Core/interfaces/IProperty.hpp
  * @author Jacob Dix
  * @date 20120423 - Initial Release
+ * @date 20261018 - Allocate derived classes from size class ObjectPools
  */
 #ifndef IPROPERTY_HPP_INCLUDED
 #define IPROPERTY_HPP_INCLUDED
 
+#include <cstddef>
+#include <new>
 #include <AGE/Core/Core_types.hpp>
 
 namespace AGE
@@ -41,6 +44,37 @@ namespace AGE
        */
       virtual ~IProperty();
 
+      /**
+       * Operator new will allocate IProperty derived classes from the ObjectPool
+       * for their size so properties are packed together in memory.
+       * @param[in] theSize of the derived class being created
+       * @return pointer to the memory for the new object
+       */
+      static void* operator new(std::size_t theSize);
+
+      /**
+       * Operator new will allocate IProperty derived classes from the ObjectPool
+       * for their size, returning NULL if out of memory.
+       * @param[in] theSize of the derived class being created
+       * @return pointer to the memory for the new object or NULL
+       */
+      static void* operator new(std::size_t theSize, const std::nothrow_t&) throw();
+
+      /**
+       * Operator delete will return theProperty (of theSize provided) to the
+       * ObjectPool it was allocated from.
+       * @param[in] theProperty memory to release
+       * @param[in] theSize of the derived class being deleted
+       */
+      static void operator delete(void* theProperty, std::size_t theSize);
+
+      /**
+       * Operator delete is only used if a constructor throws after
+       * operator new(std::nothrow) and releases theProperty provided.
+       * @param[in] theProperty memory to release
+       */
+      static void operator delete(void* theProperty, const std::nothrow_t&) throw();
+
       /**
        * GetType will return the Type_t type for this property
        * @return the Type_t class for this property
@@ -19,11 +19,13 @@
  * @date 20110627 - Removed extra ; from namespace
  * @date 20110801 - Moved code to .cpp file due to circular dependencies
  * @date 20120702 - Switched names of Cleanup and HandleCleanup and added cleanup events
+ * @date 20261018 - Added AssetManifest for loading state assets in the background
  */
 #ifndef   CORE_ISTATE_HPP_INCLUDED
 #define   CORE_ISTATE_HPP_INCLUDED
 
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/AssetManifest.hpp>
 #include <SFML/System.hpp>
 #include <SFML/Window.hpp>
 
@@ -132,6 +134,21 @@ namespace AGE
        */
       float getElapsedTime(void) const;
 
+      /**
+       * GetManifest will return the AssetManifest listing the assets this
+       * State needs, which the StateManager will load in the background
+       * before switching to this State (see StateManager::setActiveStateWhenReady).
+       * @return the AssetManifest for this State
+       */
+      AssetManifest& getManifest(void);
+
+      /**
+       * GetLoadProgress will return the percentage (0 to 100) of the assets
+       * in the AssetManifest for this State that have been loaded.
+       * @return the percentage of assets loaded
+       */
+      float getLoadProgress(void) const;
+
     protected:
       /// Address to the App class
       Game&                 mApp;
@@ -159,6 +176,8 @@ namespace AGE
       sf::Clock             mPausedClock;
       /// Total elapsed time paused since DoInit was called
       float                 mPausedTime;
+      /// Assets this State needs before it can become active
+      AssetManifest         mManifest;
 
       /**
        * Our copy constructor is private because we do not allow copies of
@@ -18,6 +18,10 @@
  * @date 20120514 - Fix comment whitespace and added GetID method call
  * @date 20120523 - Remove AGE_API from template classes to fix linker issues
  * @date 20120616 - Add default constructor and fixed assignment operator issues
+ * @date 20261018 - Asset IDs and filenames are interned Symbols
+ * @date 20261018 - Hold the handler control block for lock free copies
+ * @date 20261018 - Read the asset through the control block so it can be shared
+ * @date 20261018 - Added GetAssetData and GetHandler for holding references
  */
 #ifndef   CORE_TASSET_HPP_INCLUDED
 #define   CORE_TASSET_HPP_INCLUDED
@@ -47,7 +51,8 @@ namespace AGE
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
         AssetDropTime theDropTime = AssetDropAtZero) :
         mAssetHandler(Game::getApp()->mAssetManager.getHandler<TYPE>()),
-        mAsset(mAssetHandler.getReference(theAssetID, theLoadTime, theLoadStyle, theDropTime)),
+        mAssetData(mAssetHandler.getData(theAssetID, theLoadTime, theLoadStyle, theDropTime)),
+        mAsset(NULL != mAssetData ? mAssetData->asset : mAssetHandler.getReference()),
         mAssetID(theAssetID)
       {
       }
@@ -60,21 +65,24 @@ namespace AGE
        */
       TAsset() :
         mAssetHandler(Game::getApp()->mAssetManager.getHandler<TYPE>()),
+        mAssetData(NULL),
         mAsset(mAssetHandler.getReference())
       {
       }
 
       /**
         * TAsset copy constructor will allow for copying of assets by
-        * incrementing the reference counter for this asset through the
-        * Asset Handler provided at construction time.
+        * incrementing the reference counter of the control block for this
+        * asset without taking any locks, so copies can be made on any thread.
         */
       TAsset(const TAsset<TYPE>& theCopy) :
         mAssetHandler(theCopy.mAssetHandler),
+        mAssetData(theCopy.mAssetData),
+        mAsset(theCopy.mAsset),
         mAssetID(theCopy.mAssetID)
       {
         // Increment reference count to this asset
-        mAsset = mAssetHandler.getReference(mAssetID);
+        TAssetHandler<TYPE>::addData(mAssetData);
       }
 
 
@@ -84,7 +92,7 @@ namespace AGE
       virtual ~TAsset()
       {
         // Drop reference to this asset
-        mAssetHandler.dropReference(mAssetID);
+        mAssetHandler.dropData(mAssetData);
       }
 
       /**
@@ -93,7 +101,27 @@ namespace AGE
        */
       bool isLoaded(void) const
       {
-        return mAssetHandler.isLoaded(mAssetID);
+        return NULL != mAssetData && mAssetData->loaded.load(std::memory_order_acquire);
+      }
+
+      /**
+       * GetAssetData will return the control block for this asset which can
+       * be used with TAssetHandler::addData and TAssetHandler::dropData to
+       * hold a reference to this asset without copying this TAsset.
+       * @return the control block or NULL for the dummy asset
+       */
+      typename TAssetHandler<TYPE>::typeAssetData* getAssetData(void) const
+      {
+        return mAssetData;
+      }
+
+      /**
+       * GetHandler will return the TAssetHandler that manages this asset.
+       * @return the TAssetHandler for this asset
+       */
+      TAssetHandler<TYPE>& getHandler(void) const
+      {
+        return mAssetHandler;
       }
 
       /**
@@ -118,11 +146,17 @@ namespace AGE
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
         AssetDropTime theDropTime = AssetDropAtZero)
       {
+        // Try to obtain a reference to the new Asset from Handler
+        typename TAssetHandler<TYPE>::typeAssetData* anData =
+          mAssetHandler.getData(theAssetID, theLoadTime, theLoadStyle, theDropTime);
+
+        // Drop our reference to the previous Asset
+        mAssetHandler.dropData(mAssetData);
+
         // Make note of the new Asset ID
         mAssetID = theAssetID;
-
-        // Try to obtain a reference to the new Asset from Handler
-        mAsset = mAssetHandler.getReference(mAssetID, theLoadTime, theLoadStyle, theDropTime);
+        mAssetData = anData;
+        mAsset = (NULL != anData) ? anData->asset : mAssetHandler.getReference();
       }
 
       /**
@@ -132,21 +166,15 @@ namespace AGE
       TYPE& getAsset(void)
       {
         // Is asset not yet loaded, then try to load it immediately
-        if(false == mAssetHandler.isLoaded(mAssetID))
+        if(NULL != mAssetData && false == isLoaded())
         {
           // Load the asset immediately
-          bool anLoaded = mAssetHandler.loadAsset(mAssetID);
-
-          // If the asset was loaded, get a reference to it now
-          if(anLoaded)
-          {
-            // Get reference to the asset immediately
-            mAsset = mAssetHandler.getReference(mAssetID);
-          }
+          mAssetHandler.loadData(*mAssetData);
         }
 
-        // Return reference to dummy asset or loaded asset
-        return *mAsset;
+        // Return reference to dummy asset or loaded asset (which may be shared
+        // with other asset IDs once loaded, see TAssetHandler::isDeduplicated)
+        return (NULL != mAssetData) ? *(mAssetData->asset) : *mAsset;
       }
 
       /**
@@ -154,7 +182,7 @@ namespace AGE
        * loading this asset.
        * @return the filename to use when loading this asset
        */
-      const std::string getFilename(void)
+      const std::string& getFilename(void) const
       {
         return mAssetHandler.getFilename(mAssetID);
       }
@@ -164,7 +192,7 @@ namespace AGE
        * loading this asset.
        * @param[in] theFilename to use for loading asset
        */
-      void setFilename(std::string theFilename)
+      void setFilename(const Symbol theFilename)
       {
         // Set the filename to use for this asset
         mAssetHandler.setFilename(mAssetID, theFilename);
@@ -240,12 +268,10 @@ namespace AGE
        */
       TAsset<TYPE>& operator=(TAsset<TYPE> theRight)
       {
-        // Now swap my local copy with theRight copy made during the call to this method
+        // Now swap my local copy with theRight copy made during the call to
+        // this method, theRight will drop our previous reference
         swap(*this, theRight);
 
-        // Increment the reference count to this Asset
-        mAssetHandler.getReference(mAssetID);
-
         // Return my pointer
         return *this;
       }
@@ -261,7 +287,8 @@ namespace AGE
         // enable ADL
         using std::swap;
 
-        // Swap our asset pointer and ID
+        // Swap our control block, asset pointer and ID
+        swap(first.mAssetData, second.mAssetData);
         swap(first.mAsset, second.mAsset);
         swap(first.mAssetID, second.mAssetID);
         // The mAssetHandler is already handled at construction time
@@ -271,6 +298,8 @@ namespace AGE
       ///////////////////////////////////////////////////////////////////////////
       /// Asset Handler class that will manage this asset
       TAssetHandler<TYPE>& mAssetHandler;
+      /// Control block for this asset or NULL for the dummy asset
+      typename TAssetHandler<TYPE>::typeAssetData* mAssetData;
       /// Pointer to the loaded asset
       TYPE*                mAsset;
       /// Asset ID specified for this asset
@@ -285,7 +314,9 @@ namespace AGE
  * @ingroup Core
  * The TAsset template class is the template used to create a new asset type
  * reference.  It provides indirect reference counting and dummy asset
- * references if no Asset ID is provided (see IAssetHandler).
+ * references if no Asset ID is provided (see IAssetHandler). Copying and
+ * destroying a TAsset only touches the atomic reference count of its control
+ * block, so TAsset objects may be shared with and used from other threads.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -6,15 +6,34 @@
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
  * @date 20120523 - Remove AGE_API from template classes to fix linker issues
+ * @date 20261018 - Record asset loads with the TraceManager
+ * @date 20261018 - Hash the full typeid name at run time for the handler ID
+ * @date 20261018 - Asset IDs and filenames are interned Symbols
+ * @date 20261018 - Added GetHandlerSlot for constant time handler lookup
+ * @date 20261018 - Thread safe atomic reference counts in stable control blocks
+ * @date 20261018 - Added AddReference for prefetching assets by ID
+ * @date 20261018 - Share one decoded asset between files with identical content
+ * @date 20261018 - Added InstallAsset for assets decoded by other threads
+ * @date 20261018 - Allocate assets and control blocks from ObjectPools
+ * @date 20261018 - Record the bytes used by each loaded asset with the MemoryTracker
+ * @date 20261018 - Delete released assets that were not allocated from the pool
  */
 #ifndef   CORE_TASSET_HANDLER_HPP_INCLUDED
 #define   CORE_TASSET_HANDLER_HPP_INCLUDED
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <typeinfo>
+#include <vector>
+#include <SFML/System.hpp>
 #include <AGE/Core/interfaces/IAssetHandler.hpp>
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
+#include <AGE/Core/classes/ObjectPool.hpp>
+#include <AGE/Core/classes/TraceManager.hpp>
 #include <AGE/Core/utils/CRC32.hpp>
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
 
 namespace AGE
@@ -24,15 +43,80 @@ namespace AGE
   class TAssetHandler : public IAssetHandler
   {
     public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of assets and contents in each slab of their ObjectPools
+      static const Uint32 ASSET_SLAB_BLOCKS = 16;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Decoded asset shared by every asset ID whose file has the same content
+      struct typeContent {
+        std::pair<Uint32, Uint64> key;    ///< CRC32 and size of the file contents
+        TYPE*                     asset;  ///< The decoded asset being shared
+        Uint32                    count;  ///< Number of control blocks sharing asset
+        Uint64                    bytes;  ///< Memory used by asset once decoded
+        bool                      loaded; ///< Was asset decoded successfully?
+        sf::Mutex                 mutex;  ///< Held while asset is being decoded
+      };
+
+      /// Control block holding information about each Resource, it stays at
+      /// the same address until the last reference to it is dropped
+      struct typeAssetData {
+        assetID              id;        ///< The ID of the asset being shared
+        TYPE*                asset;     ///< The asset being shared
+        TYPE*                original;  ///< The asset acquired for this ID
+        typeContent*         content;   ///< Shared content or NULL if not shared
+        std::atomic<Uint32>  count;     ///< Number of people referencing this Asset
+        std::atomic<bool>    loaded;    ///< Is the Asset currently loaded?
+        AssetLoadStyle       loadStyle; ///< Load type (File, Memory, Network, etc)
+        AssetLoadTime        loadTime;  ///< Load time (Now, later)
+        AssetDropTime        dropTime;  ///< Drop time at (Zero, Exit)
+        Uint64               bytes;     ///< Memory used by asset if not shared
+        Symbol               filename;  ///< Filename to use when loading this asset
+        sf::Mutex            mutex;     ///< Held while the asset is being loaded
+      };
+
       /**
        * TAssetHandler default constructor.
+       * @param[in] theMemoryTag to record the bytes used by each asset under
        */
-      TAssetHandler() :
-        IAssetHandler(ID(typeid(TYPE).name()))
+      explicit TAssetHandler(const MemoryTracker::MemoryTag theMemoryTag =
+          MemoryTracker::MemoryAssets) :
+        IAssetHandler(getHandlerID(), getHandlerSlot()),
+        mOwnerThread(std::this_thread::get_id()),
+        mMemoryTag(theMemoryTag),
+        mAssetPool("TAssetHandler assets", sizeof(TYPE), ASSET_SLAB_BLOCKS),
+        mDataPool("TAssetHandler data", sizeof(typeAssetData)),
+        mContentPool("TAssetHandler contents", sizeof(typeContent), ASSET_SLAB_BLOCKS)
       {
         ILOG() << "TAssetHandler::ctor(" << getID() << ")" << std::endl;
       }
 
+      /**
+       * GetHandlerID will return the ID every TAssetHandler for TYPE is
+       * registered under which is the CRC32 of typeid(TYPE).name().
+       * @return the ID of the TAssetHandler for TYPE
+       */
+      static Id getHandlerID(void)
+      {
+        // Only hash the type name the first time it is needed
+        static const Id gHandlerID = crc32_register(typeid(TYPE).name(),
+          strlen(typeid(TYPE).name()));
+        return gHandlerID;
+      }
+
+      /**
+       * GetHandlerSlot will return the type slot every TAssetHandler for TYPE
+       * is registered under which is allocated the first time it is needed.
+       * @return the type slot of the TAssetHandler for TYPE
+       */
+      static Uint32 getHandlerSlot(void)
+      {
+        static const Uint32 gHandlerSlot = IAssetHandler::allocateTypeSlot();
+        return gHandlerSlot;
+      }
+
       /**
        * TAssetHandler deconstructor
        */
@@ -40,36 +124,20 @@ namespace AGE
       {
         ILOG() << "TAssetHandler::dtor(" << getID() << ")" << std::endl;
 
-        // Iterator to use while deleting all assets
-        typename std::map<const assetID, typeAssetData>::iterator iter;
-
-        // Loop through each asset and try to remove each one
-        iter = mAssets.begin();
-        while(iter != mAssets.end())
-        {
-          // Decrement the reference count for this asset
-          iter->second.count--;
-
-          // See if the asset should be released and deleted
-          if(iter->second.count != 0)
-          {
-            // Log an error for trying to drop a reference to an unknown ID
-            ELOG() << "TAssetHandler(" << getID() << "):dtor("
-              << iter->first << ") Non zero asset reference count("
-              << iter->second.count << ")!" << std::endl;
-          }
-          const assetID anAssetID = iter->first;
-          TYPE* anAsset = iter->second.asset;
-
-          // Remove this Asset Data structure from our map
-          mAssets.erase(iter++);
-
-          // Release the asset
-          releaseAsset(anAssetID, anAsset);
+        // Release every asset still held by this handler
+        releaseAssets();
+      }
 
-          // Don't keep pointers to something that has been released
-          anAsset = NULL;
-        }
+      /**
+       * AddReference will increment the reference counter for theAssetID
+       * specified (creating the asset if needed) without loading it so it
+       * stays resident until DropReference is called.
+       * @param[in] theAssetID to add the reference for
+       * @return true if the asset exists or was created, false otherwise
+       */
+      virtual bool addReference(const assetID theAssetID)
+      {
+        return NULL != getData(theAssetID);
       }
 
       /**
@@ -83,57 +151,31 @@ namespace AGE
       virtual void dropReference(const assetID theAssetID,
         AssetDropTime theDropTime = AssetDropUnspecified)
       {
-        // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
-
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // The control block found for theAssetID
+        typeAssetData* anData = NULL;
 
-        // Found asset? decrement the count value
-        if(iter != mAssets.end())
+        // Only hold the lock while looking up theAssetID
         {
-          // Default to dropTime previously registered
-          AssetDropTime anDropTime = iter->second.dropTime;
+          sf::Lock anLock(mMutex);
 
-          // Decrement the reference count for this asset
-          iter->second.count--;
+          // Iterator to the asset if found
+          typename std::map<const assetID, typeAssetData*>::iterator iter;
 
-          // Caller specified another dropTime value? use it instead
-          if(AssetDropUnspecified != theDropTime &&
-            theDropTime > AssetDropUnspecified &&
-            theDropTime <= AssetDropAtExit)
-          {
-            anDropTime = theDropTime;
-          }
+          // Try to find the asset using theAssetID as the key
+          iter = mAssets.find(theAssetID);
 
-          // Use anDropTime specified above
-          switch(anDropTime)
+          // Found asset? decrement the count value
+          if(iter != mAssets.end())
           {
-          default:
-            ELOG() << "TAssetHandler(" << getID() << ")::dropReference("
-              << theAssetID << ") Unknown drop time specified!" << std::endl;
-          case AssetDropUnspecified:
-          case AssetDropAtZero:
-            // See if the asset should be released and deleted
-            if(iter->second.count == 0)
-            {
-              TYPE* anAsset = iter->second.asset;
-
-              // Remove this Asset Data structure from our map
-              mAssets.erase(iter++);
-
-              // Release the asset
-              releaseAsset(theAssetID, anAsset);
-
-              // Don't keep pointers to something that has been released
-              anAsset = NULL;
-            }
-            break;
-          case AssetDropAtExit:
-            /* Do nothing, destructor will release each asset */
-            break;
+            anData = iter->second;
           }
         }
+
+        if(NULL != anData)
+        {
+          // The caller still holds a reference so anData can't go away yet
+          dropData(anData, theDropTime);
+        }
         else
         {
           // Log an error for trying to drop a reference to an unknown ID
@@ -169,79 +211,316 @@ namespace AGE
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
         AssetDropTime theDropTime = AssetDropAtZero)
       {
-        // IAsset pointer that will be returned
-        TYPE* anResult = NULL;
+        // Get the control block which holds the asset
+        typeAssetData* anData = getData(theAssetID, theLoadTime, theLoadStyle, theDropTime);
 
-        // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        // Return the Dummy Asset if the asset couldn't be acquired
+        return (NULL != anData) ? anData->asset : &mDummyAsset;
+      }
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+      /**
+       * GetData will retrieve the control block for the asset registered
+       * under theAssetID and increment its reference counter or call the
+       * AcquireAsset pure virtual function to obtain it if it hasn't yet been
+       * created. The control block stays at the same address until its last
+       * reference is dropped using DropData.
+       * @param[in] theAssetID to lookup for the reference
+       * @param[in] theLoadTime (Now, Later) of when to load this asset
+       * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
+       * @return the control block or NULL if the asset couldn't be acquired
+       */
+      typeAssetData* getData(const assetID theAssetID,
+        AssetLoadTime theLoadTime = AssetLoadLater,
+        AssetLoadStyle theLoadStyle = AssetLoadFromFile,
+        AssetDropTime theDropTime = AssetDropAtZero)
+      {
+        // Control block that will be returned
+        typeAssetData* anResult = NULL;
 
-        // Found asset? increment the count and return the reference
-        if(iter != mAssets.end())
-        {
-          // Increment the reference count for this asset
-          iter->second.count++;
+        // Will be true if the asset should be loaded before returning
+        bool anLoadNow = false;
 
-          // Return the IAsset address found
-          anResult = iter->second.asset;
-        }
-        else
+        // Only hold the lock while looking up or adding theAssetID
         {
-          // First attempt to acquire the asset first
-          anResult = acquireAsset(theAssetID);
+          sf::Lock anLock(mMutex);
+
+          // Iterator to the asset if found
+          typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+          // Try to find the asset using theAssetID as the key
+          iter = mAssets.find(theAssetID);
 
-          // Map the newly acquired asset to theAssetID provided
-          if(NULL != anResult)
+          // Found asset? increment the count and return the reference
+          if(iter != mAssets.end())
           {
-            // Create a new AssetData to hold our asset information
-            typeAssetData anAssetData;
-
-            // Acquire the asset for the first time
-            anAssetData.asset = anResult;
-            anAssetData.count = 1;
-            anAssetData.loaded = false;
-            anAssetData.loadStyle = theLoadStyle;
-            anAssetData.loadTime = theLoadTime;
-            anAssetData.dropTime = AssetDropAtZero;
-            anAssetData.filename = theAssetID;
-
-            // Check the Load Style range provided and force to LoadFromUnknown if out of range
-            if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
+            // Increment the reference count for this asset
+            iter->second->count.fetch_add(1, std::memory_order_relaxed);
+
+            // Return the control block found
+            anResult = iter->second;
+          }
+          else
+          {
+            // First attempt to acquire the asset first
+            TYPE* anAsset = acquireAsset(theAssetID);
+
+            // Map the newly acquired asset to theAssetID provided
+            if(NULL != anAsset)
             {
-              // Force style to AssetLoadFromFile if out of enum range
-              anAssetData.loadStyle = AssetLoadFromFile;
+              // Create a new control block to hold our asset information
+              anResult = mDataPool.template create<typeAssetData>();
             }
 
-            // Check the Load Time range provided and force LoadNow if out of range
-            if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadLater)
+            if(NULL != anResult)
             {
-              // Force load time to AssetLoadLater if out of enum range
-              anAssetData.loadTime = AssetLoadLater;
+              // Acquire the asset for the first time
+              anResult->id = theAssetID;
+              anResult->asset = anAsset;
+              anResult->original = anAsset;
+              anResult->content = NULL;
+              anResult->count.store(1, std::memory_order_relaxed);
+              anResult->loaded.store(false, std::memory_order_relaxed);
+              anResult->loadStyle = theLoadStyle;
+              anResult->loadTime = theLoadTime;
+              anResult->dropTime = AssetDropAtZero;
+              anResult->bytes = 0;
+              anResult->filename = theAssetID;
+
+              // Check the Load Style range provided and force to LoadFromUnknown if out of range
+              if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
+              {
+                // Force style to AssetLoadFromFile if out of enum range
+                anResult->loadStyle = AssetLoadFromFile;
+              }
+
+              // Check the Load Time range provided and force LoadNow if out of range
+              if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadLater)
+              {
+                // Force load time to AssetLoadLater if out of enum range
+                anResult->loadTime = AssetLoadLater;
+              }
+
+              // Store the newly acquired control block in our map for future reference
+              mAssets.insert(std::pair<const assetID, typeAssetData*>(theAssetID, anResult));
+
+              // Were we asked to load the asset now?
+              anLoadNow = (AssetLoadNow == anResult->loadTime);
             }
+            else if(NULL != anAsset)
+            {
+              // We couldn't create the control block, so give the asset back
+              releaseAsset(theAssetID, anAsset);
+            }
+          }
+        }
+
+        // Load the asset now without holding the lock so other threads can
+        // keep using this handler while it loads
+        if(anLoadNow)
+        {
+          loadData(*anResult);
+        }
+
+        // Return the control block provided to the caller
+        return anResult;
+      }
+
+      /**
+       * InstallAsset will make theAsset provided, which was already decoded
+       * (e.g. by a SoundBank worker thread), the loaded asset for theAssetID
+       * and add a reference to it like AddReference. The asset only becomes
+       * visible once it is completely loaded. If theAssetID is already
+       * loaded then the loaded asset is kept and theAsset is released.
+       * @param[in] theAssetID to install theAsset under
+       * @param[in] theAsset decoded, this handler takes ownership of it
+       * @param[in] theFilename theAsset was decoded from
+       * @return true if the reference was added, false otherwise
+       */
+      bool installAsset(const assetID theAssetID, TYPE* theAsset,
+        const Symbol theFilename)
+      {
+        // Add the reference the caller will drop later
+        typeAssetData* anData = getData(theAssetID);
+
+        // The asset that is no longer needed, if any
+        TYPE* anRelease = theAsset;
 
-            // Store the newly acquired asset pointer in our map for future reference
-            mAssets.insert(std::pair<const assetID, typeAssetData>(theAssetID, anAssetData));
+        if(NULL != anData)
+        {
+          // Wait for anyone else loading this asset
+          sf::Lock anLock(anData->mutex);
 
-            // Were we asked to load the asset now?
-            if(AssetLoadNow == anAssetData.loadTime)
+          // Only replace the asset acquired for an asset not yet loaded
+          if(false == anData->loaded.load(std::memory_order_acquire) &&
+            NULL == anData->content && NULL != theAsset)
+          {
+            anRelease = anData->original;
+            anData->asset = theAsset;
+            anData->original = theAsset;
+            anData->bytes = getAssetBytes(*theAsset);
+            MemoryTracker::getInstance().allocate(mMemoryTag, anData->bytes);
             {
-              // Load the Asset now
-              loadAsset(theAssetID);
+              sf::Lock anMapLock(mMutex);
+              anData->filename = theFilename;
             }
+
+            // Publish the installed asset to other threads
+            anData->loaded.store(true, std::memory_order_release);
           }
         }
 
-        // If result is NULL by this point then return the Dummy Asset instead
-        if(NULL == anResult)
+        if(NULL != anRelease)
         {
-          // Get the DummyAsset pointer now
-          anResult = &mDummyAsset;
+          // Defer the release to the owner thread if necessary
+          if(isReleaseDeferred() && std::this_thread::get_id() != mOwnerThread)
+          {
+            sf::Lock anLock(mMutex);
+            mReleases.push_back(std::pair<assetID, TYPE*>(theAssetID, anRelease));
+          }
+          else
+          {
+            releaseAsset(theAssetID, anRelease);
+          }
         }
 
-        // Return the asset pointer provided to the caller
-        return anResult;
+        return NULL != anData;
+      }
+
+      /**
+       * AddData will increment the reference counter of theData provided
+       * without taking any locks. The caller must already hold a reference
+       * to theData (e.g. when copying a TAsset).
+       * @param[in] theData to add a reference to
+       */
+      static void addData(typeAssetData* theData)
+      {
+        if(NULL != theData)
+        {
+          theData->count.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      /**
+       * DropData will decrement the reference counter of theData provided
+       * and remove and release the asset if this was the last reference and
+       * the asset is dropped at zero. Only the last reference takes a lock.
+       * The release is deferred to ProcessReleases if it happens away from
+       * the thread that created this handler for asset types that need it
+       * (see IsReleaseDeferred).
+       * @param[in] theData to drop the reference for
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or later
+       */
+      void dropData(typeAssetData* theData,
+        AssetDropTime theDropTime = AssetDropUnspecified)
+      {
+        if(NULL == theData)
+        {
+          return;
+        }
+
+        // Copy the ID now, theData may be deleted by another thread as soon
+        // as our reference is dropped
+        const assetID anAssetID = theData->id;
+
+        // Not the last reference? then we are done
+        if(1 != theData->count.fetch_sub(1, std::memory_order_acq_rel))
+        {
+          return;
+        }
+
+        // The assets to release, if any
+        TYPE* anAssets[2] = {NULL, NULL};
+
+        // Only hold the lock while removing the asset from our map
+        {
+          sf::Lock anLock(mMutex);
+
+          // Iterator to the asset if found
+          typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+          // GetData may have given out a new reference or another thread may
+          // have already removed it, so look it up again while locked
+          iter = mAssets.find(anAssetID);
+          if(iter == mAssets.end() || 0 != iter->second->count.load())
+          {
+            return;
+          }
+
+          // Default to dropTime previously registered
+          AssetDropTime anDropTime = iter->second->dropTime;
+
+          // Caller specified another dropTime value? use it instead
+          if(AssetDropUnspecified != theDropTime &&
+            theDropTime > AssetDropUnspecified &&
+            theDropTime <= AssetDropAtExit)
+          {
+            anDropTime = theDropTime;
+          }
+
+          // Use anDropTime specified above
+          switch(anDropTime)
+          {
+          default:
+            ELOG() << "TAssetHandler(" << getID() << ")::dropData("
+              << anAssetID << ") Unknown drop time specified!" << std::endl;
+          case AssetDropUnspecified:
+          case AssetDropAtZero:
+            detachData(*iter->second, anAssets);
+
+            // Remove this Asset Data structure from our map
+            mDataPool.destroy(iter->second);
+            mAssets.erase(iter);
+
+            // Defer the release to the owner thread if necessary
+            if(isReleaseDeferred() && std::this_thread::get_id() != mOwnerThread)
+            {
+              for(Uint32 iloop = 0; iloop < 2; iloop++)
+              {
+                if(NULL != anAssets[iloop])
+                {
+                  mReleases.push_back(std::pair<assetID, TYPE*>(anAssetID, anAssets[iloop]));
+                  anAssets[iloop] = NULL;
+                }
+              }
+            }
+            break;
+          case AssetDropAtExit:
+            /* Do nothing, destructor will release each asset */
+            break;
+          }
+        }
+
+        for(Uint32 iloop = 0; iloop < 2; iloop++)
+        {
+          if(NULL != anAssets[iloop])
+          {
+            // Release the asset
+            releaseAsset(anAssetID, anAssets[iloop]);
+
+            // Don't keep pointers to something that has been released
+            anAssets[iloop] = NULL;
+          }
+        }
+      }
+
+      /**
+       * ProcessReleases will release every asset whose last reference was
+       * dropped away from the thread that created this handler. This should
+       * be called periodically from that thread (see AssetManager).
+       */
+      virtual void processReleases(void)
+      {
+        // Take the pending releases so we don't release while locked
+        std::vector<std::pair<assetID, TYPE*> > anReleases;
+        {
+          sf::Lock anLock(mMutex);
+          anReleases.swap(mReleases);
+        }
+
+        for(size_t iloop = 0; iloop < anReleases.size(); iloop++)
+        {
+          releaseAsset(anReleases[iloop].first, anReleases[iloop].second);
+        }
       }
 
       /**
@@ -256,7 +535,10 @@ namespace AGE
         bool anResult = false;
 
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::const_iterator iter;
+        typename std::map<const assetID, typeAssetData*>::const_iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -265,7 +547,7 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Return the loaded value found
-          anResult = iter->second.loaded;
+          anResult = iter->second->loaded;
         }
         else
         {
@@ -285,13 +567,16 @@ namespace AGE
        * @param[in] theAssetID to set filename for
        * @param[in] theFilename to use when loading this asset from a file
        */
-      virtual const std::string getFilename(const assetID theAssetID) const
+      virtual const std::string& getFilename(const assetID theAssetID) const
       {
         // Return empty string if no filename was found
-        std::string anResult;
+        Symbol anResult;
 
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::const_iterator iter;
+        typename std::map<const assetID, typeAssetData*>::const_iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -300,7 +585,7 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Retrieve the filename for this asset
-          anResult = iter->second.filename;
+          anResult = iter->second->filename;
         }
         else
         {
@@ -311,7 +596,7 @@ namespace AGE
         }
 
         // Return anResult found, empty string otherwise
-        return anResult;
+        return anResult.str();
       }
 
       /**
@@ -320,10 +605,13 @@ namespace AGE
        * @param[in] theAssetID to set filename for
        * @param[in] theFilename to use when loading this asset from a file
        */
-      virtual void setFilename(const assetID theAssetID, std::string theFilename)
+      virtual void setFilename(const assetID theAssetID, const Symbol theFilename)
       {
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -332,14 +620,14 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Print warning if asset has already been loaded
-          if(false == iter->second.loaded)
+          if(false == iter->second->loaded)
           {
             WLOG() << "TAssetHandler(" << getID() << ")::SetFilename("
               << theAssetID << ") Asset is already loaded" << std::endl;
           }
 
           // Set the filename for this asset
-          iter->second.filename = theFilename;
+          iter->second->filename = theFilename;
         }
         else
         {
@@ -361,7 +649,10 @@ namespace AGE
         AssetLoadStyle anResult = AssetLoadFromUnknown;
 
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::const_iterator iter;
+        typename std::map<const assetID, typeAssetData*>::const_iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -369,7 +660,7 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Retrieve our loading style from the asset found
-          anResult = iter->second.loadStyle;
+          anResult = iter->second->loadStyle;
         }
         else
         {
@@ -393,7 +684,10 @@ namespace AGE
       void setLoadStyle(const assetID theAssetID, AssetLoadStyle theLoadStyle)
       {
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -405,16 +699,16 @@ namespace AGE
           if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
           {
             // Force style to AssetLoadFromFile if out of enum range
-            iter->second.loadStyle = AssetLoadFromFile;
+            iter->second->loadStyle = AssetLoadFromFile;
           }
           else
           {
             // Set the asset Load Style now
-            iter->second.loadStyle = theLoadStyle;
+            iter->second->loadStyle = theLoadStyle;
           }
 
           // Are we changing the load style after it was loaded!?
-          if(true == iter->second.loaded)
+          if(true == iter->second->loaded)
           {
             switch(theLoadStyle)
             {
@@ -458,7 +752,10 @@ namespace AGE
         AssetLoadTime anResult = AssetLoadLater;
 
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::const_iterator iter;
+        typename std::map<const assetID, typeAssetData*>::const_iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -466,7 +763,7 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Retrieve our loading time from the asset found
-          anResult = iter->second.loadTime;
+          anResult = iter->second->loadTime;
         }
         else
         {
@@ -490,7 +787,10 @@ namespace AGE
       virtual void setLoadTime(const assetID theAssetID, AssetLoadTime theLoadTime)
       {
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -502,16 +802,16 @@ namespace AGE
           if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadLater)
           {
             // Force load time to AssetLoadLater if out of enum range
-            iter->second.loadTime = AssetLoadLater;
+            iter->second->loadTime = AssetLoadLater;
           }
           else
           {
             // Set the asset Load Time now
-            iter->second.loadTime = theLoadTime;
+            iter->second->loadTime = theLoadTime;
           }
 
           // Are we changing the load time after it was loaded!?
-          if(true == iter->second.loaded)
+          if(true == iter->second->loaded)
           {
             switch(theLoadTime)
             {
@@ -550,7 +850,10 @@ namespace AGE
         AssetDropTime anResult = AssetDropUnspecified;
 
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::const_iterator iter;
+        typename std::map<const assetID, typeAssetData*>::const_iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -558,7 +861,7 @@ namespace AGE
         if(iter != mAssets.end())
         {
           // Retrieve our loading time from the asset found
-          anResult = iter->second.dropTime;
+          anResult = iter->second->dropTime;
         }
         else
         {
@@ -582,7 +885,10 @@ namespace AGE
         AssetDropTime theDropTime)
       {
         // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+        // Lock the asset map while we use it
+        sf::Lock anLock(mMutex);
 
         // Try to find the asset using theAssetID as the key
         iter = mAssets.find(theAssetID);
@@ -594,12 +900,12 @@ namespace AGE
           if(theDropTime < AssetDropAtZero || theDropTime > AssetDropAtExit)
           {
             // Force drop time to AssetDropAtZero if out of enum range
-            iter->second.dropTime = AssetDropAtZero;
+            iter->second->dropTime = AssetDropAtZero;
           }
           else
           {
             // Set the asset drop time now
-            iter->second.dropTime = theDropTime;
+            iter->second->dropTime = theDropTime;
           }
         }
         else
@@ -622,39 +928,32 @@ namespace AGE
         // Result if asset was not found
         bool anResult = false;
 
-        // Iterator to the asset if found
-        typename std::map<const assetID, typeAssetData>::iterator iter;
+        // Hold a reference to the asset while it loads
+        typeAssetData* anData = NULL;
+        {
+          sf::Lock anLock(mMutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+          // Iterator to the asset if found
+          typename std::map<const assetID, typeAssetData*>::iterator iter;
 
-        // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
-        {
-          if(false == iter->second.loaded)
+          // Try to find the asset using theAssetID as the key
+          iter = mAssets.find(theAssetID);
+
+          // Found asset? keep it around until we are done loading it
+          if(iter != mAssets.end())
           {
-            // Attempt to load the asset now using the correct style
-            switch(iter->second.loadStyle)
-            {
-            case AssetLoadFromFile:
-              iter->second.loaded = loadFromFile(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromMemory:
-              iter->second.loaded = loadFromMemory(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromNetwork:
-              iter->second.loaded = loadFromNetwork(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromUnknown:
-            default:
-              ELOG() << "TAssetHandler(" << getID() << ")::loadAsset("
-                << theAssetID << ") unknown loading style specified!" << std::endl;
-              break;
-            }
+            anData = iter->second;
+            anData->count.fetch_add(1, std::memory_order_relaxed);
           }
+        }
 
-          // Set our return result
-          anResult = iter->second.loaded;
+        if(NULL != anData)
+        {
+          // Load the asset without holding our lock
+          anResult = loadData(*anData);
+
+          // Drop the reference we added above
+          dropData(anData);
         }
         else
         {
@@ -668,6 +967,68 @@ namespace AGE
         return anResult;
       }
 
+      /**
+       * LoadData is responsible for loading the asset held by theData
+       * provided according to the previously registered style. Different
+       * assets may be loaded at the same time by different threads. The
+       * caller must hold a reference to theData.
+       * @param[in] theData of the asset to load
+       * @return true if the asset is loaded, false otherwise
+       */
+      bool loadData(typeAssetData& theData)
+      {
+        // Only one thread at a time may load each asset
+        sf::Lock anLock(theData.mutex);
+
+        if(false == theData.loaded.load(std::memory_order_acquire))
+        {
+          // Record the time spent loading this asset in the trace timeline
+          TRACE_SCOPE_DETAIL("TAssetHandler::loadAsset", "asset", theData.id.c_str());
+
+          // Will be true if the asset was loaded
+          bool anLoaded = false;
+
+          // Attempt to load the asset now using the correct style
+          switch(theData.loadStyle)
+          {
+          case AssetLoadFromFile:
+            if(isDeduplicated())
+            {
+              anLoaded = loadContent(theData);
+            }
+            else
+            {
+              anLoaded = loadFromFile(theData.id, *(theData.asset));
+            }
+            break;
+          case AssetLoadFromMemory:
+            anLoaded = loadFromMemory(theData.id, *(theData.asset));
+            break;
+          case AssetLoadFromNetwork:
+            anLoaded = loadFromNetwork(theData.id, *(theData.asset));
+            break;
+          case AssetLoadFromUnknown:
+          default:
+            ELOG() << "TAssetHandler(" << getID() << ")::loadAsset("
+              << theData.id << ") unknown loading style specified!" << std::endl;
+            break;
+          }
+
+          // Shared contents record their own bytes in LoadContent
+          if(anLoaded && NULL == theData.content)
+          {
+            theData.bytes = getAssetBytes(*(theData.asset));
+            MemoryTracker::getInstance().allocate(mMemoryTag, theData.bytes);
+          }
+
+          // Publish the loaded asset to other threads
+          theData.loaded.store(anLoaded, std::memory_order_release);
+        }
+
+        // Return true if the asset is loaded
+        return theData.loaded.load(std::memory_order_acquire);
+      }
+
       /**
        * LoadAllAssets is responsible for loading all unloaded assets that are
        * currently registered with this IAssetHandler derived class.
@@ -677,42 +1038,35 @@ namespace AGE
       {
         // Return true if all assets load successfully
         bool anResult = true;
-    
-        // Iterator for each typeAssetData registered
-        typename std::map<const assetID, typeAssetData>::iterator iter;
 
-        // Loop through each asset handler and tell it to load its assets
-        iter = mAssets.begin();
-        while(iter != mAssets.end())
+        // Hold a reference to each asset while we load them
+        std::vector<typeAssetData*> anAssets;
         {
-          // Is this an asset that hasn't been loaded yet? load it now
-          if(false == iter->second.loaded)
+          sf::Lock anLock(mMutex);
+
+          // Iterator for each typeAssetData registered
+          typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+          // Loop through each asset and make note of it
+          iter = mAssets.begin();
+          while(iter != mAssets.end())
           {
-            // Attempt to load the asset now using the correct style
-            switch(iter->second.loadStyle)
-            {
-            case AssetLoadFromFile:
-              iter->second.loaded = loadFromFile(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromMemory:
-              iter->second.loaded = loadFromMemory(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromNetwork:
-              iter->second.loaded = loadFromNetwork(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromUnknown:
-            default:
-              ELOG() << "TAssetHandler(" << getID() << ")::loadAllAssets("
-                << iter->first << ") unknown loading style specified!" << std::endl;
-              break;
-            }
+            iter->second->count.fetch_add(1, std::memory_order_relaxed);
+            anAssets.push_back(iter->second);
+
+            // Move to the next registered Assets value
+            iter++;
           }
+        }
 
+        // Load each asset without holding our lock
+        for(size_t iloop = 0; iloop < anAssets.size(); iloop++)
+        {
           // Set our return result
-          anResult &= iter->second.loaded;
+          anResult &= loadData(*anAssets[iloop]);
 
-          // Move to the next registered Assets value
-          iter++;
+          // Drop the reference we added above
+          dropData(anAssets[iloop]);
         }
 
         // Return anResult which will still be true if all LoadAllAssets returned
@@ -720,10 +1074,33 @@ namespace AGE
         return anResult;
       }
 
+      /**
+       * GetSavedBytes will return the memory saved by sharing one decoded
+       * asset between asset IDs whose files have identical contents.
+       * @return the number of bytes saved
+       */
+      virtual Uint64 getSavedBytes(void) const
+      {
+        Uint64 anResult = 0;
+
+        // Lock the content map while we use it
+        sf::Lock anLock(mMutex);
+
+        // Every control block after the first sharing each content saves bytes
+        typename std::map<std::pair<Uint32, Uint64>, typeContent*>::const_iterator iter;
+        for(iter = mContents.begin(); iter != mContents.end(); iter++)
+        {
+          anResult += (Uint64)(iter->second->count - 1) * iter->second->bytes;
+        }
+
+        return anResult;
+      }
+
     protected:
       /**
        * AcquireAsset is responsible for creating an IAsset derived asset and
-       * returning it to the caller.
+       * returning it to the caller. Assets not created from our pool are
+       * released with delete unless ReleaseAsset is overridden.
        * @param[in] theAssetID of the asset to acquire
        * @return a pointer to the newly created asset
        */
@@ -731,7 +1108,7 @@ namespace AGE
       {
         ILOG() << "TAssetHandler(" << getID() << "):acquireAsset("
           << theAssetID << ") Creating asset" << std::endl;
-        return new(std::nothrow) TYPE();
+        return mAssetPool.template create<TYPE>();
       }
       
       /**
@@ -745,8 +1122,105 @@ namespace AGE
         ILOG() << "TAssetHandler(" << getID() << "):releaseAsset("
           << theAssetID << ") Releasing asset" << std::endl;
 
-        // Just delete the memory used for the asset
-        delete theAsset;
+        // Assets acquired or installed from outside our pool were created
+        // with new, everything else goes back to the pool
+        if(mAssetPool.owns(theAsset))
+        {
+          mAssetPool.destroy(theAsset);
+        }
+        else
+        {
+          delete theAsset;
+        }
+      }
+
+      /**
+       * ReleaseAssets is responsible for releasing every asset still held
+       * by this handler. The TAssetHandler destructor calls it, but by then
+       * ReleaseAsset no longer reaches derived classes, so derived classes
+       * that override ReleaseAsset must call it from their own destructor.
+       */
+      void releaseAssets(void)
+      {
+        // Release anything still waiting for the owner thread first
+        processReleases();
+
+        // Iterator to use while deleting all assets
+        typename std::map<const assetID, typeAssetData*>::iterator iter;
+
+        // Loop through each asset and try to remove each one
+        iter = mAssets.begin();
+        while(iter != mAssets.end())
+        {
+          typeAssetData* anData = iter->second;
+
+          // See if anyone still has a reference to this asset
+          if(anData->count.load() != 0)
+          {
+            // Include the memory this asset is keeping alive
+            Uint64 anBytes = (NULL != anData->content) ?
+              anData->content->bytes : anData->bytes;
+
+            // Log an error for trying to drop a reference to an unknown ID
+            ELOG() << "TAssetHandler(" << getID() << "):releaseAssets("
+              << iter->first << ") Non zero asset reference count("
+              << anData->count.load() << ") holding " << anBytes
+              << " bytes!" << std::endl;
+          }
+
+          // Remove this Asset Data structure from our map
+          mAssets.erase(iter++);
+
+          // Release the assets no longer used by anyone
+          TYPE* anAssets[2];
+          detachData(*anData, anAssets);
+          for(Uint32 jloop = 0; jloop < 2; jloop++)
+          {
+            if(NULL != anAssets[jloop])
+            {
+              releaseAsset(anData->id, anAssets[jloop]);
+            }
+          }
+
+          // Delete the control block
+          mDataPool.destroy(anData);
+        }
+      }
+
+      /**
+       * IsReleaseDeferred should return true if assets of this type must be
+       * released by the thread that created this handler (e.g. assets that
+       * own OpenGL resources). Those assets dropped on another thread are
+       * released by the next call to ProcessReleases instead.
+       * @return true if releases are deferred, false otherwise
+       */
+      virtual bool isReleaseDeferred(void) const
+      {
+        return false;
+      }
+
+      /**
+       * IsDeduplicated should return true if asset IDs whose files have
+       * identical contents may share one decoded asset. Only asset types
+       * that are never modified after loading should return true.
+       * @return true if identical files share an asset, false otherwise
+       */
+      virtual bool isDeduplicated(void) const
+      {
+        return false;
+      }
+
+      /**
+       * GetAssetBytes may be defined by the derived class to return the
+       * memory used by theAsset once decoded for GetSavedBytes and the
+       * MemoryTracker. The size of the file is used instead if 0 is returned
+       * by handlers that return true from IsDeduplicated.
+       * @param[in] theAsset that was decoded
+       * @return the bytes used by theAsset or 0 if unknown
+       */
+      virtual Uint64 getAssetBytes(const TYPE& theAsset) const
+      {
+        return 0;
       }
 
       /**
@@ -780,25 +1254,148 @@ namespace AGE
       virtual bool loadFromNetwork(const assetID theAssetID, TYPE& theAsset) = 0;
 
     private:
-      // Structures
-      ///////////////////////////////////////////////////////////////////////////
-      /// Structure holding information about each Resource
-      struct typeAssetData {
-        TYPE*          asset;     ///< The asset being shared
-        Uint32         count;     ///< Number of people referencing this Asset
-        bool           loaded;    ///< Is the Asset currently loaded?
-        AssetLoadStyle loadStyle; ///< Load type (File, Memory, Network, etc)
-        AssetLoadTime  loadTime;  ///< Load time (Now, later)
-        AssetDropTime  dropTime;  ///< Drop time at (Zero, Exit)
-        std::string    filename;  ///< Filename to use when loading this asset
-      };
-
       // Variables
       ///////////////////////////////////////////////////////////////////////////
-      /// Map that associates asset ID's with their appropriate TAssetData
-      std::map<const assetID, typeAssetData> mAssets;
+      /// Map that associates asset ID's with their control blocks
+      std::map<const assetID, typeAssetData*> mAssets;
+      /// Map that associates file CRC32 and size with the content shared
+      std::map<std::pair<Uint32, Uint64>, typeContent*> mContents;
+      /// Assets waiting to be released by ProcessReleases
+      std::vector<std::pair<assetID, TYPE*> > mReleases;
+      /// Mutex protecting mAssets, mReleases and the control block settings
+      mutable sf::Mutex mMutex;
+      /// Thread that created this handler which releases deferred assets
+      const std::thread::id mOwnerThread;
+      /// Tag the bytes used by each loaded asset are recorded under
+      const MemoryTracker::MemoryTag mMemoryTag;
+      /// Pool the assets created by AcquireAsset are allocated from
+      ObjectPool mAssetPool;
+      /// Pool the control blocks in mAssets are allocated from
+      ObjectPool mDataPool;
+      /// Pool the contents in mContents are allocated from
+      ObjectPool mContentPool;
       /// Dummy asset that will be returned if an asset can't be Acquired
       TYPE mDummyAsset;
+
+      /**
+       * LoadContent is responsible for loading theData provided from its file
+       * or sharing the asset already decoded from a file with the same CRC32
+       * and size. The caller must hold the mutex of theData.
+       * @param[in] theData of the asset to load
+       * @return true if the asset is loaded, false otherwise
+       */
+      bool loadContent(typeAssetData& theData)
+      {
+        // Hash the file contents to find other files just like it
+        MemoryMappedFile anFile;
+        if(!anFile.open(theData.filename.str()))
+        {
+          return loadFromFile(theData.id, *(theData.asset));
+        }
+        const std::pair<Uint32, Uint64> anKey(
+          crc32_runtime(anFile.getData(), anFile.getSize()), (Uint64)anFile.getSize());
+        anFile.close();
+
+        // Find or add the content shared by theData
+        typeContent* anContent = NULL;
+        {
+          sf::Lock anLock(mMutex);
+
+          typename std::map<std::pair<Uint32, Uint64>, typeContent*>::iterator iter;
+          iter = mContents.find(anKey);
+          if(iter != mContents.end())
+          {
+            anContent = iter->second;
+            anContent->count++;
+          }
+          else
+          {
+            anContent = mContentPool.template create<typeContent>();
+            if(NULL == anContent)
+            {
+              return loadFromFile(theData.id, *(theData.asset));
+            }
+
+            // The first asset ID with this content provides the asset shared
+            anContent->key = anKey;
+            anContent->asset = theData.original;
+            anContent->count = 1;
+            anContent->bytes = 0;
+            anContent->loaded = false;
+            mContents.insert(std::pair<std::pair<Uint32, Uint64>, typeContent*>(
+              anKey, anContent));
+          }
+
+          theData.content = anContent;
+          theData.asset = anContent->asset;
+        }
+
+        // Only one thread at a time may decode each content
+        sf::Lock anContentLock(anContent->mutex);
+
+        if(false == anContent->loaded)
+        {
+          anContent->loaded = loadFromFile(theData.id, *(anContent->asset));
+
+          if(anContent->loaded)
+          {
+            // Prefer the decoded size over the file size
+            Uint64 anBytes = getAssetBytes(*(anContent->asset));
+
+            sf::Lock anLock(mMutex);
+            anContent->bytes = (0 != anBytes) ? anBytes : anKey.second;
+            MemoryTracker::getInstance().allocate(mMemoryTag, anContent->bytes);
+          }
+        }
+        else
+        {
+          ILOG() << "TAssetHandler(" << getID() << "):loadContent("
+            << theData.id << ") Sharing identical asset" << std::endl;
+        }
+
+        return anContent->loaded;
+      }
+
+      /**
+       * DetachData is responsible for removing theData provided from the
+       * content it shares and providing up to two assets in theAssets that
+       * should now be released (or NULL). The caller must hold mMutex.
+       * @param[in] theData of the asset being removed
+       * @param[out] theAssets to release
+       */
+      void detachData(typeAssetData& theData, TYPE* theAssets[2])
+      {
+        theAssets[0] = theData.original;
+        theAssets[1] = NULL;
+
+        // The asset is released by the caller so stop counting its memory
+        if(theData.loaded.load(std::memory_order_acquire) && NULL == theData.content)
+        {
+          MemoryTracker::getInstance().release(mMemoryTag, theData.bytes);
+        }
+        theData.bytes = 0;
+
+        typeContent* anContent = theData.content;
+        if(NULL != anContent)
+        {
+          // The asset shared is released with the last one sharing it
+          if(anContent->asset == theData.original)
+          {
+            theAssets[0] = NULL;
+          }
+          if(0 == --anContent->count)
+          {
+            if(anContent->loaded)
+            {
+              MemoryTracker::getInstance().release(mMemoryTag, anContent->bytes);
+            }
+            theAssets[1] = anContent->asset;
+            mContents.erase(anContent->key);
+            mContentPool.destroy(anContent);
+          }
+          theData.content = NULL;
+        }
+      }
   }; // class TAssetHandler
 } // namespace AGE
 
@@ -809,6 +1406,21 @@ namespace AGE
  * @ingroup Core
  * The TAssetHandler template class is used to quickly provide a IAssetHandler
  * derived class for handling the Asset type specified.
+ * Each asset is kept in a control block with an atomic reference count which
+ * TAsset holds directly, so copying a TAsset never takes a lock. The map of
+ * control blocks is protected by a mutex which is only taken to look up an
+ * asset by ID or to remove it when its last reference is dropped. Assets are
+ * loaded without holding that mutex so different assets can be loaded by
+ * different threads at the same time.
+ *
+ * Handlers that return true from IsDeduplicated hash the contents of each
+ * file before loading it. Asset IDs whose files have the same CRC32 and size
+ * share the asset decoded for the first of them, which is only released once
+ * every one of them has been dropped (see GetSavedBytes).
+ *
+ * The bytes used by each loaded asset (see GetAssetBytes) are recorded with
+ * the MemoryTracker under the tag provided to the constructor so they can be
+ * reported per subsystem. Shared assets are only counted once.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -6,6 +6,7 @@
  * @author Ryan Lindeman
  * @date 20110607 - Initial Release
  * @date 20120504 - Fix segfault caused by SLOG taking over gInstance
+ * @date 20261018 - Record the memory buffered with the MemoryTracker
  */
 #ifndef   CORE_STRING_LOGGER_HPP_INCLUDED
 #define   CORE_STRING_LOGGER_HPP_INCLUDED
@@ -84,6 +85,14 @@ namespace AGE
     private:
       /// Output Logger file
       std::ostringstream mStringStream;
+      /// Bytes of mStringStream recorded with the MemoryTracker
+      Int64 mTrackedBytes;
+
+      /**
+       * TrackMemory will record any change in the size of mStringStream
+       * with the MemoryTracker.
+       */
+      void trackMemory(void);
 
       /**
        * Copy constructor is private because we do not allow copies of
@@ -0,0 +1,167 @@
+/**
+ * Provides the BitStream class in the AGE namespace which is responsible
+ * for packing values into (and unpacking them from) the fewest bits needed.
+ *
+ * @file include/AGE/Core/utils/BitStream.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_BIT_STREAM_HPP_INCLUDED
+#define   CORE_BIT_STREAM_HPP_INCLUDED
+
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a buffer of bit packed values for network packets
+  class AGE_API BitStream
+  {
+    public:
+      /**
+       * BitStream constructor
+       */
+      BitStream();
+
+      /**
+       * Clear will remove every bit written and rewind the read position.
+       */
+      void clear(void);
+
+      /**
+       * SetData will replace the contents with theSize bytes of theData
+       * provided (such as a received packet) and rewind the read position.
+       * @param[in] theData to copy
+       * @param[in] theSize of theData in bytes
+       */
+      void setData(const void* theData, const Uint32 theSize);
+
+      /**
+       * GetData will return the bytes written so far.
+       * @return pointer to the bytes written
+       */
+      const Uint8* getData(void) const;
+
+      /**
+       * GetSize will return the number of bytes needed for the bits written.
+       * @return the number of bytes
+       */
+      Uint32 getSize(void) const;
+
+      /**
+       * GetBitCount will return the number of bits written so far.
+       * @return the number of bits
+       */
+      Uint32 getBitCount(void) const;
+
+      /**
+       * SetBitCount will remove the bits written after theBitCount provided,
+       * which is used to undo a value that didn't fit.
+       * @param[in] theBitCount to keep (must not be more than GetBitCount)
+       */
+      void setBitCount(const Uint32 theBitCount);
+
+      /**
+       * WriteBits will append the low theCount bits of theValue provided.
+       * @param[in] theValue to write
+       * @param[in] theCount of bits to write from 1 to 32
+       */
+      void writeBits(const Uint32 theValue, const Uint32 theCount);
+
+      /**
+       * WriteBool will append theValue provided as a single bit.
+       * @param[in] theValue to write
+       */
+      void writeBool(const bool theValue);
+
+      /**
+       * WriteUint will append theValue provided using 6 to 34 bits, smaller
+       * values use fewer bits.
+       * @param[in] theValue to write
+       */
+      void writeUint(const Uint32 theValue);
+
+      /**
+       * WriteInt will append theValue provided using 6 to 34 bits, values
+       * closer to zero use fewer bits.
+       * @param[in] theValue to write
+       */
+      void writeInt(const Int32 theValue);
+
+      /**
+       * ReadBits will return the next theCount bits.
+       * @param[in] theCount of bits to read from 1 to 32
+       * @return the value read or 0 if there aren't enough bits left
+       */
+      Uint32 readBits(const Uint32 theCount);
+
+      /**
+       * ReadBool will return the next bit.
+       * @return the value read
+       */
+      bool readBool(void);
+
+      /**
+       * ReadUint will return the next value written by WriteUint.
+       * @return the value read
+       */
+      Uint32 readUint(void);
+
+      /**
+       * ReadInt will return the next value written by WriteInt.
+       * @return the value read
+       */
+      Int32 readInt(void);
+
+      /**
+       * IsValid will return false if a read went past the last bit.
+       * @return true if every read was valid, false otherwise
+       */
+      bool isValid(void) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Bytes holding the bits written, least significant bit first
+      std::vector<Uint8> mData;
+      /// Number of bits written
+      Uint32             mBitCount;
+      /// Number of bits read
+      Uint32             mReadCount;
+      /// True if a read went past the last bit
+      bool               mOverflow;
+  }; // class BitStream
+} // namespace AGE
+
+#endif // CORE_BIT_STREAM_HPP_INCLUDED
+
+/**
+ * @class AGE::BitStream
+ * @ingroup Core
+ * The BitStream class is used by the ReplicationManager to build snapshot
+ * packets. Values are not aligned to bytes so a flag costs 1 bit and a small
+ * delta costs 6 bits. WriteUint and WriteInt use a 2 bit prefix to select a
+ * 4, 8, 16 or 32 bit value, and WriteInt zigzag encodes so small negative
+ * values stay small. Reading past the end returns 0 and marks the stream
+ * invalid instead of failing, so a truncated or corrupt packet can be checked
+ * once with IsValid after it is decoded.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <AGE/Config.hpp>
 // CRC32 Table (zlib polynomial)
 static constexpr uint32_t crc_table[256] = {
    0x00000000L, 0x77073096L, 0xee0e612cL, 0x990951baL, 0x076dc419L,
@@ -58,15 +60,22 @@ static constexpr uint32_t crc_table[256] = {
    0x5d681b02L, 0x2a6f2b94L, 0xb40bbe37L, 0xc30c8ea1L, 0x5a05df1bL,
    0x2d02ef8dL};
 
+// Single step of the CRC32 calculation for one character
+constexpr uint32_t crc32_step(uint32_t crc, char c)
+{
+   return (crc >> 8) ^ crc_table[(crc ^ c) & 0x000000FF];
+}
+
+// Each level recurses only once so long names stay cheap to compile
    template<size_t idx>
 constexpr uint32_t crc32(const char * str)
 {
-   return (crc32<idx-1>(str) >> 8) ^ crc_table[(crc32<idx-1>(str) ^ str[idx]) & 0x000000FF];
+   return crc32_step(crc32<idx-1>(str), str[idx]);
 }
 
 // This is the stop-recursion function
    template<>
-constexpr uint32_t crc32<-1>(const char * str)
+constexpr uint32_t crc32<size_t(-1)>(const char * str)
 {
    return 0xFFFFFFFF;
 }
@@ -79,4 +88,19 @@ enum TestEnum
     Val_0 = ID("Val_0"),
 };
 
-#endif
\ No newline at end of file
+// Runtime version of ID() for strings only known at run time, the result
+// matches ID() for the same characters (slice-by-8 table implementation)
+uint32_t AGE_API crc32_runtime(const char * str, size_t len);
+
+// Runtime version of ID() for a null terminated string
+inline uint32_t crc32_runtime(const char * str)
+{
+   return crc32_runtime(str, strlen(str));
+}
+
+// Same as crc32_runtime but in debug builds also remembers the string for
+// each value returned and logs an error if two different strings produce
+// the same value, use it wherever a runtime string becomes a registered Id
+uint32_t AGE_API crc32_register(const char * str, size_t len);
+
+#endif
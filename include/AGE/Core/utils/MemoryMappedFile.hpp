@@ -0,0 +1,132 @@
+/**
+ * Provides the MemoryMappedFile class in the AGE namespace which is
+ * responsible for mapping the contents of a file read-only into memory.
+ *
+ * @file include/AGE/Core/utils/MemoryMappedFile.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Added GetModifiedTime for cache validation
+ */
+#ifndef   CORE_MEMORY_MAPPED_FILE_HPP_INCLUDED
+#define   CORE_MEMORY_MAPPED_FILE_HPP_INCLUDED
+
+#include <string>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a read-only memory mapping of an entire file
+  class AGE_API MemoryMappedFile
+  {
+    public:
+      /**
+       * MemoryMappedFile constructor
+       */
+      MemoryMappedFile();
+
+      /**
+       * MemoryMappedFile deconstructor will unmap the file if still open
+       */
+      virtual ~MemoryMappedFile();
+
+      /**
+       * Open will map the entire contents of theFilename provided into
+       * memory, closing any file previously opened.
+       * @param[in] theFilename to map into memory
+       * @return true if the file was opened and mapped, false otherwise
+       */
+      bool open(const std::string& theFilename);
+
+      /**
+       * Close will unmap the file previously opened.
+       */
+      void close(void);
+
+      /**
+       * IsOpen will return true if a file is currently mapped.
+       * @return true if a file is mapped, false otherwise
+       */
+      bool isOpen(void) const;
+
+      /**
+       * GetData will return a pointer to the mapped contents of the file.
+       * The contents are not null terminated.
+       * @return pointer to the file contents or NULL if empty or not open
+       */
+      const char* getData(void) const;
+
+      /**
+       * GetSize will return the number of bytes mapped.
+       * @return the size of the file in bytes
+       */
+      size_t getSize(void) const;
+
+      /**
+       * GetModifiedTime will return the last modification time of the file
+       * mapped in nanoseconds since an OS specific epoch, which is only
+       * useful for comparing against a previous value.
+       * @return the last modification time of the file
+       */
+      Int64 getModifiedTime(void) const;
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Pointer to the mapped contents of the file
+      const char* mData;
+      /// Number of bytes mapped
+      size_t      mSize;
+      /// Last modification time of the file in nanoseconds
+      Int64       mModified;
+      /// True if a file is currently open
+      bool        mOpen;
+#if defined(AGE_WINDOWS)
+      /// Windows file handle
+      void*       mFile;
+      /// Windows file mapping handle
+      void*       mMapping;
+#endif
+
+      /**
+       * MemoryMappedFile copy constructor is private because we do not allow
+       * copies of our class
+       */
+      MemoryMappedFile(const MemoryMappedFile&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      MemoryMappedFile& operator=(const MemoryMappedFile&); // Intentionally undefined
+  }; // class MemoryMappedFile
+} // namespace AGE
+
+#endif // CORE_MEMORY_MAPPED_FILE_HPP_INCLUDED
+
+/**
+ * @class AGE::MemoryMappedFile
+ * @ingroup Core
+ * The MemoryMappedFile class is used to read large data files (such as
+ * configuration files) without copying them through stdio buffers. It uses
+ * mmap on POSIX systems and CreateFileMapping/MapViewOfFile on Windows. An
+ * empty file is opened successfully with a NULL data pointer and a size of 0.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
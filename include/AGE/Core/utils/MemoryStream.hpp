@@ -0,0 +1,131 @@
+/**
+ * Provides the MemoryStream class in the AGE namespace which is responsible
+ * for providing an sf::InputStream over a memory mapped region of a file.
+ *
+ * @file include/AGE/Core/utils/MemoryStream.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_MEMORY_STREAM_HPP_INCLUDED
+#define   CORE_MEMORY_STREAM_HPP_INCLUDED
+
+#include <string>
+#include <SFML/System.hpp>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
+
+namespace AGE
+{
+  /// Provides an sf::InputStream over a memory mapped region of a file
+  class AGE_API MemoryStream : public sf::InputStream
+  {
+    public:
+      /**
+       * MemoryStream constructor
+       */
+      MemoryStream();
+
+      /**
+       * MemoryStream deconstructor will unmap the file if still open
+       */
+      virtual ~MemoryStream();
+
+      /**
+       * Open will map theFilename provided into memory and limit this stream
+       * to theSize bytes starting at theOffset (e.g. one file packed inside
+       * a bundled data file).
+       * @param[in] theFilename to map into memory
+       * @param[in] theOffset of the region in bytes
+       * @param[in] theSize of the region in bytes or 0 for the rest of the file
+       * @return true if the region was mapped, false otherwise
+       */
+      bool open(const std::string& theFilename, const Uint64 theOffset = 0,
+        const Uint64 theSize = 0);
+
+      /**
+       * Close will unmap the file previously opened.
+       */
+      void close(void);
+
+      /**
+       * Read will copy up to theSize bytes from the current position into
+       * theData provided.
+       * @param[out] theData to copy the bytes into
+       * @param[in] theSize is the maximum number of bytes to copy
+       * @return the number of bytes copied or -1 on error
+       */
+      virtual sf::Int64 read(void* theData, sf::Int64 theSize);
+
+      /**
+       * Seek will change the current position to thePosition provided.
+       * @param[in] thePosition from the start of the region
+       * @return the new position or -1 on error
+       */
+      virtual sf::Int64 seek(sf::Int64 thePosition);
+
+      /**
+       * Tell will return the current position.
+       * @return the current position or -1 on error
+       */
+      virtual sf::Int64 tell(void);
+
+      /**
+       * GetSize will return the size of the region.
+       * @return the size of the region or -1 on error
+       */
+      virtual sf::Int64 getSize(void);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The file mapped into memory
+      MemoryMappedFile mFile;
+      /// Start of the region within the mapped file
+      const char*      mData;
+      /// Size of the region in bytes
+      sf::Int64        mSize;
+      /// Current position within the region
+      sf::Int64        mPosition;
+
+      /**
+       * MemoryStream copy constructor is private because we do not allow
+       * copies of our class
+       */
+      MemoryStream(const MemoryStream&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      MemoryStream& operator=(const MemoryStream&); // Intentionally undefined
+  }; // class MemoryStream
+} // namespace AGE
+
+#endif // CORE_MEMORY_STREAM_HPP_INCLUDED
+
+/**
+ * @class AGE::MemoryStream
+ * @ingroup Core
+ * The MemoryStream class lets SFML stream compressed audio (or decode any
+ * other asset) straight out of a memory mapped file without copying it. The
+ * operating system pages the region in as it is read.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,206 @@
+/**
+ * Provides the ReadAheadStream class in the AGE namespace which is
+ * responsible for providing an sf::InputStream over a region of a file that
+ * is read in chunks ahead of time by a background thread.
+ *
+ * @file include/AGE/Core/utils/ReadAheadStream.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_READ_AHEAD_STREAM_HPP_INCLUDED
+#define   CORE_READ_AHEAD_STREAM_HPP_INCLUDED
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/System.hpp>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides an sf::InputStream that reads ahead on a background thread
+  class AGE_API ReadAheadStream : public sf::InputStream
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of bytes read from the file at a time
+      static const Uint32 CHUNK_SIZE = 65536;
+      /// Number of chunks kept in memory (the current chunk and the next)
+      static const Uint32 CHUNK_COUNT = 2;
+
+      /**
+       * ReadAheadStream constructor
+       */
+      ReadAheadStream();
+
+      /**
+       * ReadAheadStream deconstructor will stop the background thread and
+       * close the file if still open
+       */
+      virtual ~ReadAheadStream();
+
+      /**
+       * Open will open theFilename provided, limit this stream to theSize
+       * bytes starting at theOffset (e.g. one file packed inside a bundled
+       * data file) and start reading the first chunk in the background.
+       * @param[in] theFilename to open
+       * @param[in] theOffset of the region in bytes
+       * @param[in] theSize of the region in bytes or 0 for the rest of the file
+       * @return true if the file was opened, false otherwise
+       */
+      bool open(const std::string& theFilename, const Uint64 theOffset = 0,
+        const Uint64 theSize = 0);
+
+      /**
+       * Close will stop the background thread and close the file.
+       */
+      void close(void);
+
+      /**
+       * Read will copy up to theSize bytes from the current position into
+       * theData provided, only waiting for the background thread if the
+       * chunk needed hasn't been read yet.
+       * @param[out] theData to copy the bytes into
+       * @param[in] theSize is the maximum number of bytes to copy
+       * @return the number of bytes copied or -1 on error
+       */
+      virtual sf::Int64 read(void* theData, sf::Int64 theSize);
+
+      /**
+       * Seek will change the current position to thePosition provided and
+       * start reading the chunk for it in the background.
+       * @param[in] thePosition from the start of the region
+       * @return the new position or -1 on error
+       */
+      virtual sf::Int64 seek(sf::Int64 thePosition);
+
+      /**
+       * Tell will return the current position.
+       * @return the current position or -1 on error
+       */
+      virtual sf::Int64 tell(void);
+
+      /**
+       * GetSize will return the size of the region.
+       * @return the size of the region or -1 on error
+       */
+      virtual sf::Int64 getSize(void);
+
+      /**
+       * GetStalls will return the number of times Read had to wait for the
+       * background thread to read the chunk it needed.
+       * @return the number of stalls since Open was called
+       */
+      Uint32 getStalls(void) const;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// The states a chunk can be in
+      enum typeChunkState
+      {
+        ChunkEmpty,     ///< Chunk holds nothing useful
+        ChunkRequested, ///< Chunk is waiting for the background thread
+        ChunkFilling,   ///< Chunk is being read by the background thread
+        ChunkReady      ///< Chunk holds size bytes starting at start
+      };
+
+      /// Each chunk of the file kept in memory
+      struct typeChunk
+      {
+        std::vector<char> data;  ///< CHUNK_SIZE bytes of storage
+        sf::Int64         start; ///< Position of the first byte in the region
+        sf::Int64         size;  ///< Number of bytes read into data
+        typeChunkState    state; ///< Current state of this chunk
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The file being read, only used by the background thread once open
+      std::FILE*              mFile;
+      /// Offset of the region within the file
+      sf::Int64               mOffset;
+      /// Size of the region in bytes
+      sf::Int64               mSize;
+      /// Current position within the region
+      sf::Int64               mPosition;
+      /// Number of times Read had to wait for a chunk
+      Uint32                  mStalls;
+      /// True if the background thread should exit
+      bool                    mStopping;
+      /// The chunks kept in memory
+      typeChunk               mChunks[CHUNK_COUNT];
+      /// The background thread reading chunks
+      std::thread             mThread;
+      /// Mutex protecting everything above except the contents of Filling chunks
+      mutable std::mutex      mMutex;
+      /// Signaled when a chunk has been requested or we are stopping
+      std::condition_variable mWake;
+      /// Signaled when a chunk becomes ready
+      std::condition_variable mReady;
+
+      /**
+       * Run is the background thread which reads each chunk requested.
+       */
+      void run(void);
+
+      /**
+       * Request will ask the background thread to read the chunk starting at
+       * theStart provided unless it is already available or on its way. The
+       * chunk covering theKeep is never reused for the request.
+       * @param[in] theStart of the chunk (a multiple of CHUNK_SIZE)
+       * @param[in] theKeep is the position whose chunk must not be reused
+       * @return true if the chunk is available or on its way, false if every
+       *   other chunk is busy
+       */
+      bool request(const sf::Int64 theStart, const sf::Int64 theKeep);
+
+      /**
+       * ReadAheadStream copy constructor is private because we do not allow
+       * copies of our class
+       */
+      ReadAheadStream(const ReadAheadStream&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      ReadAheadStream& operator=(const ReadAheadStream&); // Intentionally undefined
+  }; // class ReadAheadStream
+} // namespace AGE
+
+#endif // CORE_READ_AHEAD_STREAM_HPP_INCLUDED
+
+/**
+ * @class AGE::ReadAheadStream
+ * @ingroup Core
+ * The ReadAheadStream class is used to stream large files (such as music)
+ * without the thread decoding them blocking on disk reads. The region is
+ * split into CHUNK_SIZE chunks; whenever Read starts using a chunk the next
+ * one is requested from a background thread, so by the time the decoder
+ * reaches it the bytes are normally already in memory. The background thread
+ * never holds the mutex while it reads from the file.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
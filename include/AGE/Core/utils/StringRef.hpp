@@ -0,0 +1,172 @@
+/**
+ * Provides the StringRef class in the AGE namespace which is a non-owning
+ * reference to a sequence of characters (a C++11 stand-in for string_view).
+ *
+ * @file include/AGE/Core/utils/StringRef.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_STRING_REF_HPP_INCLUDED
+#define   CORE_STRING_REF_HPP_INCLUDED
+
+#include <cstring>
+#include <string>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a non-owning pointer and length reference to characters
+  class StringRef
+  {
+    public:
+      /**
+       * StringRef default constructor will reference an empty string.
+       */
+      StringRef() :
+        mData(""),
+        mSize(0)
+      {
+      }
+
+      /**
+       * StringRef constructor will reference theSize characters at theData.
+       * @param[in] theData to reference
+       * @param[in] theSize number of characters to reference
+       */
+      StringRef(const char* theData, size_t theSize) :
+        mData(theData),
+        mSize(theSize)
+      {
+      }
+
+      /**
+       * StringRef constructor will reference the null terminated theString.
+       * @param[in] theString to reference
+       */
+      StringRef(const char* theString) :
+        mData(theString),
+        mSize(strlen(theString))
+      {
+      }
+
+      /**
+       * StringRef constructor will reference the characters of theString
+       * which must outlive this StringRef.
+       * @param[in] theString to reference
+       */
+      StringRef(const std::string& theString) :
+        mData(theString.data()),
+        mSize(theString.size())
+      {
+      }
+
+      /**
+       * Data will return a pointer to the first character referenced which
+       * is not necessarily null terminated.
+       * @return pointer to the first character
+       */
+      const char* data(void) const
+      {
+        return mData;
+      }
+
+      /**
+       * Size will return the number of characters referenced.
+       * @return the number of characters
+       */
+      size_t size(void) const
+      {
+        return mSize;
+      }
+
+      /**
+       * Empty will return true if no characters are referenced.
+       * @return true if size is 0, false otherwise
+       */
+      bool empty(void) const
+      {
+        return 0 == mSize;
+      }
+
+      /**
+       * Index operator will return the character at theIndex provided.
+       * @param[in] theIndex of the character to return (must be < size)
+       * @return the character at theIndex
+       */
+      char operator[](size_t theIndex) const
+      {
+        return mData[theIndex];
+      }
+
+      /**
+       * Str will return a copy of the characters referenced.
+       * @return a new std::string with the characters referenced
+       */
+      std::string str(void) const
+      {
+        return std::string(mData, mSize);
+      }
+
+      /**
+       * Equal operator will return true if theRight references the same
+       * sequence of characters.
+       * @param[in] theRight to compare against
+       * @return true if both reference equal characters, false otherwise
+       */
+      bool operator==(const StringRef& theRight) const
+      {
+        return mSize == theRight.mSize &&
+          (0 == mSize || 0 == memcmp(mData, theRight.mData, mSize));
+      }
+
+      /**
+       * Not equal operator will return true if theRight references a
+       * different sequence of characters.
+       * @param[in] theRight to compare against
+       * @return true if the characters differ, false otherwise
+       */
+      bool operator!=(const StringRef& theRight) const
+      {
+        return !(*this == theRight);
+      }
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Pointer to the first character referenced
+      const char* mData;
+      /// Number of characters referenced
+      size_t      mSize;
+  }; // class StringRef
+} // namespace AGE
+
+#endif // CORE_STRING_REF_HPP_INCLUDED
+
+/**
+ * @class AGE::StringRef
+ * @ingroup Core
+ * The StringRef class is used by the ConfigReader tokenizer and the string
+ * parsing functions to refer to a range of characters inside a larger buffer
+ * (such as a memory mapped file) without copying them into a std::string.
+ * A StringRef never owns its characters, so the buffer it refers to must
+ * outlive it.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
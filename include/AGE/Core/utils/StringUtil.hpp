@@ -8,12 +8,14 @@
  * @date 20110906 - Moved Util.hpp from Entities to here
  * @date 20120720 - Added several new Convert and Parse functions
  * @date 20120904 - Fix SFML v1.6 issues with Vector2u
+ * @date 20261018 - Locale-free parse/format methods using StringRef
  */
 #ifndef   CORE_STRING_UTIL_HPP_INCLUDED
 #define   CORE_STRING_UTIL_HPP_INCLUDED
 
 #include <string>
 #include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
 #include <SFML/Graphics.hpp>
 
 // Define Vector2u here since it was not defined for SFML 1.6
@@ -26,6 +28,38 @@ namespace sf
 
 namespace AGE
 {
+  /// Minimum size of the buffer provided to the Format methods below
+  const size_t FORMAT_BUFFER_SIZE = 32;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // String Format Methods
+  ///////////////////////////////////////////////////////////////////////////
+  /**
+   * FormatDouble will write theNumber provided into theBuffer using 6
+   * significant digits (like std::ostream) and a '.' decimal point
+   * regardless of the current locale.
+   * @param[out] theBuffer of at least FORMAT_BUFFER_SIZE characters
+   * @param[in] theNumber to write
+   * @return the number of characters written (not counting the null)
+   */
+  size_t AGE_API formatDouble(char* theBuffer, const double theNumber);
+
+  /**
+   * FormatInt64 will write theNumber provided into theBuffer.
+   * @param[out] theBuffer of at least FORMAT_BUFFER_SIZE characters
+   * @param[in] theNumber to write
+   * @return the number of characters written (not counting the null)
+   */
+  size_t AGE_API formatInt64(char* theBuffer, const Int64 theNumber);
+
+  /**
+   * FormatUint64 will write theNumber provided into theBuffer.
+   * @param[out] theBuffer of at least FORMAT_BUFFER_SIZE characters
+   * @param[in] theNumber to write
+   * @return the number of characters written (not counting the null)
+   */
+  size_t AGE_API formatUint64(char* theBuffer, const Uint64 theNumber);
+
   ///////////////////////////////////////////////////////////////////////////
   // String Manipulation Methods
   ///////////////////////////////////////////////////////////////////////////
@@ -163,6 +197,49 @@ namespace AGE
    */
   std::string AGE_API convertVector3i(const sf::Vector3i theVector);
 
+  ///////////////////////////////////////////////////////////////////////////
+  // String Scan Methods
+  ///////////////////////////////////////////////////////////////////////////
+  /**
+   * ScanBool will compare theValue (ignoring case) against true/1/on and
+   * false/0/off and store the matching value in theResult.
+   * @param[in] theValue to scan
+   * @param[out] theResult to store the value found
+   * @return true if theValue matched one of the above, false otherwise
+   */
+  bool AGE_API scanBool(const StringRef theValue, bool& theResult);
+
+  /**
+   * ScanDouble will skip any leading whitespace and parse the decimal
+   * number (with optional sign, fraction and exponent) at the start of
+   * theValue using a '.' decimal point regardless of the current locale.
+   * Any characters following the number are ignored.
+   * @param[in] theValue to scan
+   * @param[out] theResult to store the value found
+   * @return true if a number was found and in range, false otherwise
+   */
+  bool AGE_API scanDouble(const StringRef theValue, double& theResult);
+
+  /**
+   * ScanInt64 will skip any leading whitespace and parse the signed decimal
+   * integer at the start of theValue. Any characters following the number
+   * are ignored.
+   * @param[in] theValue to scan
+   * @param[out] theResult to store the value found
+   * @return true if a number was found and in range, false otherwise
+   */
+  bool AGE_API scanInt64(const StringRef theValue, Int64& theResult);
+
+  /**
+   * ScanUint64 will skip any leading whitespace and parse the unsigned
+   * decimal integer at the start of theValue. Any characters following the
+   * number are ignored.
+   * @param[in] theValue to scan
+   * @param[out] theResult to store the value found
+   * @return true if a number was found and in range, false otherwise
+   */
+  bool AGE_API scanUint64(const StringRef theValue, Uint64& theResult);
+
   ///////////////////////////////////////////////////////////////////////////
   // String Parse Methods
   ///////////////////////////////////////////////////////////////////////////
@@ -174,7 +251,7 @@ namespace AGE
    * @param[in] theDefault value to return if not one of the above
    * @return the boolean value obtained
    */
-  bool AGE_API parseBool(std::string theValue, const bool theDefault);
+  bool AGE_API parseBool(const StringRef theValue, const bool theDefault);
 
   /**
    * ParseColor will parse theValue string to obtain the R,G,B,A color values
@@ -183,7 +260,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Color AGE_API parseColor(const std::string theValue, const sf::Color theDefault);
+  sf::Color AGE_API parseColor(const StringRef theValue, const sf::Color theDefault);
 
   /**
    * ParseDouble will parse theValue string to obtain the double value to
@@ -192,7 +269,7 @@ namespace AGE
    * @param[in] theDefault float value to use if the parser fails
    * @return the float value obtained or theDefault if not parsed
    */
-  double AGE_API parseDouble(const std::string theValue, const double theDefault);
+  double AGE_API parseDouble(const StringRef theValue, const double theDefault);
 
   /**
    * ParseFloat will parse theValue string to obtain the float value to
@@ -201,7 +278,7 @@ namespace AGE
    * @param[in] theDefault float value to use if the parser fails
    * @return the float value obtained or theDefault if not parsed
    */
-  float AGE_API parseFloat(const std::string theValue, const float theDefault);
+  float AGE_API parseFloat(const StringRef theValue, const float theDefault);
 
   /**
    * ParseInt8 will parse theValue string to obtain a signed 8 bit value.
@@ -210,7 +287,7 @@ namespace AGE
    * @param[in] theDefault signed 8 bit value to use if the parser fails
    * @return the signed 8 bit value obtained
    */
-  Int8 AGE_API parseInt8(const std::string theValue, const Int8 theDefault);
+  Int8 AGE_API parseInt8(const StringRef theValue, const Int8 theDefault);
 
   /**
    * ParseInt16 will parse theValue string to obtain a signed 16 bit value.
@@ -219,7 +296,7 @@ namespace AGE
    * @param[in] theDefault signed 16 bit value to use if the parser fails
    * @return the signed 16 bit value obtained
    */
-  Int16 AGE_API parseInt16(const std::string theValue, const Int16 theDefault);
+  Int16 AGE_API parseInt16(const StringRef theValue, const Int16 theDefault);
 
   /**
    * ParseInt32 will parse theValue string to obtain a signed 32 bit value.
@@ -228,7 +305,7 @@ namespace AGE
    * @param[in] theDefault signed 32 bit value to use if the parser fails
    * @return the signed 32 bit value obtained
    */
-  Int32 AGE_API parseInt32(const std::string theValue, const Int32 theDefault);
+  Int32 AGE_API parseInt32(const StringRef theValue, const Int32 theDefault);
 
   /**
    * ParseInt64 will parse theValue string to obtain a signed 64 bit value.
@@ -237,7 +314,7 @@ namespace AGE
    * @param[in] theDefault signed 64 bit value to use if the parser fails
    * @return the signed 64 bit value obtained
    */
-  Int64 AGE_API parseInt64(const std::string theValue, const Int64 theDefault);
+  Int64 AGE_API parseInt64(const StringRef theValue, const Int64 theDefault);
 
   /**
    * ParseIntRect will parse theValue string to obtain a sf::IntRect value.
@@ -246,7 +323,7 @@ namespace AGE
    * @param[in] theDefault sf::IntRect value to use if the parser fails
    * @return the sf::IntRect value obtained
    */
-  sf::IntRect AGE_API parseIntRect(const std::string theValue, const sf::IntRect theDefault);
+  sf::IntRect AGE_API parseIntRect(const StringRef theValue, const sf::IntRect theDefault);
 
   /**
    * ParseUint8 will parse theValue string to obtain a signed 8 bit value.
@@ -255,7 +332,7 @@ namespace AGE
    * @param[in] theDefault signed 8 bit value to use if the parser fails
    * @return the signed 8 bit value obtained
    */
-  Uint8 AGE_API parseUint8(const std::string theValue, const Uint8 theDefault);
+  Uint8 AGE_API parseUint8(const StringRef theValue, const Uint8 theDefault);
 
   /**
    * ParseUint16 will parse theValue string to obtain an unsigned 16 bit
@@ -264,7 +341,7 @@ namespace AGE
    * @param[in] theDefault unsigned 16 bit value to use if the parser fails
    * @return the unsigned 16 bit value obtained
    */
-  Uint16 AGE_API parseUint16(const std::string theValue, const Uint16 theDefault);
+  Uint16 AGE_API parseUint16(const StringRef theValue, const Uint16 theDefault);
 
   /**
    * ParseUint32 will parse theValue string to obtain an unsigned 32 bit
@@ -273,7 +350,7 @@ namespace AGE
    * @param[in] theDefault unsigned 32 bit value to use if the parser fails
    * @return the unsigned 32 bit value obtained
    */
-  Uint32 AGE_API parseUint32(const std::string theValue, const Uint32 theDefault);
+  Uint32 AGE_API parseUint32(const StringRef theValue, const Uint32 theDefault);
 
   /**
    * ParseUint64 will parse theValue string to obtain an unsigned 64 bit
@@ -282,7 +359,7 @@ namespace AGE
    * @param[in] theDefault unsigned 64 bit value to use if the parser fails
    * @return the unsigned 64 bit value obtained
    */
-  Uint64 AGE_API parseUint64(const std::string theValue, const Uint64 theDefault);
+  Uint64 AGE_API parseUint64(const StringRef theValue, const Uint64 theDefault);
 
   /**
    * ParseVector2f will parse theValue string to obtain the X,Y vector values
@@ -291,7 +368,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Vector2f AGE_API parseVector2f(const std::string theValue, const sf::Vector2f theDefault);
+  sf::Vector2f AGE_API parseVector2f(const StringRef theValue, const sf::Vector2f theDefault);
 
   /**
    * ParseVector2i will parse theValue string to obtain the X,Y vector values
@@ -300,7 +377,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Vector2i AGE_API parseVector2i(const std::string theValue, const sf::Vector2i theDefault);
+  sf::Vector2i AGE_API parseVector2i(const StringRef theValue, const sf::Vector2i theDefault);
 
   /**
    * ParseVector2u will parse theValue string to obtain the X,Y vector values
@@ -309,7 +386,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Vector2u AGE_API parseVector2u(const std::string theValue, const sf::Vector2u theDefault);
+  sf::Vector2u AGE_API parseVector2u(const StringRef theValue, const sf::Vector2u theDefault);
 
   /**
    * ParseVector3f will parse theValue string to obtain the X,Y,Z vector values
@@ -318,7 +395,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Vector3f AGE_API parseVector3f(const std::string theValue, const sf::Vector3f theDefault);
+  sf::Vector3f AGE_API parseVector3f(const StringRef theValue, const sf::Vector3f theDefault);
 
   /**
    * ParseVector3i will parse theValue string to obtain the X,Y,Z vector values
@@ -327,7 +404,7 @@ namespace AGE
    * @param[in] theDefault color to use if the parser fails
    * @return the color object created with the values obtained
    */
-  sf::Vector3i AGE_API parseVector3i(const std::string theValue, const sf::Vector3i theDefault);
+  sf::Vector3i AGE_API parseVector3i(const StringRef theValue, const sf::Vector3i theDefault);
 
 } // namespace AGE
 
@@ -338,6 +415,12 @@ namespace AGE
  * be used by any class in the AGE namespace.  The ConfigReader class in
  * particular makes frequent use of these methods.
  *
+ * None of these methods allocate (except for the std::string returned by the
+ * Convert methods) or depend on the current locale: the Parse methods scan
+ * the characters referenced by theValue in place (so std::string, const
+ * char* and sub-ranges of a larger buffer can all be parsed) and return
+ * theDefault if no number is found or the number does not fit the type.
+ *
  * Copyright (c) 2010-2011 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
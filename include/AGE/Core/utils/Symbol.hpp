@@ -0,0 +1,198 @@
+/**
+ * Provides the Symbol class in the AGE namespace which is a 32 bit handle to
+ * a string interned in the StringPool.
+ *
+ * @file include/AGE/Core/utils/Symbol.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_SYMBOL_HPP_INCLUDED
+#define   CORE_SYMBOL_HPP_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <AGE/Core/Core_types.hpp>
+#include <AGE/Core/classes/StringPool.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
+
+namespace AGE
+{
+  /// Provides an interned string with O(1) copies, compares and hashes
+  class Symbol
+  {
+    public:
+      /**
+       * Symbol default constructor will refer to the empty string.
+       */
+      Symbol() :
+        mHandle(StringPool::EMPTY_HANDLE)
+      {
+      }
+
+      /**
+       * Symbol constructor will intern the null terminated theString.
+       * @param[in] theString to intern
+       */
+      Symbol(const char* theString) :
+        mHandle(StringPool::getInstance().intern(StringRef(theString)))
+      {
+      }
+
+      /**
+       * Symbol constructor will intern theString provided.
+       * @param[in] theString to intern
+       */
+      Symbol(const std::string& theString) :
+        mHandle(StringPool::getInstance().intern(StringRef(theString)))
+      {
+      }
+
+      /**
+       * Symbol constructor will intern the characters referenced by
+       * theString provided.
+       * @param[in] theString to intern
+       */
+      explicit Symbol(const StringRef theString) :
+        mHandle(StringPool::getInstance().intern(theString))
+      {
+      }
+
+      /**
+       * Str will return the interned string which remains valid until the
+       * application exits.
+       * @return the interned string
+       */
+      const std::string& str(void) const
+      {
+        return StringPool::getInstance().getString(mHandle);
+      }
+
+      /**
+       * C_str will return the null terminated interned string.
+       * @return pointer to the interned characters
+       */
+      const char* c_str(void) const
+      {
+        return str().c_str();
+      }
+
+      /**
+       * Size will return the number of characters in the interned string.
+       * @return the number of characters
+       */
+      size_t size(void) const
+      {
+        return str().size();
+      }
+
+      /**
+       * Empty will return true if this Symbol refers to the empty string.
+       * @return true if empty, false otherwise
+       */
+      bool empty(void) const
+      {
+        return StringPool::EMPTY_HANDLE == mHandle;
+      }
+
+      /**
+       * GetHandle will return the StringPool handle for this Symbol which is
+       * unique for each different string.
+       * @return the StringPool handle
+       */
+      Uint32 getHandle(void) const
+      {
+        return mHandle;
+      }
+
+      /**
+       * GetHash will return the CRC32 of the interned string which matches
+       * ID() for the same characters.
+       * @return the CRC32 of the interned string
+       */
+      Id getHash(void) const
+      {
+        return StringPool::getInstance().getHash(mHandle);
+      }
+
+      /**
+       * Equal operator will return true if theRight refers to the same string.
+       * @param[in] theRight to compare against
+       * @return true if both refer to the same string, false otherwise
+       */
+      bool operator==(const Symbol& theRight) const
+      {
+        return mHandle == theRight.mHandle;
+      }
+
+      /**
+       * Not equal operator will return true if theRight refers to a
+       * different string.
+       * @param[in] theRight to compare against
+       * @return true if they refer to different strings, false otherwise
+       */
+      bool operator!=(const Symbol& theRight) const
+      {
+        return mHandle != theRight.mHandle;
+      }
+
+      /**
+       * Less than operator orders Symbols by handle (the order they were
+       * first interned in) so they can be used as std::map keys.
+       * @param[in] theRight to compare against
+       * @return true if this handle is less than theRight handle
+       */
+      bool operator<(const Symbol& theRight) const
+      {
+        return mHandle < theRight.mHandle;
+      }
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Handle of the string in the StringPool
+      Uint32 mHandle;
+  }; // class Symbol
+
+  /**
+   * Stream output operator will write the interned string of theSymbol.
+   * @param[in] theStream to write to
+   * @param[in] theSymbol to write
+   * @return theStream provided
+   */
+  inline std::ostream& operator<<(std::ostream& theStream, const Symbol& theSymbol)
+  {
+    return theStream << theSymbol.str();
+  }
+} // namespace AGE
+
+#endif // CORE_SYMBOL_HPP_INCLUDED
+
+/**
+ * @class AGE::Symbol
+ * @ingroup Core
+ * The Symbol class is used for asset IDs (see assetID) and filenames so they
+ * are stored once in the StringPool. Copying, comparing and hashing a Symbol
+ * only touch its 32 bit handle; only constructing one from a string takes
+ * the StringPool lock and hashes the characters. Symbols can be implicitly
+ * constructed from std::string and string literals so existing code that
+ * passes strings as asset IDs keeps working.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
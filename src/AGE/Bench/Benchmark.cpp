@@ -0,0 +1,203 @@
+/**
+ * Provides the Benchmark class in the AGE namespace which is responsible for
+ * running registered benchmark functions with warm-up and repetitions and
+ * writing the results as machine-readable JSON.
+ *
+ * @file src/AGE/Bench/Benchmark.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <SFML/System.hpp>
+#include "Benchmark.hpp"
+
+namespace AGE
+{
+  /// Global sink written by benchmarks so results are not optimized away
+  volatile Uint32 gBenchSink = 0;
+
+  Benchmark::Benchmark() :
+    mFilter(),
+    mWarmup(DEFAULT_WARMUP),
+    mRepetitions(DEFAULT_REPETITIONS),
+    mMinTime(DEFAULT_MIN_TIME * 1000)
+  {
+  }
+
+  void Benchmark::add(const std::string theName, typeRunFunc theRunFunc,
+      typeFixtureFunc theSetUp, typeFixtureFunc theTearDown)
+  {
+    typeBenchmark anBenchmark;
+    anBenchmark.name = theName;
+    anBenchmark.run = theRunFunc;
+    anBenchmark.setUp = theSetUp;
+    anBenchmark.tearDown = theTearDown;
+    anBenchmark.measured = false;
+    anBenchmark.iterations = 0;
+    anBenchmark.mean = 0.0;
+    anBenchmark.stddev = 0.0;
+    anBenchmark.min = 0.0;
+    anBenchmark.max = 0.0;
+    anBenchmark.median = 0.0;
+    mBenchmarks.push_back(anBenchmark);
+  }
+
+  void Benchmark::setFilter(const std::string theFilter)
+  {
+    mFilter = theFilter;
+  }
+
+  void Benchmark::setWarmup(Uint32 theWarmup)
+  {
+    mWarmup = theWarmup;
+  }
+
+  void Benchmark::setRepetitions(Uint32 theRepetitions)
+  {
+    mRepetitions = theRepetitions < 1 ? 1 : theRepetitions;
+  }
+
+  void Benchmark::setMinTime(Uint32 theMinTime)
+  {
+    mMinTime = (Int64)theMinTime * 1000;
+  }
+
+  Uint32 Benchmark::run(void)
+  {
+    Uint32 anResult = 0;
+
+    std::vector<typeBenchmark>::iterator iter;
+    for(iter = mBenchmarks.begin(); iter != mBenchmarks.end(); ++iter)
+    {
+      // Skip any benchmark that doesn't match our filter
+      if(false == mFilter.empty() && std::string::npos == iter->name.find(mFilter))
+      {
+        continue;
+      }
+
+      // Prepare the fixture for this benchmark
+      if(NULL != iter->setUp)
+      {
+        iter->setUp();
+      }
+
+      // Calibrate the number of iterations to meet our minimum time
+      Uint32 anIterations = 1;
+      Int64 anElapsed = timeRun(iter->run, anIterations);
+      while(anElapsed < mMinTime && anIterations < 0x40000000)
+      {
+        // Grow by the missing ratio, but at least double and at most 10x
+        Uint64 anNext = anElapsed <= 0 ? (Uint64)anIterations * 10 :
+          (Uint64)((double)anIterations * (double)mMinTime / (double)anElapsed * 1.2);
+        anNext = std::max(anNext, (Uint64)anIterations * 2);
+        anNext = std::min(anNext, (Uint64)anIterations * 10);
+        anIterations = (Uint32)std::min(anNext, (Uint64)0x40000000);
+        anElapsed = timeRun(iter->run, anIterations);
+      }
+
+      // Run our warm-up repetitions and discard the results
+      for(Uint32 iloop = 0; iloop < mWarmup; iloop++)
+      {
+        timeRun(iter->run, anIterations);
+      }
+
+      // Run our measured repetitions
+      std::vector<double> anSamples;
+      for(Uint32 iloop = 0; iloop < mRepetitions; iloop++)
+      {
+        anSamples.push_back((double)timeRun(iter->run, anIterations) * 1000.0 /
+            (double)anIterations);
+      }
+
+      // Release the fixture for this benchmark
+      if(NULL != iter->tearDown)
+      {
+        iter->tearDown();
+      }
+
+      // Compute the statistics of our measured repetitions
+      double anSum = 0.0;
+      for(size_t iloop = 0; iloop < anSamples.size(); iloop++)
+      {
+        anSum += anSamples[iloop];
+      }
+      iter->mean = anSum / anSamples.size();
+      double anVariance = 0.0;
+      for(size_t iloop = 0; iloop < anSamples.size(); iloop++)
+      {
+        anVariance += (anSamples[iloop] - iter->mean) * (anSamples[iloop] - iter->mean);
+      }
+      iter->stddev = anSamples.size() > 1 ? std::sqrt(anVariance / (anSamples.size() - 1)) : 0.0;
+      std::sort(anSamples.begin(), anSamples.end());
+      iter->min = anSamples.front();
+      iter->max = anSamples.back();
+      iter->median = anSamples.size() % 2 == 1 ? anSamples[anSamples.size() / 2] :
+        (anSamples[anSamples.size() / 2 - 1] + anSamples[anSamples.size() / 2]) / 2.0;
+      iter->iterations = anIterations;
+      iter->measured = true;
+
+      fprintf(stderr, "%-48s %12.1f ns/op (+/- %.1f) x %u\n", iter->name.c_str(),
+          iter->mean, iter->stddev, anIterations);
+
+      anResult++;
+    }
+
+    // Return the number of benchmarks run
+    return anResult;
+  }
+
+  void Benchmark::writeJSON(FILE* theFile) const
+  {
+    fprintf(theFile, "{\n  \"version\": \"%d.%d\",\n  \"warmup\": %u,\n"
+        "  \"repetitions\": %u,\n  \"min_time_ms\": %lld,\n  \"benchmarks\": [",
+        AGE_VERSION_MAJOR, AGE_VERSION_MINOR, mWarmup, mRepetitions,
+        (long long)(mMinTime / 1000));
+
+    bool anFirst = true;
+    std::vector<typeBenchmark>::const_iterator iter;
+    for(iter = mBenchmarks.begin(); iter != mBenchmarks.end(); ++iter)
+    {
+      if(false == iter->measured)
+      {
+        continue;
+      }
+      fprintf(theFile, "%s\n    {\"name\": \"%s\", \"iterations\": %u, "
+          "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"median_ns\": %.3f, "
+          "\"min_ns\": %.3f, \"max_ns\": %.3f}", anFirst ? "" : ",",
+          iter->name.c_str(), iter->iterations, iter->mean, iter->stddev,
+          iter->median, iter->min, iter->max);
+      anFirst = false;
+    }
+    fprintf(theFile, "\n  ]\n}\n");
+  }
+
+  Int64 Benchmark::timeRun(typeRunFunc theRunFunc, Uint32 theIterations)
+  {
+    sf::Clock anClock;
+    theRunFunc(theIterations);
+    return anClock.getElapsedTime().asMicroseconds();
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,171 @@
+/**
+ * Provides the Benchmark class in the AGE namespace which is responsible for
+ * running registered benchmark functions with warm-up and repetitions and
+ * writing the results as machine-readable JSON.
+ *
+ * @file src/AGE/Bench/Benchmark.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   BENCH_BENCHMARK_HPP_INCLUDED
+#define   BENCH_BENCHMARK_HPP_INCLUDED
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <AGE/Core/Core_types.hpp>
+
+namespace AGE
+{
+  /// Provides a minimal benchmark runner with JSON output
+  class Benchmark
+  {
+    public:
+      /// Function that runs theIterations of a benchmark
+      typedef void (*typeRunFunc)(Uint32 theIterations);
+      /// Function that prepares or releases the fixture of a benchmark
+      typedef void (*typeFixtureFunc)(void);
+
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Default number of warm-up repetitions that are not measured
+      static const Uint32 DEFAULT_WARMUP = 2;
+      /// Default number of measured repetitions
+      static const Uint32 DEFAULT_REPETITIONS = 10;
+      /// Default minimum time in milliseconds for each repetition
+      static const Uint32 DEFAULT_MIN_TIME = 20;
+
+      /**
+       * Benchmark constructor
+       */
+      Benchmark();
+
+      /**
+       * Add will register theRunFunc benchmark under theName provided.
+       * @param[in] theName of the benchmark ("Group/Case" style)
+       * @param[in] theRunFunc to call with the number of iterations to run
+       * @param[in] theSetUp is called once before the benchmark is run
+       * @param[in] theTearDown is called once after the benchmark is run
+       */
+      void add(const std::string theName, typeRunFunc theRunFunc,
+          typeFixtureFunc theSetUp = NULL, typeFixtureFunc theTearDown = NULL);
+
+      /**
+       * SetFilter will only run benchmarks whose name contains theFilter.
+       * @param[in] theFilter substring to match or empty to run all
+       */
+      void setFilter(const std::string theFilter);
+
+      /**
+       * SetWarmup will set the number of unmeasured warm-up repetitions.
+       * @param[in] theWarmup number of repetitions
+       */
+      void setWarmup(Uint32 theWarmup);
+
+      /**
+       * SetRepetitions will set the number of measured repetitions.
+       * @param[in] theRepetitions number of repetitions (at least 1)
+       */
+      void setRepetitions(Uint32 theRepetitions);
+
+      /**
+       * SetMinTime will set the minimum time of each repetition which is
+       * used to calibrate the number of iterations per repetition.
+       * @param[in] theMinTime in milliseconds
+       */
+      void setMinTime(Uint32 theMinTime);
+
+      /**
+       * Run will calibrate, warm-up and measure every benchmark registered
+       * that matches the filter, printing a summary line for each.
+       * @return the number of benchmarks run
+       */
+      Uint32 run(void);
+
+      /**
+       * WriteJSON will write the results of the last Run to theFile.
+       * @param[in] theFile to write the results to
+       */
+      void writeJSON(FILE* theFile) const;
+
+    private:
+      /// Registered benchmark and its results
+      struct typeBenchmark
+      {
+        std::string     name;        ///< Name of the benchmark
+        typeRunFunc     run;         ///< Function to run the iterations
+        typeFixtureFunc setUp;       ///< Function to prepare the fixture
+        typeFixtureFunc tearDown;    ///< Function to release the fixture
+        bool            measured;    ///< Was this benchmark run?
+        Uint32          iterations;  ///< Iterations in each repetition
+        double          mean;        ///< Mean nanoseconds per iteration
+        double          stddev;      ///< Standard deviation of the repetitions
+        double          min;         ///< Fastest repetition per iteration
+        double          max;         ///< Slowest repetition per iteration
+        double          median;      ///< Median repetition per iteration
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Every benchmark registered
+      std::vector<typeBenchmark> mBenchmarks;
+      /// Only run benchmarks whose name contains this filter
+      std::string                mFilter;
+      /// Number of unmeasured warm-up repetitions
+      Uint32                     mWarmup;
+      /// Number of measured repetitions
+      Uint32                     mRepetitions;
+      /// Minimum time in microseconds for each repetition
+      Int64                      mMinTime;
+
+      /**
+       * TimeRun will return the number of microseconds taken to call
+       * theRunFunc with theIterations provided.
+       * @param[in] theRunFunc to call
+       * @param[in] theIterations to pass to theRunFunc
+       * @return the elapsed time in microseconds
+       */
+      static Int64 timeRun(typeRunFunc theRunFunc, Uint32 theIterations);
+  }; // class Benchmark
+
+  /// Global sink written by benchmarks so results are not optimized away
+  extern volatile Uint32 gBenchSink;
+
+  /**
+   * RegisterCoreBenchmarks will add every AGE Core benchmark to theBenchmark.
+   * @param[in] theBenchmark to add the benchmarks to
+   */
+  void registerCoreBenchmarks(Benchmark& theBenchmark);
+} // namespace AGE
+
+#endif // BENCH_BENCHMARK_HPP_INCLUDED
+
+/**
+ * @class AGE::Benchmark
+ * @ingroup Bench
+ * The Benchmark class is used by the age-bench program to measure the AGE
+ * Core subsystems without opening a window. The number of iterations for
+ * each benchmark is calibrated so each repetition takes at least the
+ * minimum time, then warm-up repetitions are run and discarded before the
+ * measured repetitions are used to compute the mean, standard deviation,
+ * median, min and max time per iteration in nanoseconds.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,561 @@
+/**
+ * Provides the AGE Core benchmarks run by the age-bench program which
+ * exercise the asset handlers, config reader, string utilities, property
+ * and event managers, state manager and loggers without opening a window.
+ *
+ * @file src/AGE/Bench/CoreBenchmarks.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add ConfigReader::getUint32 ID lookup benchmark
+ * @date 20261018 - Add StringUtil compound parse and format benchmarks
+ * @date 20261018 - Add CRC32 throughput and uncached ConfigReader benchmarks
+ * @date 20261018 - Add Symbol interning benchmark
+ * @date 20261018 - Add AssetManager::getHandler benchmark
+ * @date 20261018 - Add lock free TAssetHandler::addData benchmark
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <AGE/Core/assets/ConfigHandler.hpp>
+#include <AGE/Core/assets/FontHandler.hpp>
+#include <AGE/Core/assets/MusicHandler.hpp>
+#include <AGE/Core/assets/SoundHandler.hpp>
+#include <AGE/Core/classes/AssetManager.hpp>
+#include <AGE/Core/classes/ConfigReader.hpp>
+#include <AGE/Core/classes/EventManager.hpp>
+#include <AGE/Core/classes/PropertyManager.hpp>
+#include <AGE/Core/classes/StateManager.hpp>
+#include <AGE/Core/interfaces/Game.hpp>
+#include <AGE/Core/interfaces/IState.hpp>
+#include <AGE/Core/loggers/FileLogger.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/loggers/StringLogger.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+#include <AGE/Core/utils/StringUtil.hpp>
+#include <AGE/Core/utils/Symbol.hpp>
+#include "Benchmark.hpp"
+
+namespace AGE
+{
+  /// Number of assets, config keys, properties and events in each fixture
+  static const Uint32 FIXTURE_SIZE = 256;
+  /// Temporary config file written by the ConfigReader fixture
+  static const char* BENCH_CONFIG = "age-bench.cfg";
+  /// Temporary log file written by the FileLogger fixture
+  static const char* BENCH_LOG = "age-bench.log";
+  /// Size of the buffer hashed by the largest CRC32 benchmark
+  static const Uint32 CRC32_DATA_SIZE = 65536;
+
+  /// Game used by the StateManager benchmark (no window is ever created)
+  class BenchGame : public Game
+  {
+    public:
+      BenchGame() : Game("age-bench") {}
+    protected:
+      virtual void initAssetHandlers(void) {}
+      virtual void initScreenFactory(void) {}
+      virtual void handleCleanup(void) {}
+  }; // class BenchGame
+
+  /// State used by the StateManager benchmark
+  class BenchState : public IState
+  {
+    public:
+      BenchState(const Id theStateID, Game& theApp) : IState(theStateID, theApp) {}
+      virtual void reInit(void) {}
+      virtual void updateVariable(float theElapsedTime) {}
+      virtual void draw(void) {}
+    protected:
+      virtual void handleCleanup(void) {}
+  }; // class BenchState
+
+  /// Target class used by the EventManager benchmark
+  class BenchTarget
+  {
+    public:
+      void onEvent(void* theContext)
+      {
+        gBenchSink = gBenchSink + 1;
+      }
+  }; // class BenchTarget
+
+  // Fixtures
+  ///////////////////////////////////////////////////////////////////////////
+  static ConfigHandler*   gConfigHandler = NULL;
+  static AssetManager*    gAssetManager = NULL;
+  static std::vector<assetID> gAssetIDs;
+  static ConfigReader*    gConfigReader = NULL;
+  static PropertyManager* gProperties = NULL;
+  static EventManager*    gEvents = NULL;
+  static BenchTarget      gTarget;
+  static BenchGame*       gGame = NULL;
+  static StateManager*    gStates = NULL;
+  static ILogger*         gLogger = NULL;
+  static std::vector<char> gCRC32Data;
+
+  // TAssetHandler benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpAssetHandler(void)
+  {
+    gConfigHandler = new(std::nothrow) ConfigHandler();
+    for(Uint32 iloop = 0; iloop < FIXTURE_SIZE; iloop++)
+    {
+      std::ostringstream anID;
+      anID << "resources/bench/asset" << iloop << ".cfg";
+      gAssetIDs.push_back(anID.str());
+      gConfigHandler->getReference(gAssetIDs.back());
+    }
+  }
+
+  static void tearDownAssetHandler(void)
+  {
+    for(Uint32 iloop = 0; iloop < gAssetIDs.size(); iloop++)
+    {
+      gConfigHandler->dropReference(gAssetIDs[iloop]);
+    }
+    gAssetIDs.clear();
+    delete gConfigHandler;
+    gConfigHandler = NULL;
+  }
+
+  static void benchAssetHandlerIsLoaded(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + gConfigHandler->isLoaded(gAssetIDs[iloop % FIXTURE_SIZE]);
+    }
+  }
+
+  static void benchAssetHandlerReference(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      const assetID& anID = gAssetIDs[iloop % FIXTURE_SIZE];
+      gBenchSink = gBenchSink + (NULL != gConfigHandler->getReference(anID));
+      gConfigHandler->dropReference(anID);
+    }
+  }
+
+  static void benchAssetHandlerAddData(Uint32 theIterations)
+  {
+    // Hold one reference to the asset just like a TAsset would
+    ConfigHandler::typeAssetData* anData = gConfigHandler->getData(gAssetIDs[0]);
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      ConfigHandler::addData(anData);
+      gConfigHandler->dropData(anData);
+    }
+    gConfigHandler->dropData(anData);
+  }
+
+  static void benchSymbolIntern(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      Symbol anSymbol(gAssetIDs[iloop % FIXTURE_SIZE].str());
+      gBenchSink = gBenchSink + anSymbol.getHandle();
+    }
+  }
+
+  // ConfigReader benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpConfigReader(void)
+  {
+    FILE* anFile = fopen(BENCH_CONFIG, "w");
+    if(NULL != anFile)
+    {
+      for(Uint32 iloop = 0; iloop < FIXTURE_SIZE / 16; iloop++)
+      {
+        fprintf(anFile, "; Section %u comment\n[section%u]\n", iloop, iloop);
+        for(Uint32 jloop = 0; jloop < 16; jloop++)
+        {
+          fprintf(anFile, "name%u = %u\n", jloop, iloop * 16 + jloop);
+        }
+      }
+      fclose(anFile);
+    }
+    gConfigReader = new(std::nothrow) ConfigReader();
+    gConfigReader->loadFromFile(BENCH_CONFIG);
+  }
+
+  static void tearDownConfigReader(void)
+  {
+    delete gConfigReader;
+    gConfigReader = NULL;
+    remove(BENCH_CONFIG);
+    remove(ConfigReader::getCacheFilename(BENCH_CONFIG).c_str());
+    ConfigReader::setCacheEnabled(true);
+  }
+
+  static void setUpConfigReaderNoCache(void)
+  {
+    setUpConfigReader();
+    ConfigReader::setCacheEnabled(false);
+  }
+
+  static void benchConfigReaderLoad(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      ConfigReader anReader;
+      gBenchSink = gBenchSink + anReader.loadFromFile(BENCH_CONFIG);
+    }
+  }
+
+  static void benchConfigReaderGetUint32(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + gConfigReader->getUint32("section7", "name9", 0);
+    }
+  }
+
+  static void benchConfigReaderGetUint32Id(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + gConfigReader->getUint32(ID("section7"), ID("name9"), 0);
+    }
+  }
+
+  // AssetManager benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpAssetManager(void)
+  {
+    gAssetManager = new(std::nothrow) AssetManager();
+    gAssetManager->registerHandler(new(std::nothrow) ConfigHandler());
+    gAssetManager->registerHandler(new(std::nothrow) FontHandler());
+    gAssetManager->registerHandler(new(std::nothrow) MusicHandler());
+    gAssetManager->registerHandler(new(std::nothrow) SoundHandler());
+  }
+
+  static void tearDownAssetManager(void)
+  {
+    delete gAssetManager;
+    gAssetManager = NULL;
+  }
+
+  static void benchAssetManagerGetHandler(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      IAssetHandler* anHandler = &gAssetManager->getHandler<ConfigReader>();
+      gBenchSink = gBenchSink + (NULL != anHandler);
+      anHandler = &gAssetManager->getHandler<sf::SoundBuffer>();
+      gBenchSink = gBenchSink + (NULL != anHandler);
+    }
+  }
+
+  // CRC32 benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpCRC32(void)
+  {
+    gCRC32Data.resize(CRC32_DATA_SIZE);
+    for(Uint32 iloop = 0; iloop < CRC32_DATA_SIZE; iloop++)
+    {
+      gCRC32Data[iloop] = (char)('a' + iloop % 26);
+    }
+  }
+
+  static void tearDownCRC32(void)
+  {
+    std::vector<char>().swap(gCRC32Data);
+  }
+
+  static void benchCRC32Runtime16(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + crc32_runtime(&gCRC32Data[iloop & 7], 16);
+    }
+  }
+
+  static void benchCRC32Runtime64(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + crc32_runtime(&gCRC32Data[iloop & 7], 64);
+    }
+  }
+
+  static void benchCRC32Runtime64K(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + crc32_runtime(&gCRC32Data[0], CRC32_DATA_SIZE);
+    }
+  }
+
+  // StringUtil benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void benchParseUint32(Uint32 theIterations)
+  {
+    const std::string anValue("1234567");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + parseUint32(anValue, 0);
+    }
+  }
+
+  static void benchParseFloat(Uint32 theIterations)
+  {
+    const std::string anValue("3.14159");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)parseFloat(anValue, 0.0f);
+    }
+  }
+
+  static void benchParseBool(Uint32 theIterations)
+  {
+    const std::string anValue("True");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + parseBool(anValue, false);
+    }
+  }
+
+  static void benchParseVector2f(Uint32 theIterations)
+  {
+    const std::string anValue("1.5, 2.5");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)parseVector2f(anValue, sf::Vector2f()).x;
+    }
+  }
+
+  static void benchParseInt64(Uint32 theIterations)
+  {
+    const std::string anValue("-9876543210");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)parseInt64(anValue, 0);
+    }
+  }
+
+  static void benchParseColor(Uint32 theIterations)
+  {
+    const std::string anValue("255, 128, 64, 255");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + parseColor(anValue, sf::Color()).g;
+    }
+  }
+
+  static void benchParseIntRect(Uint32 theIterations)
+  {
+    const std::string anValue("10, 20, 640, 480");
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + parseIntRect(anValue, sf::IntRect()).width;
+    }
+  }
+
+  static void benchConvertUint32(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)convertUint32(iloop).size();
+    }
+  }
+
+  static void benchConvertFloat(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)convertFloat((float)iloop * 0.25f).size();
+    }
+  }
+
+  static void benchConvertVector2f(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink +
+        (Uint32)convertVector2f(sf::Vector2f((float)iloop, 0.5f)).size();
+    }
+  }
+
+  // PropertyManager benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpProperties(void)
+  {
+    gProperties = new(std::nothrow) PropertyManager();
+    for(Uint32 iloop = 0; iloop < FIXTURE_SIZE; iloop++)
+    {
+      gProperties->add<float>(iloop, (float)iloop);
+    }
+  }
+
+  static void tearDownProperties(void)
+  {
+    delete gProperties;
+    gProperties = NULL;
+  }
+
+  static void benchPropertyGet(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gBenchSink = gBenchSink + (Uint32)gProperties->get<float>(iloop % FIXTURE_SIZE);
+    }
+  }
+
+  static void benchPropertySet(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gProperties->set<float>(iloop % FIXTURE_SIZE, (float)iloop);
+    }
+  }
+
+  // EventManager benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpEvents(void)
+  {
+    gEvents = new(std::nothrow) EventManager();
+    for(Uint32 iloop = 0; iloop < FIXTURE_SIZE; iloop++)
+    {
+      gEvents->add<BenchTarget>(iloop, gTarget, &BenchTarget::onEvent);
+    }
+  }
+
+  static void tearDownEvents(void)
+  {
+    delete gEvents;
+    gEvents = NULL;
+  }
+
+  static void benchDoEvents(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gEvents->doEvents();
+    }
+  }
+
+  // StateManager benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpStates(void)
+  {
+    gGame = new(std::nothrow) BenchGame();
+    gStates = new(std::nothrow) StateManager();
+    gStates->addActiveState(new(std::nothrow) BenchState(1, *gGame));
+    gStates->addActiveState(new(std::nothrow) BenchState(2, *gGame));
+  }
+
+  static void tearDownStates(void)
+  {
+    delete gStates;
+    gStates = NULL;
+    delete gGame;
+    gGame = NULL;
+  }
+
+  static void benchSetActiveState(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      gStates->setActiveState(1 + (iloop & 1));
+      gStates->cleanup();
+    }
+  }
+
+  // Logger benchmarks
+  ///////////////////////////////////////////////////////////////////////////
+  static void setUpStringLogger(void)
+  {
+    gLogger = new(std::nothrow) StringLogger(true);
+  }
+
+  static void setUpFileLogger(void)
+  {
+    gLogger = new(std::nothrow) FileLogger(BENCH_LOG, true);
+  }
+
+  static void tearDownLogger(void)
+  {
+    delete gLogger;
+    gLogger = NULL;
+    remove(BENCH_LOG);
+  }
+
+  static void benchLogLine(Uint32 theIterations)
+  {
+    for(Uint32 iloop = 0; iloop < theIterations; iloop++)
+    {
+      ILOG() << "age-bench log line " << iloop << std::endl;
+    }
+  }
+
+  void registerCoreBenchmarks(Benchmark& theBenchmark)
+  {
+    theBenchmark.add("TAssetHandler/isLoaded", benchAssetHandlerIsLoaded,
+        setUpAssetHandler, tearDownAssetHandler);
+    theBenchmark.add("TAssetHandler/getReference+dropReference", benchAssetHandlerReference,
+        setUpAssetHandler, tearDownAssetHandler);
+    theBenchmark.add("TAssetHandler/addData+dropData", benchAssetHandlerAddData,
+        setUpAssetHandler, tearDownAssetHandler);
+    theBenchmark.add("Symbol/intern", benchSymbolIntern,
+        setUpAssetHandler, tearDownAssetHandler);
+    theBenchmark.add("AssetManager/getHandler<TYPE>x2", benchAssetManagerGetHandler,
+        setUpAssetManager, tearDownAssetManager);
+    theBenchmark.add("ConfigReader/loadFromFile/256keys", benchConfigReaderLoad,
+        setUpConfigReader, tearDownConfigReader);
+    theBenchmark.add("ConfigReader/loadFromFile/256keys/NoCache", benchConfigReaderLoad,
+        setUpConfigReaderNoCache, tearDownConfigReader);
+    theBenchmark.add("ConfigReader/getUint32", benchConfigReaderGetUint32,
+        setUpConfigReader, tearDownConfigReader);
+    theBenchmark.add("ConfigReader/getUint32/Id", benchConfigReaderGetUint32Id,
+        setUpConfigReader, tearDownConfigReader);
+    theBenchmark.add("CRC32/crc32_runtime/16B", benchCRC32Runtime16,
+        setUpCRC32, tearDownCRC32);
+    theBenchmark.add("CRC32/crc32_runtime/64B", benchCRC32Runtime64,
+        setUpCRC32, tearDownCRC32);
+    theBenchmark.add("CRC32/crc32_runtime/64KB", benchCRC32Runtime64K,
+        setUpCRC32, tearDownCRC32);
+    theBenchmark.add("StringUtil/parseUint32", benchParseUint32);
+    theBenchmark.add("StringUtil/parseFloat", benchParseFloat);
+    theBenchmark.add("StringUtil/parseBool", benchParseBool);
+    theBenchmark.add("StringUtil/parseVector2f", benchParseVector2f);
+    theBenchmark.add("StringUtil/parseInt64", benchParseInt64);
+    theBenchmark.add("StringUtil/parseColor", benchParseColor);
+    theBenchmark.add("StringUtil/parseIntRect", benchParseIntRect);
+    theBenchmark.add("StringUtil/convertUint32", benchConvertUint32);
+    theBenchmark.add("StringUtil/convertFloat", benchConvertFloat);
+    theBenchmark.add("StringUtil/convertVector2f", benchConvertVector2f);
+    theBenchmark.add("PropertyManager/get<float>", benchPropertyGet,
+        setUpProperties, tearDownProperties);
+    theBenchmark.add("PropertyManager/set<float>", benchPropertySet,
+        setUpProperties, tearDownProperties);
+    theBenchmark.add("EventManager/doEvents/256events", benchDoEvents,
+        setUpEvents, tearDownEvents);
+    theBenchmark.add("StateManager/setActiveState+cleanup", benchSetActiveState,
+        setUpStates, tearDownStates);
+    theBenchmark.add("Logger/StringLogger/ILOG", benchLogLine,
+        setUpStringLogger, tearDownLogger);
+    theBenchmark.add("Logger/FileLogger/ILOG", benchLogLine,
+        setUpFileLogger, tearDownLogger);
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
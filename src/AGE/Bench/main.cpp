@@ -0,0 +1,99 @@
+/**
+ * Provides the main entry point for the age-bench program which runs every
+ * AGE Core benchmark without opening a window and writes the results as
+ * machine-readable JSON.
+ *
+ * Usage: age-bench [--filter text] [--warmup N] [--repetitions N]
+ *                  [--min-time ms] [--output file.json]
+ *
+ * @file src/AGE/Bench/main.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Benchmark.hpp"
+
+int main(int argc, char* argv[])
+{
+  AGE::Benchmark anBenchmark;
+  const char* anOutput = NULL;
+
+  // Process our command line arguments
+  for(int iloop = 1; iloop < argc; iloop++)
+  {
+    bool anValue = iloop + 1 < argc;
+    if(0 == strcmp(argv[iloop], "--filter") && anValue)
+    {
+      anBenchmark.setFilter(argv[++iloop]);
+    }
+    else if(0 == strcmp(argv[iloop], "--warmup") && anValue)
+    {
+      anBenchmark.setWarmup((AGE::Uint32)atoi(argv[++iloop]));
+    }
+    else if(0 == strcmp(argv[iloop], "--repetitions") && anValue)
+    {
+      anBenchmark.setRepetitions((AGE::Uint32)atoi(argv[++iloop]));
+    }
+    else if(0 == strcmp(argv[iloop], "--min-time") && anValue)
+    {
+      anBenchmark.setMinTime((AGE::Uint32)atoi(argv[++iloop]));
+    }
+    else if(0 == strcmp(argv[iloop], "--output") && anValue)
+    {
+      anOutput = argv[++iloop];
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--filter text] [--warmup N] [--repetitions N]"
+          " [--min-time ms] [--output file.json]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  // Register and run every benchmark
+  AGE::registerCoreBenchmarks(anBenchmark);
+  if(0 == anBenchmark.run())
+  {
+    fprintf(stderr, "%s: no benchmarks matched\n", argv[0]);
+    return 1;
+  }
+
+  // Write our results to stdout or the output file requested
+  FILE* anFile = NULL == anOutput ? stdout : fopen(anOutput, "w");
+  if(NULL == anFile)
+  {
+    fprintf(stderr, "%s: unable to open %s\n", argv[0], anOutput);
+    return 1;
+  }
+  anBenchmark.writeJSON(anFile);
+  if(stdout != anFile)
+  {
+    fclose(anFile);
+  }
+
+  return 0;
+}
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -6,10 +6,15 @@
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
  * @date 20120514 - Don't throw exception on new
+ * @date 20261018 - Use new ConfigReader::loadFromMemory
+ * @date 20261018 - Use the interned filename without copying it
+ * @date 20261018 - Load assets from the network using the AssetDownloader
+ * @date 20261018 - Load assets from memory using a MemoryMappedFile
  */
  
 #include <AGE/Core/assets/ConfigHandler.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
  
 namespace AGE
 {
@@ -30,7 +35,7 @@ namespace AGE
     bool anResult = false;
 
     // Retrieve the filename for this asset
-    std::string anFilename = getFilename(theAssetID);
+    const std::string& anFilename = getFilename(theAssetID);
 
     // Was a valid filename found? then attempt to load the asset from anFilename
     if(anFilename.length() > 0)
@@ -53,7 +58,22 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add LoadFromMemory support to ConfigReader
+    // Retrieve the filename for this asset
+    const std::string& anFilename = getFilename(theAssetID);
+
+    // Map the config file into memory, the mapping is released when we return
+    MemoryMappedFile anFile;
+    if(anFilename.length() > 0 && anFile.open(anFilename) &&
+      NULL != anFile.getData() && anFile.getSize() > 0)
+    {
+      // Load the config file from the memory location specified
+      anResult = theAsset.loadFromMemory(anFile.getData(), anFile.getSize());
+    }
+    else
+    {
+      ELOG() << "ConfigHandler::loadFromMemory(" << theAssetID
+        << ") Bad memory location or size!" << std::endl;
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
@@ -64,7 +84,18 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add load from network for this asset
+    // Download the asset into the cache (or use the cached copy)
+    std::string anFilename;
+    if(downloadAsset(theAssetID, anFilename))
+    {
+      anResult = theAsset.loadFromFile(anFilename);
+    }
+    else
+    {
+      WLOG() << "ConfigHandler::loadFromNetwork(" << theAssetID
+        << ") download failed, loading from file instead" << std::endl;
+      anResult = loadFromFile(theAssetID, theAsset);
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
@@ -5,6 +5,11 @@
  * @file src/AGE/Core/assets/FontHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Use the interned filename without copying it
+ * @date 20261018 - Defer releases made away from the owner thread
+ * @date 20261018 - Share one decoded asset between files with identical content
+ * @date 20261018 - Load assets from the network using the AssetDownloader
+ * @date 20261018 - Record the memory used by each asset with the MemoryTracker
  */
  
 #include <AGE/Core/assets/FontHandler.hpp>
@@ -13,7 +18,7 @@
 namespace AGE
 {
   FontHandler::FontHandler() :
-    TAssetHandler<sf::Font>()
+    TAssetHandler<sf::Font>(MemoryTracker::MemoryFonts)
   {
     ILOG() << "FontHandler::ctor()" << std::endl;
   }
@@ -29,7 +34,7 @@ namespace AGE
     bool anResult = false;
 
     // Retrieve the filename for this asset
-    std::string anFilename = getFilename(theAssetID);
+    const std::string& anFilename = getFilename(theAssetID);
 
     // Was a valid filename found? then attempt to load the asset from anFilename
     if(anFilename.length() > 0)
@@ -85,11 +90,32 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add load from network for this asset
+    // Download the asset into the cache (or use the cached copy)
+    std::string anFilename;
+    if(downloadAsset(theAssetID, anFilename))
+    {
+      anResult = theAsset.loadFromFile(anFilename);
+    }
+    else
+    {
+      WLOG() << "FontHandler::loadFromNetwork(" << theAssetID
+        << ") download failed, loading from file instead" << std::endl;
+      anResult = loadFromFile(theAssetID, theAsset);
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
   }
+
+  bool FontHandler::isReleaseDeferred(void) const
+  {
+    return true;
+  }
+
+  bool FontHandler::isDeduplicated(void) const
+  {
+    return true;
+  }
 } // namespace AGE
  
 /**
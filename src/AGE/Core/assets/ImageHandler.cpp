@@ -5,6 +5,12 @@
  * @file src/AGE/Core/assets/ImageHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Use the interned filename without copying it
+ * @date 20261018 - Defer releases made away from the owner thread
+ * @date 20261018 - Share one decoded asset between files with identical content
+ * @date 20261018 - Load assets from the network using the AssetDownloader
+ * @date 20261018 - Record the memory used by each asset with the MemoryTracker
+ * @date 20261018 - Never share images since textures may be modified
  */
  
 #include <AGE/Core/assets/ImageHandler.hpp>
@@ -14,7 +20,7 @@ namespace AGE
 {
   ImageHandler::ImageHandler() :
 
-    TAssetHandler<sf::Texture>()
+    TAssetHandler<sf::Texture>(MemoryTracker::MemoryTextures)
 
   {
     ILOG() << "ImageHandler::ctor()" << std::endl;
@@ -33,7 +39,7 @@ namespace AGE
     bool anResult = false;
 
     // Retrieve the filename for this asset
-    std::string anFilename = getFilename(theAssetID);
+    const std::string& anFilename = getFilename(theAssetID);
 
     // Was a valid filename found? then attempt to load the asset from anFilename
     if(anFilename.length() > 0)
@@ -90,11 +96,37 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add load from network for this asset
+    // Download the asset into the cache (or use the cached copy)
+    std::string anFilename;
+    if(downloadAsset(theAssetID, anFilename))
+    {
+      anResult = theAsset.loadFromFile(anFilename);
+    }
+    else
+    {
+      WLOG() << "ImageHandler::loadFromNetwork(" << theAssetID
+        << ") download failed, loading from file instead" << std::endl;
+      anResult = loadFromFile(theAssetID, theAsset);
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
   }
+
+  bool ImageHandler::isReleaseDeferred(void) const
+  {
+    return true;
+  }
+
+  bool ImageHandler::isDeduplicated(void) const
+  {
+    return false;
+  }
+
+  Uint64 ImageHandler::getAssetBytes(const sf::Texture& theAsset) const
+  {
+    return (Uint64)theAsset.getSize().x * theAsset.getSize().y * 4;
+  }
 } // namespace AGE
 
 /**
@@ -5,13 +5,64 @@
  * @file src/AGE/Core/assets/MusicHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Use the interned filename without copying it
+ * @date 20261018 - Stream music through read ahead and memory mapped streams
+ * @date 20261018 - Load assets from the network using the AssetDownloader
+ * @date 20261018 - Delete the streamed music created by AcquireAsset
+ * @date 20261018 - Release remaining music before the TAssetHandler destructor runs
  */
  
+#include <cassert>
 #include <AGE/Core/assets/MusicHandler.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/MemoryStream.hpp>
+#include <AGE/Core/utils/ReadAheadStream.hpp>
+#include <AGE/Core/utils/StringUtil.hpp>
  
 namespace AGE
 {
+  /// Provides sf::Music that owns the sf::InputStream it streams from
+  class StreamedMusic : public sf::Music
+  {
+    public:
+      /**
+       * StreamedMusic constructor
+       */
+      StreamedMusic() :
+        mStream(NULL)
+      {
+      }
+
+      /**
+       * StreamedMusic deconstructor will stop the streaming thread before
+       * deleting the stream it reads from.
+       */
+      virtual ~StreamedMusic()
+      {
+        stop();
+        delete mStream;
+      }
+
+      /**
+       * OpenFromOwnedStream will open theStream provided and take ownership
+       * of it, deleting the stream previously opened (if any) which is no
+       * longer used once sf::Music has reopened.
+       * @param[in] theStream to stream from
+       * @return true if theStream could be opened, false otherwise
+       */
+      bool openFromOwnedStream(sf::InputStream* theStream)
+      {
+        bool anResult = openFromStream(*theStream);
+        delete mStream;
+        mStream = theStream;
+        return anResult;
+      }
+
+    private:
+      /// The stream being played
+      sf::InputStream* mStream;
+  }; // class StreamedMusic
+
   MusicHandler::MusicHandler() :
     TAssetHandler<sf::Music>()
   {
@@ -21,6 +72,23 @@ namespace AGE
   MusicHandler::~MusicHandler()
   {
     ILOG() << "MusicHandler::dtor()" << std::endl;
+
+    // Release our streamed music while our ReleaseAsset is still reachable
+    releaseAssets();
+  }
+
+  sf::Music* MusicHandler::acquireAsset(const assetID theAssetID)
+  {
+    ILOG() << "MusicHandler::acquireAsset(" << theAssetID
+      << ") Creating asset" << std::endl;
+    return new(std::nothrow) StreamedMusic();
+  }
+
+  void MusicHandler::releaseAsset(const assetID theAssetID, sf::Music* theAsset)
+  {
+    ILOG() << "MusicHandler::releaseAsset(" << theAssetID
+      << ") Releasing asset" << std::endl;
+    delete theAsset;
   }
 
   bool MusicHandler::loadFromFile(const assetID theAssetID, sf::Music& theAsset)
@@ -29,15 +97,27 @@ namespace AGE
     bool anResult = false;
 
     // Retrieve the filename for this asset
-    std::string anFilename = getFilename(theAssetID);
+    const std::string& anFilename = getFilename(theAssetID);
+
+    // File and region within it to stream from
+    std::string anFile;
+    Uint64 anOffset = 0;
+    Uint64 anSize = 0;
 
     // Was a valid filename found? then attempt to load the asset from anFilename
-    if(anFilename.length() > 0)
+    if(anFilename.length() > 0 && parseFilename(anFilename, anFile, anOffset, anSize))
     {
-      // Load the asset from a file
-
-      anResult = theAsset.openFromFile(anFilename);
-
+      // Stream the asset from the file, reading ahead on another thread
+      ReadAheadStream* anStream = new(std::nothrow) ReadAheadStream();
+      assert(NULL != anStream && "MusicHandler::loadFromFile() unable to allocate stream");
+      if(NULL != anStream && anStream->open(anFile, anOffset, anSize))
+      {
+        anResult = static_cast<StreamedMusic&>(theAsset).openFromOwnedStream(anStream);
+      }
+      else
+      {
+        delete anStream;
+      }
     }
     else
     {
@@ -54,18 +134,28 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Retrieve the const char* pointer to load data from
-    const char* anData = NULL;
-    // TODO: Retrieve the size in bytes of the font to load from memory
-    size_t anDataSize = 0;
-
-    // Try to obtain the font from the memory location specified
-    if(NULL != anData && anDataSize > 0)
-    {
-      // Load the image from the memory location specified
+    // Retrieve the filename for this asset
+    const std::string& anFilename = getFilename(theAssetID);
 
-      anResult = theAsset.openFromMemory(anData, anDataSize);
+    // File and region within it to map into memory
+    std::string anFile;
+    Uint64 anOffset = 0;
+    Uint64 anSize = 0;
 
+    // Try to map the region of the file specified into memory
+    if(anFilename.length() > 0 && parseFilename(anFilename, anFile, anOffset, anSize))
+    {
+      // Stream the asset from the memory mapped region
+      MemoryStream* anStream = new(std::nothrow) MemoryStream();
+      assert(NULL != anStream && "MusicHandler::loadFromMemory() unable to allocate stream");
+      if(NULL != anStream && anStream->open(anFile, anOffset, anSize))
+      {
+        anResult = static_cast<StreamedMusic&>(theAsset).openFromOwnedStream(anStream);
+      }
+      else
+      {
+        delete anStream;
+      }
     }
     else
     {
@@ -82,11 +172,60 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add load from network for this asset
+    // Download the asset into the cache (or use the cached copy)
+    std::string anFilename;
+    if(downloadAsset(theAssetID, anFilename))
+    {
+      // Stream the asset from the cached file, reading ahead on another thread
+      ReadAheadStream* anStream = new(std::nothrow) ReadAheadStream();
+      assert(NULL != anStream && "MusicHandler::loadFromNetwork() unable to allocate stream");
+      if(NULL != anStream && anStream->open(anFilename))
+      {
+        anResult = static_cast<StreamedMusic&>(theAsset).openFromOwnedStream(anStream);
+      }
+      else
+      {
+        delete anStream;
+      }
+    }
+    else
+    {
+      WLOG() << "MusicHandler::loadFromNetwork(" << theAssetID
+        << ") download failed, loading from file instead" << std::endl;
+      anResult = loadFromFile(theAssetID, theAsset);
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
   }
+
+  bool MusicHandler::parseFilename(const std::string& theFilename, std::string& theFile,
+    Uint64& theOffset, Uint64& theSize)
+  {
+    theOffset = 0;
+    theSize = 0;
+
+    // No region specified? then use the whole file
+    std::string::size_type anHash = theFilename.rfind('#');
+    if(std::string::npos == anHash)
+    {
+      theFile = theFilename;
+      return true;
+    }
+
+    theFile = theFilename.substr(0, anHash);
+    std::string::size_type anComma = theFilename.find(',', anHash);
+    if(std::string::npos == anComma ||
+      !scanUint64(StringRef(theFilename.data() + anHash + 1, anComma - anHash - 1), theOffset) ||
+      !scanUint64(StringRef(theFilename.data() + anComma + 1, theFilename.size() - anComma - 1), theSize))
+    {
+      ELOG() << "MusicHandler::parseFilename(" << theFilename
+        << ") expected file#offset,size" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
 } // namespace AGE
  
 /**
@@ -5,6 +5,10 @@
  * @file src/AGE/Core/assets/SoundHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Use the interned filename without copying it
+ * @date 20261018 - Share one decoded asset between files with identical content
+ * @date 20261018 - Load assets from the network using the AssetDownloader
+ * @date 20261018 - Record the memory used by each asset with the MemoryTracker
  */
  
 #include <AGE/Core/assets/SoundHandler.hpp>
@@ -13,7 +17,7 @@
 namespace AGE
 {
   SoundHandler::SoundHandler() :
-    TAssetHandler<sf::SoundBuffer>()
+    TAssetHandler<sf::SoundBuffer>(MemoryTracker::MemorySounds)
   {
     ILOG() << "SoundHandler::ctor()" << std::endl;
   }
@@ -29,7 +33,7 @@ namespace AGE
     bool anResult = false;
 
     // Retrieve the filename for this asset
-    std::string anFilename = getFilename(theAssetID);
+    const std::string& anFilename = getFilename(theAssetID);
 
     // Was a valid filename found? then attempt to load the asset from anFilename
     if(anFilename.length() > 0)
@@ -82,11 +86,32 @@ namespace AGE
     // Start with a return result of false
     bool anResult = false;
 
-    // TODO: Add load from network for this asset
+    // Download the asset into the cache (or use the cached copy)
+    std::string anFilename;
+    if(downloadAsset(theAssetID, anFilename))
+    {
+      anResult = theAsset.loadFromFile(anFilename);
+    }
+    else
+    {
+      WLOG() << "SoundHandler::loadFromNetwork(" << theAssetID
+        << ") download failed, loading from file instead" << std::endl;
+      anResult = loadFromFile(theAssetID, theAsset);
+    }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
   }
+
+  bool SoundHandler::isDeduplicated(void) const
+  {
+    return true;
+  }
+
+  Uint64 SoundHandler::getAssetBytes(const sf::SoundBuffer& theAsset) const
+  {
+    return (Uint64)theAsset.getSampleCount() * sizeof(sf::Int16);
+  }
 } // namespace AGE
  
 /**
@@ -0,0 +1,541 @@
+/**
+ * Provides the AssetDownloader class in the AGE namespace which is
+ * responsible for downloading assets over HTTP into an on-disk cache.
+ *
+ * @file src/AGE/Core/classes/AssetDownloader.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Keep requesting ranges of files with an unknown length
+ * @date 20261018 - Only create the cache directory when a base URL is set
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <AGE/Core/classes/AssetDownloader.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+#if defined(AGE_WINDOWS)
+#include <direct.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace AGE
+{
+  /// HTTP status returned when a range starts past the end of the file
+  static const int HTTP_RANGE_NOT_SATISFIABLE = 416;
+
+  /**
+   * GetFileSize will return the size of theFilename provided.
+   * @param[in] theFilename to query
+   * @param[out] theSize of the file
+   * @return true if theFilename exists, false otherwise
+   */
+  static bool getFileSize(const std::string& theFilename, Uint64& theSize)
+  {
+#if defined(AGE_WINDOWS)
+    struct _stat64 anStat;
+    if(0 != _stat64(theFilename.c_str(), &anStat))
+#else
+    struct stat anStat;
+    if(0 != stat(theFilename.c_str(), &anStat))
+#endif
+    {
+      theSize = 0;
+      return false;
+    }
+    theSize = (Uint64)anStat.st_size;
+    return true;
+  }
+
+  /**
+   * MakeDirectory will create theDirectory provided and each missing parent
+   * directory.
+   * @param[in] theDirectory to create
+   */
+  static void makeDirectory(const std::string& theDirectory)
+  {
+    for(size_t iloop = 1; iloop <= theDirectory.size(); iloop++)
+    {
+      if(iloop == theDirectory.size() || '/' == theDirectory[iloop])
+      {
+        std::string anPath = theDirectory.substr(0, iloop);
+#if defined(AGE_WINDOWS)
+        _mkdir(anPath.c_str());
+#else
+        mkdir(anPath.c_str(), 0755);
+#endif
+      }
+    }
+  }
+
+  /**
+   * ReadText will return the contents of the small text file theFilename
+   * provided or an empty string if it doesn't exist.
+   * @param[in] theFilename to read
+   * @return the contents of theFilename
+   */
+  static std::string readText(const std::string& theFilename)
+  {
+    std::string anResult;
+    std::FILE* anFile = std::fopen(theFilename.c_str(), "rb");
+    if(NULL != anFile)
+    {
+      char anBuffer[256];
+      size_t anRead = std::fread(anBuffer, 1, sizeof(anBuffer), anFile);
+      anResult.assign(anBuffer, anRead);
+      std::fclose(anFile);
+    }
+    return anResult;
+  }
+
+  /**
+   * WriteFile will write theData provided to theFilename, replacing or
+   * appending to its contents.
+   * @param[in] theFilename to write
+   * @param[in] theData to write
+   * @param[in] theAppend is true to append to the existing contents
+   * @return true if successful, false otherwise
+   */
+  static bool writeFile(const std::string& theFilename, const std::string& theData,
+    const bool theAppend)
+  {
+    std::FILE* anFile = std::fopen(theFilename.c_str(), theAppend ? "ab" : "wb");
+    if(NULL == anFile)
+    {
+      ELOG() << "AssetDownloader unable to write (" << theFilename << ")" << std::endl;
+      return false;
+    }
+    bool anResult = theData.size() == std::fwrite(theData.data(), 1, theData.size(), anFile);
+    anResult = (0 == std::fclose(anFile)) && anResult;
+    return anResult;
+  }
+
+  /**
+   * ParseURL will split theURL provided into its host, port and URI.
+   * @param[in] theURL to split such as "http://localhost:8080/dlc/a.png"
+   * @param[out] theHost such as "localhost"
+   * @param[out] thePort such as 8080 (80 if not provided)
+   * @param[out] theURI such as "/dlc/a.png"
+   * @return true if theURL is a valid http URL, false otherwise
+   */
+  static bool parseURL(const std::string& theURL, std::string& theHost,
+    unsigned short& thePort, std::string& theURI)
+  {
+    if(0 == theURL.compare(0, 8, "https://"))
+    {
+      ELOG() << "AssetDownloader::parseURL(" << theURL << ") https is not supported" << std::endl;
+      return false;
+    }
+    if(0 != theURL.compare(0, 7, "http://"))
+    {
+      return false;
+    }
+
+    size_t anSlash = theURL.find('/', 7);
+    std::string anHost = theURL.substr(7, anSlash - 7);
+    theURI = (std::string::npos == anSlash) ? "/" : theURL.substr(anSlash);
+    thePort = 80;
+    size_t anColon = anHost.find(':');
+    if(std::string::npos != anColon)
+    {
+      thePort = (unsigned short)std::atoi(anHost.c_str() + anColon + 1);
+      anHost.erase(anColon);
+    }
+    theHost = anHost;
+
+    return !theHost.empty();
+  }
+
+  /**
+   * ParseContentRange will parse the "bytes first-last/total" value of the
+   * Content-Range field provided.
+   * @param[in] theField value to parse
+   * @param[out] theFirst byte included in the response
+   * @param[out] theTotal size of the file or 0 if unknown
+   * @return true if theField could be parsed, false otherwise
+   */
+  static bool parseContentRange(const std::string& theField, Uint64& theFirst,
+    Uint64& theTotal)
+  {
+    unsigned long long anFirst = 0;
+    unsigned long long anLast = 0;
+    if(2 > std::sscanf(theField.c_str(), "bytes %llu-%llu", &anFirst, &anLast))
+    {
+      return false;
+    }
+    theFirst = anFirst;
+
+    theTotal = 0;
+    size_t anSlash = theField.find('/');
+    if(std::string::npos != anSlash && '*' != theField[anSlash + 1])
+    {
+      theTotal = std::strtoull(theField.c_str() + anSlash + 1, NULL, 10);
+    }
+
+    return true;
+  }
+
+  AssetDownloader::AssetDownloader() :
+    mChunkSize(DEFAULT_CHUNK_SIZE),
+    mTimeout(DEFAULT_TIMEOUT),
+    mDownloads(0),
+    mCacheHits(0),
+    mFallbacks(0),
+    mBytes(0)
+  {
+  }
+
+  AssetDownloader::~AssetDownloader()
+  {
+    deInit();
+  }
+
+  void AssetDownloader::doInit(const std::string& theBaseURL, const std::string& theCacheDir,
+    Uint32 theChunkSize, Uint32 theTimeout)
+  {
+    mBaseURL = theBaseURL;
+    mCacheDir = theCacheDir;
+    if(!mCacheDir.empty() && '/' != mCacheDir[mCacheDir.size() - 1])
+    {
+      mCacheDir += '/';
+    }
+    mChunkSize = (0 < theChunkSize) ? theChunkSize : DEFAULT_CHUNK_SIZE;
+    mTimeout = theTimeout;
+    mDownloads = 0;
+    mCacheHits = 0;
+    mFallbacks = 0;
+    mBytes = 0;
+
+    // Only create the cache directory if there is anything to download
+    if(!mBaseURL.empty() && !mCacheDir.empty())
+    {
+      makeDirectory(mCacheDir.substr(0, mCacheDir.size() - 1));
+    }
+  }
+
+  void AssetDownloader::deInit(void)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    for(size_t iloop = 0; iloop < mIdle.size(); iloop++)
+    {
+      delete mIdle[iloop].http;
+    }
+    mIdle.clear();
+  }
+
+  bool AssetDownloader::download(const std::string& theFilename, std::string& theCachedFilename)
+  {
+    std::string anURL = getURL(theFilename);
+
+    // Name the cached file after the URL but keep the extension for loaders
+    // (such as sf::Music) that use it to pick a format
+    std::string anPath = anURL.substr(0, anURL.find_first_of("?#"));
+    size_t anDot = anPath.find_last_of("./");
+    std::string anExtension;
+    if(std::string::npos != anDot && '.' == anPath[anDot])
+    {
+      anExtension = anPath.substr(anDot);
+    }
+    char anName[16];
+    std::sprintf(anName, "%08x", crc32_runtime(anURL.data(), anURL.size()));
+    theCachedFilename = mCacheDir + anName + anExtension;
+
+    // Only one thread downloads each URL, the others use its result
+    bool anWaited = false;
+    {
+      std::unique_lock<std::mutex> anLock(mMutex);
+      while(mActive.end() != mActive.find(anURL))
+      {
+        anWaited = true;
+        mFinished.wait(anLock);
+      }
+      Uint64 anSize;
+      if(anWaited && getFileSize(theCachedFilename, anSize))
+      {
+        return true;
+      }
+      mActive.insert(anURL);
+    }
+
+    std::string anHost;
+    unsigned short anPort = 0;
+    std::string anURI;
+    bool anResult = parseURL(anURL, anHost, anPort, anURI) &&
+      fetch(anHost, anPort, anURI, theCachedFilename);
+
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      mActive.erase(anURL);
+    }
+    mFinished.notify_all();
+
+    // Use the cached file if the server couldn't be reached
+    if(!anResult)
+    {
+      Uint64 anSize;
+      if(getFileSize(theCachedFilename, anSize))
+      {
+        WLOG() << "AssetDownloader::download(" << anURL << ") using cached file ("
+          << theCachedFilename << ")" << std::endl;
+        mFallbacks++;
+        anResult = true;
+      }
+      else
+      {
+        ELOG() << "AssetDownloader::download(" << anURL << ") failed" << std::endl;
+      }
+    }
+
+    return anResult;
+  }
+
+  std::string AssetDownloader::getURL(const std::string& theFilename) const
+  {
+    if(0 == theFilename.compare(0, 7, "http://") ||
+       0 == theFilename.compare(0, 8, "https://"))
+    {
+      return theFilename;
+    }
+    return mBaseURL + theFilename;
+  }
+
+  Uint32 AssetDownloader::getDownloadCount(void) const
+  {
+    return mDownloads;
+  }
+
+  Uint32 AssetDownloader::getCacheHitCount(void) const
+  {
+    return mCacheHits;
+  }
+
+  Uint32 AssetDownloader::getFallbackCount(void) const
+  {
+    return mFallbacks;
+  }
+
+  Uint64 AssetDownloader::getBytesDownloaded(void) const
+  {
+    return mBytes;
+  }
+
+  bool AssetDownloader::fetch(const std::string& theHost, const unsigned short thePort,
+    const std::string& theURI, const std::string& theCachedFilename)
+  {
+    // The partial download and the ETag of each file are kept beside it
+    std::string anPartFilename = theCachedFilename + ".part";
+    std::string anTagFilename = theCachedFilename + ".etag";
+    std::string anPartTagFilename = anPartFilename + ".etag";
+
+    Uint64 anSize = 0;
+    bool anCached = getFileSize(theCachedFilename, anSize);
+    std::string anCachedTag = anCached ? readText(anTagFilename) : std::string();
+    Uint64 anOffset = 0;
+    std::string anPartTag;
+    if(getFileSize(anPartFilename, anOffset))
+    {
+      anPartTag = readText(anPartTagFilename);
+    }
+
+    // A partial download can't be resumed safely without its ETag
+    if(0 < anOffset && anPartTag.empty())
+    {
+      anOffset = 0;
+    }
+
+    sf::Http* anHttp = acquireHttp(theHost, thePort);
+    if(NULL == anHttp)
+    {
+      return false;
+    }
+
+    bool anResult = false;
+    bool anRestarted = false;
+    // True if the file length is unknown and the last range was full, so
+    // the file may continue past it
+    bool anOpenEnded = false;
+    while(true)
+    {
+      sf::Http::Request anRequest(theURI);
+      std::ostringstream anRange;
+      anRange << "bytes=" << anOffset << "-" << (anOffset + mChunkSize - 1);
+      anRequest.setField("Range", anRange.str());
+      if(0 < anOffset)
+      {
+        // Only continue if the file didn't change since it was started
+        anRequest.setField("If-Range", anPartTag);
+      }
+      else if(!anCachedTag.empty())
+      {
+        anRequest.setField("If-None-Match", anCachedTag);
+      }
+
+      sf::Http::Response anResponse = anHttp->sendRequest(anRequest, sf::seconds((float)mTimeout));
+      int anStatus = anResponse.getStatus();
+      const std::string& anBody = anResponse.getBody();
+
+      if(sf::Http::Response::NotModified == anStatus)
+      {
+        mCacheHits++;
+        anResult = true;
+        break;
+      }
+      else if(sf::Http::Response::Ok == anStatus)
+      {
+        // The server ignored the range (or the file changed), this is the
+        // whole file
+        if(!writeFile(anPartFilename, anBody, false))
+        {
+          break;
+        }
+        mBytes += anBody.size();
+        anPartTag = anResponse.getField("etag");
+        anResult = true;
+      }
+      else if(sf::Http::Response::PartialContent == anStatus)
+      {
+        Uint64 anFirst = 0;
+        Uint64 anTotal = 0;
+        if(!parseContentRange(anResponse.getField("content-range"), anFirst, anTotal) ||
+           anFirst != anOffset || (anBody.empty() && !anOpenEnded))
+        {
+          ELOG() << "AssetDownloader::fetch(" << theURI << ") unexpected range ("
+            << anResponse.getField("content-range") << ")" << std::endl;
+          break;
+        }
+        if(!anBody.empty())
+        {
+          if(!writeFile(anPartFilename, anBody, 0 < anOffset))
+          {
+            break;
+          }
+          if(0 == anOffset)
+          {
+            anPartTag = anResponse.getField("etag");
+            writeFile(anPartTagFilename, anPartTag, false);
+          }
+          anOffset += anBody.size();
+          mBytes += anBody.size();
+        }
+
+        // Keep asking for the next range until the file is complete, which
+        // for a file of unknown length ("bytes a-b/*") is the first range
+        // shorter than requested
+        anOpenEnded = (0 == anTotal && mChunkSize <= anBody.size());
+        if((0 != anTotal && anOffset < anTotal) || anOpenEnded)
+        {
+          continue;
+        }
+        anResult = true;
+      }
+      else if(HTTP_RANGE_NOT_SATISFIABLE == anStatus && anOpenEnded)
+      {
+        // The file of unknown length ended exactly after the last range
+        anResult = true;
+      }
+      else if(HTTP_RANGE_NOT_SATISFIABLE == anStatus && 0 < anOffset && !anRestarted)
+      {
+        // The partial download is longer than the file, start over
+        std::remove(anPartFilename.c_str());
+        std::remove(anPartTagFilename.c_str());
+        anOffset = 0;
+        anRestarted = true;
+        continue;
+      }
+      else
+      {
+        ELOG() << "AssetDownloader::fetch(" << theURI << ") failed with status ("
+          << anStatus << ")" << std::endl;
+        break;
+      }
+
+      // Replace the cached file with the completed download
+      std::remove(theCachedFilename.c_str());
+      if(0 != std::rename(anPartFilename.c_str(), theCachedFilename.c_str()))
+      {
+        ELOG() << "AssetDownloader::fetch(" << theURI << ") unable to rename ("
+          << anPartFilename << ")" << std::endl;
+        anResult = false;
+        break;
+      }
+      if(anPartTag.empty())
+      {
+        std::remove(anTagFilename.c_str());
+      }
+      else
+      {
+        writeFile(anTagFilename, anPartTag, false);
+      }
+      std::remove(anPartTagFilename.c_str());
+      mDownloads++;
+      break;
+    }
+
+    releaseHttp(theHost, thePort, anHttp);
+
+    return anResult;
+  }
+
+  sf::Http* AssetDownloader::acquireHttp(const std::string& theHost, const unsigned short thePort)
+  {
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      for(size_t iloop = 0; iloop < mIdle.size(); iloop++)
+      {
+        if(mIdle[iloop].port == thePort && mIdle[iloop].host == theHost)
+        {
+          sf::Http* anHttp = mIdle[iloop].http;
+          mIdle.erase(mIdle.begin() + iloop);
+          return anHttp;
+        }
+      }
+    }
+
+    // Resolving the host can take a while so do it without the lock
+    sf::Http* anHttp = new(std::nothrow) sf::Http(theHost, thePort);
+    assert(NULL != anHttp && "AssetDownloader::acquireHttp() unable to allocate memory");
+    return anHttp;
+  }
+
+  void AssetDownloader::releaseHttp(const std::string& theHost, const unsigned short thePort,
+    sf::Http* theHttp)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    if(mIdle.size() < MAX_IDLE)
+    {
+      typeConnection anConnection;
+      anConnection.host = theHost;
+      anConnection.port = thePort;
+      anConnection.http = theHttp;
+      mIdle.push_back(anConnection);
+    }
+    else
+    {
+      delete theHttp;
+    }
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
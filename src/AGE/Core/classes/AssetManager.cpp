@@ -17,6 +17,10 @@
  * @date 20110831 - Support new SFML2 snapshot changes
  * @date 20120322 - Support new SFML2 snapshot changes
  * @date 20120503 - Redo AssetManager to be more flexible and use RAII techniques
+ * @date 20261018 - Register handlers by type slot for GetHandler<TYPE>
+ * @date 20261018 - Added ProcessReleases for releases deferred by other threads
+ * @date 20261018 - Register handlers by type name for asset manifests
+ * @date 20261018 - Added GetSavedBytes for assets shared by identical files
  */
 
 #include <AGE/Core/classes/AssetManager.hpp>
@@ -48,6 +52,10 @@ namespace AGE
       // Delete the Asset Handler
       delete anAssetHandler;
     }
+
+    // Every handler in mSlots and mNames was also in mHandlers
+    mSlots.clear();
+    mNames.clear();
   }
 
   IAssetHandler& AssetManager::getHandler(const Id theAssetHandlerID) const
@@ -79,7 +87,8 @@ namespace AGE
     return *anResult;
   }
 
-  void AssetManager::registerHandler(IAssetHandler* theAssetHandler)
+  void AssetManager::registerHandler(IAssetHandler* theAssetHandler,
+    const std::string& theName)
   {
     // Iterator to the asset if found
     std::map<const Id, IAssetHandler*>::iterator iter;
@@ -97,6 +106,23 @@ namespace AGE
         mHandlers.insert(
           std::pair<const Id, IAssetHandler*>(
           theAssetHandler->getID(), theAssetHandler));
+
+        // Also store it by type slot for GetHandler<TYPE>
+        const Uint32 anSlot = theAssetHandler->getTypeSlot();
+        if(IAssetHandler::NO_TYPE_SLOT != anSlot)
+        {
+          if(anSlot >= mSlots.size())
+          {
+            mSlots.resize(anSlot + 1, NULL);
+          }
+          mSlots[anSlot] = theAssetHandler;
+        }
+
+        // Also store it by name for AssetManifest
+        if(!theName.empty())
+        {
+          mNames[theName] = theAssetHandler;
+        }
       }
       else
       {
@@ -114,6 +140,16 @@ namespace AGE
     }
   }
 
+  IAssetHandler* AssetManager::findHandler(const std::string& theName) const
+  {
+    // Iterator to the handler if found
+    std::map<std::string, IAssetHandler*>::const_iterator iter;
+
+    iter = mNames.find(theName);
+
+    return (iter != mNames.end()) ? iter->second : NULL;
+  }
+
   bool AssetManager::loadAllAssets(void)
   {
     // Return true if all assets load successfully
@@ -138,6 +174,38 @@ namespace AGE
     return anResult;
   }
 
+  void AssetManager::processReleases(void)
+  {
+    // Iterator for each IAssetHandler registered
+    std::map<const Id, IAssetHandler*>::iterator iter;
+
+    // Loop through each asset handler and tell it to release its assets
+    iter = mHandlers.begin();
+    while(iter != mHandlers.end())
+    {
+      iter->second->processReleases();
+
+      // Move to the next registered IAssetHandler derived class
+      iter++;
+    }
+  }
+
+  Uint64 AssetManager::getSavedBytes(void) const
+  {
+    Uint64 anResult = 0;
+
+    // Iterator for each IAssetHandler registered
+    std::map<const Id, IAssetHandler*>::const_iterator iter;
+
+    // Loop through each asset handler and add up the bytes it saved
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      anResult += iter->second->getSavedBytes();
+    }
+
+    return anResult;
+  }
+
 } // namespace AGE
 
 /**
@@ -0,0 +1,417 @@
+/**
+ * Provides the AssetManifest class in the AGE namespace which is responsible
+ * for prefetching a list of assets and their dependencies in the background.
+ *
+ * @file src/AGE/Core/classes/AssetManifest.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Count the assets that failed to load separately
+ */
+
+#include <SFML/System.hpp>
+#include <AGE/Core/classes/AssetManager.hpp>
+#include <AGE/Core/classes/AssetManifest.hpp>
+#include <AGE/Core/classes/ConfigReader.hpp>
+#include <AGE/Core/classes/JobManager.hpp>
+#include <AGE/Core/interfaces/IAssetHandler.hpp>
+#include <AGE/Core/interfaces/IJob.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/StringRef.hpp>
+
+namespace AGE
+{
+  /// Load group of an entry that hasn't been assigned one yet
+  static const Uint32 NO_LEVEL = 0xFFFFFFFF;
+
+  /**
+   * Trim will remove the spaces and tabs from both ends of theString.
+   * @param[in] theString to trim
+   * @return theString without leading or trailing spaces
+   */
+  static StringRef trim(const StringRef theString)
+  {
+    const char* anBegin = theString.data();
+    const char* anEnd = anBegin + theString.size();
+    while(anBegin < anEnd && (*anBegin == ' ' || *anBegin == '\t'))
+    {
+      anBegin++;
+    }
+    while(anEnd > anBegin && (anEnd[-1] == ' ' || anEnd[-1] == '\t'))
+    {
+      anEnd--;
+    }
+    return StringRef(anBegin, anEnd - anBegin);
+  }
+
+  /// Job that loads one asset of an AssetManifest
+  class AssetManifest::LoadJob : public IJob
+  {
+    public:
+      LoadJob(AssetManifest& theManifest, const typeEntry& theEntry) :
+        IJob(theEntry.id.getHash()),
+        mManifest(theManifest),
+        mHandler(*theEntry.handler),
+        mAssetID(theEntry.id),
+        mSucceeded(false)
+      {
+      }
+
+      /**
+       * LoadJob deconstructor will report back to the manifest whether the
+       * asset was loaded, or failed to load or was deleted by
+       * JobManager::deInit without being run.
+       */
+      virtual ~LoadJob()
+      {
+        // Count it as finished first so IsReady never sees it missing
+        if(mSucceeded)
+        {
+          mManifest.mLoaded.fetch_add(1);
+        }
+        else
+        {
+          mManifest.mFailed.fetch_add(1);
+        }
+        mManifest.mLoading.fetch_sub(1);
+      }
+
+      virtual void doJob(void)
+      {
+        mSucceeded = mHandler.loadAsset(mAssetID);
+        if(!mSucceeded)
+        {
+          WLOG() << "AssetManifest::LoadJob(" << mAssetID
+            << ") unable to load asset" << std::endl;
+        }
+      }
+
+    private:
+      /// The manifest to report back to
+      AssetManifest& mManifest;
+      /// The handler to load the asset with
+      IAssetHandler& mHandler;
+      /// The asset to load
+      const assetID  mAssetID;
+      /// True if the asset was loaded by DoJob
+      bool           mSucceeded;
+  }; // class AssetManifest::LoadJob
+
+  AssetManifest::AssetManifest(AssetManager& theAssetManager, JobManager& theJobManager) :
+    mAssetManager(theAssetManager),
+    mJobManager(theJobManager),
+    mNextLevel(0),
+    mLevels(0),
+    mPrefetched(false),
+    mLoading(0),
+    mLoaded(0),
+    mFailed(0)
+  {
+  }
+
+  AssetManifest::~AssetManifest()
+  {
+    release();
+  }
+
+  bool AssetManifest::loadFromFile(const std::string& theFilename,
+      const std::string& theSection)
+  {
+    ConfigReader anConfig;
+    if(!anConfig.loadFromFile(theFilename))
+    {
+      ELOG() << "AssetManifest::loadFromFile(" << theFilename
+        << ") unable to read manifest" << std::endl;
+      return false;
+    }
+    return loadFromConfig(anConfig, theSection);
+  }
+
+  bool AssetManifest::loadFromConfig(const ConfigReader& theConfig,
+      const std::string& theSection)
+  {
+    bool anResult = true;
+
+    std::vector<std::string> anNames;
+    theConfig.getNames(theSection, anNames);
+
+    // Read each value once, the first item is the handler type name
+    std::vector<std::string> anValues(anNames.size());
+    for(size_t iloop = 0; iloop < anNames.size(); iloop++)
+    {
+      anValues[iloop] = theConfig.getString(theSection, anNames[iloop], "");
+      StringRef anValue(anValues[iloop]);
+      size_t anComma = 0;
+      while(anComma < anValue.size() && anValue[anComma] != ',')
+      {
+        anComma++;
+      }
+      anResult &= addAsset(trim(StringRef(anValue.data(), anComma)).str(),
+          anNames[iloop]);
+    }
+
+    // Now every asset exists, add the dependencies that follow each type
+    for(size_t iloop = 0; iloop < anNames.size(); iloop++)
+    {
+      const char* anBegin = anValues[iloop].c_str();
+      const char* anEnd = anBegin + anValues[iloop].size();
+
+      // Skip the handler type name
+      while(anBegin < anEnd && *anBegin != ',')
+      {
+        anBegin++;
+      }
+      while(anBegin < anEnd)
+      {
+        const char* anItem = ++anBegin;
+        while(anBegin < anEnd && *anBegin != ',')
+        {
+          anBegin++;
+        }
+        StringRef anDependency = trim(StringRef(anItem, anBegin - anItem));
+        if(!anDependency.empty())
+        {
+          addDependency(anNames[iloop], Symbol(anDependency));
+        }
+      }
+    }
+
+    return anResult;
+  }
+
+  bool AssetManifest::addAsset(const std::string& theType, const assetID theAssetID)
+  {
+    IAssetHandler* anHandler = mAssetManager.findHandler(theType);
+    if(NULL == anHandler)
+    {
+      ELOG() << "AssetManifest::addAsset(" << theType << "," << theAssetID
+        << ") unknown asset type" << std::endl;
+      return false;
+    }
+
+    if(mPrefetched)
+    {
+      WLOG() << "AssetManifest::addAsset(" << theType << "," << theAssetID
+        << ") added after Prefetch will not be prefetched" << std::endl;
+    }
+
+    if(findEntry(theAssetID) == mEntries.size())
+    {
+      typeEntry anEntry;
+      anEntry.id = theAssetID;
+      anEntry.handler = anHandler;
+      anEntry.level = NO_LEVEL;
+      anEntry.referenced = false;
+      mEntries.push_back(anEntry);
+    }
+
+    return true;
+  }
+
+  void AssetManifest::addDependency(const assetID theAssetID,
+      const assetID theDependencyID)
+  {
+    Uint32 anIndex = findEntry(theAssetID);
+    Uint32 anDependency = findEntry(theDependencyID);
+    if(anIndex == mEntries.size() || anDependency == mEntries.size())
+    {
+      ELOG() << "AssetManifest::addDependency(" << theAssetID << ","
+        << theDependencyID << ") both assets must be added first" << std::endl;
+      return;
+    }
+    mEntries[anIndex].dependencies.push_back(anDependency);
+  }
+
+  void AssetManifest::prefetch(void)
+  {
+    if(mPrefetched)
+    {
+      return;
+    }
+
+    // Assign each asset to the load group after its dependencies
+    mLevels = 0;
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      mEntries[iloop].level = NO_LEVEL;
+    }
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      Uint32 anLevel = getLevel(iloop, 0);
+      if(anLevel + 1 > mLevels)
+      {
+        mLevels = anLevel + 1;
+      }
+    }
+
+    // Keep every asset resident until Release is called
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      mEntries[iloop].referenced =
+        mEntries[iloop].handler->addReference(mEntries[iloop].id);
+    }
+
+    mLoaded = 0;
+    mFailed = 0;
+    mLoading = 0;
+    mNextLevel = 0;
+    mPrefetched = true;
+
+    // Start loading the assets without any dependencies
+    startLevel();
+  }
+
+  void AssetManifest::update(void)
+  {
+    // Start the next group once the current group has finished
+    if(mPrefetched && 0 == mLoading.load() && mNextLevel < mLevels)
+    {
+      startLevel();
+    }
+  }
+
+  void AssetManifest::release(void)
+  {
+    if(!mPrefetched)
+    {
+      return;
+    }
+
+    // The LoadJobs refer to us so wait for any still running
+    while(0 != mLoading.load())
+    {
+      sf::sleep(sf::milliseconds(1));
+    }
+
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      if(mEntries[iloop].referenced)
+      {
+        mEntries[iloop].handler->dropReference(mEntries[iloop].id);
+        mEntries[iloop].referenced = false;
+      }
+    }
+
+    mPrefetched = false;
+  }
+
+  bool AssetManifest::isEmpty(void) const
+  {
+    return mEntries.empty();
+  }
+
+  bool AssetManifest::isReady(void) const
+  {
+    return mPrefetched && mLoaded.load() + mFailed.load() == mEntries.size();
+  }
+
+  bool AssetManifest::hasFailed(void) const
+  {
+    return 0 != mFailed.load();
+  }
+
+  float AssetManifest::getProgress(void) const
+  {
+    if(mEntries.empty())
+    {
+      return 100.0f;
+    }
+    return 100.0f * (float)(mLoaded.load() + mFailed.load()) / (float)mEntries.size();
+  }
+
+  Uint32 AssetManifest::findEntry(const assetID theAssetID) const
+  {
+    Uint32 anResult = 0;
+    while(anResult < mEntries.size() && mEntries[anResult].id != theAssetID)
+    {
+      anResult++;
+    }
+    return anResult;
+  }
+
+  Uint32 AssetManifest::getLevel(const Uint32 theIndex, const Uint32 theDepth)
+  {
+    typeEntry& anEntry = mEntries[theIndex];
+
+    // Already assigned a load group?
+    if(NO_LEVEL != anEntry.level)
+    {
+      return anEntry.level;
+    }
+
+    // Deeper than the number of assets means there is a cycle
+    if(theDepth > mEntries.size())
+    {
+      ELOG() << "AssetManifest::getLevel(" << anEntry.id
+        << ") dependency cycle found" << std::endl;
+      return 0;
+    }
+
+    Uint32 anLevel = 0;
+    for(size_t iloop = 0; iloop < anEntry.dependencies.size(); iloop++)
+    {
+      Uint32 anDependency = getLevel(anEntry.dependencies[iloop], theDepth + 1);
+      if(anDependency + 1 > anLevel)
+      {
+        anLevel = anDependency + 1;
+      }
+    }
+
+    // Don't use anEntry here, it may not be assigned until the cycle unwinds
+    mEntries[theIndex].level = anLevel;
+    return anLevel;
+  }
+
+  void AssetManifest::startLevel(void)
+  {
+    // Count the whole group first since jobs may finish before we return
+    Uint32 anCount = 0;
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      if(mEntries[iloop].level == mNextLevel)
+      {
+        anCount++;
+      }
+    }
+    mLoading.fetch_add(anCount);
+
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      if(mEntries[iloop].level == mNextLevel)
+      {
+        LoadJob* anJob = new(std::nothrow) LoadJob(*this, mEntries[iloop]);
+        if(NULL == anJob)
+        {
+          ELOG() << "AssetManifest::startLevel(" << mEntries[iloop].id
+            << ") unable to create LoadJob" << std::endl;
+          mFailed.fetch_add(1);
+          mLoading.fetch_sub(1);
+          continue;
+        }
+        mJobManager.addJob(anJob);
+      }
+    }
+
+    mNextLevel++;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -19,55 +19,108 @@
  * @date 20110820 - Changed Read to LoadFromFile to match SFML style
  * @date 20110820 - Removed GetColor, use GetString and ParseColor instead
  * @date 20120512 - Renamed App to Game since it really is just an interface
+ * @date 20261018 - Memory mapped one pass parser without the line length limit
+ * @date 20261018 - Flat hashed section/name table with ID overloads and typed value cache
+ * @date 20261018 - Added binary compiled cache of parsed configuration files
+ * @date 20261018 - Parse typed values with the locale-free StringUtil scanners
+ * @date 20261018 - Added GetNames for listing every name in a section
+ * @date 20261018 - Parse typed values when stored so getters never write
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <AGE/Core/classes/ConfigReader.hpp>
-#include <AGE/Core/interfaces/Game.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
 #include <AGE/Core/utils/StringUtil.hpp>
 
 namespace AGE
 {
-  ConfigReader::ConfigReader()
+  /// Minimum number of slots in the hash table once a pair is stored
+  static const Uint32 CONFIG_MIN_TABLE = 64;
+  /// Magic value at the start of every binary cache file ("AGEC")
+  static const Uint32 CONFIG_CACHE_MAGIC = 0x43454741;
+  /// Version of the binary cache file format
+  static const Uint16 CONFIG_CACHE_VERSION = 2;
+  /// Byte order marker written in native byte order in the cache header
+  static const Uint16 CONFIG_CACHE_BYTE_ORDER = 0x0102;
+  /// Every typed value of an entry in a binary cache has been parsed
+  static const Uint8 CONFIG_CACHE_PARSED = 0x07;
+
+  /// Header at the start of every binary cache file
+  struct typeConfigCache
+  {
+    Uint32 magic;          ///< CONFIG_CACHE_MAGIC
+    Uint16 version;        ///< CONFIG_CACHE_VERSION
+    Uint16 byteOrder;      ///< CONFIG_CACHE_BYTE_ORDER
+    Uint32 entrySize;      ///< Size of each entry structure
+    Uint32 sectionSize;    ///< Size of each section structure
+    Uint64 sourceSize;     ///< Size of the source file
+    Int64  sourceModified; ///< Modification time of the source file
+    Uint32 sourceHash;     ///< CRC32 of the source file
+    Uint32 entries;        ///< Number of entries that follow the header
+    Uint32 table;          ///< Number of hash table slots after the entries
+    Uint32 sections;       ///< Number of sections after the hash table
+    Uint32 strings;        ///< Number of string bytes after the sections
+    Uint32 reserved;       ///< Keeps the header a multiple of 8 bytes
+  };
+
+  bool ConfigReader::gCacheEnabled = true;
+  std::string ConfigReader::gCacheDirectory;
+
+  ConfigReader::ConfigReader() :
+    mImage(NULL),
+    mEntryData(NULL),
+    mEntryCount(0),
+    mTableData(NULL),
+    mTableSize(0),
+    mSectionData(NULL),
+    mSectionCount(0),
+    mStringData(NULL),
+    mStringSize(0)
   {
     ILOGM("ConfigReader::ctor()");
   }
 
   ConfigReader::ConfigReader(const ConfigReader& theCopy) :
-    mSections(theCopy.mSections)
+    mEntries(theCopy.mEntryData, theCopy.mEntryData + theCopy.mEntryCount),
+    mTable(theCopy.mTableData, theCopy.mTableData + theCopy.mTableSize),
+    mSections(theCopy.mSectionData, theCopy.mSectionData + theCopy.mSectionCount),
+    mStrings(theCopy.mStringData, theCopy.mStringData + theCopy.mStringSize),
+    mImage(NULL)
   {
+    // Copies always own their data even if theCopy uses a binary cache
+    refresh();
   }
 
   ConfigReader::~ConfigReader()
   {
     ILOGM("ConfigReader::dtor()");
 
-    // Delete all section name, value maps
-    std::map<const std::string, typeNameValue*>::iterator iter;
-    iter = mSections.begin();
-    while(iter != mSections.end())
-    {
-      typeNameValue* anMap = iter->second;
-      mSections.erase(iter++);
-      delete anMap;
-    }
+    // Release the binary cache if one is being used
+    delete mImage;
+    mImage = NULL;
   }
 
-  bool ConfigReader::isSectionEmpty(const std::string theSection) const
+  bool ConfigReader::isSectionEmpty(const std::string& theSection) const
+  {
+    return isSectionEmpty(getId(theSection));
+  }
+
+  bool ConfigReader::isSectionEmpty(const Id theSection) const
   {
     bool anResult = false;
 
     // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    for(Uint32 iloop = 0; iloop < mSectionCount; iloop++)
     {
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      if(mSectionData[iloop].id == theSection)
       {
-        anResult = anMap->empty();
+        anResult = (0 == mSectionData[iloop].count);
+        break;
       }
     }
 
@@ -75,53 +128,44 @@ namespace AGE
     return anResult;
   }
 
-  bool ConfigReader::getBool(const std::string theSection,
-      const std::string theName, const bool theDefault) const
+  void ConfigReader::getNames(const std::string& theSection,
+      std::vector<std::string>& theNames) const
   {
-    bool anResult = theDefault;
+    getNames(getId(theSection), theNames);
+  }
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+  void ConfigReader::getNames(const Id theSection,
+      std::vector<std::string>& theNames) const
+  {
+    // Entries are stored in the order they were read
+    for(Uint32 iloop = 0; iloop < mEntryCount; iloop++)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      if((Id)(mEntryData[iloop].key >> 32) == theSection)
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = parseBool(iterNameValue->second, theDefault);
-        }
+        theNames.push_back(std::string(mStringData + mEntryData[iloop].name));
       }
     }
+  }
 
-    // Return the result found or theDefault assigned above
-    return anResult;
+  bool ConfigReader::getBool(const std::string& theSection,
+      const std::string& theName, const bool theDefault) const
+  {
+    return getBool(getId(theSection), getId(theName), theDefault);
   }
 
-  float ConfigReader::getFloat(const std::string theSection,
-      const std::string theName, const float theDefault) const
+  bool ConfigReader::getBool(const Id theSection, const Id theName,
+      const bool theDefault) const
   {
-    float anResult = theDefault;
+    bool anResult = theDefault;
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    // Try to obtain the name, value pair
+    const typeEntry* anEntry = findEntry(((Uint64)theSection << 32) | theName);
+    if(NULL != anEntry)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      // Values are parsed as every type when they are stored
+      if(0 != (anEntry->valid & ParsedBool))
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = parseFloat(iterNameValue->second, theDefault);
-        }
+        anResult = anEntry->asBool;
       }
     }
 
@@ -129,26 +173,25 @@ namespace AGE
     return anResult;
   }
 
-  std::string ConfigReader::getString(const std::string theSection,
-      const std::string theName, const std::string theDefault) const
+  float ConfigReader::getFloat(const std::string& theSection,
+      const std::string& theName, const float theDefault) const
   {
-    std::string anResult = theDefault;
+    return getFloat(getId(theSection), getId(theName), theDefault);
+  }
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+  float ConfigReader::getFloat(const Id theSection, const Id theName,
+      const float theDefault) const
+  {
+    float anResult = theDefault;
+
+    // Try to obtain the name, value pair
+    const typeEntry* anEntry = findEntry(((Uint64)theSection << 32) | theName);
+    if(NULL != anEntry)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      // Values are parsed as every type when they are stored
+      if(0 != (anEntry->valid & ParsedFloat))
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = iterNameValue->second;
-        }
+        anResult = anEntry->asFloat;
       }
     }
 
@@ -156,26 +199,45 @@ namespace AGE
     return anResult;
   }
 
-  Uint32 ConfigReader::getUint32(const std::string theSection,
-      const std::string theName, const Uint32 theDefault) const
+  std::string ConfigReader::getString(const std::string& theSection,
+      const std::string& theName, const std::string theDefault) const
+  {
+    return getString(getId(theSection), getId(theName), theDefault);
+  }
+
+  std::string ConfigReader::getString(const Id theSection, const Id theName,
+      const std::string theDefault) const
+  {
+    // Try to obtain the name, value pair
+    const typeEntry* anEntry = findEntry(((Uint64)theSection << 32) | theName);
+    if(NULL != anEntry)
+    {
+      return std::string(&mStringData[anEntry->value], anEntry->size);
+    }
+
+    // Return theDefault since the value was not found
+    return theDefault;
+  }
+
+  Uint32 ConfigReader::getUint32(const std::string& theSection,
+      const std::string& theName, const Uint32 theDefault) const
+  {
+    return getUint32(getId(theSection), getId(theName), theDefault);
+  }
+
+  Uint32 ConfigReader::getUint32(const Id theSection, const Id theName,
+      const Uint32 theDefault) const
   {
     Uint32 anResult = theDefault;
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    // Try to obtain the name, value pair
+    const typeEntry* anEntry = findEntry(((Uint64)theSection << 32) | theName);
+    if(NULL != anEntry)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      // Values are parsed as every type when they are stored
+      if(0 != (anEntry->valid & ParsedUint32))
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = parseUint32(iterNameValue->second, theDefault);
-        }
+        anResult = anEntry->asUint32;
       }
     }
 
@@ -186,262 +248,594 @@ namespace AGE
   bool ConfigReader::loadFromFile(const std::string theFilename)
   {
     bool anResult = false;
-    char anLine[MAX_CHARS];
-    std::string anSection;
-    unsigned long anCount = 1;
 
     // Let the log know about the file we are about to read in
-    ILOG() << "ConfigReader:read(" << theFilename << ") opening..." << std::endl;
+    ILOG() << "ConfigReader::loadFromFile(" << theFilename << ") opening..." << std::endl;
 
-    // Attempt to open the file
-    FILE* anFile = fopen(theFilename.c_str(), "r");
-
-    // Read from the file if successful
-    if(NULL != anFile)
+    // Attempt to map the entire file into memory
+    MemoryMappedFile anFile;
+    if(anFile.open(theFilename))
     {
-      // Keep reading from configuration file until we reach the end of file marker
-      while(!feof(anFile))
+      // Binary caches are only used when nothing has been loaded yet
+      bool anCache = gCacheEnabled && 0 == mEntryCount && 0 == mSectionCount;
+      std::string anCacheFilename = getCacheFilename(theFilename);
+
+      // Use the binary cache if it matches or parse the file in place
+      if(anCache && loadCache(anCacheFilename, anFile))
       {
-        // Get the first line from the file
-        if(fgets(anLine, MAX_CHARS, anFile) == NULL)
-        {
-          // Log the failure to read a line from the file if not at the end of the file
-          if(!feof(anFile))
-          {
-            ELOG() << "ConfigReader::read(" << anFile << ") error reading line " << anCount << std::endl;
-          }
-          // Exit our while loop, were done!
-          break;
-        }
-        else
+        ILOG() << "ConfigReader::loadFromFile(" << theFilename << ") using "
+          << anCacheFilename << std::endl;
+      }
+      else
+      {
+        // The mapping of the file is released when we return
+        parse(anFile.getData(), anFile.getSize());
+
+        // Write the binary cache for the next time this file is loaded
+        if(anCache)
         {
-          // Parse the line
-          anSection = parseLine(anLine, anCount, anSection);
+          writeCache(anCacheFilename, anFile);
         }
-
-        // Increment our Line counter
-        anCount++;
       }
 
-      // Don't forget to close the file
-      fclose(anFile);
-
       // Set success result
       anResult = true;
     }
     else
     {
-      ELOG() << "ConfigReader::read(" << theFilename << ") error opening file" << std::endl;
+      ELOG() << "ConfigReader::loadFromFile(" << theFilename << ") error opening file" << std::endl;
     }
 
     // Return anResult of true if successful, false otherwise
     return anResult;
   }
 
+  bool ConfigReader::loadFromMemory(const char* theData, const size_t theSize)
+  {
+    // Parse theData provided in place
+    parse(theData, theSize);
+
+    // Parsing errors are logged but never cause the load to fail
+    return true;
+  }
+
   ConfigReader& ConfigReader::operator=(const ConfigReader& theRight)
   {
     // Use copy constructor to duplicate theRight side
     ConfigReader temp(theRight);
 
-    // Now swap my local copy with the copy from theRight
+    // Now swap my local copy with the copy from theRight, swapping the
+    // vectors keeps the views pointing at the same buffers
+    std::swap(mEntries, temp.mEntries);
+    std::swap(mTable, temp.mTable);
     std::swap(mSections, temp.mSections);
+    std::swap(mStrings, temp.mStrings);
+    std::swap(mImage, temp.mImage);
+    std::swap(mEntryData, temp.mEntryData);
+    std::swap(mEntryCount, temp.mEntryCount);
+    std::swap(mTableData, temp.mTableData);
+    std::swap(mTableSize, temp.mTableSize);
+    std::swap(mSectionData, temp.mSectionData);
+    std::swap(mSectionCount, temp.mSectionCount);
+    std::swap(mStringData, temp.mStringData);
+    std::swap(mStringSize, temp.mStringSize);
 
     // Return my pointer
     return *this;
   }
 
-  std::string ConfigReader::parseLine(const char* theLine,
-      const unsigned long theCount, const std::string theSection)
+  void ConfigReader::setCacheEnabled(const bool theEnabled)
+  {
+    gCacheEnabled = theEnabled;
+  }
+
+  void ConfigReader::setCacheDirectory(const std::string& theDirectory)
+  {
+    gCacheDirectory = theDirectory;
+  }
+
+  std::string ConfigReader::getCacheFilename(const std::string& theFilename)
   {
-    std::string anResult = theSection;
-    size_t anLength = strlen(theLine);
-    if(anLength > 1)
+    // Write the cache next to the source file by default
+    if(gCacheDirectory.empty())
+    {
+      return theFilename + ".bin";
+    }
+
+    // Flatten the path of theFilename into a unique name in the directory
+    std::string anResult = theFilename;
+    for(size_t iloop = 0; iloop < anResult.size(); iloop++)
     {
-      // Skip preceeding spaces at the begining of the line
-      size_t anOffset = 0;
-      while(anOffset < anLength && theLine[anOffset] == ' ')
+      if(anResult[iloop] == '/' || anResult[iloop] == '\\' || anResult[iloop] == ':')
       {
-        anOffset++;
+        anResult[iloop] = '_';
       }
+    }
+    return gCacheDirectory + "/" + anResult + ".bin";
+  }
+
+  void ConfigReader::parse(const char* theData, const size_t theSize)
+  {
+    // Copy any binary cache being used so we can add to it
+    detach();
+
+    const char* anEnd = theData + theSize;
+    const char* anLine = theData;
+    size_t anSection = storeSection(StringRef());
+    unsigned long anCount = 1;
+    unsigned long anPairs = 0;
+
+    // Names and values are never longer than the data they are parsed from
+    mStrings.reserve(mStrings.size() + theSize);
 
-      // Now check for comments
-      if(theLine[anOffset] != '#' && theLine[anOffset] != ';')
+    // Tokenize each line in place, no copies are made until a pair is stored
+    for(; anLine < anEnd; anCount++)
+    {
+      // Find the end of this line and the start of the next one
+      const char* anEOL = (const char*)memchr(anLine, '\n', anEnd - anLine);
+      if(NULL == anEOL)
       {
-        // Next check for the start of a new section
-        if(theLine[anOffset] == '[')
-        {
-          // Skip over the begin section marker '['
-          anOffset++;
+        anEOL = anEnd;
+      }
+      const char* anNext = anEOL < anEnd ? anEOL + 1 : anEnd;
 
-          // Skip preceeding spaces of section name
-          while(anOffset < anLength && theLine[anOffset] == ' ')
-          {
-            anOffset++;
-          }
+      // Skip preceeding spaces and trailing spaces/carriage returns
+      while(anLine < anEOL && (*anLine == ' ' || *anLine == '\t'))
+      {
+        anLine++;
+      }
+      while(anEOL > anLine &&
+          (anEOL[-1] == ' ' || anEOL[-1] == '\t' || anEOL[-1] == '\r'))
+      {
+        anEOL--;
+      }
 
-          // Retrieve the section name while looking for the section end marker ']'
-          size_t anIndex = 0;
-          char anSection[MAX_CHARS] = {0};
-          while((anOffset+anIndex) < anLength && theLine[anOffset+anIndex] != ']')
-          {
-            // Retrieve the section name from theLine
-            anSection[anIndex] = theLine[anOffset+anIndex];
+      // Skip empty lines and comments
+      if(anLine == anEOL || *anLine == '#' || *anLine == ';')
+      {
+        anLine = anNext;
+        continue;
+      }
 
-            // Increment anIndex
-            anIndex++;
-          }
-          // Add null terminator
-          anSection[anIndex] = '\0';
-          // Remove trailing spaces
-          while(anIndex > 0 && anSection[anIndex-1] == ' ')
-          {
-            // Put a null terminator at the end of the section name
-            anSection[--anIndex] = '\0';
-          }
+      // Next check for the start of a new section
+      if(*anLine == '[')
+      {
+        // Look for the section end marker ']'
+        const char* anClose = (const char*)memchr(anLine, ']', anEOL - anLine);
+        StringRef anName = trim(anLine + 1, NULL == anClose ? anLine + 1 : anClose);
 
-          // Only update the current section name if we found the section end
-          // marker before the end of the line
-          if((anOffset+anIndex) < anLength && anIndex > 0)
-          {
-            // Change the return string to the newly parsed section name
-            anResult = anSection;
-          }
-          else
-          {
-            ELOG() << "ConfigReader::parseLine(" << theCount << ") missing section end marker ']'" << std::endl;
-          }
+        // Only update the current section if we found the section end
+        // marker and a section name
+        if(NULL != anClose && !anName.empty())
+        {
+          anSection = storeSection(anName);
         }
-        // Just read the name=value pair into the current section
         else
         {
-          // Retrieve the name and value while looking for the comment flags ';' or '#'
-          size_t anNameIndex = 0;
-          char anName[MAX_CHARS];
-
-          // First retrieve the name while looking for either the '=' or ':' delimiter
-          while((anOffset+anNameIndex) < anLength &&
-              theLine[(anOffset+anNameIndex)] != '=' &&
-              theLine[(anOffset+anNameIndex)] != ':')
-          {
-            // Retrieve anName from theLine
-            anName[anNameIndex] = theLine[anOffset+anNameIndex];
+          ELOG() << "ConfigReader::parse(" << anCount << ") missing section end marker ']'" << std::endl;
+        }
+      }
+      // Just read the name=value pair into the current section
+      else
+      {
+        // Find the '=' or ':' delimiter between the name and value
+        const char* anDelimiter = anLine;
+        while(anDelimiter < anEOL && *anDelimiter != '=' && *anDelimiter != ':')
+        {
+          anDelimiter++;
+        }
+        StringRef anName = trim(anLine, anDelimiter);
 
-            // Increment anNameIndex
-            anNameIndex++;
-          }
-          // Assign our starting offset value
-          anOffset += anNameIndex;
-          // Put a null terminator at the end of the name
-          anName[anNameIndex] = '\0';
-          // Remove trailing spaces from the name
-          while(anNameIndex > 0 && anName[anNameIndex-1] == ' ')
+        // Only store the value if we found the delimiter and a name
+        if(anDelimiter < anEOL && !anName.empty())
+        {
+          // The value ends at the end of the line or a comment flag ';' or '#'
+          const char* anValue = anDelimiter + 1;
+          const char* anValueEnd = anValue;
+          while(anValueEnd < anEOL && *anValueEnd != ';' && *anValueEnd != '#')
           {
-            // Put a null terminator at the end of the name
-            anName[--anNameIndex] = '\0';
+            anValueEnd++;
           }
 
-          // Only search for the value if we found the '=' or ':' delimiter
-          if(anOffset < anLength && anNameIndex > 0)
-          {
-            size_t anValueIndex = 0;
-            char anValue[MAX_CHARS];
-
-            // Skip over the delimiter between name and value '=' or ':'
-            anOffset++;
-
-            // Skip preceeding spaces
-            while(anOffset < anLength && theLine[anOffset] == ' ')
-            {
-              anOffset++;
-            }
-            // Next retrieve the value while looking for comments flags ';' or '#'
-            while((anOffset + anValueIndex) < anLength &&
-                theLine[(anOffset+anValueIndex)] != '\r' &&
-                theLine[(anOffset+anValueIndex)] != '\n' &&
-                theLine[(anOffset+anValueIndex)] != ';' &&
-                theLine[(anOffset+anValueIndex)] != '#')
-            {
-              // Retrieve anValue from theLine
-              anValue[anValueIndex] = theLine[anOffset+anValueIndex];
-
-              // Increment anValueIndex
-              anValueIndex++;
-            }
-            // Put a null terminator at the end of the section name
-            anValue[anValueIndex] = '\0';
-            // Remove trailing spaces from the name
-            while(anValueIndex > 0 && anValue[anValueIndex-1] == ' ')
-            {
-              // Put a null terminator at the end of the name
-              anValue[--anValueIndex] = '\0';
-            }
-
-            // Store the name,value pair obtained into the current section
-            storeNameValue(theSection,anName,anValue);
-          }
-          else
+          // Store the name,value pair obtained into the current section
+          if(storeNameValue(anSection, anName, trim(anValue, anValueEnd)))
           {
-            ELOG() << "ConfigReader::parseLine(" << theCount << ") missing name or value delimiter of '=' or ':'" << std::endl;
+            anPairs++;
           }
         }
-      } // if(theLine[anOffset] != '#' && theLine[anOffset] != ';') // Not a comment
-    } // if(anLength > 1)
+        else
+        {
+          ELOG() << "ConfigReader::parse(" << anCount << ") missing name or value delimiter of '=' or ':'" << std::endl;
+        }
+      }
 
-    // Return either the previous section name or the new section name found
-    return anResult;
+      // Move on to the next line
+      anLine = anNext;
+    }
+
+    ILOG() << "ConfigReader::parse() " << anPairs << " name,value pairs from "
+      << (anCount - 1) << " lines" << std::endl;
   }
 
-  void ConfigReader::storeNameValue(const std::string theSection,
-      const std::string theName, const std::string theValue)
+  StringRef ConfigReader::trim(const char* theBegin, const char* theEnd)
   {
-    // Check if the name, value map already exists for theSection
-    std::map<const std::string, typeNameValue*>::iterator iterSection;
-    iterSection = mSections.find(theSection);
-    if(iterSection == mSections.end())
+    // Remove preceeding spaces
+    while(theBegin < theEnd && (*theBegin == ' ' || *theBegin == '\t'))
+    {
+      theBegin++;
+    }
+
+    // Remove trailing spaces
+    while(theEnd > theBegin && (theEnd[-1] == ' ' || theEnd[-1] == '\t'))
     {
-      // First try to create a new name, value pair map for this new section
-      typeNameValue* anMap = new(std::nothrow) typeNameValue;
+      theEnd--;
+    }
+
+    return StringRef(theBegin, theEnd - theBegin);
+  }
+
+  Id ConfigReader::getId(const StringRef theString)
+  {
+    return crc32_runtime(theString.data(), theString.size());
+  }
+
+  Uint32 ConfigReader::storeString(const StringRef theString)
+  {
+    Uint32 anResult = (Uint32)mStrings.size();
+
+    // Copy theString followed by a null terminator
+    mStrings.insert(mStrings.end(), theString.data(), theString.data() + theString.size());
+    mStrings.push_back('\0');
+
+    return anResult;
+  }
+
+  size_t ConfigReader::storeSection(const StringRef theSection)
+  {
+    Id anID = getId(theSection);
 
-      // Make sure we were able to create the map ok
-      if(NULL != anMap)
+    // Check if theSection already exists
+    for(size_t iloop = 0; iloop < mSections.size(); iloop++)
+    {
+      if(mSections[iloop].id == anID)
       {
-        ILOG() << "ConfigReader::storeNameValue(" << theSection << ") adding (" << theName << "," << theValue << ")" << std::endl;
+        // Different section names with the same ID can't be told apart
+        if(theSection != StringRef(&mStrings[mSections[iloop].name]))
+        {
+          ELOG() << "ConfigReader::storeSection(" << theSection.str()
+            << ") has the same ID as section (" << &mStrings[mSections[iloop].name]
+            << "), merging them!" << std::endl;
+        }
+        return iloop;
+      }
+    }
+
+    // Add the new section
+    typeSection anSection;
+    anSection.id = anID;
+    anSection.name = storeString(theSection);
+    anSection.count = 0;
+    mSections.push_back(anSection);
+    refresh();
+
+    return mSections.size() - 1;
+  }
 
-        // Add the new name, value pair to this map
-        anMap->insert(std::pair<const std::string, const std::string>(theName,theValue));
+  bool ConfigReader::storeNameValue(const size_t theSection,
+      const StringRef theName, const StringRef theValue)
+  {
+    typeSection& anSection = mSections[theSection];
+    Uint64 anKey = ((Uint64)anSection.id << 32) | getId(theName);
 
-        // Add the new name, value pair map for this new section
-        mSections.insert(std::pair<const std::string, typeNameValue*>(theSection, anMap));
+    // Make sure the name, value pair doesn't already exist
+    const typeEntry* anExisting = findEntry(anKey);
+    if(NULL != anExisting)
+    {
+      if(theName == StringRef(&mStrings[anExisting->name]))
+      {
+        ELOG() << "ConfigReader::storeNameValue(" << &mStrings[anSection.name]
+          << ") unable to add (" << theName.str() << "," << theValue.str()
+          << ") already exists!" << std::endl;
       }
       else
       {
-        ELOG() << "ConfigReader::storeNameValue(" << theSection << ") unable to add (" << theName << "," << theValue << ") out of memory!" << std::endl;
+        ELOG() << "ConfigReader::storeNameValue(" << &mStrings[anSection.name]
+          << ") unable to add (" << theName.str() << "," << theValue.str()
+          << ") same ID as (" << &mStrings[anExisting->name] << ")!" << std::endl;
       }
+      return false;
     }
-    else
+
+    // Add the new name, value pair and parse its value as every type now so
+    // the const getters never write to it (readers may be on other threads)
+    typeEntry anEntry;
+    memset(&anEntry, 0, sizeof(anEntry));
+    anEntry.key = anKey;
+    anEntry.name = storeString(theName);
+    anEntry.value = storeString(theValue);
+    anEntry.size = (Uint32)theValue.size();
+    parseValue(anEntry, theValue, ParsedBool);
+    parseValue(anEntry, theValue, ParsedFloat);
+    parseValue(anEntry, theValue, ParsedUint32);
+    mEntries.push_back(anEntry);
+    insertEntry((Uint32)mEntries.size() - 1);
+    anSection.count++;
+    refresh();
+
+    return true;
+  }
+
+  const ConfigReader::typeEntry* ConfigReader::findEntry(const Uint64 theKey) const
+  {
+    // Nothing to find if nothing has been stored yet
+    if(0 == mTableSize)
+    {
+      return NULL;
+    }
+
+    // Linear probe from the slot for theKey until an empty slot is found
+    Uint32 anMask = mTableSize - 1;
+    Uint32 anSlot = ((Uint32)(theKey >> 32) * 0x9E3779B1u ^ (Uint32)theKey) & anMask;
+    while(0 != mTableData[anSlot])
+    {
+      const typeEntry& anEntry = mEntryData[mTableData[anSlot] - 1];
+      if(anEntry.key == theKey)
+      {
+        return &anEntry;
+      }
+      anSlot = (anSlot + 1) & anMask;
+    }
+
+    return NULL;
+  }
+
+  void ConfigReader::insertEntry(const Uint32 theIndex)
+  {
+    // Keep the table at most half full, rebuilding it when it grows
+    if(mTable.size() < mEntries.size() * 2)
+    {
+      Uint32 anSize = mTable.empty() ? CONFIG_MIN_TABLE : (Uint32)mTable.size() * 2;
+      while(anSize < mEntries.size() * 2)
+      {
+        anSize *= 2;
+      }
+      mTable.assign(anSize, 0);
+      for(Uint32 iloop = 0; iloop < theIndex; iloop++)
+      {
+        insertEntry(iloop);
+      }
+    }
+
+    // Store theIndex in the first empty slot for its key
+    Uint32 anMask = (Uint32)mTable.size() - 1;
+    Uint64 anKey = mEntries[theIndex].key;
+    Uint32 anSlot = ((Uint32)(anKey >> 32) * 0x9E3779B1u ^ (Uint32)anKey) & anMask;
+    while(0 != mTable[anSlot])
+    {
+      anSlot = (anSlot + 1) & anMask;
+    }
+    mTable[anSlot] = theIndex + 1;
+  }
+
+  void ConfigReader::refresh(void)
+  {
+    mEntryData = mEntries.empty() ? NULL : &mEntries[0];
+    mEntryCount = (Uint32)mEntries.size();
+    mTableData = mTable.empty() ? NULL : &mTable[0];
+    mTableSize = (Uint32)mTable.size();
+    mSectionData = mSections.empty() ? NULL : &mSections[0];
+    mSectionCount = (Uint32)mSections.size();
+    mStringData = mStrings.empty() ? NULL : &mStrings[0];
+    mStringSize = (Uint32)mStrings.size();
+  }
+
+  void ConfigReader::detach(void)
+  {
+    // Nothing to do if we already own our data
+    if(NULL == mImage)
+    {
+      return;
+    }
+
+    // Copy the binary cache into our own vectors
+    mEntries.assign(mEntryData, mEntryData + mEntryCount);
+    mTable.assign(mTableData, mTableData + mTableSize);
+    mSections.assign(mSectionData, mSectionData + mSectionCount);
+    mStrings.assign(mStringData, mStringData + mStringSize);
+
+    // Release the binary cache and point our views at our vectors
+    delete mImage;
+    mImage = NULL;
+    refresh();
+  }
+
+  bool ConfigReader::loadCache(const std::string& theCacheFilename,
+      const MemoryMappedFile& theSource)
+  {
+    // A missing cache is expected, so check for it before trying to map it
+    FILE* anFile = fopen(theCacheFilename.c_str(), "rb");
+    if(NULL == anFile)
     {
-      // Retrieve the existing name, value pair map
-      typeNameValue* anMap = iterSection->second;
+      return false;
+    }
+    fclose(anFile);
+
+    MemoryMappedFile* anImage = new(std::nothrow) MemoryMappedFile();
+    if(NULL == anImage || !anImage->open(theCacheFilename) ||
+        anImage->getSize() < sizeof(typeConfigCache))
+    {
+      delete anImage;
+      return false;
+    }
 
-      // Make sure we were able to retrieve the map ok
-      if(NULL != anMap)
+    // Validate the header against this build and theSource provided
+    typeConfigCache anHeader;
+    memcpy(&anHeader, anImage->getData(), sizeof(anHeader));
+    Uint64 anSize = sizeof(anHeader) + (Uint64)anHeader.entries * sizeof(typeEntry) +
+      (Uint64)anHeader.table * sizeof(Uint32) +
+      (Uint64)anHeader.sections * sizeof(typeSection) + anHeader.strings;
+    bool anValid = CONFIG_CACHE_MAGIC == anHeader.magic &&
+      CONFIG_CACHE_VERSION == anHeader.version &&
+      CONFIG_CACHE_BYTE_ORDER == anHeader.byteOrder &&
+      sizeof(typeEntry) == anHeader.entrySize &&
+      sizeof(typeSection) == anHeader.sectionSize &&
+      anSize == anImage->getSize() &&
+      theSource.getSize() == anHeader.sourceSize &&
+      0 == (anHeader.table & (anHeader.table - 1)) &&
+      anHeader.entries * 2 <= anHeader.table &&
+      0 < anHeader.strings;
+
+    // If only the modification time changed compare the contents instead
+    if(anValid && theSource.getModifiedTime() != anHeader.sourceModified)
+    {
+      anValid = anHeader.sourceHash ==
+        crc32_runtime(theSource.getData(), theSource.getSize());
+      if(anValid)
       {
-        // Make sure the name, value pair doesn't already in the map
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue == anMap->end())
+        // Remember the new modification time for the next load
+        anHeader.sourceModified = theSource.getModifiedTime();
+        anFile = fopen(theCacheFilename.c_str(), "r+b");
+        if(NULL != anFile)
         {
-          ILOG() << "ConfigReader::storeNameValue(" << theSection << ") adding (" << theName << "," << theValue << ")" << std::endl;
+          fwrite(&anHeader, sizeof(anHeader), 1, anFile);
+          fclose(anFile);
+        }
+      }
+    }
+    if(!anValid)
+    {
+      ILOG() << "ConfigReader::loadCache(" << theCacheFilename << ") out of date" << std::endl;
+      delete anImage;
+      return false;
+    }
+
+    // Locate each array inside the binary cache
+    const char* anData = anImage->getData() + sizeof(anHeader);
+    const typeEntry* anEntries = (const typeEntry*)anData;
+    const Uint32* anTable = (const Uint32*)(anEntries + anHeader.entries);
+    const typeSection* anSections = (const typeSection*)(anTable + anHeader.table);
+    const char* anStrings = (const char*)(anSections + anHeader.sections);
+
+    // Make sure every offset stays inside the binary cache
+    anValid = '\0' == anStrings[anHeader.strings - 1];
+    for(Uint32 iloop = 0; anValid && iloop < anHeader.entries; iloop++)
+    {
+      anValid = anEntries[iloop].name < anHeader.strings &&
+        anEntries[iloop].value + (Uint64)anEntries[iloop].size < anHeader.strings &&
+        CONFIG_CACHE_PARSED == anEntries[iloop].parsed;
+    }
+    for(Uint32 iloop = 0; anValid && iloop < anHeader.table; iloop++)
+    {
+      anValid = anTable[iloop] <= anHeader.entries;
+    }
+    for(Uint32 iloop = 0; anValid && iloop < anHeader.sections; iloop++)
+    {
+      anValid = anSections[iloop].name < anHeader.strings;
+    }
+    if(!anValid)
+    {
+      WLOG() << "ConfigReader::loadCache(" << theCacheFilename << ") corrupt" << std::endl;
+      delete anImage;
+      return false;
+    }
+
+    // Use the binary cache directly
+    mImage = anImage;
+    mEntryData = anEntries;
+    mEntryCount = anHeader.entries;
+    mTableData = anTable;
+    mTableSize = anHeader.table;
+    mSectionData = anSections;
+    mSectionCount = anHeader.sections;
+    mStringData = anStrings;
+    mStringSize = anHeader.strings;
+
+    return true;
+  }
+
+  void ConfigReader::writeCache(const std::string& theCacheFilename,
+      const MemoryMappedFile& theSource)
+  {
+    typeConfigCache anHeader;
+    memset(&anHeader, 0, sizeof(anHeader));
+    anHeader.magic = CONFIG_CACHE_MAGIC;
+    anHeader.version = CONFIG_CACHE_VERSION;
+    anHeader.byteOrder = CONFIG_CACHE_BYTE_ORDER;
+    anHeader.entrySize = sizeof(typeEntry);
+    anHeader.sectionSize = sizeof(typeSection);
+    anHeader.sourceSize = theSource.getSize();
+    anHeader.sourceModified = theSource.getModifiedTime();
+    anHeader.sourceHash = crc32_runtime(theSource.getData(), theSource.getSize());
+    anHeader.entries = mEntryCount;
+    anHeader.table = mTableSize;
+    anHeader.sections = mSectionCount;
+    anHeader.strings = mStringSize;
+
+    // Write to a temporary file first so a partial cache is never used
+    std::string anTemp = theCacheFilename + ".tmp";
+    FILE* anFile = fopen(anTemp.c_str(), "wb");
+    if(NULL == anFile)
+    {
+      WLOG() << "ConfigReader::writeCache(" << theCacheFilename
+        << ") unable to create file" << std::endl;
+      return;
+    }
+    bool anResult = 1 == fwrite(&anHeader, sizeof(anHeader), 1, anFile);
+    anResult = anResult && mEntryCount == fwrite(mEntryData, sizeof(typeEntry), mEntryCount, anFile);
+    anResult = anResult && mTableSize == fwrite(mTableData, sizeof(Uint32), mTableSize, anFile);
+    anResult = anResult && mSectionCount == fwrite(mSectionData, sizeof(typeSection), mSectionCount, anFile);
+    anResult = anResult && mStringSize == fwrite(mStringData, 1, mStringSize, anFile);
+    anResult = 0 == fclose(anFile) && anResult;
+
+    // Replace any previous cache with the new one
+    remove(theCacheFilename.c_str());
+    if(!anResult || 0 != rename(anTemp.c_str(), theCacheFilename.c_str()))
+    {
+      WLOG() << "ConfigReader::writeCache(" << theCacheFilename
+        << ") unable to write file" << std::endl;
+      remove(anTemp.c_str());
+    }
+  }
 
-          // Add the new name, value pair to this map
-          anMap->insert(std::pair<const std::string, const std::string>(theName,theValue));
+  void ConfigReader::parseValue(typeEntry& theEntry, const StringRef theValue,
+      const ParsedFlags theType)
+  {
+    switch(theType)
+    {
+      case ParsedBool:
+        // Accept true/1/on and false/0/off in any case
+        if(scanBool(theValue, theEntry.asBool))
+        {
+          theEntry.valid |= ParsedBool;
         }
-        else
+        break;
+      case ParsedFloat:
+        {
+          double anResult;
+          if(scanDouble(theValue, anResult) &&
+              anResult <= std::numeric_limits<float>::max() &&
+              anResult >= -std::numeric_limits<float>::max())
+          {
+            theEntry.asFloat = (float)anResult;
+            theEntry.valid |= ParsedFloat;
+          }
+        }
+        break;
+      case ParsedUint32:
         {
-          ELOG() << "ConfigReader::storeNameValue(" << theSection << ") unable to add (" << theName << "," << theValue << ") already exists!" << std::endl;
+          Uint64 anResult;
+          if(scanUint64(theValue, anResult) &&
+              anResult <= std::numeric_limits<Uint32>::max())
+          {
+            theEntry.asUint32 = (Uint32)anResult;
+            theEntry.valid |= ParsedUint32;
+          }
         }
-      }
-    } // else(iterSection == mSections.end())
+        break;
+    }
+
+    // Record that theType has been parsed
+    theEntry.parsed |= theType;
   }
 
 } // namespace AGE
@@ -0,0 +1,173 @@
+/**
+ * Provides the FrameArena class in the AGE namespace which is responsible
+ * for handing out memory that only needs to live for the current and next
+ * frame without touching the heap.
+ *
+ * @file src/AGE/Core/classes/FrameArena.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cassert>
+#include <new>
+#include <AGE/Core/classes/FrameArena.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  FrameArena::FrameArena() :
+    mCapacity(0),
+    mCurrent(0),
+    mUsed(0),
+    mOverflowUsed(0),
+    mPeak(0),
+    mOverflowCount(0)
+  {
+    mBuffers[0] = NULL;
+    mBuffers[1] = NULL;
+  }
+
+  FrameArena::~FrameArena()
+  {
+    deInit();
+  }
+
+  bool FrameArena::doInit(const size_t theSize)
+  {
+    deInit();
+
+    mBuffers[0] = new(std::nothrow) char[theSize];
+    mBuffers[1] = new(std::nothrow) char[theSize];
+    if(NULL == mBuffers[0] || NULL == mBuffers[1])
+    {
+      ELOG() << "FrameArena::doInit(" << theSize << ") unable to allocate buffers" << std::endl;
+      deInit();
+      return false;
+    }
+    mCapacity = theSize;
+
+    ILOG() << "FrameArena::doInit() using 2 buffers of " << theSize << " bytes" << std::endl;
+
+    return true;
+  }
+
+  void FrameArena::deInit(void)
+  {
+    release(0);
+    release(1);
+    delete[] mBuffers[0];
+    delete[] mBuffers[1];
+    mBuffers[0] = NULL;
+    mBuffers[1] = NULL;
+    mCapacity = 0;
+    mCurrent = 0;
+    mUsed = 0;
+    mOverflowUsed = 0;
+  }
+
+  void* FrameArena::allocate(const size_t theSize, const size_t theAlignment)
+  {
+    assert(0 != theAlignment && 0 == (theAlignment & (theAlignment - 1)) &&
+      "FrameArena::allocate() alignment must be a power of 2");
+
+    // Bump past any padding needed to align the address
+    char* anBuffer = mBuffers[mCurrent];
+    if(NULL != anBuffer)
+    {
+      size_t anAddress = reinterpret_cast<size_t>(anBuffer) + mUsed;
+      size_t anPadding = (theAlignment - (anAddress & (theAlignment - 1))) & (theAlignment - 1);
+      if(anPadding + theSize <= mCapacity - mUsed)
+      {
+        void* anResult = anBuffer + mUsed + anPadding;
+        mUsed += anPadding + theSize;
+        if(mUsed + mOverflowUsed > mPeak)
+        {
+          mPeak = mUsed + mOverflowUsed;
+        }
+        return anResult;
+      }
+    }
+
+    // Use the heap rather than fail, new[] is aligned for any fundamental type
+    assert(theAlignment <= DEFAULT_ALIGNMENT && "FrameArena::allocate() alignment too large");
+    char* anOverflow = new(std::nothrow) char[theSize];
+    if(NULL == anOverflow)
+    {
+      ELOG() << "FrameArena::allocate(" << theSize << ") out of memory" << std::endl;
+      return NULL;
+    }
+    if(0 == mOverflowCount)
+    {
+      WLOG() << "FrameArena::allocate(" << theSize << ") buffer full, using the heap"
+        << std::endl;
+    }
+    mOverflow[mCurrent].push_back(anOverflow);
+    mOverflowCount++;
+    mOverflowUsed += theSize;
+    if(mUsed + mOverflowUsed > mPeak)
+    {
+      mPeak = mUsed + mOverflowUsed;
+    }
+
+    return anOverflow;
+  }
+
+  void FrameArena::nextFrame(void)
+  {
+    // The other buffer holds the previous frame which is no longer needed
+    mCurrent = 1 - mCurrent;
+    release(mCurrent);
+    mUsed = 0;
+    mOverflowUsed = 0;
+  }
+
+  size_t FrameArena::getCapacity(void) const
+  {
+    return mCapacity;
+  }
+
+  size_t FrameArena::getUsed(void) const
+  {
+    return mUsed + mOverflowUsed;
+  }
+
+  size_t FrameArena::getPeak(void) const
+  {
+    return mPeak;
+  }
+
+  Uint32 FrameArena::getOverflowCount(void) const
+  {
+    return mOverflowCount;
+  }
+
+  void FrameArena::release(const Uint32 theBuffer)
+  {
+    for(size_t iloop = 0; iloop < mOverflow[theBuffer].size(); iloop++)
+    {
+      delete[] mOverflow[theBuffer][iloop];
+    }
+    mOverflow[theBuffer].clear();
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,197 @@
+/**
+ * Provides the Histogram class in the AGE namespace which is responsible for
+ * recording time values into log-linear (HDR style) buckets so percentiles
+ * can be computed with a fixed relative error and no allocations.
+ *
+ * @file src/AGE/Core/classes/Histogram.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <string.h>
+#include <AGE/Core/classes/Histogram.hpp>
+
+namespace AGE
+{
+  Histogram::Histogram() :
+    mCount(0),
+    mTotal(0),
+    mMin(0),
+    mMax(0)
+  {
+    memset(mBuckets, 0, sizeof(mBuckets));
+  }
+
+  void Histogram::reset(void)
+  {
+    memset(mBuckets, 0, sizeof(mBuckets));
+    mCount = 0;
+    mTotal = 0;
+    mMin = 0;
+    mMax = 0;
+  }
+
+  void Histogram::record(Uint32 theValue)
+  {
+    mBuckets[getBucket(theValue)]++;
+
+    // Keep track of the smallest and largest values recorded
+    if(0 == mCount || theValue < mMin)
+    {
+      mMin = theValue;
+    }
+    if(theValue > mMax)
+    {
+      mMax = theValue;
+    }
+
+    mCount++;
+    mTotal += theValue;
+  }
+
+  void Histogram::merge(const Histogram& theOther)
+  {
+    // Nothing to merge if theOther histogram is empty
+    if(0 == theOther.mCount)
+    {
+      return;
+    }
+
+    for(Uint32 iloop = 0; iloop < BUCKETS; iloop++)
+    {
+      mBuckets[iloop] += theOther.mBuckets[iloop];
+    }
+
+    // Keep track of the smallest and largest values recorded
+    if(0 == mCount || theOther.mMin < mMin)
+    {
+      mMin = theOther.mMin;
+    }
+    if(theOther.mMax > mMax)
+    {
+      mMax = theOther.mMax;
+    }
+
+    mCount += theOther.mCount;
+    mTotal += theOther.mTotal;
+  }
+
+  Uint64 Histogram::getCount(void) const
+  {
+    return mCount;
+  }
+
+  Uint32 Histogram::getMin(void) const
+  {
+    return mMin;
+  }
+
+  Uint32 Histogram::getMax(void) const
+  {
+    return mMax;
+  }
+
+  double Histogram::getMean(void) const
+  {
+    return 0 == mCount ? 0.0 : (double)mTotal / (double)mCount;
+  }
+
+  Uint32 Histogram::getPercentile(float thePercentile) const
+  {
+    // Return 0 if nothing has been recorded yet
+    if(0 == mCount)
+    {
+      return 0;
+    }
+
+    // Determine how many values must be at or below the percentile
+    if(thePercentile < 0.0f)
+    {
+      thePercentile = 0.0f;
+    }
+    Uint64 anTarget = (Uint64)((double)thePercentile / 100.0 * (double)mCount + 0.5);
+    if(anTarget < 1)
+    {
+      anTarget = 1;
+    }
+    if(anTarget > mCount)
+    {
+      anTarget = mCount;
+    }
+
+    // Walk the buckets until we have seen anTarget values
+    Uint64 anSeen = 0;
+    for(Uint32 iloop = 0; iloop < BUCKETS; iloop++)
+    {
+      anSeen += mBuckets[iloop];
+      if(anSeen >= anTarget)
+      {
+        Uint32 anResult = getBucketLimit(iloop);
+        return anResult > mMax ? mMax : anResult;
+      }
+    }
+
+    // Return the largest value recorded (should never get here)
+    return mMax;
+  }
+
+  Uint32 Histogram::getBucket(Uint32 theValue)
+  {
+    // Values below two times the sub bucket count are stored exactly
+    if(theValue < (SUB_BUCKETS << 1))
+    {
+      return theValue;
+    }
+
+    // Find the most significant bit of theValue
+#if defined(__GNUC__)
+    Uint32 anMSB = 31 - __builtin_clz(theValue);
+#else
+    Uint32 anMSB = 0;
+    for(Uint32 anValue = theValue; anValue > 1; anValue >>= 1)
+    {
+      anMSB++;
+    }
+#endif
+
+    // Each power of two is split into SUB_BUCKETS linear sub buckets
+    Uint32 anShift = anMSB - SUB_BUCKET_BITS;
+    return (anShift << SUB_BUCKET_BITS) + (theValue >> anShift);
+  }
+
+  Uint32 Histogram::getBucketLimit(Uint32 theBucket)
+  {
+    // Buckets below two times the sub bucket count are exact values
+    if(theBucket < (SUB_BUCKETS << 1))
+    {
+      return theBucket;
+    }
+
+    // Reverse the calculation done in GetBucket
+    Uint32 anShift = (theBucket >> SUB_BUCKET_BITS) - 1;
+    Uint64 anSub = theBucket - (anShift << SUB_BUCKET_BITS);
+    Uint64 anResult = ((anSub + 1) << anShift) - 1;
+    return anResult > 0xFFFFFFFF ? 0xFFFFFFFF : (Uint32)anResult;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
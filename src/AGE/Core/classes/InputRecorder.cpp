@@ -0,0 +1,328 @@
+/**
+ * Provides the InputRecorder class in the AGE namespace which is responsible
+ * for recording the sf::Event stream of the game loop, stamped with update
+ * tick indices, into a compact binary file and replaying it later.
+ *
+ * @file src/AGE/Core/classes/InputRecorder.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <string.h>
+#include <AGE/Core/classes/InputRecorder.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Byte order marker written in native byte order in the file header
+  static const Uint16 INPUT_BYTE_ORDER = 0x0102;
+  /// Size of the file header (magic, version, byte order, update rate)
+  static const size_t INPUT_HEADER_SIZE = 12;
+  /// Size of each entry before its payload (tick, type)
+  static const size_t INPUT_ENTRY_SIZE = 5;
+  /// Number of buffered bytes that will cause a write to the file
+  static const size_t INPUT_FLUSH_SIZE = 4096;
+
+  InputRecorder::InputRecorder() :
+    mMode(InputIdle),
+    mFile(NULL),
+    mUpdateRate(0),
+    mBuffer(),
+    mOffset(0),
+    mEndTick(0)
+  {
+    ILOGM("InputRecorder::ctor()");
+  }
+
+  InputRecorder::~InputRecorder()
+  {
+    ILOGM("InputRecorder::dtor()");
+
+    // Make sure any recording in progress is written and closed
+    if(InputRecording == mMode)
+    {
+      flush();
+      fclose(mFile);
+      mFile = NULL;
+    }
+  }
+
+  bool InputRecorder::startRecording(const std::string& theFilename,
+      Uint32 theUpdateRate)
+  {
+    // Stop anything already in progress
+    stop(0);
+
+    mFile = fopen(theFilename.c_str(), "wb");
+    if(NULL == mFile)
+    {
+      ELOG() << "InputRecorder::startRecording(" << theFilename
+        << ") unable to create file" << std::endl;
+      return false;
+    }
+
+    // Write our file header
+    Uint32 anMagic = FILE_MAGIC;
+    Uint16 anVersion = FILE_VERSION;
+    char anHeader[INPUT_HEADER_SIZE];
+    memcpy(&anHeader[0], &anMagic, sizeof(Uint32));
+    memcpy(&anHeader[4], &anVersion, sizeof(Uint16));
+    memcpy(&anHeader[6], &INPUT_BYTE_ORDER, sizeof(Uint16));
+    memcpy(&anHeader[8], &theUpdateRate, sizeof(Uint32));
+    mBuffer.assign(anHeader, anHeader + INPUT_HEADER_SIZE);
+
+    mUpdateRate = theUpdateRate;
+    mMode = InputRecording;
+
+    ILOG() << "InputRecorder::startRecording(" << theFilename << ")" << std::endl;
+
+    return true;
+  }
+
+  bool InputRecorder::startReplay(const std::string& theFilename)
+  {
+    // Stop anything already in progress
+    stop(0);
+
+    FILE* anFile = fopen(theFilename.c_str(), "rb");
+    if(NULL == anFile)
+    {
+      ELOG() << "InputRecorder::startReplay(" << theFilename
+        << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    // Read the entire file into our buffer
+    char anChunk[INPUT_FLUSH_SIZE];
+    size_t anRead;
+    while(0 < (anRead = fread(anChunk, 1, sizeof(anChunk), anFile)))
+    {
+      mBuffer.insert(mBuffer.end(), anChunk, anChunk + anRead);
+    }
+    fclose(anFile);
+
+    // Validate the file header
+    Uint32 anMagic = 0;
+    Uint16 anVersion = 0;
+    Uint16 anByteOrder = 0;
+    if(INPUT_HEADER_SIZE <= mBuffer.size())
+    {
+      memcpy(&anMagic, &mBuffer[0], sizeof(Uint32));
+      memcpy(&anVersion, &mBuffer[4], sizeof(Uint16));
+      memcpy(&anByteOrder, &mBuffer[6], sizeof(Uint16));
+      memcpy(&mUpdateRate, &mBuffer[8], sizeof(Uint32));
+    }
+    if(FILE_MAGIC != anMagic || FILE_VERSION != anVersion ||
+        INPUT_BYTE_ORDER != anByteOrder)
+    {
+      ELOG() << "InputRecorder::startReplay(" << theFilename
+        << ") invalid or incompatible recording" << std::endl;
+      mBuffer.clear();
+      return false;
+    }
+
+    // Replay runs forever unless the end of recording marker is found
+    mEndTick = 0xFFFFFFFF;
+    mOffset = INPUT_HEADER_SIZE;
+    mMode = InputReplaying;
+
+    ILOG() << "InputRecorder::startReplay(" << theFilename << ") "
+      << mBuffer.size() << " bytes" << std::endl;
+
+    return true;
+  }
+
+  void InputRecorder::stop(Uint32 theTick)
+  {
+    if(InputRecording == mMode)
+    {
+      // Write the end of recording marker so replays stop on the same tick
+      char anEntry[INPUT_ENTRY_SIZE];
+      memcpy(&anEntry[0], &theTick, sizeof(Uint32));
+      anEntry[4] = (char)END_OF_RECORDING;
+      mBuffer.insert(mBuffer.end(), anEntry, anEntry + INPUT_ENTRY_SIZE);
+
+      flush();
+      fclose(mFile);
+      mFile = NULL;
+    }
+
+    // Release our buffer and return to idle
+    std::vector<char>().swap(mBuffer);
+    mOffset = 0;
+    mEndTick = 0;
+    mMode = InputIdle;
+  }
+
+  InputRecorder::InputMode InputRecorder::getMode(void) const
+  {
+    return mMode;
+  }
+
+  bool InputRecorder::isActive(void) const
+  {
+    return InputIdle != mMode;
+  }
+
+  bool InputRecorder::isReplaying(void) const
+  {
+    return InputReplaying == mMode;
+  }
+
+  Uint32 InputRecorder::getUpdateRate(void) const
+  {
+    return mUpdateRate;
+  }
+
+  void InputRecorder::recordEvent(Uint32 theTick, const sf::Event& theEvent)
+  {
+    // Only record while recording
+    if(InputRecording != mMode)
+    {
+      return;
+    }
+
+    // Append the tick, type and the union member used by this event type
+    Uint8 anType = (Uint8)theEvent.type;
+    size_t anPayload = getPayloadSize(anType);
+    size_t anOffset = mBuffer.size();
+    mBuffer.resize(anOffset + INPUT_ENTRY_SIZE + anPayload);
+    memcpy(&mBuffer[anOffset], &theTick, sizeof(Uint32));
+    mBuffer[anOffset + 4] = (char)anType;
+    if(0 < anPayload)
+    {
+      memcpy(&mBuffer[anOffset + INPUT_ENTRY_SIZE], &theEvent.size, anPayload);
+    }
+
+    // Write our buffer to the file once it is large enough
+    if(INPUT_FLUSH_SIZE <= mBuffer.size())
+    {
+      flush();
+    }
+  }
+
+  bool InputRecorder::replayEvent(Uint32 theTick, sf::Event& theEvent)
+  {
+    // Only replay while replaying and while entries remain
+    if(InputReplaying != mMode || mOffset + INPUT_ENTRY_SIZE > mBuffer.size())
+    {
+      return false;
+    }
+
+    // Is the next entry for theTick provided?
+    Uint32 anTick;
+    memcpy(&anTick, &mBuffer[mOffset], sizeof(Uint32));
+    if(anTick != theTick)
+    {
+      return false;
+    }
+
+    // Is this the end of recording marker?
+    Uint8 anType = (Uint8)mBuffer[mOffset + 4];
+    if(END_OF_RECORDING == anType)
+    {
+      mEndTick = anTick;
+      mOffset = mBuffer.size();
+      return false;
+    }
+
+    // Make sure the entry is valid and complete
+    size_t anPayload = getPayloadSize(anType);
+    if(sf::Event::Count <= anType ||
+        mOffset + INPUT_ENTRY_SIZE + anPayload > mBuffer.size())
+    {
+      WLOG() << "InputRecorder::replayEvent() truncated or invalid entry at offset "
+        << mOffset << std::endl;
+      mOffset = mBuffer.size();
+      return false;
+    }
+
+    // Fill theEvent using the recorded type and union member
+    memset(&theEvent, 0, sizeof(sf::Event));
+    theEvent.type = (sf::Event::EventType)anType;
+    if(0 < anPayload)
+    {
+      memcpy(&theEvent.size, &mBuffer[mOffset + INPUT_ENTRY_SIZE], anPayload);
+    }
+    mOffset += INPUT_ENTRY_SIZE + anPayload;
+
+    return true;
+  }
+
+  bool InputRecorder::isFinished(Uint32 theTick) const
+  {
+    return InputReplaying == mMode && theTick >= mEndTick;
+  }
+
+  size_t InputRecorder::getPayloadSize(Uint8 theType)
+  {
+    switch(theType)
+    {
+      case sf::Event::Resized:
+        return sizeof(sf::Event::SizeEvent);
+      case sf::Event::TextEntered:
+        return sizeof(sf::Event::TextEvent);
+      case sf::Event::KeyPressed:
+      case sf::Event::KeyReleased:
+        return sizeof(sf::Event::KeyEvent);
+      case sf::Event::MouseWheelMoved:
+        return sizeof(sf::Event::MouseWheelEvent);
+      case sf::Event::MouseWheelScrolled:
+        return sizeof(sf::Event::MouseWheelScrollEvent);
+      case sf::Event::MouseButtonPressed:
+      case sf::Event::MouseButtonReleased:
+        return sizeof(sf::Event::MouseButtonEvent);
+      case sf::Event::MouseMoved:
+        return sizeof(sf::Event::MouseMoveEvent);
+      case sf::Event::JoystickButtonPressed:
+      case sf::Event::JoystickButtonReleased:
+        return sizeof(sf::Event::JoystickButtonEvent);
+      case sf::Event::JoystickMoved:
+        return sizeof(sf::Event::JoystickMoveEvent);
+      case sf::Event::JoystickConnected:
+      case sf::Event::JoystickDisconnected:
+        return sizeof(sf::Event::JoystickConnectEvent);
+      case sf::Event::TouchBegan:
+      case sf::Event::TouchMoved:
+      case sf::Event::TouchEnded:
+        return sizeof(sf::Event::TouchEvent);
+      case sf::Event::SensorChanged:
+        return sizeof(sf::Event::SensorEvent);
+      default:
+        return 0;
+    }
+  }
+
+  void InputRecorder::flush(void)
+  {
+    if(NULL != mFile && false == mBuffer.empty())
+    {
+      if(mBuffer.size() != fwrite(&mBuffer[0], 1, mBuffer.size(), mFile))
+      {
+        ELOG() << "InputRecorder::flush() unable to write recording" << std::endl;
+      }
+      mBuffer.clear();
+    }
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
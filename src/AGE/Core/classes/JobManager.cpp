@@ -0,0 +1,192 @@
+/**
+ * Provides the JobManager class in the AGE namespace which is responsible
+ * for running IJob derived classes on a pool of worker threads.
+ *
+ * @file src/AGE/Core/classes/JobManager.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <AGE/Core/classes/JobManager.hpp>
+#include <AGE/Core/classes/TraceManager.hpp>
+#include <AGE/Core/interfaces/IJob.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  JobManager::JobManager() :
+    mRunning(0),
+    mStopping(false)
+  {
+    ILOGM("JobManager::ctor()");
+  }
+
+  JobManager::~JobManager()
+  {
+    ILOGM("JobManager::dtor()");
+
+    // Stop our worker threads if DeInit wasn't called
+    deInit();
+  }
+
+  void JobManager::doInit(Uint32 theWorkers)
+  {
+    // Stop any worker threads previously started
+    deInit();
+
+    // Leave one hardware thread for the game loop
+    if(0 == theWorkers)
+    {
+      theWorkers = std::thread::hardware_concurrency();
+      theWorkers = (theWorkers > 1) ? theWorkers - 1 : 1;
+    }
+    if(MAX_WORKERS < theWorkers)
+    {
+      theWorkers = MAX_WORKERS;
+    }
+
+    ILOG() << "JobManager::doInit(" << theWorkers << ") starting worker threads"
+      << std::endl;
+
+    mStopping = false;
+    for(Uint32 iloop = 0; iloop < theWorkers; iloop++)
+    {
+      mWorkers.push_back(std::thread(&JobManager::workerLoop, this));
+    }
+  }
+
+  void JobManager::deInit(void)
+  {
+    // Tell each worker thread to stop
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      mStopping = true;
+    }
+    mWake.notify_all();
+
+    // Wait for each worker to finish the job it is running
+    for(size_t iloop = 0; iloop < mWorkers.size(); iloop++)
+    {
+      mWorkers[iloop].join();
+    }
+    mWorkers.clear();
+
+    // Delete the jobs that were never started
+    if(!mQueue.empty())
+    {
+      WLOG() << "JobManager::deInit() deleting " << mQueue.size()
+        << " jobs that were never run" << std::endl;
+    }
+    while(!mQueue.empty())
+    {
+      delete mQueue.front();
+      mQueue.pop_front();
+    }
+    mIdle.notify_all();
+  }
+
+  void JobManager::addJob(IJob* theJob)
+  {
+    if(NULL == theJob)
+    {
+      ELOG() << "JobManager::addJob() job pointer provided was NULL!" << std::endl;
+      return;
+    }
+
+    // No worker threads? then run theJob now
+    if(mWorkers.empty())
+    {
+      theJob->doJob();
+      delete theJob;
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      mQueue.push_back(theJob);
+    }
+    mWake.notify_one();
+  }
+
+  void JobManager::waitAll(void)
+  {
+    std::unique_lock<std::mutex> anLock(mMutex);
+    while(!mQueue.empty() || 0 != mRunning)
+    {
+      mIdle.wait(anLock);
+    }
+  }
+
+  Uint32 JobManager::getWorkerCount(void) const
+  {
+    return (Uint32)mWorkers.size();
+  }
+
+  Uint32 JobManager::getPendingCount(void) const
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return (Uint32)mQueue.size() + mRunning;
+  }
+
+  void JobManager::workerLoop(void)
+  {
+    while(true)
+    {
+      IJob* anJob = NULL;
+
+      // Wait for the next job or for DeInit to stop us
+      {
+        std::unique_lock<std::mutex> anLock(mMutex);
+        while(!mStopping && mQueue.empty())
+        {
+          mWake.wait(anLock);
+        }
+        if(mStopping)
+        {
+          break;
+        }
+        anJob = mQueue.front();
+        mQueue.pop_front();
+        mRunning++;
+      }
+
+      // Run the job without holding our lock
+      {
+        TRACE_SCOPE("IJob::doJob");
+        anJob->doJob();
+      }
+      delete anJob;
+
+      // Let WaitAll know if this was the last job
+      {
+        std::lock_guard<std::mutex> anLock(mMutex);
+        mRunning--;
+        if(mQueue.empty() && 0 == mRunning)
+        {
+          mIdle.notify_all();
+        }
+      }
+    }
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
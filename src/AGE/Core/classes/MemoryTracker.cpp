@@ -0,0 +1,142 @@
+/**
+ * Provides the MemoryTracker class in the AGE namespace which is responsible
+ * for keeping track of the memory used by each subsystem of the application.
+ *
+ * @file src/AGE/Core/classes/MemoryTracker.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - WriteReport notes a tag expected to still be allocated
+ */
+
+#include <assert.h>
+#include <AGE/Core/classes/MemoryTracker.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  MemoryTracker::MemoryTracker()
+  {
+    for(Uint32 iloop = 0; iloop < MemoryTagCount; iloop++)
+    {
+      mCurrent[iloop].store(0, std::memory_order_relaxed);
+      mPeak[iloop].store(0, std::memory_order_relaxed);
+      mCount[iloop].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  MemoryTracker& MemoryTracker::getInstance(void)
+  {
+    // Created the first time it is needed (thread safe in C++11) and never
+    // deconstructed since MemoryTracker has no deconstructor
+    static MemoryTracker gInstance;
+    return gInstance;
+  }
+
+  const char* MemoryTracker::getName(const MemoryTag theTag)
+  {
+    static const char* anNames[MemoryTagCount] = {
+      "assets", "textures", "sounds", "fonts", "properties", "events", "loggers"
+    };
+    return (theTag < MemoryTagCount) ? anNames[theTag] : "unknown";
+  }
+
+  void MemoryTracker::allocate(const MemoryTag theTag, const Uint64 theBytes)
+  {
+    assert(theTag < MemoryTagCount && "MemoryTracker::allocate() invalid tag");
+    mCount[theTag].fetch_add(1, std::memory_order_relaxed);
+    resize(theTag, (Int64)theBytes);
+  }
+
+  void MemoryTracker::release(const MemoryTag theTag, const Uint64 theBytes)
+  {
+    assert(theTag < MemoryTagCount && "MemoryTracker::release() invalid tag");
+    mCount[theTag].fetch_sub(1, std::memory_order_relaxed);
+    mCurrent[theTag].fetch_sub((Int64)theBytes, std::memory_order_relaxed);
+  }
+
+  void MemoryTracker::resize(const MemoryTag theTag, const Int64 theBytes)
+  {
+    assert(theTag < MemoryTagCount && "MemoryTracker::resize() invalid tag");
+    Int64 anCurrent = mCurrent[theTag].fetch_add(theBytes, std::memory_order_relaxed) + theBytes;
+
+    // Raise the peak unless another thread already raised it further
+    Int64 anPeak = mPeak[theTag].load(std::memory_order_relaxed);
+    while(anCurrent > anPeak &&
+      !mPeak[theTag].compare_exchange_weak(anPeak, anCurrent, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  void MemoryTracker::getStats(const MemoryTag theTag, typeStats& theStats) const
+  {
+    assert(theTag < MemoryTagCount && "MemoryTracker::getStats() invalid tag");
+    theStats.name = getName(theTag);
+    theStats.current = mCurrent[theTag].load(std::memory_order_relaxed);
+    theStats.peak = mPeak[theTag].load(std::memory_order_relaxed);
+    theStats.count = mCount[theTag].load(std::memory_order_relaxed);
+  }
+
+  Int64 MemoryTracker::getCurrent(void) const
+  {
+    Int64 anResult = 0;
+    for(Uint32 iloop = 0; iloop < MemoryTagCount; iloop++)
+    {
+      anResult += mCurrent[iloop].load(std::memory_order_relaxed);
+    }
+    return anResult;
+  }
+
+  bool MemoryTracker::writeReport(const MemoryTag theExpectedTag) const
+  {
+    // Will be true if nothing else is still allocated
+    bool anResult = true;
+
+    for(Uint32 iloop = 0; iloop < MemoryTagCount; iloop++)
+    {
+      typeStats anStats;
+      getStats((MemoryTag)iloop, anStats);
+
+      if(theExpectedTag == (MemoryTag)iloop)
+      {
+        ILOG() << "MemoryTracker::writeReport() " << anStats.name << " has "
+          << anStats.current << " bytes in " << anStats.count
+          << " allocations (peak=" << anStats.peak << ")" << std::endl;
+      }
+      else if(0 != anStats.current || 0 != anStats.count)
+      {
+        WLOG() << "MemoryTracker::writeReport() " << anStats.name << " has "
+          << anStats.current << " bytes in " << anStats.count
+          << " allocations outstanding (peak=" << anStats.peak << ")" << std::endl;
+        anResult = false;
+      }
+      else
+      {
+        ILOG() << "MemoryTracker::writeReport() " << anStats.name
+          << " released everything (peak=" << anStats.peak << ")" << std::endl;
+      }
+    }
+
+    return anResult;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
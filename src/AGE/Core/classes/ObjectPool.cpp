@@ -0,0 +1,195 @@
+/**
+ * Provides the ObjectPool class in the AGE namespace which is responsible
+ * for allocating fixed size blocks for small objects from slabs of memory
+ * using a free list.
+ *
+ * @file src/AGE/Core/classes/ObjectPool.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cassert>
+#include <AGE/Core/classes/ObjectPool.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// List of every ObjectPool that exists
+  struct typePoolList
+  {
+    sf::Mutex   mutex; ///< Mutex protecting the list
+    ObjectPool* first; ///< First pool in the list
+  };
+
+  /**
+   * GetPoolList will return the list of every ObjectPool. It is never
+   * deleted so pools destroyed during static destruction can still remove
+   * themselves.
+   * @return the list of pools
+   */
+  static typePoolList& getPoolList(void)
+  {
+    static typePoolList* gList = new typePoolList();
+    return *gList;
+  }
+
+  ObjectPool::ObjectPool(const char* theName, const size_t theBlockSize,
+    const Uint32 theSlabBlocks) :
+    mName(theName),
+    mBlockSize(((0 < theBlockSize ? theBlockSize : 1) + BLOCK_ALIGNMENT - 1) &
+      ~(BLOCK_ALIGNMENT - 1)),
+    mSlabBlocks(0 < theSlabBlocks ? theSlabBlocks : 1),
+    mFree(NULL),
+    mUsed(0),
+    mPeak(0),
+    mNext(NULL)
+  {
+    typePoolList& anList = getPoolList();
+    sf::Lock anLock(anList.mutex);
+    mNext = anList.first;
+    anList.first = this;
+  }
+
+  ObjectPool::~ObjectPool()
+  {
+    typePoolList& anList = getPoolList();
+    {
+      sf::Lock anLock(anList.mutex);
+      ObjectPool** anLink = &anList.first;
+      while(NULL != *anLink && this != *anLink)
+      {
+        anLink = &(*anLink)->mNext;
+      }
+      if(NULL != *anLink)
+      {
+        *anLink = mNext;
+      }
+    }
+
+    // Objects still using our blocks would be left dangling, so keep the
+    // slabs (they are reclaimed when the application exits anyway)
+    if(0 == mUsed)
+    {
+      for(size_t iloop = 0; iloop < mSlabs.size(); iloop++)
+      {
+        delete[] mSlabs[iloop];
+      }
+    }
+    mSlabs.clear();
+    mFree = NULL;
+  }
+
+  void* ObjectPool::allocate(void)
+  {
+    sf::Lock anLock(mMutex);
+
+    if(NULL == mFree && !addSlab())
+    {
+      return NULL;
+    }
+
+    void* anResult = mFree;
+    mFree = *static_cast<void**>(mFree);
+    if(++mUsed > mPeak)
+    {
+      mPeak = mUsed;
+    }
+
+    return anResult;
+  }
+
+  void ObjectPool::release(void* theBlock)
+  {
+    if(NULL == theBlock)
+    {
+      return;
+    }
+
+    sf::Lock anLock(mMutex);
+    assert(0 < mUsed && "ObjectPool::release() more blocks released than allocated");
+    *static_cast<void**>(theBlock) = mFree;
+    mFree = theBlock;
+    mUsed--;
+  }
+
+  bool ObjectPool::owns(const void* theBlock) const
+  {
+    const char* anBlock = static_cast<const char*>(theBlock);
+
+    sf::Lock anLock(mMutex);
+    for(size_t iloop = 0; iloop < mSlabs.size(); iloop++)
+    {
+      if(anBlock >= mSlabs[iloop] && anBlock < mSlabs[iloop] + mBlockSize * mSlabBlocks)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void ObjectPool::getStats(typeStats& theStats) const
+  {
+    sf::Lock anLock(mMutex);
+    theStats.name = mName;
+    theStats.blockSize = mBlockSize;
+    theStats.used = mUsed;
+    theStats.peak = mPeak;
+    theStats.capacity = (Uint32)mSlabs.size() * mSlabBlocks;
+  }
+
+  void ObjectPool::getAllStats(std::vector<typeStats>& theStats)
+  {
+    typePoolList& anList = getPoolList();
+    sf::Lock anLock(anList.mutex);
+    for(ObjectPool* anPool = anList.first; NULL != anPool; anPool = anPool->mNext)
+    {
+      typeStats anStats;
+      anPool->getStats(anStats);
+      theStats.push_back(anStats);
+    }
+  }
+
+  bool ObjectPool::addSlab(void)
+  {
+    char* anSlab = new(std::nothrow) char[mBlockSize * mSlabBlocks];
+    if(NULL == anSlab)
+    {
+      ELOG() << "ObjectPool::addSlab(" << mName << ") unable to allocate "
+        << mBlockSize * mSlabBlocks << " bytes" << std::endl;
+      return false;
+    }
+    mSlabs.push_back(anSlab);
+
+    // Link the blocks in address order so they are handed out in order
+    for(Uint32 iloop = 0; iloop < mSlabBlocks; iloop++)
+    {
+      char* anBlock = anSlab + iloop * mBlockSize;
+      *reinterpret_cast<void**>(anBlock) = (iloop + 1 < mSlabBlocks) ?
+        anBlock + mBlockSize : mFree;
+    }
+    mFree = anSlab;
+
+    return true;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -7,6 +7,7 @@
  * @date 20120609 - Initial Release
  * @date 20120620 - Remove excess warning message when adding existing properties
  * @date 20120702 - Fix variable misspelling with iterators
+ * @date 20261018 - Delete the property being removed
  */
 
 #include <AGE/Core/classes/PropertyManager.hpp>
@@ -53,7 +54,13 @@ void PropertyManager::add(IProperty* theProperty)
 
 void PropertyManager::remove(Id thePropertyID)
 {
-   mList.erase(thePropertyID);
+    // We own the property so delete it before forgetting about it
+    std::map<const Id, IProperty*>::iterator anPropertyIter = mList.find(thePropertyID);
+    if(anPropertyIter != mList.end())
+    {
+        delete anPropertyIter->second;
+        mList.erase(anPropertyIter);
+    }
 }
 
 void PropertyManager::clone(const PropertyManager& thePropertyManager)
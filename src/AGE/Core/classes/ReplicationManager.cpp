@@ -0,0 +1,1050 @@
+/**
+ * Provides the ReplicationManager class in the AGE namespace which is
+ * responsible for replicating entity state from a server to its clients
+ * using delta compressed snapshots sent over UDP.
+ *
+ * @file src/AGE/Core/classes/ReplicationManager.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Skip entries over the snapshot budget instead of stopping
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <AGE/Core/classes/ReplicationManager.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Value at the start of every packet so stray packets are ignored
+  static const Uint32 REPLICATION_PROTOCOL = 0xA6E1;
+  /// Packet sent by a client to join a server
+  static const Uint32 REPLICATION_CONNECT = 1;
+  /// Packet sent by a server with the entities that changed
+  static const Uint32 REPLICATION_SNAPSHOT = 2;
+  /// Packet sent by a client for each snapshot decoded
+  static const Uint32 REPLICATION_ACK = 3;
+  /// Packet sent by either side when leaving
+  static const Uint32 REPLICATION_DISCONNECT = 4;
+  /// Snapshot entry with the fields that changed from the baseline
+  static const Uint32 REPLICATION_DELTA = 0;
+  /// Snapshot entry with every field of an entity new to the client
+  static const Uint32 REPLICATION_FULL = 1;
+  /// Snapshot entry for an entity removed since the baseline
+  static const Uint32 REPLICATION_REMOVED = 2;
+  /// Smallest number of bytes each snapshot may use
+  static const Uint32 REPLICATION_MIN_BUDGET = 64;
+
+  const float ReplicationManager::TIMEOUT = 5.0f;
+  const float ReplicationManager::CONNECT_INTERVAL = 0.25f;
+
+  /**
+   * EntityLess is used to keep entities sorted by ID.
+   * @param[in] theEntity to compare
+   * @param[in] theEntityID to compare against
+   * @return true if theEntity comes before theEntityID
+   */
+  template<class TYPE>
+  static bool entityLess(const TYPE& theEntity, const Uint32 theEntityID)
+  {
+    return theEntity.id < theEntityID;
+  }
+
+  ReplicationManager::ReplicationManager() :
+    mRole(ReplicationNone),
+    mTickRate(DEFAULT_TICK_RATE),
+    mBandwidth(DEFAULT_BANDWIDTH),
+    mDelay(DEFAULT_DELAY),
+    mTick(0),
+    mAccumulator(0.0f),
+    mTime(0.0f),
+    mServerPort(0),
+    mServerIdle(0.0f),
+    mNewest(0),
+    mReceived(0),
+    mRenderTick(0.0f),
+    mLoss(0.0f),
+    mLatency(0.0f),
+    mJitter(0.0f),
+    mRandom(1),
+    mBytesSent(0),
+    mBytesReceived(0),
+    mRateBytes(0),
+    mRateTime(0.0f),
+    mSendRate(0),
+    mDropped(0)
+  {
+  }
+
+  ReplicationManager::~ReplicationManager()
+  {
+    disconnect();
+  }
+
+  bool ReplicationManager::listen(const unsigned short thePort, const Uint32 theTickRate)
+  {
+    disconnect();
+
+    mSocket.setBlocking(false);
+    if(sf::Socket::Done != mSocket.bind(thePort))
+    {
+      ELOG() << "ReplicationManager::listen(" << thePort << ") unable to bind port" << std::endl;
+      return false;
+    }
+
+    mRole = ReplicationServer;
+    mTickRate = (0 < theTickRate) ? theTickRate : DEFAULT_TICK_RATE;
+    ILOG() << "ReplicationManager::listen(" << mSocket.getLocalPort() << ") started" << std::endl;
+
+    return true;
+  }
+
+  bool ReplicationManager::connect(const sf::IpAddress& theAddress, const unsigned short thePort,
+    const Uint32 theTickRate)
+  {
+    disconnect();
+
+    mSocket.setBlocking(false);
+    if(sf::Socket::Done != mSocket.bind(sf::Socket::AnyPort))
+    {
+      ELOG() << "ReplicationManager::connect(" << theAddress << ":" << thePort
+        << ") unable to bind port" << std::endl;
+      return false;
+    }
+
+    mRole = ReplicationClient;
+    mTickRate = (0 < theTickRate) ? theTickRate : DEFAULT_TICK_RATE;
+    mServerAddress = theAddress;
+    mServerPort = thePort;
+
+    // Send the first connect request with the next update
+    mAccumulator = CONNECT_INTERVAL;
+    ILOG() << "ReplicationManager::connect(" << theAddress << ":" << thePort << ") started" << std::endl;
+
+    return true;
+  }
+
+  void ReplicationManager::disconnect(void)
+  {
+    // Let the other side know right away instead of waiting for a timeout
+    mStream.clear();
+    mStream.writeBits(REPLICATION_PROTOCOL, 16);
+    mStream.writeBits(REPLICATION_DISCONNECT, 4);
+    if(ReplicationServer == mRole)
+    {
+      for(size_t iloop = 0; iloop < mClients.size(); iloop++)
+      {
+        sendPacket(mStream.getData(), mStream.getSize(), mClients[iloop]->address,
+          mClients[iloop]->port);
+        delete mClients[iloop];
+      }
+    }
+    else if(ReplicationClient == mRole)
+    {
+      sendPacket(mStream.getData(), mStream.getSize(), mServerAddress, mServerPort);
+    }
+    mClients.clear();
+
+    if(ReplicationNone != mRole)
+    {
+      mSocket.unbind();
+    }
+
+    mRole = ReplicationNone;
+    mTick = 0;
+    mAccumulator = 0.0f;
+    mTime = 0.0f;
+    mEntities.clear();
+    mServerAddress = sf::IpAddress::None;
+    mServerPort = 0;
+    mServerIdle = 0.0f;
+    mHistory.clear();
+    mNewest = 0;
+    mReceived = 0;
+    mRenderTick = 0.0f;
+    mDelayed.clear();
+    mBytesSent = 0;
+    mBytesReceived = 0;
+    mRateBytes = 0;
+    mRateTime = 0.0f;
+    mSendRate = 0;
+    mDropped = 0;
+  }
+
+  ReplicationRole ReplicationManager::getRole(void) const
+  {
+    return mRole;
+  }
+
+  bool ReplicationManager::isConnected(void) const
+  {
+    return ReplicationServer == mRole ||
+      (ReplicationClient == mRole && 0 != mNewest && mServerIdle < TIMEOUT);
+  }
+
+  unsigned short ReplicationManager::getLocalPort(void) const
+  {
+    return mSocket.getLocalPort();
+  }
+
+  void ReplicationManager::update(const float theElapsedTime)
+  {
+    if(ReplicationNone == mRole)
+    {
+      return;
+    }
+
+    mTime += theElapsedTime;
+
+    // Measure the bytes sent over each full second
+    mRateTime += theElapsedTime;
+    if(1.0f <= mRateTime)
+    {
+      mSendRate = (Uint32)(mRateBytes / mRateTime);
+      mRateBytes = 0;
+      mRateTime = 0.0f;
+    }
+
+    // Send the packets the simulation delayed that are now due
+    while(!mDelayed.empty() && mDelayed.front().time <= mTime)
+    {
+      typePacket& anPacket = mDelayed.front();
+      sendPacket(&anPacket.data[0], (Uint32)anPacket.data.size(), anPacket.address, anPacket.port);
+      mDelayed.pop_front();
+    }
+
+    receive();
+
+    if(ReplicationServer == mRole)
+    {
+      // Drop clients we haven't heard from in a while
+      std::vector<typeClient*>::iterator iter = mClients.begin();
+      while(iter != mClients.end())
+      {
+        (*iter)->idle += theElapsedTime;
+        if(TIMEOUT < (*iter)->idle)
+        {
+          ILOG() << "ReplicationManager::update() client (" << (*iter)->address << ":"
+            << (*iter)->port << ") timed out" << std::endl;
+          delete *iter;
+          iter = mClients.erase(iter);
+        }
+        else
+        {
+          ++iter;
+        }
+      }
+
+      // Send one snapshot each tick, skipping ticks we fell too far behind on
+      float anTickTime = 1.0f / mTickRate;
+      mAccumulator += theElapsedTime;
+      if(anTickTime <= mAccumulator)
+      {
+        mAccumulator -= anTickTime;
+        if(anTickTime < mAccumulator)
+        {
+          mAccumulator = 0.0f;
+        }
+        mTick++;
+        sendSnapshots();
+      }
+    }
+    else
+    {
+      mServerIdle += theElapsedTime;
+
+      if(!isConnected())
+      {
+        // Keep asking to join until the server sends a snapshot
+        mAccumulator += theElapsedTime;
+        if(CONNECT_INTERVAL <= mAccumulator)
+        {
+          mAccumulator = 0.0f;
+          mStream.clear();
+          mStream.writeBits(REPLICATION_PROTOCOL, 16);
+          mStream.writeBits(REPLICATION_CONNECT, 4);
+          send(mServerAddress, mServerPort);
+        }
+      }
+      else
+      {
+        // Advance the render time but stay between the newest snapshot and
+        // twice the delay behind it
+        float anNewest = (float)mTick;
+        mRenderTick += theElapsedTime * mTickRate;
+        if(mRenderTick > anNewest)
+        {
+          mRenderTick = anNewest;
+        }
+        else if(mRenderTick < anNewest - 2.0f * mDelay)
+        {
+          mRenderTick = anNewest - (float)mDelay;
+        }
+      }
+    }
+  }
+
+  void ReplicationManager::addEntity(const Uint32 theEntityID, const Uint32 theFieldCount)
+  {
+    assert(ReplicationServer == mRole && "ReplicationManager::addEntity() only servers add entities");
+    assert(0 < theFieldCount && MAX_FIELDS >= theFieldCount &&
+      "ReplicationManager::addEntity() invalid field count");
+
+    typeState::iterator iter = std::lower_bound(mEntities.begin(), mEntities.end(),
+      theEntityID, entityLess<typeEntity>);
+    if(iter != mEntities.end() && iter->id == theEntityID)
+    {
+      WLOG() << "ReplicationManager::addEntity(" << theEntityID << ") already exists" << std::endl;
+      return;
+    }
+
+    typeEntity anEntity;
+    anEntity.id = theEntityID;
+    anEntity.count = (MAX_FIELDS < theFieldCount) ? MAX_FIELDS :
+      ((0 == theFieldCount) ? 1 : theFieldCount);
+    for(Uint32 iloop = 0; iloop < MAX_FIELDS; iloop++)
+    {
+      anEntity.fields[iloop] = 0;
+    }
+    mEntities.insert(iter, anEntity);
+  }
+
+  void ReplicationManager::removeEntity(const Uint32 theEntityID)
+  {
+    typeState::iterator iter = std::lower_bound(mEntities.begin(), mEntities.end(),
+      theEntityID, entityLess<typeEntity>);
+    if(iter != mEntities.end() && iter->id == theEntityID)
+    {
+      mEntities.erase(iter);
+    }
+  }
+
+  void ReplicationManager::setField(const Uint32 theEntityID, const Uint32 theField,
+    const Int32 theValue)
+  {
+    typeState::iterator iter = std::lower_bound(mEntities.begin(), mEntities.end(),
+      theEntityID, entityLess<typeEntity>);
+    if(iter != mEntities.end() && iter->id == theEntityID && theField < iter->count)
+    {
+      iter->fields[theField] = theValue;
+    }
+    else
+    {
+      WLOG() << "ReplicationManager::setField(" << theEntityID << "," << theField
+        << ") entity or field doesn't exist" << std::endl;
+    }
+  }
+
+  void ReplicationManager::setFloat(const Uint32 theEntityID, const Uint32 theField,
+    const float theValue)
+  {
+    float anValue = theValue * FIXED_SCALE;
+    setField(theEntityID, theField, (Int32)(anValue < 0.0f ? anValue - 0.5f : anValue + 0.5f));
+  }
+
+  bool ReplicationManager::hasEntity(const Uint32 theEntityID) const
+  {
+    if(ReplicationClient == mRole)
+    {
+      return mHistory.end() != mHistory.find(theEntityID);
+    }
+    return NULL != findEntity(theEntityID);
+  }
+
+  void ReplicationManager::getEntityIDs(std::vector<Uint32>& theEntityIDs) const
+  {
+    theEntityIDs.clear();
+    if(ReplicationClient == mRole)
+    {
+      theEntityIDs.reserve(mHistory.size());
+      std::map<Uint32, typeHistory>::const_iterator iter = mHistory.begin();
+      for(; iter != mHistory.end(); ++iter)
+      {
+        theEntityIDs.push_back(iter->first);
+      }
+    }
+    else
+    {
+      theEntityIDs.reserve(mEntities.size());
+      for(size_t iloop = 0; iloop < mEntities.size(); iloop++)
+      {
+        theEntityIDs.push_back(mEntities[iloop].id);
+      }
+    }
+  }
+
+  Int32 ReplicationManager::getField(const Uint32 theEntityID, const Uint32 theField) const
+  {
+    if(ReplicationClient == mRole)
+    {
+      Uint32 anCount = 0;
+      const typeVersion* anVersion = findVersion(theEntityID, anCount);
+      return (NULL != anVersion && theField < anCount) ? anVersion->fields[theField] : 0;
+    }
+
+    const typeEntity* anEntity = findEntity(theEntityID);
+    return (NULL != anEntity && theField < anEntity->count) ? anEntity->fields[theField] : 0;
+  }
+
+  float ReplicationManager::getFloat(const Uint32 theEntityID, const Uint32 theField) const
+  {
+    std::map<Uint32, typeHistory>::const_iterator iter = mHistory.find(theEntityID);
+    if(ReplicationClient != mRole || iter == mHistory.end())
+    {
+      return (float)getField(theEntityID, theField) / FIXED_SCALE;
+    }
+    const typeHistory& anHistory = iter->second;
+    if(theField >= anHistory.count)
+    {
+      return 0.0f;
+    }
+
+    // Find the versions received just before and just after the render time
+    const typeVersion* anBefore = NULL;
+    const typeVersion* anAfter = NULL;
+    for(Uint32 iloop = 0; iloop < HISTORY_COUNT; iloop++)
+    {
+      const typeVersion& anVersion = anHistory.versions[iloop];
+      if(0 == anVersion.sequence)
+      {
+        continue;
+      }
+      if((float)anVersion.tick <= mRenderTick)
+      {
+        if(NULL == anBefore || anVersion.tick > anBefore->tick)
+        {
+          anBefore = &anVersion;
+        }
+      }
+      else if(NULL == anAfter || anVersion.tick < anAfter->tick)
+      {
+        anAfter = &anVersion;
+      }
+    }
+
+    float anResult = 0.0f;
+    if(NULL != anBefore && NULL != anAfter)
+    {
+      float anFraction = (mRenderTick - anBefore->tick) / (float)(anAfter->tick - anBefore->tick);
+      anResult = anBefore->fields[theField] +
+        (float)(anAfter->fields[theField] - anBefore->fields[theField]) * anFraction;
+    }
+    else
+    {
+      anResult = (float)((NULL != anBefore) ? anBefore : anAfter)->fields[theField];
+    }
+
+    return anResult / FIXED_SCALE;
+  }
+
+  void ReplicationManager::setBandwidth(const Uint32 theBytesPerSecond)
+  {
+    mBandwidth = theBytesPerSecond;
+  }
+
+  void ReplicationManager::setDelay(const Uint32 theTicks)
+  {
+    mDelay = theTicks;
+  }
+
+  void ReplicationManager::setSimulation(const float theLoss, const float theLatency,
+    const float theJitter, const Uint32 theSeed)
+  {
+    mLoss = theLoss;
+    mLatency = theLatency;
+    mJitter = theJitter;
+    mRandom = (0 != theSeed) ? theSeed : 1;
+  }
+
+  Uint32 ReplicationManager::getClientCount(void) const
+  {
+    return (Uint32)mClients.size();
+  }
+
+  Uint32 ReplicationManager::getTick(void) const
+  {
+    return mTick;
+  }
+
+  Uint64 ReplicationManager::getBytesSent(void) const
+  {
+    return mBytesSent;
+  }
+
+  Uint64 ReplicationManager::getBytesReceived(void) const
+  {
+    return mBytesReceived;
+  }
+
+  Uint32 ReplicationManager::getSendRate(void) const
+  {
+    return mSendRate;
+  }
+
+  Uint32 ReplicationManager::getDroppedCount(void) const
+  {
+    return mDropped;
+  }
+
+  void ReplicationManager::receive(void)
+  {
+    char anBuffer[MAX_PACKET_SIZE];
+    std::size_t anReceived = 0;
+    sf::IpAddress anAddress;
+    unsigned short anPort = 0;
+    while(sf::Socket::Done == mSocket.receive(anBuffer, sizeof(anBuffer), anReceived,
+      anAddress, anPort))
+    {
+      mBytesReceived += anReceived;
+      mStream.setData(anBuffer, (Uint32)anReceived);
+      if(REPLICATION_PROTOCOL != mStream.readBits(16))
+      {
+        mDropped++;
+        continue;
+      }
+      Uint32 anType = mStream.readBits(4);
+
+      if(ReplicationServer == mRole)
+      {
+        typeClient* anClient = findClient(anAddress, anPort);
+        if(REPLICATION_CONNECT == anType && NULL == anClient)
+        {
+          if(MAX_CLIENTS <= mClients.size())
+          {
+            WLOG() << "ReplicationManager::receive() too many clients, ignoring ("
+              << anAddress << ":" << anPort << ")" << std::endl;
+            continue;
+          }
+          anClient = new(std::nothrow) typeClient();
+          assert(NULL != anClient && "ReplicationManager::receive() unable to allocate memory");
+          if(NULL == anClient)
+          {
+            continue;
+          }
+          anClient->address = anAddress;
+          anClient->port = anPort;
+          anClient->sequence = 0;
+          anClient->roundTrip = 0.0f;
+          for(Uint32 iloop = 0; iloop < SNAPSHOT_COUNT; iloop++)
+          {
+            anClient->records[iloop].sequence = 0;
+          }
+          mClients.push_back(anClient);
+          ILOG() << "ReplicationManager::receive() client (" << anAddress << ":"
+            << anPort << ") connected" << std::endl;
+        }
+        if(NULL == anClient)
+        {
+          continue;
+        }
+        anClient->idle = 0.0f;
+
+        if(REPLICATION_ACK == anType)
+        {
+          readAck(*anClient);
+        }
+        else if(REPLICATION_DISCONNECT == anType)
+        {
+          ILOG() << "ReplicationManager::receive() client (" << anAddress << ":"
+            << anPort << ") disconnected" << std::endl;
+          mClients.erase(std::find(mClients.begin(), mClients.end(), anClient));
+          delete anClient;
+        }
+      }
+      else if(anAddress == mServerAddress && anPort == mServerPort)
+      {
+        if(REPLICATION_SNAPSHOT == anType)
+        {
+          readSnapshot();
+        }
+        else if(REPLICATION_DISCONNECT == anType)
+        {
+          ILOG() << "ReplicationManager::receive() server disconnected" << std::endl;
+          mServerIdle = TIMEOUT;
+        }
+      }
+    }
+  }
+
+  void ReplicationManager::sendSnapshots(void)
+  {
+    for(size_t iloop = 0; iloop < mClients.size(); iloop++)
+    {
+      typeClient& anClient = *mClients[iloop];
+      typeRecord& anRecord = anClient.records[++anClient.sequence % SNAPSHOT_COUNT];
+      anRecord.sequence = anClient.sequence;
+      anRecord.entries.clear();
+
+      mStream.clear();
+      mStream.writeBits(REPLICATION_PROTOCOL, 16);
+      mStream.writeBits(REPLICATION_SNAPSHOT, 4);
+      mStream.writeBits(anRecord.sequence, 32);
+      mStream.writeBits(mTick, 32);
+      writeSnapshot(anClient, anRecord);
+      send(anClient.address, anClient.port);
+    }
+  }
+
+  void ReplicationManager::writeSnapshot(typeClient& theClient, typeRecord& theRecord)
+  {
+    const Uint32 anSequence = theRecord.sequence;
+    const Uint32 anResend = (Uint32)theClient.roundTrip + 2;
+    std::map<Uint32, typeRemote>& anRemotes = theClient.remotes;
+
+    // Find every entity that differs from what the client acknowledged and
+    // how many ticks it has been waiting to be sent
+    std::vector<std::pair<Uint32, Uint32> > anChanged;
+    typeState::const_iterator iter = mEntities.begin();
+    std::map<Uint32, typeRemote>::iterator iterRemote = anRemotes.begin();
+    while(iter != mEntities.end() || iterRemote != anRemotes.end())
+    {
+      if(iterRemote == anRemotes.end() || (iter != mEntities.end() && iter->id < iterRemote->first))
+      {
+        // The client has never been sent this entity
+        typeRemote anRemote;
+        memset(&anRemote, 0, sizeof(anRemote));
+        anRemote.waited = 1;
+        anRemotes.insert(iterRemote, std::pair<const Uint32, typeRemote>(iter->id, anRemote));
+        anChanged.push_back(std::pair<Uint32, Uint32>(~anRemote.waited, iter->id));
+        ++iter;
+        continue;
+      }
+
+      std::map<Uint32, typeRemote>::iterator anRemoteIter = iterRemote++;
+      typeRemote& anRemote = anRemoteIter->second;
+      const typeEntity* anCurrent = NULL;
+      if(iter != mEntities.end() && iter->id == anRemoteIter->first)
+      {
+        anCurrent = &(*iter++);
+      }
+
+      bool anSent;
+      if(NULL == anCurrent)
+      {
+        // Forget entities removed before the client was ever sent them
+        if(0 == anRemote.sentSequence[0])
+        {
+          anRemotes.erase(anRemoteIter);
+          continue;
+        }
+        anSent = 0 == anRemote.sentCount;
+      }
+      else
+      {
+        if(0 != anRemote.ackedSequence && anRemote.count == anCurrent->count &&
+           0 == memcmp(anRemote.acked, anCurrent->fields, anCurrent->count * sizeof(Int32)))
+        {
+          anRemote.waited = 0;
+          continue;
+        }
+        anSent = anRemote.sentCount == anCurrent->count &&
+          0 == memcmp(anRemote.sent, anCurrent->fields, anCurrent->count * sizeof(Int32));
+      }
+
+      // Don't send it again while the last copy is still on its way
+      if(anSent && anSequence - anRemote.sentSequence[0] <= anResend)
+      {
+        continue;
+      }
+      anRemote.waited++;
+      anChanged.push_back(std::pair<Uint32, Uint32>(~anRemote.waited, anRemoteIter->first));
+    }
+
+    // Longest waiting first (~ sorts the most waited first), then by ID
+    std::sort(anChanged.begin(), anChanged.end());
+
+    // Write entries until this tick's share of the bandwidth is used,
+    // keeping a bit for the end marker
+    Uint32 anBudget = mBandwidth / mTickRate;
+    if(REPLICATION_MIN_BUDGET > anBudget)
+    {
+      anBudget = REPLICATION_MIN_BUDGET;
+    }
+    if(MAX_PACKET_SIZE < anBudget)
+    {
+      anBudget = MAX_PACKET_SIZE;
+    }
+    anBudget = anBudget * 8 - 1;
+    for(size_t iloop = 0; iloop < anChanged.size(); iloop++)
+    {
+      Uint32 anID = anChanged[iloop].second;
+      const typeEntity* anCurrent = findEntity(anID);
+      typeRemote& anRemote = anRemotes[anID];
+
+      // A delta needs the acknowledged version to still be in the client
+      // history, which keeps the newest HISTORY_COUNT versions
+      Uint32 anNewer = 0;
+      for(Uint32 jloop = 0; jloop < HISTORY_COUNT; jloop++)
+      {
+        if(anRemote.sentSequence[jloop] > anRemote.ackedSequence)
+        {
+          anNewer++;
+        }
+      }
+      bool anDelta = NULL != anCurrent && 0 != anRemote.ackedSequence &&
+        anRemote.count == anCurrent->count && HISTORY_COUNT > anNewer;
+
+      Uint32 anStart = mStream.getBitCount();
+      mStream.writeBool(true);
+      mStream.writeUint(anID);
+      if(NULL == anCurrent)
+      {
+        mStream.writeBits(REPLICATION_REMOVED, 2);
+      }
+      else if(anDelta)
+      {
+        mStream.writeBits(REPLICATION_DELTA, 2);
+        mStream.writeUint(anSequence - anRemote.ackedSequence);
+        for(Uint32 jloop = 0; jloop < anCurrent->count; jloop++)
+        {
+          bool anChange = anCurrent->fields[jloop] != anRemote.acked[jloop];
+          mStream.writeBool(anChange);
+          if(anChange)
+          {
+            mStream.writeInt((Int32)((Uint32)anCurrent->fields[jloop] -
+              (Uint32)anRemote.acked[jloop]));
+          }
+        }
+      }
+      else
+      {
+        mStream.writeBits(REPLICATION_FULL, 2);
+        mStream.writeBits(anCurrent->count - 1, 4);
+        for(Uint32 jloop = 0; jloop < anCurrent->count; jloop++)
+        {
+          mStream.writeInt(anCurrent->fields[jloop]);
+        }
+      }
+
+      // Leave an entry that doesn't fit for the next snapshot but try the
+      // smaller ones after it. The first entry is always sent (even a full
+      // entry with MAX_FIELDS fields fits in MAX_PACKET_SIZE) so an entry
+      // larger than the budget can't keep every other one from being sent.
+      if(anBudget < mStream.getBitCount() && !theRecord.entries.empty())
+      {
+        mStream.setBitCount(anStart);
+        continue;
+      }
+
+      // Remember what was sent so acknowledgements can update the remote
+      typeEntity anEntry;
+      anEntry.id = anID;
+      anEntry.count = 0;
+      if(NULL != anCurrent)
+      {
+        anEntry = *anCurrent;
+        memcpy(anRemote.sent, anCurrent->fields, sizeof(anRemote.sent));
+      }
+      theRecord.entries.push_back(anEntry);
+      anRemote.sentCount = anEntry.count;
+      for(Uint32 jloop = HISTORY_COUNT - 1; 0 < jloop; jloop--)
+      {
+        anRemote.sentSequence[jloop] = anRemote.sentSequence[jloop - 1];
+      }
+      anRemote.sentSequence[0] = anSequence;
+      anRemote.waited = 0;
+
+      // Full entries and removals start a new baseline, acknowledgements of
+      // anything sent before them no longer describe the client
+      if(!anDelta)
+      {
+        anRemote.ackedSequence = 0;
+        anRemote.resetSequence = anSequence;
+      }
+    }
+    mStream.writeBool(false);
+  }
+
+  void ReplicationManager::readAck(typeClient& theClient)
+  {
+    Uint32 anNewest = mStream.readBits(32);
+    Uint32 anReceived = mStream.readBits(32);
+    if(!mStream.isValid() || 0 == anNewest || anNewest > theClient.sequence)
+    {
+      return;
+    }
+
+    // Measure the round trip from how many snapshots were sent since
+    float anRoundTrip = (float)(theClient.sequence - anNewest);
+    theClient.roundTrip = (0.0f == theClient.roundTrip) ? anRoundTrip :
+      theClient.roundTrip * 0.875f + anRoundTrip * 0.125f;
+
+    // The newest snapshot and each of the 32 before it that was received
+    for(Uint32 iloop = 0; iloop <= 32 && iloop < anNewest; iloop++)
+    {
+      if(0 < iloop && 0 == (anReceived & (1u << (iloop - 1))))
+      {
+        continue;
+      }
+      Uint32 anSequence = anNewest - iloop;
+      typeRecord& anRecord = theClient.records[anSequence % SNAPSHOT_COUNT];
+      if(anRecord.sequence != anSequence)
+      {
+        continue;
+      }
+
+      for(size_t jloop = 0; jloop < anRecord.entries.size(); jloop++)
+      {
+        const typeEntity& anEntry = anRecord.entries[jloop];
+        std::map<Uint32, typeRemote>::iterator iter = theClient.remotes.find(anEntry.id);
+        if(iter == theClient.remotes.end() ||
+           anSequence < iter->second.resetSequence ||
+           anSequence <= iter->second.ackedSequence)
+        {
+          continue;
+        }
+        typeRemote& anRemote = iter->second;
+        if(0 == anEntry.count)
+        {
+          // Forget removed entities unless they were sent again since
+          if(anRemote.sentSequence[0] == anSequence)
+          {
+            theClient.remotes.erase(iter);
+          }
+        }
+        else
+        {
+          anRemote.count = anEntry.count;
+          memcpy(anRemote.acked, anEntry.fields, sizeof(anRemote.acked));
+          anRemote.ackedSequence = anSequence;
+        }
+      }
+
+      // Each snapshot only needs to be acknowledged once
+      anRecord.sequence = 0;
+    }
+  }
+
+  void ReplicationManager::readSnapshot(void)
+  {
+    Uint32 anSequence = mStream.readBits(32);
+    Uint32 anTick = mStream.readBits(32);
+
+    // Ignore snapshots older than the newest one unless the server restarted
+    if(0 != mNewest && anSequence <= mNewest)
+    {
+      if(isConnected())
+      {
+        return;
+      }
+      mHistory.clear();
+      mNewest = 0;
+    }
+
+    // Decode every entry before changing anything so a packet that can't
+    // be decoded is dropped (and not acknowledged) as a whole
+    typeState anEntries;
+    std::vector<Uint32> anKinds;
+    while(mStream.isValid() && mStream.readBool())
+    {
+      typeEntity anEntry;
+      memset(&anEntry, 0, sizeof(anEntry));
+      anEntry.id = mStream.readUint();
+      Uint32 anKind = mStream.readBits(2);
+      if(REPLICATION_FULL == anKind)
+      {
+        anEntry.count = mStream.readBits(4) + 1;
+        for(Uint32 iloop = 0; iloop < anEntry.count; iloop++)
+        {
+          anEntry.fields[iloop] = mStream.readInt();
+        }
+      }
+      else if(REPLICATION_DELTA == anKind)
+      {
+        // Find the version the server encoded this delta against
+        Uint32 anBaseline = anSequence - mStream.readUint();
+        std::map<Uint32, typeHistory>::const_iterator iter = mHistory.find(anEntry.id);
+        const typeVersion* anVersion = NULL;
+        for(Uint32 iloop = 0; iter != mHistory.end() && iloop < HISTORY_COUNT; iloop++)
+        {
+          if(iter->second.versions[iloop].sequence == anBaseline)
+          {
+            anVersion = &iter->second.versions[iloop];
+          }
+        }
+        if(NULL == anVersion)
+        {
+          mDropped++;
+          return;
+        }
+        anEntry.count = iter->second.count;
+        for(Uint32 iloop = 0; iloop < anEntry.count; iloop++)
+        {
+          anEntry.fields[iloop] = anVersion->fields[iloop];
+          if(mStream.readBool())
+          {
+            anEntry.fields[iloop] = (Int32)((Uint32)anEntry.fields[iloop] +
+              (Uint32)mStream.readInt());
+          }
+        }
+      }
+      else if(REPLICATION_REMOVED != anKind)
+      {
+        mDropped++;
+        return;
+      }
+      anEntries.push_back(anEntry);
+      anKinds.push_back(anKind);
+    }
+    if(!mStream.isValid())
+    {
+      mDropped++;
+      return;
+    }
+
+    for(size_t iloop = 0; iloop < anEntries.size(); iloop++)
+    {
+      const typeEntity& anEntry = anEntries[iloop];
+      if(REPLICATION_REMOVED == anKinds[iloop])
+      {
+        mHistory.erase(anEntry.id);
+        continue;
+      }
+
+      // Every entry adds the newest version, a full entry with a different
+      // number of fields can't be interpolated with the older versions
+      typeHistory& anHistory = mHistory[anEntry.id];
+      if(REPLICATION_FULL == anKinds[iloop] && anHistory.count != anEntry.count)
+      {
+        memset(&anHistory, 0, sizeof(anHistory));
+        anHistory.count = anEntry.count;
+      }
+      anHistory.newest = (anHistory.newest + 1) % HISTORY_COUNT;
+      typeVersion& anVersion = anHistory.versions[anHistory.newest];
+      anVersion.sequence = anSequence;
+      anVersion.tick = anTick;
+      memcpy(anVersion.fields, anEntry.fields, sizeof(anVersion.fields));
+    }
+
+    // Remember which of the 32 snapshots before this one were received
+    Uint32 anShift = anSequence - mNewest;
+    if(0 == mNewest || 32 < anShift)
+    {
+      mReceived = 0;
+    }
+    else
+    {
+      mReceived = ((32 == anShift) ? 0 : (mReceived << anShift)) | (1u << (anShift - 1));
+    }
+    if(0 == mNewest)
+    {
+      mRenderTick = (float)anTick - (float)mDelay;
+    }
+    mNewest = anSequence;
+    mTick = anTick;
+    mServerIdle = 0.0f;
+
+    // Let the server know which snapshots it can encode against
+    mStream.clear();
+    mStream.writeBits(REPLICATION_PROTOCOL, 16);
+    mStream.writeBits(REPLICATION_ACK, 4);
+    mStream.writeBits(mNewest, 32);
+    mStream.writeBits(mReceived, 32);
+    send(mServerAddress, mServerPort);
+  }
+
+  void ReplicationManager::send(const sf::IpAddress& theAddress, const unsigned short thePort)
+  {
+    if(0.0f < mLoss && getRandom() < mLoss)
+    {
+      mDropped++;
+      return;
+    }
+
+    if(0.0f < mLatency || 0.0f < mJitter)
+    {
+      // Keep the delayed packets ordered by when they are due, jitter can
+      // make a later packet arrive first just like on a real network
+      typePacket anPacket;
+      anPacket.time = mTime + mLatency + mJitter * getRandom();
+      anPacket.address = theAddress;
+      anPacket.port = thePort;
+      anPacket.data.assign(mStream.getData(), mStream.getData() + mStream.getSize());
+      std::deque<typePacket>::iterator iter = mDelayed.end();
+      while(iter != mDelayed.begin() && (iter - 1)->time > anPacket.time)
+      {
+        --iter;
+      }
+      mDelayed.insert(iter, anPacket);
+    }
+    else
+    {
+      sendPacket(mStream.getData(), mStream.getSize(), theAddress, thePort);
+    }
+  }
+
+  void ReplicationManager::sendPacket(const void* theData, const Uint32 theSize,
+    const sf::IpAddress& theAddress, const unsigned short thePort)
+  {
+    if(sf::Socket::Done == mSocket.send(theData, theSize, theAddress, thePort))
+    {
+      mBytesSent += theSize;
+      mRateBytes += theSize;
+    }
+  }
+
+  float ReplicationManager::getRandom(void)
+  {
+    // Xorshift is enough for simulating loss and repeats for each seed
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+    return (float)(mRandom & 0xFFFFFF) / 16777216.0f;
+  }
+
+  const ReplicationManager::typeEntity* ReplicationManager::findEntity(
+    const Uint32 theEntityID) const
+  {
+    typeState::const_iterator iter = std::lower_bound(mEntities.begin(), mEntities.end(),
+      theEntityID, entityLess<typeEntity>);
+    return (iter != mEntities.end() && iter->id == theEntityID) ? &(*iter) : NULL;
+  }
+
+  const ReplicationManager::typeVersion* ReplicationManager::findVersion(
+    const Uint32 theEntityID, Uint32& theCount) const
+  {
+    std::map<Uint32, typeHistory>::const_iterator iter = mHistory.find(theEntityID);
+    if(iter == mHistory.end())
+    {
+      theCount = 0;
+      return NULL;
+    }
+    theCount = iter->second.count;
+    return &iter->second.versions[iter->second.newest];
+  }
+
+  ReplicationManager::typeClient* ReplicationManager::findClient(
+    const sf::IpAddress& theAddress, const unsigned short thePort)
+  {
+    for(size_t iloop = 0; iloop < mClients.size(); iloop++)
+    {
+      if(mClients[iloop]->port == thePort && mClients[iloop]->address == theAddress)
+      {
+        return mClients[iloop];
+      }
+    }
+    return NULL;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,246 @@
+/**
+ * Provides the RollbackManager class in the AGE namespace which is
+ * responsible for saving the simulation state each update tick into a
+ * preallocated buffer and rolling back and re-simulating from an earlier
+ * tick when corrected input arrives.
+ *
+ * @file src/AGE/Core/classes/RollbackManager.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cassert>
+#include <cstring>
+#include <SFML/System.hpp>
+#include <AGE/Core/classes/RollbackManager.hpp>
+#include <AGE/Core/interfaces/IState.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  RollbackManager::RollbackManager() :
+    mBuffer(NULL),
+    mSnapshotSize(0),
+    mTick(0),
+    mRequested(0),
+    mResimulating(false),
+    mRollbacks(0),
+    mRollbackTime(0)
+  {
+    memset(mSaved, 0, sizeof(mSaved));
+  }
+
+  RollbackManager::~RollbackManager()
+  {
+    delete[] mBuffer;
+    mBuffer = NULL;
+  }
+
+  bool RollbackManager::addData(void* theData, const size_t theSize)
+  {
+    assert(NULL != theData && "RollbackManager::addData() theData is NULL");
+    if(NULL == theData || 0 == theSize)
+    {
+      ELOG() << "RollbackManager::addData() invalid data provided" << std::endl;
+      return false;
+    }
+
+    typeRegion anRegion;
+    anRegion.data = theData;
+    anRegion.size = theSize;
+    anRegion.offset = 0;
+    mRegions.push_back(anRegion);
+    layout();
+
+    return NULL != mBuffer;
+  }
+
+  void RollbackManager::removeData(const void* theData)
+  {
+    std::vector<typeRegion>::iterator iter = mRegions.begin();
+    while(iter != mRegions.end())
+    {
+      if(iter->data == theData)
+      {
+        mRegions.erase(iter);
+        layout();
+        return;
+      }
+      ++iter;
+    }
+  }
+
+  void RollbackManager::clear(void)
+  {
+    mRegions.clear();
+    layout();
+  }
+
+  bool RollbackManager::isActive(void) const
+  {
+    return NULL != mBuffer;
+  }
+
+  size_t RollbackManager::getSnapshotSize(void) const
+  {
+    return mSnapshotSize;
+  }
+
+  void RollbackManager::saveTick(const Uint32 theTick)
+  {
+    if(NULL == mBuffer)
+    {
+      return;
+    }
+
+    Uint32 anSlot = theTick % SNAPSHOT_COUNT;
+    char* anSnapshot = mBuffer + anSlot * mSnapshotSize;
+    for(size_t iloop = 0; iloop < mRegions.size(); iloop++)
+    {
+      const typeRegion& anRegion = mRegions[iloop];
+      memcpy(anSnapshot + anRegion.offset, anRegion.data, anRegion.size);
+    }
+    mSaved[anSlot] = theTick + 1;
+  }
+
+  bool RollbackManager::loadTick(const Uint32 theTick)
+  {
+    if(!hasTick(theTick))
+    {
+      return false;
+    }
+
+    const char* anSnapshot = mBuffer + (theTick % SNAPSHOT_COUNT) * mSnapshotSize;
+    for(size_t iloop = 0; iloop < mRegions.size(); iloop++)
+    {
+      const typeRegion& anRegion = mRegions[iloop];
+      memcpy(anRegion.data, anSnapshot + anRegion.offset, anRegion.size);
+    }
+
+    return true;
+  }
+
+  bool RollbackManager::hasTick(const Uint32 theTick) const
+  {
+    return NULL != mBuffer && theTick + 1 == mSaved[theTick % SNAPSHOT_COUNT];
+  }
+
+  bool RollbackManager::requestRollback(const Uint32 theTick)
+  {
+    if(!hasTick(theTick))
+    {
+      WLOG() << "RollbackManager::requestRollback(" << theTick
+        << ") tick is no longer saved" << std::endl;
+      return false;
+    }
+
+    // Roll back to the earliest tick requested
+    if(0 == mRequested || theTick + 1 < mRequested)
+    {
+      mRequested = theTick + 1;
+    }
+
+    return true;
+  }
+
+  void RollbackManager::update(IState& theState, const Uint32 theTick,
+    const float theElapsedTime)
+  {
+    // Restore the tick requested and simulate each tick since again
+    if(0 != mRequested)
+    {
+      Uint32 anTick = mRequested - 1;
+      mRequested = 0;
+      if(anTick < theTick && loadTick(anTick))
+      {
+        sf::Clock anClock;
+        mResimulating = true;
+        for(mTick = anTick; mTick < theTick; mTick++)
+        {
+          // The snapshot for anTick is what was just restored
+          if(mTick != anTick)
+          {
+            saveTick(mTick);
+          }
+          theState.updateVariable(theElapsedTime);
+        }
+        mResimulating = false;
+        mRollbacks++;
+        mRollbackTime = anClock.getElapsedTime().asMicroseconds();
+      }
+    }
+
+    mTick = theTick;
+    saveTick(theTick);
+  }
+
+  Uint32 RollbackManager::getTick(void) const
+  {
+    return mTick;
+  }
+
+  bool RollbackManager::isResimulating(void) const
+  {
+    return mResimulating;
+  }
+
+  Uint32 RollbackManager::getRollbackCount(void) const
+  {
+    return mRollbacks;
+  }
+
+  Int64 RollbackManager::getLastRollbackTime(void) const
+  {
+    return mRollbackTime;
+  }
+
+  void RollbackManager::layout(void)
+  {
+    // Snapshots saved with the old layout can't be restored
+    memset(mSaved, 0, sizeof(mSaved));
+    mRequested = 0;
+    delete[] mBuffer;
+    mBuffer = NULL;
+    mSnapshotSize = 0;
+
+    // Place each region at an aligned offset within each snapshot
+    for(size_t iloop = 0; iloop < mRegions.size(); iloop++)
+    {
+      mRegions[iloop].offset = mSnapshotSize;
+      mSnapshotSize += (mRegions[iloop].size + REGION_ALIGNMENT - 1) &
+        ~(size_t)(REGION_ALIGNMENT - 1);
+    }
+
+    if(0 < mSnapshotSize)
+    {
+      mBuffer = new(std::nothrow) char[mSnapshotSize * SNAPSHOT_COUNT];
+      if(NULL == mBuffer)
+      {
+        ELOG() << "RollbackManager::layout() unable to allocate "
+          << mSnapshotSize * SNAPSHOT_COUNT << " bytes" << std::endl;
+        mSnapshotSize = 0;
+      }
+    }
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
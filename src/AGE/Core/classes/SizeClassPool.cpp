@@ -0,0 +1,129 @@
+/**
+ * Provides the SizeClassPool class in the AGE namespace which is responsible
+ * for allocating small objects of varying sizes from a set of ObjectPools,
+ * one for each size class.
+ *
+ * @file src/AGE/Core/classes/SizeClassPool.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <new>
+#include <AGE/Core/classes/SizeClassPool.hpp>
+#include <AGE/Core/classes/ObjectPool.hpp>
+
+namespace AGE
+{
+  SizeClassPool::SizeClassPool(const char* theName,
+    const MemoryTracker::MemoryTag theMemoryTag) :
+    mMemoryTag(theMemoryTag)
+  {
+    for(Uint32 iloop = 0; iloop < POOL_COUNT; iloop++)
+    {
+      mPools[iloop] = new(std::nothrow) ObjectPool(theName,
+        SMALLEST_BLOCK_SIZE << iloop);
+    }
+  }
+
+  SizeClassPool::~SizeClassPool()
+  {
+    for(Uint32 iloop = 0; iloop < POOL_COUNT; iloop++)
+    {
+      delete mPools[iloop];
+      mPools[iloop] = NULL;
+    }
+  }
+
+  void* SizeClassPool::allocate(const size_t theSize)
+  {
+    ObjectPool* anPool = getPool(theSize);
+    void* anResult = (NULL != anPool) ? anPool->allocate() : ::operator new(theSize, std::nothrow);
+    if(NULL != anResult)
+    {
+      MemoryTracker::getInstance().allocate(mMemoryTag, getBlockSize(theSize));
+    }
+    return anResult;
+  }
+
+  void SizeClassPool::release(void* theBlock, const size_t theSize)
+  {
+    if(NULL == theBlock)
+    {
+      return;
+    }
+    MemoryTracker::getInstance().release(mMemoryTag, getBlockSize(theSize));
+    ObjectPool* anPool = getPool(theSize);
+    if(NULL != anPool)
+    {
+      anPool->release(theBlock);
+    }
+    else
+    {
+      ::operator delete(theBlock);
+    }
+  }
+
+  void SizeClassPool::release(void* theBlock)
+  {
+    if(NULL == theBlock)
+    {
+      return;
+    }
+    // The size isn't known here, so look for the pool that owns it
+    for(Uint32 iloop = 0; iloop < POOL_COUNT; iloop++)
+    {
+      if(NULL != mPools[iloop] && mPools[iloop]->owns(theBlock))
+      {
+        MemoryTracker::getInstance().release(mMemoryTag, SMALLEST_BLOCK_SIZE << iloop);
+        mPools[iloop]->release(theBlock);
+        return;
+      }
+    }
+    ::operator delete(theBlock);
+  }
+
+  size_t SizeClassPool::getBlockSize(const size_t theSize)
+  {
+    for(Uint32 iloop = 0; iloop < POOL_COUNT; iloop++)
+    {
+      if(theSize <= (SMALLEST_BLOCK_SIZE << iloop))
+      {
+        return SMALLEST_BLOCK_SIZE << iloop;
+      }
+    }
+    return theSize;
+  }
+
+  ObjectPool* SizeClassPool::getPool(const size_t theSize) const
+  {
+    for(Uint32 iloop = 0; iloop < POOL_COUNT; iloop++)
+    {
+      if(theSize <= (SMALLEST_BLOCK_SIZE << iloop))
+      {
+        return mPools[iloop];
+      }
+    }
+    return NULL;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,268 @@
+/**
+ * Provides the SoundBank class in the AGE namespace which is responsible for
+ * decoding a list of sound effects in parallel and installing them into the
+ * sf::SoundBuffer asset handler once every one has been decoded.
+ *
+ * @file src/AGE/Core/classes/SoundBank.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <SFML/System.hpp>
+#include <AGE/Core/classes/ConfigReader.hpp>
+#include <AGE/Core/classes/JobManager.hpp>
+#include <AGE/Core/classes/SoundBank.hpp>
+#include <AGE/Core/classes/TraceManager.hpp>
+#include <AGE/Core/interfaces/IJob.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Job that decodes one sound effect of a SoundBank
+  class SoundBank::DecodeJob : public IJob
+  {
+    public:
+      DecodeJob(SoundBank& theSoundBank, typeEntry& theEntry) :
+        IJob(theEntry.id.getHash()),
+        mSoundBank(theSoundBank),
+        mEntry(theEntry)
+      {
+      }
+
+      /**
+       * DecodeJob deconstructor will report back to the sound bank whether
+       * the job was run or deleted by JobManager::deInit without being run.
+       */
+      virtual ~DecodeJob()
+      {
+        // Count it as decoded first so IsReady never sees it missing
+        mSoundBank.mDecoded.fetch_add(1);
+        mSoundBank.mDecoding.fetch_sub(1);
+      }
+
+      virtual void doJob(void)
+      {
+        TRACE_SCOPE_DETAIL("SoundBank::DecodeJob", "asset", mEntry.id.c_str());
+
+        // Decode into a private buffer nobody else can see yet
+        sf::SoundBuffer* anBuffer = new(std::nothrow) sf::SoundBuffer();
+        if(NULL != anBuffer && anBuffer->loadFromFile(mEntry.filename.str()))
+        {
+          mEntry.buffer = anBuffer;
+        }
+        else
+        {
+          WLOG() << "SoundBank::DecodeJob(" << mEntry.id
+            << ") unable to decode " << mEntry.filename << std::endl;
+          delete anBuffer;
+        }
+      }
+
+    private:
+      /// The sound bank to report back to
+      SoundBank& mSoundBank;
+      /// The sound effect to decode
+      typeEntry& mEntry;
+  }; // class SoundBank::DecodeJob
+
+  SoundBank::SoundBank(TAssetHandler<sf::SoundBuffer>& theSoundHandler,
+      JobManager& theJobManager) :
+    mSoundHandler(theSoundHandler),
+    mJobManager(theJobManager),
+    mPrefetched(false),
+    mInstalled(false),
+    mDecoding(0),
+    mDecoded(0)
+  {
+  }
+
+  SoundBank::~SoundBank()
+  {
+    release();
+  }
+
+  bool SoundBank::loadFromFile(const std::string& theFilename,
+      const std::string& theSection)
+  {
+    ConfigReader anConfig;
+    if(!anConfig.loadFromFile(theFilename))
+    {
+      ELOG() << "SoundBank::loadFromFile(" << theFilename
+        << ") unable to read sound bank" << std::endl;
+      return false;
+    }
+    loadFromConfig(anConfig, theSection);
+    return true;
+  }
+
+  void SoundBank::loadFromConfig(const ConfigReader& theConfig,
+      const std::string& theSection)
+  {
+    std::vector<std::string> anNames;
+    theConfig.getNames(theSection, anNames);
+
+    for(size_t iloop = 0; iloop < anNames.size(); iloop++)
+    {
+      addSound(anNames[iloop], theConfig.getString(theSection, anNames[iloop], ""));
+    }
+  }
+
+  void SoundBank::addSound(const assetID theAssetID, const std::string& theFilename)
+  {
+    if(mPrefetched)
+    {
+      WLOG() << "SoundBank::addSound(" << theAssetID
+        << ") added after Prefetch will not be decoded" << std::endl;
+      return;
+    }
+
+    for(size_t iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      if(mEntries[iloop].id == theAssetID)
+      {
+        return;
+      }
+    }
+
+    typeEntry anEntry;
+    anEntry.id = theAssetID;
+    anEntry.filename = theFilename.empty() ? theAssetID : Symbol(theFilename);
+    anEntry.buffer = NULL;
+    anEntry.referenced = false;
+    mEntries.push_back(anEntry);
+  }
+
+  void SoundBank::prefetch(void)
+  {
+    if(mPrefetched)
+    {
+      return;
+    }
+
+    mDecoded = 0;
+    mDecoding = (Uint32)mEntries.size();
+    mInstalled = false;
+    mPrefetched = true;
+
+    // Each job only touches its own entry so mEntries must not grow now
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      DecodeJob* anJob = new(std::nothrow) DecodeJob(*this, mEntries[iloop]);
+      if(NULL == anJob)
+      {
+        ELOG() << "SoundBank::prefetch(" << mEntries[iloop].id
+          << ") unable to create DecodeJob" << std::endl;
+        mDecoded.fetch_add(1);
+        mDecoding.fetch_sub(1);
+        continue;
+      }
+      mJobManager.addJob(anJob);
+    }
+  }
+
+  void SoundBank::update(void)
+  {
+    // Install everything at once after the last sound effect is decoded
+    if(mPrefetched && !mInstalled && 0 == mDecoding.load())
+    {
+      install();
+    }
+  }
+
+  void SoundBank::release(void)
+  {
+    if(!mPrefetched)
+    {
+      return;
+    }
+
+    // The DecodeJobs refer to us so wait for any still running
+    while(0 != mDecoding.load())
+    {
+      sf::sleep(sf::milliseconds(1));
+    }
+
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      // Decoded but never installed
+      delete mEntries[iloop].buffer;
+      mEntries[iloop].buffer = NULL;
+
+      if(mEntries[iloop].referenced)
+      {
+        mSoundHandler.dropReference(mEntries[iloop].id);
+        mEntries[iloop].referenced = false;
+      }
+    }
+
+    mInstalled = false;
+    mPrefetched = false;
+  }
+
+  bool SoundBank::isEmpty(void) const
+  {
+    return mEntries.empty();
+  }
+
+  bool SoundBank::isReady(void) const
+  {
+    return mInstalled;
+  }
+
+  float SoundBank::getProgress(void) const
+  {
+    if(mEntries.empty())
+    {
+      return 100.0f;
+    }
+    return 100.0f * (float)mDecoded.load() / (float)mEntries.size();
+  }
+
+  void SoundBank::install(void)
+  {
+    Uint32 anFailed = 0;
+    for(Uint32 iloop = 0; iloop < mEntries.size(); iloop++)
+    {
+      typeEntry& anEntry = mEntries[iloop];
+      if(NULL == anEntry.buffer)
+      {
+        anFailed++;
+        continue;
+      }
+
+      // The handler takes ownership of the buffer
+      anEntry.referenced = mSoundHandler.installAsset(anEntry.id, anEntry.buffer,
+        anEntry.filename);
+      anEntry.buffer = NULL;
+    }
+
+    if(0 != anFailed)
+    {
+      WLOG() << "SoundBank::install() " << anFailed << " of " << mEntries.size()
+        << " sound effects could not be decoded" << std::endl;
+    }
+
+    mInstalled = true;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,877 @@
+/**
+ * Provides the SoundManager class in the AGE namespace which is responsible
+ * for playing SoundAsset objects using a fixed pool of preallocated voices.
+ *
+ * @file src/AGE/Core/classes/SoundManager.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Added spatial grid of emitters bound to the loudest voices
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <cmath>
+#include <AGE/Core/assets/SoundAsset.hpp>
+#include <AGE/Core/classes/SoundManager.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Number of bits of each voice handle used for the voice index
+  static const Uint32 VOICE_INDEX_BITS = 8;
+  /// Generation numbers wrap back to 1 when they reach this value
+  static const Uint32 VOICE_MAX_GENERATION = 1 << (32 - VOICE_INDEX_BITS);
+  /// Number of bits of each emitter handle used for the emitter index
+  static const Uint32 EMITTER_INDEX_BITS = 16;
+  /// Emitter generation numbers wrap back to 1 when they reach this value
+  static const Uint32 EMITTER_MAX_GENERATION = 1 << (32 - EMITTER_INDEX_BITS);
+  /// Emitters already bound to a voice are treated as this much louder
+  static const float EMITTER_BOUND_BIAS = 1.25f;
+
+  const float SoundManager::DEFAULT_CELL_SIZE = 1024.0f;
+  const float SoundManager::DEFAULT_EMITTER_RANGE = 1024.0f;
+  const float SoundManager::MIN_AUDIBLE_VOLUME = 1.0f;
+
+  /**
+   * CompareLoudness will order the audible emitters from loudest to quietest.
+   * @param[in] theLeft emitter to compare
+   * @param[in] theRight emitter to compare
+   * @return true if theLeft is louder than theRight
+   */
+  static bool compareLoudness(const std::pair<float, Uint32>& theLeft,
+    const std::pair<float, Uint32>& theRight)
+  {
+    return theLeft.first > theRight.first;
+  }
+
+  SoundManager::SoundManager() :
+    mListener(0.0f, 0.0f, 0.0f),
+    mPlayed(0),
+    mActive(0),
+    mStolen(0),
+    mRejected(0),
+    mNullDevice(false),
+    mCellSize(DEFAULT_CELL_SIZE),
+    mEmitterRange(0.0f),
+    mEmitterVoices(DEFAULT_EMITTER_VOICES),
+    mEmitterCount(0),
+    mEmitterUpdates(0)
+  {
+    ILOGM("SoundManager::ctor()");
+
+    for(Uint32 iloop = 0; iloop < MAX_CATEGORIES; iloop++)
+    {
+      mCategoryCounts[iloop] = 0;
+      mCategoryLimits[iloop] = MAX_VOICES;
+    }
+  }
+
+  SoundManager::~SoundManager()
+  {
+    ILOGM("SoundManager::dtor()");
+
+    // Release our voices if DeInit wasn't called
+    deInit();
+  }
+
+  void SoundManager::doInit(Uint32 theVoices, bool theNullDevice)
+  {
+    // Release any voices previously allocated
+    deInit();
+
+    if(MAX_VOICES < theVoices)
+    {
+      WLOG() << "SoundManager::doInit(" << theVoices << ") limited to "
+        << MAX_VOICES << " voices" << std::endl;
+      theVoices = MAX_VOICES;
+    }
+
+    ILOG() << "SoundManager::doInit(" << theVoices << ","
+      << (theNullDevice ? "null" : "audio") << ") allocating voices" << std::endl;
+
+    mNullDevice = theNullDevice;
+    mVoices.resize(theVoices);
+    for(Uint32 iloop = 0; iloop < theVoices; iloop++)
+    {
+      typeVoice& anVoice = mVoices[iloop];
+      anVoice.sound = NULL;
+      anVoice.handler = NULL;
+      anVoice.data = NULL;
+      anVoice.generation = 0;
+      anVoice.started = 0;
+      anVoice.category = 0;
+      anVoice.priority = 0;
+      anVoice.remaining = 0.0f;
+      anVoice.relative = true;
+      anVoice.loop = false;
+      anVoice.active = false;
+
+      // Create every sound source now so Play never has to
+      if(!mNullDevice)
+      {
+        anVoice.sound = new(std::nothrow) sf::Sound();
+        assert(NULL != anVoice.sound && "SoundManager::doInit() unable to allocate voice");
+      }
+    }
+
+    mPlayed = 0;
+    mActive = 0;
+    mStolen = 0;
+    mRejected = 0;
+  }
+
+  void SoundManager::deInit(void)
+  {
+    // Emitters hold sound buffer references too
+    removeAllEmitters();
+
+    stopAll();
+
+    for(size_t iloop = 0; iloop < mVoices.size(); iloop++)
+    {
+      delete mVoices[iloop].sound;
+      mVoices[iloop].sound = NULL;
+    }
+    mVoices.clear();
+  }
+
+  Uint32 SoundManager::play(SoundAsset& theSound, const typeSoundParams& theParams)
+  {
+    if(mVoices.empty())
+    {
+      WLOG() << "SoundManager::play(" << theSound.getID()
+        << ") no voices, was DoInit called?" << std::endl;
+      return INVALID_VOICE;
+    }
+
+    Uint32 anCategory = theParams.category;
+    if(MAX_CATEGORIES <= anCategory)
+    {
+      WLOG() << "SoundManager::play(" << theSound.getID() << ") invalid category("
+        << anCategory << ")" << std::endl;
+      anCategory = 0;
+    }
+
+    // Make sure the sound buffer is loaded before taking a voice for it
+    theSound.getAsset();
+    TAssetHandler<sf::SoundBuffer>::typeAssetData* anData = theSound.getAssetData();
+    if(NULL == anData)
+    {
+      WLOG() << "SoundManager::play(" << theSound.getID()
+        << ") no sound buffer to play" << std::endl;
+      return INVALID_VOICE;
+    }
+
+    typeSoundParams anParams = theParams;
+    anParams.category = anCategory;
+    return playData(theSound.getHandler(), anData, anParams, true);
+  }
+
+  Uint32 SoundManager::playData(TAssetHandler<sf::SoundBuffer>& theHandler,
+    TAssetHandler<sf::SoundBuffer>::typeAssetData* theData,
+    const typeSoundParams& theParams, const bool theSteal)
+  {
+    const sf::SoundBuffer& anBuffer = *theData->asset;
+    const Uint32 anCategory = theParams.category;
+    const float anDistance = getDistance(theParams.relative, theParams.position);
+
+    // Find a free voice unless the category has reached its limit
+    Uint32 anIndex = (Uint32)mVoices.size();
+    if(mCategoryCounts[anCategory] < mCategoryLimits[anCategory])
+    {
+      for(Uint32 iloop = 0; iloop < mVoices.size(); iloop++)
+      {
+        if(isFinished(mVoices[iloop]))
+        {
+          anIndex = iloop;
+          break;
+        }
+      }
+      if(anIndex == mVoices.size() && theSteal)
+      {
+        anIndex = findVictim(MAX_CATEGORIES, theParams.priority, anDistance);
+      }
+    }
+    else if(theSteal)
+    {
+      anIndex = findVictim(anCategory, theParams.priority, anDistance);
+    }
+
+    if(anIndex == mVoices.size())
+    {
+      if(theSteal)
+      {
+        mRejected++;
+      }
+      return INVALID_VOICE;
+    }
+
+    typeVoice& anVoice = mVoices[anIndex];
+    if(anVoice.active)
+    {
+      // Only count the voices that were still playing
+      if(!isFinished(anVoice))
+      {
+        mStolen++;
+      }
+      releaseVoice(anVoice);
+    }
+
+    // Hold a reference to the sound buffer while the voice plays it
+    TAssetHandler<sf::SoundBuffer>::addData(theData);
+    anVoice.handler = &theHandler;
+    anVoice.data = theData;
+
+    if(VOICE_MAX_GENERATION <= ++anVoice.generation)
+    {
+      anVoice.generation = 1;
+    }
+    anVoice.started = mPlayed++;
+    anVoice.category = anCategory;
+    anVoice.priority = theParams.priority;
+    anVoice.relative = theParams.relative;
+    anVoice.position = theParams.position;
+    anVoice.loop = theParams.loop;
+    anVoice.remaining = anBuffer.getDuration().asSeconds() * 1000.0f;
+    if(0.0f < theParams.pitch)
+    {
+      anVoice.remaining /= theParams.pitch;
+    }
+    anVoice.active = true;
+
+    mActive++;
+    mCategoryCounts[anCategory]++;
+
+    if(NULL != anVoice.sound)
+    {
+      anVoice.sound->setBuffer(anBuffer);
+      anVoice.sound->setVolume(theParams.volume);
+      anVoice.sound->setPitch(theParams.pitch);
+      anVoice.sound->setLoop(theParams.loop);
+      anVoice.sound->setRelativeToListener(theParams.relative);
+      anVoice.sound->setPosition(theParams.position);
+      anVoice.sound->setMinDistance(theParams.minDistance);
+      anVoice.sound->setAttenuation(theParams.attenuation);
+      anVoice.sound->play();
+    }
+
+    return (anVoice.generation << VOICE_INDEX_BITS) | anIndex;
+  }
+
+  void SoundManager::stop(const Uint32 theVoice)
+  {
+    typeVoice* anVoice = const_cast<typeVoice*>(findVoice(theVoice));
+    if(NULL != anVoice)
+    {
+      releaseVoice(*anVoice);
+    }
+  }
+
+  void SoundManager::stopAll(void)
+  {
+    for(size_t iloop = 0; iloop < mVoices.size(); iloop++)
+    {
+      if(mVoices[iloop].active)
+      {
+        releaseVoice(mVoices[iloop]);
+      }
+    }
+  }
+
+  bool SoundManager::isPlaying(const Uint32 theVoice) const
+  {
+    const typeVoice* anVoice = findVoice(theVoice);
+    return NULL != anVoice && !isFinished(*anVoice);
+  }
+
+  void SoundManager::setPosition(const Uint32 theVoice, const sf::Vector3f& thePosition)
+  {
+    typeVoice* anVoice = const_cast<typeVoice*>(findVoice(theVoice));
+    if(NULL != anVoice)
+    {
+      anVoice->position = thePosition;
+      if(NULL != anVoice->sound)
+      {
+        anVoice->sound->setPosition(thePosition);
+      }
+    }
+  }
+
+  void SoundManager::setListenerPosition(const sf::Vector3f& thePosition)
+  {
+    mListener = thePosition;
+    if(!mNullDevice)
+    {
+      sf::Listener::setPosition(thePosition);
+    }
+  }
+
+  Uint32 SoundManager::addEmitter(SoundAsset& theSound, const typeSoundParams& theParams,
+    const float theRange)
+  {
+    // Make sure the sound buffer is loaded before adding an emitter for it
+    theSound.getAsset();
+    TAssetHandler<sf::SoundBuffer>::typeAssetData* anData = theSound.getAssetData();
+    if(NULL == anData)
+    {
+      WLOG() << "SoundManager::addEmitter(" << theSound.getID()
+        << ") no sound buffer to play" << std::endl;
+      return INVALID_EMITTER;
+    }
+
+    // Reuse a removed emitter slot if possible
+    Uint32 anIndex = (Uint32)mEmitters.size();
+    if(!mFreeEmitters.empty())
+    {
+      anIndex = mFreeEmitters.back();
+      mFreeEmitters.pop_back();
+    }
+    else if((1u << EMITTER_INDEX_BITS) > anIndex)
+    {
+      typeEmitter anEmitter;
+      anEmitter.generation = 0;
+      anEmitter.active = false;
+      mEmitters.push_back(anEmitter);
+    }
+    else
+    {
+      ELOG() << "SoundManager::addEmitter(" << theSound.getID()
+        << ") too many emitters" << std::endl;
+      return INVALID_EMITTER;
+    }
+
+    // Hold a reference to the sound buffer while the emitter exists
+    TAssetHandler<sf::SoundBuffer>::addData(anData);
+
+    typeEmitter& anEmitter = mEmitters[anIndex];
+    anEmitter.handler = &theSound.getHandler();
+    anEmitter.data = anData;
+    anEmitter.params = theParams;
+    anEmitter.params.loop = true;
+    anEmitter.params.relative = false;
+    if(MAX_CATEGORIES <= anEmitter.params.category)
+    {
+      WLOG() << "SoundManager::addEmitter(" << theSound.getID() << ") invalid category("
+        << anEmitter.params.category << ")" << std::endl;
+      anEmitter.params.category = 0;
+    }
+    anEmitter.range = theRange;
+    anEmitter.loudness = 0.0f;
+    anEmitter.voice = INVALID_VOICE;
+    anEmitter.selected = mEmitterUpdates - 1;
+    anEmitter.dirty = false;
+    anEmitter.active = true;
+    if(EMITTER_MAX_GENERATION <= ++anEmitter.generation)
+    {
+      anEmitter.generation = 1;
+    }
+    addToCell(anIndex);
+
+    if(theRange > mEmitterRange)
+    {
+      mEmitterRange = theRange;
+    }
+    mEmitterCount++;
+
+    return (anEmitter.generation << EMITTER_INDEX_BITS) | anIndex;
+  }
+
+  void SoundManager::removeEmitter(const Uint32 theEmitter)
+  {
+    typeEmitter* anEmitter = findEmitter(theEmitter);
+    if(NULL == anEmitter)
+    {
+      return;
+    }
+
+    const Uint32 anIndex = theEmitter & ((1 << EMITTER_INDEX_BITS) - 1);
+    if(INVALID_VOICE != anEmitter->voice)
+    {
+      stop(anEmitter->voice);
+      anEmitter->voice = INVALID_VOICE;
+      mBound.erase(std::find(mBound.begin(), mBound.end(), anIndex));
+    }
+    removeFromCell(anIndex);
+
+    // Drop our reference to the sound buffer
+    anEmitter->handler->dropData(anEmitter->data);
+    anEmitter->handler = NULL;
+    anEmitter->data = NULL;
+    anEmitter->active = false;
+
+    mFreeEmitters.push_back(anIndex);
+    mEmitterCount--;
+  }
+
+  void SoundManager::removeAllEmitters(void)
+  {
+    for(Uint32 iloop = 0; iloop < mEmitters.size(); iloop++)
+    {
+      if(mEmitters[iloop].active)
+      {
+        removeEmitter((mEmitters[iloop].generation << EMITTER_INDEX_BITS) | iloop);
+      }
+    }
+    mEmitters.clear();
+    mFreeEmitters.clear();
+    mBound.clear();
+    mCells.clear();
+    mEmitterRange = 0.0f;
+  }
+
+  void SoundManager::setEmitterPosition(const Uint32 theEmitter, const sf::Vector3f& thePosition)
+  {
+    typeEmitter* anEmitter = findEmitter(theEmitter);
+    if(NULL == anEmitter)
+    {
+      return;
+    }
+
+    const Uint32 anIndex = theEmitter & ((1 << EMITTER_INDEX_BITS) - 1);
+    const bool anMoved = getCell(thePosition) != anEmitter->cell;
+    if(anMoved)
+    {
+      removeFromCell(anIndex);
+    }
+    anEmitter->params.position = thePosition;
+    anEmitter->dirty = true;
+    if(anMoved)
+    {
+      addToCell(anIndex);
+    }
+  }
+
+  void SoundManager::setEmitterVolume(const Uint32 theEmitter, const float theVolume)
+  {
+    typeEmitter* anEmitter = findEmitter(theEmitter);
+    if(NULL != anEmitter)
+    {
+      anEmitter->params.volume = theVolume;
+      anEmitter->dirty = true;
+    }
+  }
+
+  void SoundManager::setEmitterVoices(const Uint32 theVoices)
+  {
+    mEmitterVoices = theVoices;
+  }
+
+  void SoundManager::setEmitterGrid(const float theCellSize)
+  {
+    if(0.0f >= theCellSize)
+    {
+      ELOG() << "SoundManager::setEmitterGrid(" << theCellSize
+        << ") cell size must be positive" << std::endl;
+      return;
+    }
+
+    mCellSize = theCellSize;
+    mCells.clear();
+    for(Uint32 iloop = 0; iloop < mEmitters.size(); iloop++)
+    {
+      if(mEmitters[iloop].active)
+      {
+        addToCell(iloop);
+      }
+    }
+  }
+
+  void SoundManager::setCategoryLimit(const Uint32 theCategory, const Uint32 theLimit)
+  {
+    if(MAX_CATEGORIES <= theCategory)
+    {
+      ELOG() << "SoundManager::setCategoryLimit(" << theCategory
+        << ") invalid category" << std::endl;
+      return;
+    }
+    mCategoryLimits[theCategory] = theLimit;
+  }
+
+  void SoundManager::update(float theElapsedTime)
+  {
+    for(size_t iloop = 0; iloop < mVoices.size(); iloop++)
+    {
+      typeVoice& anVoice = mVoices[iloop];
+      if(anVoice.active)
+      {
+        // The null device counts down the duration of each sound instead
+        if(NULL == anVoice.sound && !anVoice.loop)
+        {
+          anVoice.remaining -= theElapsedTime;
+        }
+
+        if(isFinished(anVoice))
+        {
+          releaseVoice(anVoice);
+        }
+      }
+    }
+
+    if(0 != mEmitterCount)
+    {
+      updateEmitters();
+    }
+  }
+
+  Uint32 SoundManager::getVoiceCount(void) const
+  {
+    return (Uint32)mVoices.size();
+  }
+
+  Uint32 SoundManager::getActiveCount(void) const
+  {
+    return mActive;
+  }
+
+  Uint32 SoundManager::getStolenCount(void) const
+  {
+    return mStolen;
+  }
+
+  Uint32 SoundManager::getRejectedCount(void) const
+  {
+    return mRejected;
+  }
+
+  Uint32 SoundManager::getEmitterCount(void) const
+  {
+    return mEmitterCount;
+  }
+
+  Uint32 SoundManager::getAudibleCount(void) const
+  {
+    return (Uint32)mAudible.size();
+  }
+
+  Uint32 SoundManager::getBoundCount(void) const
+  {
+    return (Uint32)mBound.size();
+  }
+
+  SoundManager::typeEmitter* SoundManager::findEmitter(const Uint32 theEmitter)
+  {
+    const Uint32 anIndex = theEmitter & ((1 << EMITTER_INDEX_BITS) - 1);
+    if(INVALID_EMITTER == theEmitter || anIndex >= mEmitters.size())
+    {
+      return NULL;
+    }
+
+    // Make sure the slot hasn't been reused for another emitter
+    typeEmitter& anEmitter = mEmitters[anIndex];
+    if(!anEmitter.active || anEmitter.generation != (theEmitter >> EMITTER_INDEX_BITS))
+    {
+      return NULL;
+    }
+
+    return &anEmitter;
+  }
+
+  Uint64 SoundManager::getCell(const sf::Vector3f& thePosition) const
+  {
+    const Int32 anX = (Int32)std::floor(thePosition.x / mCellSize);
+    const Int32 anY = (Int32)std::floor(thePosition.y / mCellSize);
+    return ((Uint64)(Uint32)anX << 32) | (Uint32)anY;
+  }
+
+  void SoundManager::addToCell(const Uint32 theIndex)
+  {
+    typeEmitter& anEmitter = mEmitters[theIndex];
+    anEmitter.cell = getCell(anEmitter.params.position);
+    std::vector<Uint32>& anCell = mCells[anEmitter.cell];
+    anEmitter.cellIndex = (Uint32)anCell.size();
+    anCell.push_back(theIndex);
+  }
+
+  void SoundManager::removeFromCell(const Uint32 theIndex)
+  {
+    typeEmitter& anEmitter = mEmitters[theIndex];
+    typeCellMap::iterator iter = mCells.find(anEmitter.cell);
+    assert(iter != mCells.end() && "SoundManager::removeFromCell() emitter not in its cell");
+    if(iter == mCells.end())
+    {
+      return;
+    }
+
+    // Move the last emitter of the cell into the slot being removed
+    std::vector<Uint32>& anCell = iter->second;
+    const Uint32 anLast = anCell.back();
+    anCell[anEmitter.cellIndex] = anLast;
+    mEmitters[anLast].cellIndex = anEmitter.cellIndex;
+    anCell.pop_back();
+    if(anCell.empty())
+    {
+      mCells.erase(iter);
+    }
+  }
+
+  void SoundManager::updateEmitters(void)
+  {
+    mEmitterUpdates++;
+    mAudible.clear();
+
+    // Only look at the cells within range of the listener
+    const Int32 anMinX = (Int32)std::floor((mListener.x - mEmitterRange) / mCellSize);
+    const Int32 anMaxX = (Int32)std::floor((mListener.x + mEmitterRange) / mCellSize);
+    const Int32 anMinY = (Int32)std::floor((mListener.y - mEmitterRange) / mCellSize);
+    const Int32 anMaxY = (Int32)std::floor((mListener.y + mEmitterRange) / mCellSize);
+    const Uint64 anCells = (Uint64)(anMaxX - anMinX + 1) * (Uint64)(anMaxY - anMinY + 1);
+    if(anCells > mCells.size())
+    {
+      // Fewer cells hold emitters than are in range, so check each of them
+      for(typeCellMap::const_iterator iter = mCells.begin(); iter != mCells.end(); iter++)
+      {
+        addAudible(iter->second);
+      }
+    }
+    else
+    {
+      for(Int32 anX = anMinX; anX <= anMaxX; anX++)
+      {
+        for(Int32 anY = anMinY; anY <= anMaxY; anY++)
+        {
+          typeCellMap::const_iterator iter =
+            mCells.find(((Uint64)(Uint32)anX << 32) | (Uint32)anY);
+          if(iter != mCells.end())
+          {
+            addAudible(iter->second);
+          }
+        }
+      }
+    }
+
+    // Choose the loudest emitters that can be heard
+    Uint32 anVoices = std::min(mEmitterVoices, (Uint32)mVoices.size());
+    if(mAudible.size() > anVoices)
+    {
+      std::nth_element(mAudible.begin(), mAudible.begin() + anVoices,
+        mAudible.end(), compareLoudness);
+    }
+    else
+    {
+      anVoices = (Uint32)mAudible.size();
+    }
+    for(Uint32 iloop = 0; iloop < anVoices; iloop++)
+    {
+      mEmitters[mAudible[iloop].second].selected = mEmitterUpdates;
+    }
+
+    // Free the voices of the emitters no longer chosen (or stolen) first
+    for(size_t iloop = 0; iloop < mBound.size();)
+    {
+      typeEmitter& anEmitter = mEmitters[mBound[iloop]];
+      if(mEmitterUpdates != anEmitter.selected || !isPlaying(anEmitter.voice))
+      {
+        stop(anEmitter.voice);
+        anEmitter.voice = INVALID_VOICE;
+        mBound[iloop] = mBound.back();
+        mBound.pop_back();
+      }
+      else
+      {
+        iloop++;
+      }
+    }
+
+    // Push the changes of the emitters still bound in one pass
+    for(size_t iloop = 0; iloop < mBound.size(); iloop++)
+    {
+      typeEmitter& anEmitter = mEmitters[mBound[iloop]];
+      if(anEmitter.dirty)
+      {
+        const Uint32 anIndex = anEmitter.voice & ((1 << VOICE_INDEX_BITS) - 1);
+        typeVoice& anVoice = mVoices[anIndex];
+        anVoice.position = anEmitter.params.position;
+        if(NULL != anVoice.sound)
+        {
+          anVoice.sound->setPosition(anEmitter.params.position);
+          anVoice.sound->setVolume(anEmitter.params.volume);
+        }
+        anEmitter.dirty = false;
+      }
+    }
+
+    // Bind the newly chosen emitters to voices
+    for(Uint32 iloop = 0; iloop < anVoices; iloop++)
+    {
+      const Uint32 anIndex = mAudible[iloop].second;
+      typeEmitter& anEmitter = mEmitters[anIndex];
+      if(INVALID_VOICE == anEmitter.voice)
+      {
+        // Emitters only use free voices so they never steal from each other
+        anEmitter.voice = playData(*anEmitter.handler, anEmitter.data,
+          anEmitter.params, false);
+        if(INVALID_VOICE != anEmitter.voice)
+        {
+          anEmitter.dirty = false;
+          mBound.push_back(anIndex);
+        }
+      }
+    }
+  }
+
+  void SoundManager::addAudible(const std::vector<Uint32>& theCell)
+  {
+    for(size_t iloop = 0; iloop < theCell.size(); iloop++)
+    {
+      typeEmitter& anEmitter = mEmitters[theCell[iloop]];
+      const float anDistance =
+        std::sqrt(getDistance(false, anEmitter.params.position));
+      if(anDistance > anEmitter.range)
+      {
+        continue;
+      }
+
+      // Same inverse distance clamped model OpenAL uses for the source
+      const typeSoundParams& anParams = anEmitter.params;
+      float anGain = 1.0f;
+      if(anDistance > anParams.minDistance && 0.0f < anParams.minDistance)
+      {
+        anGain = anParams.minDistance / (anParams.minDistance +
+          anParams.attenuation * (anDistance - anParams.minDistance));
+      }
+      anEmitter.loudness = anParams.volume * anGain;
+      if(anEmitter.loudness < MIN_AUDIBLE_VOLUME)
+      {
+        continue;
+      }
+
+      float anRank = anEmitter.loudness;
+      if(INVALID_VOICE != anEmitter.voice)
+      {
+        anRank *= EMITTER_BOUND_BIAS;
+      }
+      mAudible.push_back(std::pair<float, Uint32>(anRank, theCell[iloop]));
+    }
+  }
+
+  const SoundManager::typeVoice* SoundManager::findVoice(const Uint32 theVoice) const
+  {
+    const Uint32 anIndex = theVoice & ((1 << VOICE_INDEX_BITS) - 1);
+    if(INVALID_VOICE == theVoice || anIndex >= mVoices.size())
+    {
+      return NULL;
+    }
+
+    // Make sure the voice hasn't been reused for another sound
+    const typeVoice& anVoice = mVoices[anIndex];
+    if(!anVoice.active || anVoice.generation != (theVoice >> VOICE_INDEX_BITS))
+    {
+      return NULL;
+    }
+
+    return &anVoice;
+  }
+
+  Uint32 SoundManager::findVictim(const Uint32 theCategory, const Int32 thePriority,
+    const float theDistance) const
+  {
+    Uint32 anResult = (Uint32)mVoices.size();
+    float anResultDistance = 0.0f;
+
+    for(Uint32 iloop = 0; iloop < mVoices.size(); iloop++)
+    {
+      const typeVoice& anVoice = mVoices[iloop];
+      if(!anVoice.active || (MAX_CATEGORIES != theCategory && anVoice.category != theCategory))
+      {
+        continue;
+      }
+
+      // A voice that has already finished is always the best choice
+      if(isFinished(anVoice))
+      {
+        return iloop;
+      }
+
+      // Never steal from a higher priority sound
+      if(anVoice.priority > thePriority)
+      {
+        continue;
+      }
+
+      // Prefer the lowest priority, then the farthest, then the oldest
+      const float anDistance = getDistance(anVoice.relative, anVoice.position);
+      if(anResult == mVoices.size())
+      {
+        anResult = iloop;
+        anResultDistance = anDistance;
+        continue;
+      }
+      const typeVoice& anBest = mVoices[anResult];
+      if(anVoice.priority < anBest.priority ||
+        (anVoice.priority == anBest.priority &&
+        (anDistance > anResultDistance ||
+        (anDistance == anResultDistance && (Int32)(anVoice.started - anBest.started) < 0))))
+      {
+        anResult = iloop;
+        anResultDistance = anDistance;
+      }
+    }
+
+    // Don't steal a nearer sound of the same priority for a farther one
+    if(anResult != mVoices.size() && mVoices[anResult].priority == thePriority &&
+      anResultDistance < theDistance)
+    {
+      anResult = (Uint32)mVoices.size();
+    }
+
+    return anResult;
+  }
+
+  float SoundManager::getDistance(const bool theRelative, const sf::Vector3f& thePosition) const
+  {
+    sf::Vector3f anDelta = theRelative ? thePosition : thePosition - mListener;
+    return anDelta.x * anDelta.x + anDelta.y * anDelta.y + anDelta.z * anDelta.z;
+  }
+
+  bool SoundManager::isFinished(const typeVoice& theVoice) const
+  {
+    if(!theVoice.active)
+    {
+      return true;
+    }
+    if(NULL != theVoice.sound)
+    {
+      return sf::Sound::Stopped == theVoice.sound->getStatus();
+    }
+    return !theVoice.loop && theVoice.remaining <= 0.0f;
+  }
+
+  void SoundManager::releaseVoice(typeVoice& theVoice)
+  {
+    if(NULL != theVoice.sound)
+    {
+      theVoice.sound->stop();
+      theVoice.sound->resetBuffer();
+    }
+
+    // Drop our reference to the sound buffer
+    theVoice.handler->dropData(theVoice.data);
+    theVoice.handler = NULL;
+    theVoice.data = NULL;
+    theVoice.active = false;
+
+    mActive--;
+    mCategoryCounts[theVoice.category]--;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -20,26 +20,57 @@
  * @date 20120518 - Use sf::Font instead of FontAsset to remove circular dependency
  * @date 20120609 - Whitespace changes
  * @date 20120616 - Add std::nothrow to new commands for mFPS and mUPS
+ * @date 20261018 - Add frame, update and render time histograms and percentiles
+ * @date 20261018 - Game::mWindow is now a pointer
+ * @date 20261018 - Format the UPS and FPS strings without std::ostringstream
+ * @date 20261018 - Add GetPoolStats and log the ObjectPool usage at DeInit
+ * @date 20261018 - Draw the memory used by each MemoryTracker tag
+ * @date 20261018 - Draw to the window returned by Game::getWindow
+ * @date 20261018 - Don't export the time statistics unless a filename is set
  */
 
 #include <assert.h>
-#include <sstream>
+#include <stdio.h>
+#include <string.h>
 #include <AGE/Core/loggers/Log_macros.hpp>
 #include <AGE/Core/classes/StatManager.hpp>
 #include <AGE/Core/interfaces/Game.hpp>
+#include <AGE/Core/utils/StringUtil.hpp>
 
 namespace AGE
 {
+  /**
+   * AppendText will copy theText provided to the end of theBuffer.
+   * @param[in] theBuffer to append to
+   * @param[in] theLength of the text already in theBuffer
+   * @param[in] theText to append
+   * @return the new length of the text in theBuffer
+   */
+  static size_t appendText(char* theBuffer, size_t theLength, const char* theText)
+  {
+    size_t anLength = strlen(theText);
+    memcpy(theBuffer + theLength, theText, anLength + 1);
+    return theLength + anLength;
+  }
+
+  /// Suggested filename for exporting the time statistics at DeInit
+  const char* StatManager::DEFAULT_EXPORT_FILENAME = "stats.csv";
+
   StatManager::StatManager() :
     mApp(NULL),
     mShow(false),
+    mShowMemory(false),
     mFrames(0),
     mFrameClock(),
     mDefaultFont(),
     mFPS(NULL),
     mUpdates(0),
     mUpdateClock(),
-    mUPS(NULL)
+    mUPS(NULL),
+    mMemory(NULL),
+    mSlice(0),
+    mSliceClock(),
+    mExportFilename()
   {
     ILOGM("StatManager::ctor()");
 		mDefaultFont.loadFromFile("resources/arial.ttf");
@@ -61,10 +92,22 @@ namespace AGE
     mFrames = 0;
     mUpdates = 0;
 
+    // Reset our time histograms
+    for(Uint32 iloop = 0; iloop < StatTypeCount; iloop++)
+    {
+      mTotal[iloop].reset();
+      for(Uint32 jloop = 0; jloop < WINDOW_SLICES; jloop++)
+      {
+        mWindow[iloop][jloop].reset();
+      }
+    }
+    mSlice = 0;
+
     // Reset our clocks
 
     mFrameClock.restart();
     mUpdateClock.restart();
+    mSliceClock.restart();
 
     // Position and color for the FPS/UPS string
     mFPS = new(std::nothrow) sf::Text("", mDefaultFont, 30);
@@ -75,12 +118,40 @@ namespace AGE
     mUPS->setFillColor(sf::Color(0,255,0,128));
     mUPS->setPosition(0,30);
 
+    mMemory = new(std::nothrow) sf::Text("", mDefaultFont, 20);
+    mMemory->setFillColor(sf::Color(255,255,0,160));
+    mMemory->setPosition(0,60);
+
   }
 
   void StatManager::deInit(void)
   {
     ILOGM("StatManager::DeInit()");
 
+    // Dump a summary of the time statistics collected to the log file
+    ILOG() << "StatManager::deInit() frame time p50="
+      << getPercentile(StatFrameTime, 50.0f, false) << "us p95="
+      << getPercentile(StatFrameTime, 95.0f, false) << "us p99="
+      << getPercentile(StatFrameTime, 99.0f, false) << "us max="
+      << getMaxTime(StatFrameTime, false) << "us" << std::endl;
+
+    // Dump how much of each object pool was used to the log file
+    std::vector<ObjectPool::typeStats> anPools;
+    getPoolStats(anPools);
+    for(size_t iloop = 0; iloop < anPools.size(); iloop++)
+    {
+      ILOG() << "StatManager::deInit() pool " << anPools[iloop].name << "("
+        << anPools[iloop].blockSize << ") used=" << anPools[iloop].used
+        << " peak=" << anPools[iloop].peak << " capacity="
+        << anPools[iloop].capacity << std::endl;
+    }
+
+    // Export the time statistics collected if requested
+    if(false == mExportFilename.empty())
+    {
+      writeToFile(mExportFilename);
+    }
+
     // Delete our FPS string
     delete mFPS;
     mFPS = NULL;
@@ -88,6 +159,10 @@ namespace AGE
     // Delete our UPS string
     delete mUPS;
     mUPS = NULL;
+
+    // Delete our memory string
+    delete mMemory;
+    mMemory = NULL;
   }
 
   bool StatManager::isShowing(void) const
@@ -100,6 +175,16 @@ namespace AGE
     mShow = theShow;
   }
 
+  bool StatManager::isShowingMemory(void) const
+  {
+    return mShowMemory;
+  }
+
+  void StatManager::setShowMemory(bool theShow)
+  {
+    mShowMemory = theShow;
+  }
+
   Uint32 StatManager::getUpdates(void) const
   {
     return mUpdates;
@@ -110,6 +195,168 @@ namespace AGE
     return mFrames;
   }
 
+  void StatManager::recordTime(StatType theType, Int64 theMicroseconds)
+  {
+    // Sanity check theType provided
+    assert(theType < StatTypeCount && "StatManager::recordTime() invalid type provided");
+
+    // Advance the sliding window once each second
+    if(StatFrameTime == theType && mSliceClock.getElapsedTime().asSeconds() >= 1.0f)
+    {
+      mSlice = (mSlice + 1) % WINDOW_SLICES;
+      for(Uint32 iloop = 0; iloop < StatTypeCount; iloop++)
+      {
+        mWindow[iloop][mSlice].reset();
+      }
+      mSliceClock.restart();
+    }
+
+    // Clamp theMicroseconds to the range supported by the histograms
+    Uint32 anValue = theMicroseconds < 0 ? 0 :
+      (theMicroseconds > 0xFFFFFFFF ? 0xFFFFFFFF : (Uint32)theMicroseconds);
+
+    mTotal[theType].record(anValue);
+    mWindow[theType][mSlice].record(anValue);
+  }
+
+  Uint32 StatManager::getPercentile(StatType theType, float thePercentile,
+      bool theWindow) const
+  {
+    // Sanity check theType provided
+    assert(theType < StatTypeCount && "StatManager::getPercentile() invalid type provided");
+
+    if(theWindow)
+    {
+      Histogram anWindow;
+      getWindow(theType, anWindow);
+      return anWindow.getPercentile(thePercentile);
+    }
+    return mTotal[theType].getPercentile(thePercentile);
+  }
+
+  Uint32 StatManager::getMaxTime(StatType theType, bool theWindow) const
+  {
+    // Sanity check theType provided
+    assert(theType < StatTypeCount && "StatManager::getMaxTime() invalid type provided");
+
+    Uint32 anResult = 0;
+    if(theWindow)
+    {
+      for(Uint32 iloop = 0; iloop < WINDOW_SLICES; iloop++)
+      {
+        if(mWindow[theType][iloop].getMax() > anResult)
+        {
+          anResult = mWindow[theType][iloop].getMax();
+        }
+      }
+    }
+    else
+    {
+      anResult = mTotal[theType].getMax();
+    }
+    return anResult;
+  }
+
+  void StatManager::getPoolStats(std::vector<ObjectPool::typeStats>& thePools) const
+  {
+    ObjectPool::getAllStats(thePools);
+  }
+
+  const std::string& StatManager::getExportFilename(void) const
+  {
+    return mExportFilename;
+  }
+
+  void StatManager::setExportFilename(const std::string theFilename)
+  {
+    mExportFilename = theFilename;
+  }
+
+  bool StatManager::writeToFile(const std::string theFilename) const
+  {
+    static const char* anNames[StatTypeCount] = { "frame", "update", "render" };
+
+    // Use JSON if theFilename ends in .json, otherwise use CSV
+    bool anJSON = theFilename.size() >= 5 &&
+      0 == theFilename.compare(theFilename.size() - 5, 5, ".json");
+
+    FILE* anFile = fopen(theFilename.c_str(), "w");
+    if(NULL == anFile)
+    {
+      ELOG() << "StatManager::writeToFile(" << theFilename
+        << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    if(anJSON)
+    {
+      fprintf(anFile, "{");
+    }
+    else
+    {
+      fprintf(anFile, "stat,range,count,min_us,mean_us,p50_us,p95_us,p99_us,max_us\n");
+    }
+
+    for(Uint32 iloop = 0; iloop < StatTypeCount; iloop++)
+    {
+      // Write the sliding window first and then the entire run
+      Histogram anRanges[2];
+      getWindow((StatType)iloop, anRanges[0]);
+      anRanges[1].merge(mTotal[iloop]);
+      static const char* anRangeNames[2] = { "window", "total" };
+
+      if(anJSON)
+      {
+        fprintf(anFile, "%s\n  \"%s\": {", iloop == 0 ? "" : ",", anNames[iloop]);
+      }
+      for(Uint32 jloop = 0; jloop < 2; jloop++)
+      {
+        const Histogram& anRange = anRanges[jloop];
+        if(anJSON)
+        {
+          fprintf(anFile, "%s\n    \"%s\": {\"count\": %llu, \"min_us\": %u, "
+              "\"mean_us\": %.1f, \"p50_us\": %u, \"p95_us\": %u, "
+              "\"p99_us\": %u, \"max_us\": %u}", jloop == 0 ? "" : ",",
+              anRangeNames[jloop], (unsigned long long)anRange.getCount(),
+              anRange.getMin(), anRange.getMean(), anRange.getPercentile(50.0f),
+              anRange.getPercentile(95.0f), anRange.getPercentile(99.0f),
+              anRange.getMax());
+        }
+        else
+        {
+          fprintf(anFile, "%s,%s,%llu,%u,%.1f,%u,%u,%u,%u\n", anNames[iloop],
+              anRangeNames[jloop], (unsigned long long)anRange.getCount(),
+              anRange.getMin(), anRange.getMean(), anRange.getPercentile(50.0f),
+              anRange.getPercentile(95.0f), anRange.getPercentile(99.0f),
+              anRange.getMax());
+        }
+      }
+      if(anJSON)
+      {
+        fprintf(anFile, "\n  }");
+      }
+    }
+
+    if(anJSON)
+    {
+      fprintf(anFile, "\n}\n");
+    }
+    fclose(anFile);
+
+    ILOG() << "StatManager::writeToFile(" << theFilename << ") complete" << std::endl;
+
+    // Return true, the statistics were written
+    return true;
+  }
+
+  void StatManager::getWindow(StatType theType, Histogram& theHistogram) const
+  {
+    for(Uint32 iloop = 0; iloop < WINDOW_SLICES; iloop++)
+    {
+      theHistogram.merge(mWindow[theType][iloop]);
+    }
+  }
+
   void StatManager::registerApp(Game* theApp)
   {
     // Check that our pointer is good
@@ -131,15 +378,12 @@ namespace AGE
       if(mUpdateClock.getElapsedTime().asSeconds() > 1.0f)
 
       {
-        // Updates string stream
-        std::ostringstream updates;
-
         // Update our UPS string to be displayed
-        updates.precision(2);
-        updates.width(7);
-        updates << "UPS: " << std::fixed << mUpdates;
+        char anText[FORMAT_BUFFER_SIZE * 2];
+        size_t anLength = appendText(anText, 0, "  UPS: ");
+        anLength += formatUint64(anText + anLength, mUpdates);
 
-        mUPS->setString(updates.str());
+        mUPS->setString(anText);
 
 
         // Reset our Update clock and update counter
@@ -161,15 +405,42 @@ namespace AGE
     if(mFrameClock.getElapsedTime().asSeconds() > 1.0f)
 
     {
-      // Frames string stream
-      std::ostringstream frames;
-
-      // Get our FramesPerSecond value
-      frames.precision(2);
-      frames.width(7);
-      frames << "FPS: " << std::fixed << mFrames;
-
-      mFPS->setString(frames.str());
+      // Get our FramesPerSecond value and the 99th percentile frame time
+      // in milliseconds rounded to 2 decimal places
+      Uint32 anHundredths = (getPercentile(StatFrameTime, 99.0f) + 5) / 10;
+      char anText[FORMAT_BUFFER_SIZE * 4];
+      size_t anLength = appendText(anText, 0, "  FPS: ");
+      anLength += formatUint64(anText + anLength, mFrames);
+      anLength = appendText(anText, anLength, " p99: ");
+      anLength += formatUint64(anText + anLength, anHundredths / 100);
+      anText[anLength++] = '.';
+      anText[anLength++] = (char)('0' + anHundredths / 10 % 10);
+      anText[anLength++] = (char)('0' + anHundredths % 10);
+      anLength = appendText(anText, anLength, "ms");
+
+      mFPS->setString(anText);
+
+      // Update the current and peak kilobytes used by each memory tag
+      if(mShowMemory)
+      {
+        char anMemory[FORMAT_BUFFER_SIZE * 4 * (MemoryTracker::MemoryTagCount + 1)];
+        size_t anMemoryLength = appendText(anMemory, 0, "  Memory KB (now/peak)");
+        for(Uint32 iloop = 0; iloop < MemoryTracker::MemoryTagCount; iloop++)
+        {
+          MemoryTracker::typeStats anStats;
+          MemoryTracker::getInstance().getStats((MemoryTracker::MemoryTag)iloop, anStats);
+          anMemoryLength = appendText(anMemory, anMemoryLength, "\n  ");
+          anMemoryLength = appendText(anMemory, anMemoryLength, anStats.name);
+          anMemoryLength = appendText(anMemory, anMemoryLength, ": ");
+          anMemoryLength += formatUint64(anMemory + anMemoryLength,
+            (0 < anStats.current) ? (Uint64)anStats.current / 1024 : 0);
+          anMemory[anMemoryLength++] = '/';
+          anMemoryLength += formatUint64(anMemory + anMemoryLength,
+            (0 < anStats.peak) ? (Uint64)anStats.peak / 1024 : 0);
+        }
+
+        mMemory->setString(anMemory);
+      }
 
 
       // Reset our Frames clock and frame counter
@@ -179,17 +450,23 @@ namespace AGE
 
     }
 
-    // Are we showing the current statistics?
-    if(mShow)
+    // Are we showing the current statistics? (and do we have a window?)
+    if(mShow && NULL != mApp->getWindow())
     {
 
       // Draw the Frames Per Second debug value on the screen
-      mApp->mWindow.draw(*mFPS);
+      mApp->getWindow()->draw(*mFPS);
 
       // Draw the Updates Per Second debug value on the screen
-      mApp->mWindow.draw(*mUPS);
+      mApp->getWindow()->draw(*mUPS);
 
     }
+
+    // Are we showing the memory used by each tag? (and do we have a window?)
+    if(mShowMemory && NULL != mApp->getWindow())
+    {
+      mApp->getWindow()->draw(*mMemory);
+    }
   }
 } // namespace AGE
 
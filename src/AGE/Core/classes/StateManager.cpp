@@ -20,6 +20,9 @@
  * @date 20120426 - Add another sanity check in HandleCleanup for active state
  * @date 20120512 - Renamed App to Game since it really is just an interface
  * @date 20120702 - Rename HandleCleanup to Cleanup.
+ * @date 20261018 - Added WhenReady methods to switch states once assets are loaded
+ * @date 20261018 - Never wait for the assets of the first state on the main thread
+ * @date 20261018 - Don't activate a pending state whose assets failed to load
  */
 
 #include <assert.h>
@@ -32,7 +35,9 @@
 namespace AGE
 {
   StateManager::StateManager() :
-    mApp(NULL)
+    mApp(NULL),
+    mPending(NULL),
+    mPendingAdd(false)
   {
     ILOGM("StateManager::ctor()");
   }
@@ -41,6 +46,9 @@ namespace AGE
   {
     ILOGM("StateManager::dtor()");
 
+    // Delete the pending state if it was never added
+    clearPending();
+
     // Drop all active states
     while(!mStack.empty())
     {
@@ -418,6 +426,108 @@ namespace AGE
     } // for(it=mStack.begin(); it < mStack.end(); it++)
   }
 
+  void StateManager::addActiveStateWhenReady(IState* theState)
+  {
+    // Check that they didn't provide a bad pointer
+    assert(NULL != theState && "StateManager::addActiveStateWhenReady() received a bad pointer");
+
+    // Log the adding of each state
+    ILOG() << "StateManager::addActiveStateWhenReady(" << theState->getID() << ")" << std::endl;
+
+    // Replace any state already waiting
+    clearPending();
+
+    // Start loading the assets of theState, UpdatePending will add it once
+    // they are loaded
+    theState->getManifest().prefetch();
+
+    mPending = theState;
+    mPendingAdd = true;
+  }
+
+  void StateManager::setActiveStateWhenReady(Id theStateID)
+  {
+    IState* anState = findState(theStateID);
+    if(NULL == anState)
+    {
+      ELOG() << "StateManager::setActiveStateWhenReady(" << theStateID
+        << ") state not found" << std::endl;
+      return;
+    }
+
+    // Log the setting of a previously active state as the pending state
+    ILOG() << "StateManager::setActiveStateWhenReady(" << theStateID << ")" << std::endl;
+
+    // Replace any state already waiting
+    clearPending();
+
+    // Start loading the assets of anState
+    anState->getManifest().prefetch();
+
+    mPending = anState;
+    mPendingAdd = false;
+  }
+
+  IState* StateManager::getPendingState(void)
+  {
+    return mPending;
+  }
+
+  void StateManager::updatePending(void)
+  {
+    // No state waiting for assets?
+    if(NULL == mPending)
+    {
+      return;
+    }
+
+    // Make sure the pending state wasn't removed from the stack meanwhile
+    if(!mPendingAdd && NULL == findState(mPending->getID()))
+    {
+      ELOG() << "StateManager::updatePending(" << mPending->getID()
+        << ") state was removed before it was ready" << std::endl;
+      mPending = NULL;
+      return;
+    }
+
+    // Start loading the next group of assets
+    mPending->getManifest().update();
+
+    // Never switch to a state with missing assets
+    if(mPending->getManifest().isReady() && mPending->getManifest().hasFailed())
+    {
+      ELOG() << "StateManager::updatePending(" << mPending->getID()
+        << ") assets failed to load, state not activated" << std::endl;
+
+      // States never added to the stack are ours to delete
+      if(mPendingAdd)
+      {
+        delete mPending;
+      }
+      mPending = NULL;
+
+      // Nothing left to run? then exit the program
+      if(mStack.empty() && NULL != mApp)
+      {
+        mApp->quit(StatusAppInitFailed);
+      }
+    }
+    else if(mPending->getManifest().isReady())
+    {
+      IState* anState = mPending;
+      mPending = NULL;
+
+      if(mPendingAdd)
+      {
+        addActiveState(anState);
+      }
+      else
+      {
+        setActiveState(anState->getID());
+      }
+    }
+  }
+
   void StateManager::cleanup(void)
   {
     // Always call our cleanup events with our pointer when this method is called
@@ -460,6 +570,33 @@ namespace AGE
     }
   }
 
+  IState* StateManager::findState(Id theStateID)
+  {
+    for(size_t iloop = 0; iloop < mStack.size(); iloop++)
+    {
+      if(mStack[iloop]->getID() == theStateID)
+      {
+        return mStack[iloop];
+      }
+    }
+    return NULL;
+  }
+
+  void StateManager::clearPending(void)
+  {
+    if(NULL != mPending)
+    {
+      WLOG() << "StateManager::clearPending(" << mPending->getID()
+        << ") pending state dropped before it was ready" << std::endl;
+
+      // States never added to the stack are ours to delete
+      if(mPendingAdd)
+      {
+        delete mPending;
+      }
+      mPending = NULL;
+    }
+  }
 } // namespace AGE
 
 /**
@@ -0,0 +1,147 @@
+/**
+ * Provides the StringPool class in the AGE namespace which is responsible
+ * for interning strings so each unique string is stored once and can be
+ * referred to by a stable 32 bit handle.
+ *
+ * @file src/AGE/Core/classes/StringPool.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cassert>
+#include <cstring>
+#include <AGE/Core/classes/StringPool.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+
+namespace AGE
+{
+  /// Initial number of slots in the hash table
+  static const Uint32 POOL_MIN_TABLE = 1024;
+
+  StringPool::StringPool() :
+    mCount(0),
+    mTable(POOL_MIN_TABLE, 0)
+  {
+    memset(mPages, 0, sizeof(mPages));
+
+    // The empty string is always interned as EMPTY_HANDLE
+    mPages[0] = new typeEntry[PAGE_SIZE];
+    mPages[0][0].hash = crc32_runtime("", 0);
+    insert(EMPTY_HANDLE);
+    mCount = 1;
+  }
+
+  StringPool::~StringPool()
+  {
+    for(Uint32 iloop = 0; iloop < MAX_PAGES; iloop++)
+    {
+      delete[] mPages[iloop];
+      mPages[iloop] = NULL;
+    }
+  }
+
+  StringPool& StringPool::getInstance(void)
+  {
+    // Created the first time it is needed (thread safe in C++11)
+    static StringPool gInstance;
+    return gInstance;
+  }
+
+  Uint32 StringPool::intern(const StringRef theString)
+  {
+    Uint32 anHash = crc32_runtime(theString.data(), theString.size());
+
+    sf::Lock anLock(mMutex);
+
+    // Linear probe for theString from the slot for its hash
+    Uint32 anMask = (Uint32)mTable.size() - 1;
+    Uint32 anSlot = (anHash * 0x9E3779B1u) & anMask;
+    while(0 != mTable[anSlot])
+    {
+      Uint32 anHandle = mTable[anSlot] - 1;
+      const typeEntry& anEntry = mPages[anHandle / PAGE_SIZE][anHandle % PAGE_SIZE];
+      if(anEntry.hash == anHash && theString == StringRef(anEntry.text))
+      {
+        return anHandle;
+      }
+      anSlot = (anSlot + 1) & anMask;
+    }
+
+    // Make sure there is room for another string
+    Uint32 anHandle = mCount;
+    Uint32 anPage = anHandle / PAGE_SIZE;
+    assert(anPage < MAX_PAGES && "StringPool::intern() too many strings");
+    if(MAX_PAGES <= anPage)
+    {
+      FLOG(StatusError) << "StringPool::intern(" << theString.str()
+        << ") too many strings!" << std::endl;
+      return EMPTY_HANDLE;
+    }
+    if(NULL == mPages[anPage])
+    {
+      mPages[anPage] = new typeEntry[PAGE_SIZE];
+    }
+
+    // Store the new string before anyone can see its handle
+    typeEntry& anEntry = mPages[anPage][anHandle % PAGE_SIZE];
+    anEntry.text.assign(theString.data(), theString.size());
+    anEntry.hash = anHash;
+    mCount++;
+
+    // Grow the table to keep it at most half full
+    if(mCount * 2 > mTable.size())
+    {
+      std::vector<Uint32>(mTable.size() * 2, 0).swap(mTable);
+      for(Uint32 iloop = 0; iloop < mCount; iloop++)
+      {
+        insert(iloop);
+      }
+    }
+    else
+    {
+      insert(anHandle);
+    }
+
+    return anHandle;
+  }
+
+  Uint32 StringPool::getCount(void) const
+  {
+    sf::Lock anLock(mMutex);
+    return mCount;
+  }
+
+  void StringPool::insert(const Uint32 theHandle)
+  {
+    Uint32 anMask = (Uint32)mTable.size() - 1;
+    Uint32 anHash = mPages[theHandle / PAGE_SIZE][theHandle % PAGE_SIZE].hash;
+    Uint32 anSlot = (anHash * 0x9E3779B1u) & anMask;
+    while(0 != mTable[anSlot])
+    {
+      anSlot = (anSlot + 1) & anMask;
+    }
+    mTable[anSlot] = theHandle + 1;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
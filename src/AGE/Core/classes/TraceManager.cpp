@@ -0,0 +1,308 @@
+/**
+ * Provides the TraceManager class in the AGE namespace which is responsible
+ * for recording timeline events (begin/end scopes) into a preallocated ring
+ * buffer that can be written out as Chrome trace-event JSON on demand.
+ *
+ * @file src/AGE/Core/classes/TraceManager.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Publish each trace event with a per slot sequence number
+ */
+
+#include <assert.h>
+#include <string.h>
+#if !defined(AGE_WINDOWS)
+#include <signal.h>
+#endif
+#include <AGE/Core/classes/TraceManager.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Single instance of the most recently created TraceManager class
+  TraceManager* TraceManager::gInstance = NULL;
+
+#if !defined(AGE_WINDOWS)
+  /// Signal handler used to request a trace dump from outside the process
+  static void traceSignalHandler(int theSignal)
+  {
+    TraceManager* anTrace = TraceManager::getInstance();
+    if(NULL != anTrace)
+    {
+      anTrace->requestDump();
+    }
+  }
+#endif
+
+  TraceManager::TraceManager() :
+    mEvents(NULL),
+    mCapacity(0),
+    mNext(0),
+    mEnabled(false),
+    mDumpRequested(false),
+    mClock()
+  {
+    ILOGM("TraceManager::ctor()");
+
+    // Make this the TraceManager used by the TRACE_SCOPE macros
+    gInstance = this;
+  }
+
+  TraceManager::~TraceManager()
+  {
+    ILOGM("TraceManager::dtor()");
+
+    // Release the ring buffer if DeInit was never called
+    deInit();
+
+    // Clear our instance pointer if it is still pointing to us
+    if(gInstance == this)
+    {
+      gInstance = NULL;
+    }
+  }
+
+  TraceManager* TraceManager::getInstance(void)
+  {
+    return gInstance;
+  }
+
+  void TraceManager::doInit(Uint32 theCapacity)
+  {
+    ILOG() << "TraceManager::doInit(" << theCapacity << ")" << std::endl;
+
+    // Release any previous ring buffer first
+    deInit();
+
+    // Round theCapacity up to a power of two so we can mask instead of divide
+    mCapacity = 1;
+    while(mCapacity < theCapacity && mCapacity < 0x80000000)
+    {
+      mCapacity <<= 1;
+    }
+
+    // Preallocate the ring buffer (zeroed so every slot starts unwritten),
+    // recording never allocates after this
+    mEvents = new(std::nothrow) typeTraceEvent[mCapacity]();
+    if(NULL == mEvents)
+    {
+      ELOG() << "TraceManager::doInit() unable to allocate " << mCapacity
+        << " trace events" << std::endl;
+      mCapacity = 0;
+      return;
+    }
+
+    // Reset our counters and time base and start recording
+    mNext = 0;
+    mClock.restart();
+    mEnabled = true;
+  }
+
+  void TraceManager::deInit(void)
+  {
+    // Stop recording before we release the ring buffer
+    mEnabled = false;
+
+    // Release the ring buffer
+    delete[] mEvents;
+    mEvents = NULL;
+    mCapacity = 0;
+    mNext = 0;
+  }
+
+  bool TraceManager::isEnabled(void) const
+  {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+
+  void TraceManager::setEnabled(bool theEnabled)
+  {
+    // Recording is only possible once the ring buffer exists
+    mEnabled = theEnabled && NULL != mEvents;
+  }
+
+  Int64 TraceManager::getTimestamp(void) const
+  {
+    return mClock.getElapsedTime().asMicroseconds();
+  }
+
+  void TraceManager::record(const char* theName, const char* theCategory,
+      Int64 theStart, Int64 theDuration, const char* theDetail)
+  {
+    // Don't record anything if recording is disabled
+    if(false == isEnabled())
+    {
+      return;
+    }
+
+    // Claim the next slot in the ring buffer, overwriting the oldest event
+    Uint64 anIndex = mNext.fetch_add(1, std::memory_order_relaxed);
+    typeTraceEvent& anEvent = mEvents[anIndex & (mCapacity - 1)];
+
+    // Mark the slot as being written before changing any of its fields
+    anEvent.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Store the completed event
+    anEvent.name = theName;
+    anEvent.category = theCategory;
+    anEvent.start = theStart;
+    anEvent.duration = theDuration;
+    anEvent.thread = getThread();
+    if(NULL != theDetail)
+    {
+      strncpy(anEvent.detail, theDetail, MAX_DETAIL - 1);
+      anEvent.detail[MAX_DETAIL - 1] = '\0';
+    }
+    else
+    {
+      anEvent.detail[0] = '\0';
+    }
+
+    // Publish the event for WriteToFile
+    anEvent.sequence.store(anIndex + 1, std::memory_order_release);
+  }
+
+  void TraceManager::requestDump(void)
+  {
+    mDumpRequested = true;
+  }
+
+  bool TraceManager::isDumpRequested(void)
+  {
+    return mDumpRequested.exchange(false);
+  }
+
+  void TraceManager::registerSignal(void)
+  {
+#if !defined(AGE_WINDOWS)
+    signal(SIGUSR1, traceSignalHandler);
+#endif
+  }
+
+  bool TraceManager::writeToFile(const std::string theFilename) const
+  {
+    // Nothing to write if we were never initialized
+    if(NULL == mEvents)
+    {
+      WLOG() << "TraceManager::writeToFile(" << theFilename
+        << ") trace buffer not initialized" << std::endl;
+      return false;
+    }
+
+    FILE* anFile = fopen(theFilename.c_str(), "w");
+    if(NULL == anFile)
+    {
+      ELOG() << "TraceManager::writeToFile(" << theFilename
+        << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    // Determine the oldest event still in the ring buffer
+    Uint64 anEnd = mNext.load();
+    Uint64 anBegin = anEnd > mCapacity ? anEnd - mCapacity : 0;
+
+    // Number of events actually written
+    Uint64 anWritten = 0;
+
+    fprintf(anFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for(Uint64 anIndex = anBegin; anIndex < anEnd; anIndex++)
+    {
+      const typeTraceEvent& anSlot = mEvents[anIndex & (mCapacity - 1)];
+
+      // Copy the event, skipping it unless it was published for anIndex
+      // before and after the copy (still being written or overwritten)
+      if(anIndex + 1 != anSlot.sequence.load(std::memory_order_acquire))
+      {
+        continue;
+      }
+      typeTraceEvent anEvent;
+      anEvent.name = anSlot.name;
+      anEvent.category = anSlot.category;
+      anEvent.start = anSlot.start;
+      anEvent.duration = anSlot.duration;
+      anEvent.thread = anSlot.thread;
+      memcpy(anEvent.detail, anSlot.detail, MAX_DETAIL);
+      anEvent.detail[MAX_DETAIL - 1] = '\0';
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(anIndex + 1 != anSlot.sequence.load(std::memory_order_relaxed))
+      {
+        continue;
+      }
+
+      // Write each event as a complete ("X") event
+      fprintf(anFile, "%s{\"name\":", 0 == anWritten ? "" : ",\n");
+      anWritten++;
+      writeString(anFile, anEvent.name);
+      fprintf(anFile, ",\"cat\":");
+      writeString(anFile, anEvent.category);
+      fprintf(anFile, ",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u",
+          (long long)anEvent.start, (long long)anEvent.duration, anEvent.thread);
+      if('\0' != anEvent.detail[0])
+      {
+        fprintf(anFile, ",\"args\":{\"detail\":");
+        writeString(anFile, anEvent.detail);
+        fprintf(anFile, "}");
+      }
+      fprintf(anFile, "}");
+    }
+    fprintf(anFile, "\n]}\n");
+    fclose(anFile);
+
+    ILOG() << "TraceManager::writeToFile(" << theFilename << ") wrote "
+      << anWritten << " trace events" << std::endl;
+
+    // Return true, the trace was written
+    return true;
+  }
+
+  Uint32 TraceManager::getThread(void)
+  {
+    static std::atomic<Uint32> gNextThread(0);
+    static thread_local Uint32 gThread = gNextThread.fetch_add(1);
+    return gThread;
+  }
+
+  void TraceManager::writeString(FILE* theFile, const char* theString)
+  {
+    fputc('"', theFile);
+    for(const char* anChar = theString; NULL != anChar && '\0' != *anChar; anChar++)
+    {
+      if('"' == *anChar || '\\' == *anChar)
+      {
+        fputc('\\', theFile);
+        fputc(*anChar, theFile);
+      }
+      else if((unsigned char)*anChar < 0x20)
+      {
+        fprintf(theFile, "\\u%04x", (unsigned int)(unsigned char)*anChar);
+      }
+      else
+      {
+        fputc(*anChar, theFile);
+      }
+    }
+    fputc('"', theFile);
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -28,9 +28,34 @@
  * @date 20120622 - Remove setting of show value of StatManager to false
  * @date 20120630 - Add new SetGraphicRange and CalculateGraphicRange methods
  * @date 20120702 - Call new IState::Cleanup method during game loop
+ * @date 20261018 - Record game loop phases with the new TraceManager
+ * @date 20261018 - Record frame, update and render times with the StatManager
+ * @date 20261018 - Add headless run modes and create the window only when needed
+ * @date 20261018 - Add InputRecorder for deterministic input record and replay
+ * @date 20261018 - Use ID() keys for settings lookups
+ * @date 20261018 - Process deferred asset releases once each frame
+ * @date 20261018 - Add JobManager and switch states once their assets are loaded
+ * @date 20261018 - Report the memory saved by sharing identical assets
+ * @date 20261018 - Add SoundManager and free finished voices once each frame
+ * @date 20261018 - Add AssetDownloader for loading assets from the network
+ * @date 20261018 - Save each tick and re-simulate rollbacks with the RollbackManager
+ * @date 20261018 - Add FrameArena and reset it at the end of each frame
+ * @date 20261018 - Toggle the memory overlay with F11 and report memory at cleanup
+ * @date 20261018 - Add GetWindow and never quit on wrapped ticks when MaxTicks is 0
+ * @date 20261018 - Only record the frame timeline when enabled in the settings
+ * @date 20261018 - Only export the time statistics when set in the settings
+ * @date 20261018 - Write the MemoryTracker report after every member is destroyed
+ * @date 20261018 - Only initialize the AssetDownloader when a base URL is set
+ * @date 20261018 - Keep the game loop running while the first state is loading
+ * @date 20261018 - Use fixed steps at the update rate while rollback is active
+ * @date 20261018 - Only dump the trace on F12 while tracing and pass F12 on
+ * @date 20261018 - Pass F11 on to the active state after toggling memory stats
  */
 
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
 #include <AGE/Core/assets/ConfigAsset.hpp>
 #include <AGE/Core/assets/ConfigHandler.hpp>
 #include <AGE/Core/assets/FontHandler.hpp>
@@ -38,9 +63,12 @@
 #include <AGE/Core/assets/MusicHandler.hpp>
 #include <AGE/Core/assets/SoundHandler.hpp>
 #include <AGE/Core/classes/ConfigReader.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
 #include <AGE/Core/interfaces/Game.hpp>
 #include <AGE/Core/interfaces/IState.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+#include <AGE/Core/utils/StringUtil.hpp>
 
 namespace AGE {
    /// Default application wide settings file string
@@ -52,12 +80,19 @@ namespace AGE {
    Game::Game(const std::string theTitle) :
    mTitle(theTitle),
    mVideoMode(DEFAULT_VIDEO_WIDTH, DEFAULT_VIDEO_HEIGHT, DEFAULT_VIDEO_BPP),
-   mWindow(),
    mContextSettings(),
    mWindowStyle(sf::Style::Close | sf::Style::Resize),
    mGraphicRange(LowRange),
+   mExitCode(StatusAppOK),
+   mRunning(false),
    mUpdateRate((Uint32) (1000.0f / 20.0f)), // 20 updates per second
-   mMaxUpdates(5)
+   mMaxUpdates(5),
+   mRunMode(RunWindowed),
+   mWindow(NULL),
+   mTicks(0),
+   mMaxTicks(0),
+   mRecordFilename(),
+   mReplayFilename()
    {
       gApp = this;
    }
@@ -66,11 +101,22 @@ namespace AGE {
    {
       mRunning = false;
 
+      // Delete our Render window if one was created
+      delete mWindow;
+      mWindow = NULL;
+
       if (gApp == this) {
          gApp = NULL;
       }
    }
 
+   Game::MemoryReport::~MemoryReport()
+   {
+      // Report the memory each subsystem still has allocated, except the
+      // logger which normally outlives the Game
+      MemoryTracker::getInstance().writeReport(MemoryTracker::MemoryLoggers);
+   }
+
    Game* Game::getApp(void)
    {
       return gApp;
@@ -79,13 +125,29 @@ namespace AGE {
    void Game::processArguments(int argc, char* argv[])
    {
       // Handle command line arguments
-      // TODO: Add handling of command line arguments
       if (argc == 1) {
          ILOG() << "Game::processArguments(" << argv[0] << ") command line: (none)" << std::endl;
       } else {
          ILOG() << "Game::processArguments(" << argv[0] << ") command line:" << std::endl;
          for (int iloop = 1; iloop < argc; iloop++) {
             ILOG() << "Argument" << iloop << "=(" << argv[iloop] << ")" << std::endl;
+
+            // Run without a window at the fixed update rate
+            if (0 == strcmp(argv[iloop], "--headless")) {
+               setRunMode(RunHeadless);
+            }// Run without a window as fast as possible
+            else if (0 == strcmp(argv[iloop], "--batch")) {
+               setRunMode(RunHeadlessBatch);
+            }// Quit after the number of updates specified
+            else if (0 == strcmp(argv[iloop], "--ticks") && iloop + 1 < argc) {
+               setMaxTicks(parseUint32(argv[++iloop], 0));
+            }// Record input events into the file specified
+            else if (0 == strcmp(argv[iloop], "--record") && iloop + 1 < argc) {
+               mRecordFilename = argv[++iloop];
+            }// Replay input events from the file specified
+            else if (0 == strcmp(argv[iloop], "--replay") && iloop + 1 < argc) {
+               mReplayFilename = argv[++iloop];
+            }
          }
       }
    }
@@ -104,11 +166,11 @@ namespace AGE {
       mStateManager.registerApp(this);
 
       // First register the IAssetHandler derived classes in the AGE Core library
-      mAssetManager.registerHandler(new(std::nothrow) ConfigHandler());
-      mAssetManager.registerHandler(new(std::nothrow) FontHandler());
-      mAssetManager.registerHandler(new(std::nothrow) ImageHandler());
-      mAssetManager.registerHandler(new(std::nothrow) MusicHandler());
-      mAssetManager.registerHandler(new(std::nothrow) SoundHandler());
+      mAssetManager.registerHandler(new(std::nothrow) ConfigHandler(), "config");
+      mAssetManager.registerHandler(new(std::nothrow) FontHandler(), "font");
+      mAssetManager.registerHandler(new(std::nothrow) ImageHandler(), "image");
+      mAssetManager.registerHandler(new(std::nothrow) MusicHandler(), "music");
+      mAssetManager.registerHandler(new(std::nothrow) SoundHandler(), "sound");
 
       // Give derived class a time to register custom IAssetHandler classes
       initAssetHandlers();
@@ -117,16 +179,34 @@ namespace AGE {
       // registered under the ID of "resources/settings.cfg"
       initSettingsConfig();
 
+      // Start the worker threads used to load state assets in the background
+      initJobManager();
+
+      // Allocate the voices used to play sound effects
+      initSoundManager();
+
+      // Set where AssetLoadFromNetwork assets are downloaded from
+      initAssetDownloader();
+
+      // Allocate the buffers used for allocations that only live for a frame
+      initFrameArena();
+
       // Try to open the Renderer window to display graphics
       initRenderer();
 
+      // Start recording the frame timeline if enabled
+      initTraceManager();
+
       // Give the derived application a chance to register a IScreenFactory class
       // to provide IScreen derived classes (previously known as IState derived
       // classes) as requested.
       initScreenFactory();
 
       // Give the StatManager a chance to initialize
-      mStatManager.doInit();
+      initStatManager();
+
+      // Start recording or replaying input events if requested
+      initInputRecorder();
 
       // GameLoop if Running flag is still true
       gameLoop();
@@ -149,6 +229,41 @@ namespace AGE {
       return mExitCode;
    }
 
+   RunMode Game::getRunMode(void) const
+   {
+      return mRunMode;
+   }
+
+   void Game::setRunMode(RunMode theRunMode)
+   {
+      // The run mode can't be changed once the window has been created
+      if (NULL == mWindow) {
+         mRunMode = theRunMode;
+      } else {
+         WLOG() << "Game::setRunMode(" << theRunMode << ") ignored, window already created" << std::endl;
+      }
+   }
+
+   bool Game::isHeadless(void) const
+   {
+      return RunHeadless == mRunMode || RunHeadlessBatch == mRunMode;
+   }
+
+   sf::RenderWindow* Game::getWindow(void) const
+   {
+      return mWindow;
+   }
+
+   Uint32 Game::getTicks(void) const
+   {
+      return mTicks;
+   }
+
+   void Game::setMaxTicks(Uint32 theMaxTicks)
+   {
+      mMaxTicks = theMaxTicks;
+   }
+
    bool Game::isRunning(void) const
    {
       // Return true if game loop is still running
@@ -206,24 +321,74 @@ namespace AGE {
       ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
    }
 
+   void Game::initJobManager(void)
+   {
+      SLOG(App_InitJobManager, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      // How many worker threads should be started? (0 = automatic)
+      mJobManager.doInit(anSettingsConfig.getAsset().getUint32(ID("jobs"),
+              ID("threads"), 0));
+   }
+
+   void Game::initSoundManager(void)
+   {
+      SLOG(App_InitSoundManager, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      // Headless modes (or the settings file) may ask for the null device
+      mSoundManager.doInit(anSettingsConfig.getAsset().getUint32(ID("sound"),
+              ID("voices"), SoundManager::DEFAULT_VOICES), isHeadless() ||
+              anSettingsConfig.getAsset().getBool(ID("sound"), ID("null"), false));
+   }
+
+   void Game::initAssetDownloader(void)
+   {
+      SLOG(App_InitAssetDownloader, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      // Nothing is downloaded (or cached) unless a base URL is set
+      std::string anURL =
+         anSettingsConfig.getAsset().getString(ID("network"), ID("url"), "");
+      if (anURL.empty()) {
+         return;
+      }
+
+      mAssetDownloader.doInit(anURL,
+              anSettingsConfig.getAsset().getString(ID("network"), ID("cache"), "cache/"),
+              anSettingsConfig.getAsset().getUint32(ID("network"), ID("chunk"),
+                  AssetDownloader::DEFAULT_CHUNK_SIZE),
+              anSettingsConfig.getAsset().getUint32(ID("network"), ID("timeout"),
+                  AssetDownloader::DEFAULT_TIMEOUT));
+   }
+
+   void Game::initFrameArena(void)
+   {
+      SLOG(App_InitFrameArena, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      mFrameArena.doInit(anSettingsConfig.getAsset().getUint32(ID("arena"),
+              ID("size"), FrameArena::DEFAULT_SIZE));
+   }
+
    void Game::initRenderer(void)
    {
       SLOG(App_InitRenderer, SeverityInfo) << std::endl;
       ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
 
       // Are we in Fullscreen mode?
-      if (anSettingsConfig.getAsset().getBool("window", "fullscreen", false)) {
+      if (anSettingsConfig.getAsset().getBool(ID("window"), ID("fullscreen"), false)) {
          mWindowStyle = sf::Style::Fullscreen;
       }
 
 
       // What size window does the user want?
       mVideoMode.width =
-              anSettingsConfig.getAsset().getUint32("window", "width", DEFAULT_VIDEO_WIDTH);
+              anSettingsConfig.getAsset().getUint32(ID("window"), ID("width"), DEFAULT_VIDEO_WIDTH);
       mVideoMode.height =
-              anSettingsConfig.getAsset().getUint32("window", "height", DEFAULT_VIDEO_HEIGHT);
+              anSettingsConfig.getAsset().getUint32(ID("window"), ID("height"), DEFAULT_VIDEO_HEIGHT);
       mVideoMode.bitsPerPixel =
-              anSettingsConfig.getAsset().getUint32("window", "depth", DEFAULT_VIDEO_BPP);
+              anSettingsConfig.getAsset().getUint32(ID("window"), ID("depth"), DEFAULT_VIDEO_BPP);
 
       // For Fullscreen, verify valid VideoMode, otherwise revert to defaults for Fullscreen
       if (sf::Style::Fullscreen == mWindowStyle && false == mVideoMode.isValid()) {
@@ -235,12 +400,76 @@ namespace AGE {
       // Calculate and set GraphicRange value
       setGraphicRange(calculateRange(mVideoMode.height));
 
+      // Headless modes never create a window (or an OpenGL context)
+      if (isHeadless()) {
+         ILOG() << "Game::initRenderer() headless mode, no window created" << std::endl;
+         return;
+      }
+
       // Create a RenderWindow object using VideoMode object above
-      mWindow.create(mVideoMode, mTitle, mWindowStyle, mContextSettings);
+      mWindow = new(std::nothrow) sf::RenderWindow();
+      assert(NULL != mWindow && "Game::initRenderer() unable to allocate window");
+      mWindow->create(mVideoMode, mTitle, mWindowStyle, mContextSettings);
 
       // Use Vertical Sync
-      mWindow.setVerticalSyncEnabled(true);
+      mWindow->setVerticalSyncEnabled(true);
+
+   }
+
+   void Game::initTraceManager(void)
+   {
+      SLOG(App_InitTraceManager, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      // Is timeline recording enabled? (disabled by default)
+      if (anSettingsConfig.getAsset().getBool(ID("trace"), ID("enabled"), false)) {
+         // Preallocate the ring buffer using the capacity requested
+         mTraceManager.doInit(anSettingsConfig.getAsset().getUint32(ID("trace"),
+                 ID("capacity"), TraceManager::DEFAULT_CAPACITY));
+
+         // Allow a trace dump to be requested using SIGUSR1
+         mTraceManager.registerSignal();
+      }
+   }
+
+   void Game::initStatManager(void)
+   {
+      SLOG(App_InitStatManager, SeverityInfo) << std::endl;
+      ConfigAsset anSettingsConfig(Game::APP_SETTINGS);
+
+      // Give the StatManager a chance to initialize
+      mStatManager.doInit();
+
+      // Where should the time statistics be exported to at exit? (not exported by default)
+      mStatManager.setExportFilename(anSettingsConfig.getAsset().getString(ID("stats"),
+              ID("export"), ""));
+   }
+
+   void Game::initInputRecorder(void)
+   {
+      SLOG(App_InitInputRecorder, SeverityInfo) << std::endl;
+
+      if (!mReplayFilename.empty()) {
+         // Replay using the update rate the events were recorded with
+         if (mInputRecorder.startReplay(mReplayFilename)) {
+            mUpdateRate = (sf::Int32) mInputRecorder.getUpdateRate();
+         } else {
+            quit(StatusAppInitFailed);
+         }
+      } else if (!mRecordFilename.empty()) {
+         mInputRecorder.startRecording(mRecordFilename, (Uint32) mUpdateRate);
+      }
+   }
 
+   void Game::writeTrace(void)
+   {
+      // Use the current time to create a unique trace filename
+      char anFilename[64];
+      snprintf(anFilename, sizeof(anFilename), "trace-%lld.json",
+              (long long) time(NULL));
+
+      // Write the ring buffer to anFilename
+      mTraceManager.writeToFile(anFilename);
    }
 
    void Game::gameLoop(void)
@@ -248,71 +477,335 @@ namespace AGE {
       SLOG(App_GameLoop, SeverityInfo) << std::endl;
 
       sf::Clock frameClock;
+      sf::Clock anFrameTimer;
+      sf::Clock anPhaseTimer;
+      sf::Clock anStepClock;
+
+      // Real time in microseconds not yet simulated by fixed steps while
+      // rollback is active
+      sf::Int64 anStepTime = 0;
 
-      if (mStateManager.isEmpty()) {
+      if (mStateManager.isEmpty() && NULL == mStateManager.getPendingState()) {
          quit(StatusAppInitFailed);
       }
 
-      while (isRunning() && mWindow.isOpen() && !mStateManager.isEmpty()) {
+      // Use the headless game loop if we don't have a window
+      if (NULL == mWindow) {
+         headlessLoop();
+         return;
+      }
+
+      while (isRunning() && mWindow->isOpen() &&
+              (!mStateManager.isEmpty() || NULL != mStateManager.getPendingState())) {
+         TRACE_SCOPE("Game::frame");
+
+         // Keep loading the first state until it can be added
+         if (mStateManager.isEmpty()) {
+            waitForPendingState();
+            continue;
+         }
 
          IState& anState = mStateManager.getActiveState();
 
+         anFrameTimer.restart();
          frameClock.restart();
-         while (frameClock.getElapsedTime().asMilliseconds() < mUpdateRate) {
 
+         // Rolled back ticks are simulated again with a fixed step, so make
+         // one update for each mUpdateRate of real time that has elapsed
+         bool anFixedStep = mRollbackManager.isActive() && !mInputRecorder.isActive();
+         sf::Int64 anStep = (sf::Int64) mUpdateRate * 1000;
+         sf::Int64 anElapsed = anStepClock.restart().asMicroseconds();
+         anStepTime = anFixedStep ? anStepTime + anElapsed : 0;
+         Uint32 anUpdates = 0;
+
+         while (anFixedStep ?
+                 (anStepTime >= anStep && anUpdates < mMaxUpdates) :
+                 (frameClock.getElapsedTime().asMilliseconds() < mUpdateRate)) {
+            {
+               TRACE_SCOPE("Game::processInput");
+               processInput(anState);
+            }
+            if (mRollbackManager.isActive()) {
+               TRACE_SCOPE("RollbackManager::update");
+               mRollbackManager.update(anState, mTicks, (float) mUpdateRate);
+            }
+            {
+               TRACE_SCOPE("IState::updateVariable");
+               anPhaseTimer.restart();
+               // Use a fixed elapsed time while recording or replaying input
+               // or when ticks may be rolled back and simulated again
+               anState.updateVariable(
+                       (mInputRecorder.isActive() || mRollbackManager.isActive()) ?
+                       (float) mUpdateRate : frameClock.getElapsedTime().asMilliseconds());
+               mStatManager.recordTime(StatManager::StatUpdateTime,
+                       anPhaseTimer.getElapsedTime().asMicroseconds());
+            }
+
+            // Quit if we have reached the maximum number of updates requested
+            if (++mTicks == mMaxTicks && 0 != mMaxTicks) {
+               quit(StatusAppOK);
+               break;
+            }
+
+            // Make exactly one update per frame while recording or replaying
+            // input so every frame of a replay matches the recording
+            if (mInputRecorder.isActive()) {
+               break;
+            }
+
+            // Consume the real time this fixed step simulated
+            if (anFixedStep) {
+               anStepTime -= anStep;
+               anUpdates++;
+            }
+         }
+
+         // Drop the time we couldn't catch up on rather than falling behind
+         if (anFixedStep && anStepTime >= anStep) {
+            anStepTime %= anStep;
+         }
+
+         anPhaseTimer.restart();
+         {
+            TRACE_SCOPE("IState::draw");
+            anState.draw();
+            mStatManager.draw();
+         }
+         {
+            TRACE_SCOPE("Game::display");
+            mWindow->display();
+         }
+         mStatManager.recordTime(StatManager::StatRenderTime,
+                 anPhaseTimer.getElapsedTime().asMicroseconds());
+         {
+            TRACE_SCOPE("SoundManager::update");
+            mSoundManager.update((float) anFrameTimer.getElapsedTime().asMilliseconds());
+         }
+         {
+            TRACE_SCOPE("StateManager::cleanup");
+            mStateManager.cleanup();
+            mStateManager.updatePending();
+            mAssetManager.processReleases();
+         }
+
+         // Record the time spent in this entire game loop iteration
+         mStatManager.recordTime(StatManager::StatFrameTime,
+                 anFrameTimer.getElapsedTime().asMicroseconds());
+
+         // Write the trace timeline if requested by a key press or signal
+         if (mTraceManager.isDumpRequested()) {
+            writeTrace();
+         }
+
+         // Discard what was allocated from the frame arena last frame
+         mFrameArena.nextFrame();
+      }
+   }
+
+   void Game::headlessLoop(void)
+   {
+      SLOG(App_HeadlessLoop, SeverityInfo) << std::endl;
+
+      sf::Clock anFrameTimer;
+      sf::Clock anPhaseTimer;
+
+      // Each update uses the fixed update rate as its elapsed time so the
+      // simulation is deterministic regardless of how fast we are running
+      while (isRunning() &&
+              (!mStateManager.isEmpty() || NULL != mStateManager.getPendingState())) {
+         TRACE_SCOPE("Game::frame");
+
+         // Keep loading the first state until it can be added
+         if (mStateManager.isEmpty()) {
+            waitForPendingState();
+            continue;
+         }
+
+         IState& anState = mStateManager.getActiveState();
+
+         anFrameTimer.restart();
+         {
+            TRACE_SCOPE("Game::processInput");
             processInput(anState);
-            anState.updateVariable(frameClock.getElapsedTime().asMilliseconds());
+         }
+         if (mRollbackManager.isActive()) {
+            TRACE_SCOPE("RollbackManager::update");
+            mRollbackManager.update(anState, mTicks, (float) mUpdateRate);
+         }
+         {
+            TRACE_SCOPE("IState::updateVariable");
+            anPhaseTimer.restart();
+            anState.updateVariable((float) mUpdateRate);
+            mStatManager.recordTime(StatManager::StatUpdateTime,
+                    anPhaseTimer.getElapsedTime().asMicroseconds());
+         }
+         {
+            TRACE_SCOPE("SoundManager::update");
+            mSoundManager.update((float) mUpdateRate);
+         }
+         {
+            TRACE_SCOPE("StateManager::cleanup");
+            mStateManager.cleanup();
+            mStateManager.updatePending();
+            mAssetManager.processReleases();
+         }
+
+         // Quit if we have reached the maximum number of updates requested
+         if (++mTicks == mMaxTicks && 0 != mMaxTicks) {
+            quit(StatusAppOK);
+         }
+
+         // Write the trace timeline if requested by a signal
+         if (mTraceManager.isDumpRequested()) {
+            writeTrace();
          }
 
-         anState.draw();
-         mStatManager.draw();
-         mWindow.display();
+         // Discard what was allocated from the frame arena last frame
+         mFrameArena.nextFrame();
 
-         mStateManager.cleanup();
+         // Record the time spent in this entire game loop iteration
+         mStatManager.recordTime(StatManager::StatFrameTime,
+                 anFrameTimer.getElapsedTime().asMicroseconds());
+
+         // Wait for the next update unless we are running as fast as possible
+         if (RunHeadless == mRunMode &&
+                 anFrameTimer.getElapsedTime().asMilliseconds() < mUpdateRate) {
+            sf::sleep(sf::milliseconds(mUpdateRate) - anFrameTimer.getElapsedTime());
+         }
       }
    }
 
-   void Game::processInput(IState& theState)
+   void Game::waitForPendingState(void)
    {
       sf::Event anEvent;
 
+      // Keep the window responsive but only allow it to be closed
+      while (NULL != mWindow && mWindow->pollEvent(anEvent)) {
+         if (sf::Event::Closed == anEvent.type) {
+            quit(StatusAppOK);
+         }
+      }
 
-      while (mWindow.pollEvent(anEvent)) {
+      // Load the next group of assets and add the state once they are loaded
+      mStateManager.updatePending();
+      mAssetManager.processReleases();
 
-         switch (anEvent.type) {
-         case sf::Event::Closed: // Window closed
+      // Show an empty window until there is a state to draw
+      if (NULL != mWindow) {
+         mWindow->clear();
+         mWindow->display();
+      }
+   }
+
+   void Game::processInput(IState& theState)
+   {
+      sf::Event anEvent;
+
+      // Replay the events recorded for this update instead of the window events
+      if (mInputRecorder.isReplaying()) {
+         while (mInputRecorder.replayEvent(mTicks, anEvent)) {
+            dispatchEvent(theState, anEvent);
+         }
+
+         // Quit once we reach the update the recording was stopped on
+         if (mInputRecorder.isFinished(mTicks)) {
             quit(StatusAppOK);
-            break;
-         case sf::Event::GainedFocus: // Window gained focus
-            theState.resume();
-            break;
-         case sf::Event::LostFocus: // Window lost focus
-            theState.pause();
-            break;
-         case sf::Event::Resized: // Window resized
-            break;
-         default: // Current active state will handle
-            theState.handleEvents(anEvent);
-         } // switch(anEvent.Type)
-      } // while(mWindow.getEvent(anEvent))
+         }
+
+         // Keep the window responsive but only allow it to be closed
+         while (NULL != mWindow && mWindow->pollEvent(anEvent)) {
+            if (sf::Event::Closed == anEvent.type) {
+               quit(StatusAppOK);
+            }
+         }
+         return;
+      }
+
+      // No input to process without a window
+      if (NULL == mWindow) {
+         return;
+      }
+
+      while (mWindow->pollEvent(anEvent)) {
+         // Record each event with the update it was received on
+         mInputRecorder.recordEvent(mTicks, anEvent);
+
+         dispatchEvent(theState, anEvent);
+      } // while(mWindow->pollEvent(anEvent))
+   }
+
+   void Game::dispatchEvent(IState& theState, sf::Event& theEvent)
+   {
+      switch (theEvent.type) {
+      case sf::Event::Closed: // Window closed
+         quit(StatusAppOK);
+         break;
+      case sf::Event::GainedFocus: // Window gained focus
+         theState.resume();
+         break;
+      case sf::Event::LostFocus: // Window lost focus
+         theState.pause();
+         break;
+      case sf::Event::Resized: // Window resized
+         break;
+      case sf::Event::KeyReleased: // F12 writes the trace timeline, F11 shows memory
+         if (sf::Keyboard::F12 == theEvent.key.code && mTraceManager.isEnabled()) {
+            mTraceManager.requestDump();
+         } else if (sf::Keyboard::F11 == theEvent.key.code) {
+            mStatManager.setShowMemory(!mStatManager.isShowingMemory());
+         }
+         // Current active state still sees every key released
+         theState.handleEvents(theEvent);
+         break;
+      default: // Current active state will handle
+         theState.handleEvents(theEvent);
+      } // switch(theEvent.type)
    }
 
    void Game::cleanup(void)
    {
       SLOG(App_Cleanup, SeverityInfo) << std::endl;
 
+      // Report the memory saved by sharing assets loaded from identical files
+      ILOG() << "Game::cleanup() identical assets shared saved "
+              << mAssetManager.getSavedBytes() << " bytes" << std::endl;
+
       // Give the StatManager a chance to de-initialize
       mStatManager.deInit();
 
+      // Stop the worker threads before the asset handlers they use are deleted
+      mJobManager.deInit();
+
+      // Stop every voice and drop the sound buffers they are playing
+      mSoundManager.deInit();
+
+      // Drop the connections kept for downloading assets
+      mAssetDownloader.deInit();
+
+      // Stop recording the frame timeline and release the ring buffer
+      mTraceManager.deInit();
+
+      // Finish recording or replaying input events
+      mInputRecorder.stop(mTicks);
+
+      // Forget the state saved each tick
+      mRollbackManager.clear();
+
+      // Report how much of the frame arena was needed and free it
+      ILOG() << "Game::cleanup() frame arena peak " << mFrameArena.getPeak()
+              << " of " << mFrameArena.getCapacity() << " bytes ("
+              << mFrameArena.getOverflowCount() << " overflows)" << std::endl;
+      mFrameArena.deInit();
+
       // Close the Render window if it is still open
 
-      if (mWindow.isOpen()) {
+      if (NULL != mWindow && mWindow->isOpen()) {
 
          // Show the Mouse cursor
-         mWindow.setMouseCursorVisible(true);
+         mWindow->setMouseCursorVisible(true);
 
          // Close the Render window
-         mWindow.close();
+         mWindow->close();
 
       }
    }
@@ -5,16 +5,22 @@
  * @file src/AGE/Core/interfaces/IAssetHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Added type slots for constant time handler lookup
+ * @date 20261018 - Added DownloadAsset for loading assets from the network
  */
 
 #include <assert.h>
 #include <AGE/Core/interfaces/IAssetHandler.hpp>
+#include <SFML/System.hpp>
+#include <AGE/Core/interfaces/Game.hpp>
 #include <AGE/Core/loggers/Log_macros.hpp>
 
 namespace AGE
 {
-  IAssetHandler::IAssetHandler(const Id theAssetHandlerID) :
-    mAssetHandlerID(theAssetHandlerID)
+  IAssetHandler::IAssetHandler(const Id theAssetHandlerID,
+    const Uint32 theTypeSlot) :
+    mAssetHandlerID(theAssetHandlerID),
+    mTypeSlot(theTypeSlot)
   {
     ILOG() << "IAssetHandler::ctor(" << mAssetHandlerID << ")" << std::endl;
   }
@@ -28,6 +34,47 @@ namespace AGE
   {
     return mAssetHandlerID;
   }
+
+  Uint32 IAssetHandler::getTypeSlot(void) const
+  {
+    return mTypeSlot;
+  }
+
+  bool IAssetHandler::downloadAsset(const assetID theAssetID, std::string& theFilename) const
+  {
+    // Start with a return result of false
+    bool anResult = false;
+
+    // Retrieve the filename (relative to the network URL) for this asset
+    const std::string& anFilename = getFilename(theAssetID);
+
+    // The AssetDownloader is provided by the Game class
+    Game* anApp = Game::getApp();
+
+    if(anFilename.length() > 0 && NULL != anApp)
+    {
+      anResult = anApp->mAssetDownloader.download(anFilename, theFilename);
+    }
+    else
+    {
+      ELOG() << "IAssetHandler::downloadAsset(" << theAssetID
+        << ") No filename or application provided!" << std::endl;
+    }
+
+    // Return anResult of true if successful, false otherwise
+    return anResult;
+  }
+
+  Uint32 IAssetHandler::allocateTypeSlot(void)
+  {
+    // Slots for different types may be allocated from different threads
+    static sf::Mutex gMutex;
+    static Uint32 gNextSlot = 0;
+
+    sf::Lock anLock(gMutex);
+    assert(NO_TYPE_SLOT != gNextSlot && "IAssetHandler::allocateTypeSlot() out of slots");
+    return gNextSlot++;
+  }
 } // namespace AGE
 
 /**
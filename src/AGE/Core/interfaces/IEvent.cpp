@@ -4,11 +4,27 @@
  * @file src/AGE/Core/interfaces/IEvent.cpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Allocate derived classes from size class ObjectPools
+ * @date 20261018 - Record the blocks allocated with the MemoryTracker
+ * @date 20261018 - Share the size class pool code with IProperty
  */
 #include <AGE/Core/interfaces/IEvent.hpp>
+#include <AGE/Core/classes/SizeClassPool.hpp>
 
 namespace AGE
 {
+  /**
+   * GetEventPool will return the SizeClassPool for IEvent derived classes. It
+   * is never deleted so events can be deleted at any time, even during
+   * static destruction.
+   * @return the pool to use
+   */
+  static SizeClassPool& getEventPool(void)
+  {
+    static SizeClassPool* gPool = new SizeClassPool("IEvent", MemoryTracker::MemoryEvents);
+    return *gPool;
+  }
+
   IEvent::IEvent(std::string theType, const Id theEventID) :
     mType(theType),
     mEventID(theEventID)
@@ -19,6 +35,32 @@ namespace AGE
   {
   }
 
+  void* IEvent::operator new(std::size_t theSize)
+  {
+    void* anResult = IEvent::operator new(theSize, std::nothrow);
+    if(NULL == anResult)
+    {
+      throw std::bad_alloc();
+    }
+    return anResult;
+  }
+
+  void* IEvent::operator new(std::size_t theSize, const std::nothrow_t&) throw()
+  {
+    return getEventPool().allocate(theSize);
+  }
+
+  void IEvent::operator delete(void* theEvent, std::size_t theSize)
+  {
+    getEventPool().release(theEvent, theSize);
+  }
+
+  void IEvent::operator delete(void* theEvent, const std::nothrow_t&) throw()
+  {
+    // The size isn't known here, so the pool looks for the block
+    getEventPool().release(theEvent);
+  }
+
   IEvent::Type_t* IEvent::getType(void)
   {
     return &mType;
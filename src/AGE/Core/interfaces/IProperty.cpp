@@ -4,11 +4,27 @@
  * @file src/AGE/Core/interfaces/IProperty.cpp
  * @author Jacob Dix
  * @date 20120423 - Initial Release
+ * @date 20261018 - Allocate derived classes from size class ObjectPools
+ * @date 20261018 - Record the blocks allocated with the MemoryTracker
+ * @date 20261018 - Share the size class pool code with IEvent
  */
 #include <AGE/Core/interfaces/IProperty.hpp>
+#include <AGE/Core/classes/SizeClassPool.hpp>
 
 namespace AGE
 {
+  /**
+   * GetPropertyPool will return the SizeClassPool for IProperty derived
+   * classes. It is never deleted so properties can be deleted at any time,
+   * even during static destruction.
+   * @return the pool to use
+   */
+  static SizeClassPool& getPropertyPool(void)
+  {
+    static SizeClassPool* gPool = new SizeClassPool("IProperty", MemoryTracker::MemoryProperties);
+    return *gPool;
+  }
+
   IProperty::IProperty(std::string theType, const Id thePropertyID) :
     mType(theType),
     mPropertyID(thePropertyID)
@@ -19,6 +35,32 @@ namespace AGE
   {
   }
 
+  void* IProperty::operator new(std::size_t theSize)
+  {
+    void* anResult = IProperty::operator new(theSize, std::nothrow);
+    if(NULL == anResult)
+    {
+      throw std::bad_alloc();
+    }
+    return anResult;
+  }
+
+  void* IProperty::operator new(std::size_t theSize, const std::nothrow_t&) throw()
+  {
+    return getPropertyPool().allocate(theSize);
+  }
+
+  void IProperty::operator delete(void* theProperty, std::size_t theSize)
+  {
+    getPropertyPool().release(theProperty, theSize);
+  }
+
+  void IProperty::operator delete(void* theProperty, const std::nothrow_t&) throw()
+  {
+    // The size isn't known here, so the pool looks for the block
+    getPropertyPool().release(theProperty);
+  }
+
   IProperty::Type_t* IProperty::getType(void)
   {
     return &mType;
@@ -9,6 +9,7 @@
  * @date 20120322 - Support new SFML2 snapshot changes
  * @date 20120512 - Renamed App to Game since it really is just an interface
  * @date 20120702 - Switched names of Cleanup and HandleCleanup and added cleanup events
+ * @date 20261018 - Added AssetManifest for loading state assets in the background
  */
 
 #include <assert.h>
@@ -25,7 +26,8 @@ namespace AGE
     mPaused(false),
     mCleanup(false),
     mElapsedTime(0.0f),
-    mPausedTime(0.0f)
+    mPausedTime(0.0f),
+    mManifest(theApp.mAssetManager, theApp.mJobManager)
   {
     ILOG() << "IState::ctor(" << mStateID << ")" << std::endl;
   }
@@ -163,6 +165,16 @@ namespace AGE
       mCleanup = false;
     }
   }
+
+  AssetManifest& IState::getManifest(void)
+  {
+    return mManifest;
+  }
+
+  float IState::getLoadProgress(void) const
+  {
+    return mManifest.getProgress();
+  }
 } // namespace AGE
 
 /**
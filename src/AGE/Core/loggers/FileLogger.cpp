@@ -6,9 +6,12 @@
  * @author Ryan Lindeman
  * @date 20110524 - Initial Release
  * @date 20120504 - Fix segfault caused by SLOG taking over gInstance
+ * @date 20261018 - Record the memory buffered with the MemoryTracker
  */
 
+#include <cstdio>
 #include <AGE/Core/loggers/FileLogger.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
 
 namespace AGE
 {
@@ -18,6 +21,8 @@ namespace AGE
     mFileStream.open(theFilename);
     if(mFileStream.is_open())
     {
+      // The file buffer allocated by the stream is about BUFSIZ bytes
+      MemoryTracker::getInstance().allocate(MemoryTracker::MemoryLoggers, BUFSIZ);
       logMessage(SeverityInfo, __FILE__, __LINE__, "FileLogger::ctor()");
     }
   }
@@ -28,6 +33,7 @@ namespace AGE
     {
       logMessage(SeverityInfo, __FILE__, __LINE__, "FileLogger::dtor()");
       mFileStream.close();
+      MemoryTracker::getInstance().release(MemoryTracker::MemoryLoggers, BUFSIZ);
     }
   }
 
@@ -6,25 +6,31 @@
  * @author Ryan Lindeman
  * @date 20110607 - Initial Release
  * @date 20120504 - Fix segfault caused by SLOG taking over gInstance
+ * @date 20261018 - Record the memory buffered with the MemoryTracker
  */
 
 #include <AGE/Core/loggers/StringLogger.hpp>
+#include <AGE/Core/classes/MemoryTracker.hpp>
 
 namespace AGE
 {
   StringLogger::StringLogger(bool theDefault, int theExitCode) :
-    ILogger(theDefault, theExitCode)
+    ILogger(theDefault, theExitCode),
+    mTrackedBytes(0)
   {
+    MemoryTracker::getInstance().allocate(MemoryTracker::MemoryLoggers, 0);
   }
 
   StringLogger::~StringLogger()
   {
+    MemoryTracker::getInstance().release(MemoryTracker::MemoryLoggers, mTrackedBytes);
   }
 
   std::string StringLogger::getString(void)
   {
     if(isActive())
     {
+      trackMemory();
       return mStringStream.str();
     }
     else
@@ -38,6 +44,7 @@ namespace AGE
     std::ostream* anResult = &gNullStream;
     if(isActive())
     {
+      trackMemory();
       anResult = &mStringStream;      
     }
     return *anResult;
@@ -49,6 +56,7 @@ namespace AGE
     std::ostream* anResult = &gNullStream;
     if(isActive())
     {
+      trackMemory();
       anResult = &mStringStream;
       writeTag(mStringStream, theSeverity, theSourceFile, theSourceLine);
     }
@@ -60,6 +68,7 @@ namespace AGE
     if(isActive())
     {
       mStringStream << theMessage << std::endl;
+      trackMemory();
     }
   }
 
@@ -71,6 +80,20 @@ namespace AGE
     {
       writeTag(mStringStream, theSeverity, theSourceFile, theSourceLine);
       mStringStream << theMessage << std::endl;
+      trackMemory();
+    }
+  }
+
+  void StringLogger::trackMemory(void)
+  {
+    // Messages written to a stream returned by GetStream are only seen here
+    // the next time, so record whatever the buffer has grown by since then
+    Int64 anBytes = (Int64)mStringStream.tellp();
+    if(0 <= anBytes && anBytes != mTrackedBytes)
+    {
+      MemoryTracker::getInstance().resize(MemoryTracker::MemoryLoggers,
+        anBytes - mTrackedBytes);
+      mTrackedBytes = anBytes;
     }
   }
 } // namespace AGE
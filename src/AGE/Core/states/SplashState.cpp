@@ -16,6 +16,8 @@
  * @date 20120322 - Support new SFML2 snapshot changes
  * @date 20120512 - Renamed App to Game since it really is just an interface
  * @date 20120702 - Changed Cleanup to HandleCleanup
+ * @date 20261018 - Game::mWindow is now a pointer
+ * @date 20261018 - Draw to the window returned by Game::getWindow
  */
 #include <AGE/Core/interfaces/Game.hpp>
 #include <AGE/Core/states/SplashState.hpp>
@@ -60,7 +62,7 @@ namespace AGE
   {
 
     // Draw our Splash sprite
-    mApp.mWindow.draw(mSplashSprite);
+    mApp.getWindow()->draw(mSplashSprite);
 
   }
 
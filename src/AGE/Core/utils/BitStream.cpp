@@ -0,0 +1,189 @@
+/**
+ * Provides the BitStream class in the AGE namespace which is responsible
+ * for packing values into (and unpacking them from) the fewest bits needed.
+ *
+ * @file src/AGE/Core/utils/BitStream.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cassert>
+#include <cstring>
+#include <AGE/Core/utils/BitStream.hpp>
+
+namespace AGE
+{
+  /// Number of bits used by each WriteUint size prefix
+  static const Uint32 BIT_STREAM_SIZES[4] = { 4, 8, 16, 32 };
+
+  BitStream::BitStream() :
+    mBitCount(0),
+    mReadCount(0),
+    mOverflow(false)
+  {
+  }
+
+  void BitStream::clear(void)
+  {
+    mData.clear();
+    mBitCount = 0;
+    mReadCount = 0;
+    mOverflow = false;
+  }
+
+  void BitStream::setData(const void* theData, const Uint32 theSize)
+  {
+    mData.resize(theSize);
+    if(0 < theSize)
+    {
+      memcpy(&mData[0], theData, theSize);
+    }
+    mBitCount = theSize * 8;
+    mReadCount = 0;
+    mOverflow = false;
+  }
+
+  const Uint8* BitStream::getData(void) const
+  {
+    return mData.empty() ? NULL : &mData[0];
+  }
+
+  Uint32 BitStream::getSize(void) const
+  {
+    return (mBitCount + 7) / 8;
+  }
+
+  Uint32 BitStream::getBitCount(void) const
+  {
+    return mBitCount;
+  }
+
+  void BitStream::setBitCount(const Uint32 theBitCount)
+  {
+    assert(theBitCount <= mBitCount && "BitStream::setBitCount() can only remove bits");
+    mBitCount = theBitCount;
+    mData.resize((mBitCount + 7) / 8);
+
+    // Clear the bits removed from the last byte so they can be written again
+    if(0 != (mBitCount & 7))
+    {
+      mData.back() &= (Uint8)((1u << (mBitCount & 7)) - 1);
+    }
+  }
+
+  void BitStream::writeBits(const Uint32 theValue, const Uint32 theCount)
+  {
+    assert(0 < theCount && 32 >= theCount && "BitStream::writeBits() invalid count");
+    Uint32 anValue = (32 == theCount) ? theValue : (theValue & ((1u << theCount) - 1));
+    Uint32 anCount = theCount;
+    while(0 < anCount)
+    {
+      Uint32 anOffset = mBitCount & 7;
+      if(0 == anOffset)
+      {
+        mData.push_back(0);
+      }
+      Uint32 anBits = 8 - anOffset;
+      if(anBits > anCount)
+      {
+        anBits = anCount;
+      }
+      mData.back() |= (Uint8)((anValue & ((1u << anBits) - 1)) << anOffset);
+      anValue >>= anBits;
+      anCount -= anBits;
+      mBitCount += anBits;
+    }
+  }
+
+  void BitStream::writeBool(const bool theValue)
+  {
+    writeBits(theValue ? 1 : 0, 1);
+  }
+
+  void BitStream::writeUint(const Uint32 theValue)
+  {
+    Uint32 anSize = 0;
+    while(anSize < 3 && theValue >= (1u << BIT_STREAM_SIZES[anSize]))
+    {
+      anSize++;
+    }
+    writeBits(anSize, 2);
+    writeBits(theValue, BIT_STREAM_SIZES[anSize]);
+  }
+
+  void BitStream::writeInt(const Int32 theValue)
+  {
+    // Zigzag encode so -1 becomes 1, 1 becomes 2, -2 becomes 3 and so on
+    writeUint(((Uint32)theValue << 1) ^ (Uint32)(theValue >> 31));
+  }
+
+  Uint32 BitStream::readBits(const Uint32 theCount)
+  {
+    assert(0 < theCount && 32 >= theCount && "BitStream::readBits() invalid count");
+    if(mReadCount + theCount > mBitCount)
+    {
+      mReadCount = mBitCount;
+      mOverflow = true;
+      return 0;
+    }
+
+    Uint32 anResult = 0;
+    Uint32 anShift = 0;
+    while(anShift < theCount)
+    {
+      Uint32 anOffset = mReadCount & 7;
+      Uint32 anBits = 8 - anOffset;
+      if(anBits > theCount - anShift)
+      {
+        anBits = theCount - anShift;
+      }
+      Uint32 anByte = (mData[mReadCount / 8] >> anOffset) & ((1u << anBits) - 1);
+      anResult |= anByte << anShift;
+      anShift += anBits;
+      mReadCount += anBits;
+    }
+    return anResult;
+  }
+
+  bool BitStream::readBool(void)
+  {
+    return 0 != readBits(1);
+  }
+
+  Uint32 BitStream::readUint(void)
+  {
+    return readBits(BIT_STREAM_SIZES[readBits(2)]);
+  }
+
+  Int32 BitStream::readInt(void)
+  {
+    Uint32 anValue = readUint();
+    return (Int32)(anValue >> 1) ^ -(Int32)(anValue & 1);
+  }
+
+  bool BitStream::isValid(void) const
+  {
+    return !mOverflow;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,165 @@
+/**
+ * Provides the runtime CRC32 functions that match the compile time ID()
+ * macro and the debug registry used to detect Id collisions.
+ *
+ * @file src/AGE/Core/utils/CRC32.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <map>
+#include <string>
+#include <SFML/System.hpp>
+#include <AGE/Core/utils/CRC32.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /// Slice-by-8 tables derived from crc_table, built on first use
+  struct typeCRC32Tables
+  {
+    uint32_t table[8][256]; ///< table[k][n] is n followed by k zero bytes
+    bool littleEndian;      ///< True if 32 bit loads are little endian
+  };
+
+  /**
+   * BuildTables will fill theTables provided with the slice-by-8 tables.
+   * @param[out] theTables to fill
+   */
+  static void buildTables(typeCRC32Tables& theTables)
+  {
+    for(uint32_t iloop = 0; iloop < 256; iloop++)
+    {
+      theTables.table[0][iloop] = crc_table[iloop];
+    }
+    for(uint32_t jloop = 1; jloop < 8; jloop++)
+    {
+      for(uint32_t iloop = 0; iloop < 256; iloop++)
+      {
+        uint32_t anCRC = theTables.table[jloop - 1][iloop];
+        theTables.table[jloop][iloop] = (anCRC >> 8) ^ crc_table[anCRC & 0xFF];
+      }
+    }
+
+    const uint32_t anOne = 1;
+    theTables.littleEndian = (1 == *(const unsigned char*)&anOne);
+  }
+
+  /**
+   * GetTables will return the slice-by-8 tables, building them the first
+   * time they are needed (static initialization is thread safe in C++11).
+   * @return the slice-by-8 tables
+   */
+  static const typeCRC32Tables& getTables(void)
+  {
+    static typeCRC32Tables gTables;
+    static bool gBuilt = (buildTables(gTables), true);
+    (void)gBuilt;
+    return gTables;
+  }
+
+#if defined(AGE_DEBUG)
+  /**
+   * GetRegistry will return the map of every Id registered to the string it
+   * was created from.
+   * @return the registry of Ids
+   */
+  static std::map<uint32_t, std::string>& getRegistry(void)
+  {
+    static std::map<uint32_t, std::string> gRegistry;
+    return gRegistry;
+  }
+
+  /**
+   * GetRegistryMutex will return the mutex that protects the registry.
+   * @return the registry mutex
+   */
+  static sf::Mutex& getRegistryMutex(void)
+  {
+    static sf::Mutex gMutex;
+    return gMutex;
+  }
+#endif
+} // namespace AGE
+
+uint32_t crc32_runtime(const char * str, size_t len)
+{
+   const AGE::typeCRC32Tables& anTables = AGE::getTables();
+   const uint32_t (*anTable)[256] = anTables.table;
+   uint32_t crc = 0xFFFFFFFF;
+
+   // Process 8 bytes at a time using two 32 bit loads
+   if(anTables.littleEndian)
+   {
+      while(len >= 8)
+      {
+         uint32_t one;
+         uint32_t two;
+         memcpy(&one, str, sizeof(uint32_t));
+         memcpy(&two, str + 4, sizeof(uint32_t));
+         one ^= crc;
+         crc = anTable[7][one & 0xFF] ^
+               anTable[6][(one >> 8) & 0xFF] ^
+               anTable[5][(one >> 16) & 0xFF] ^
+               anTable[4][one >> 24] ^
+               anTable[3][two & 0xFF] ^
+               anTable[2][(two >> 8) & 0xFF] ^
+               anTable[1][(two >> 16) & 0xFF] ^
+               anTable[0][two >> 24];
+         str += 8;
+         len -= 8;
+      }
+   }
+
+   // Process the remaining bytes one at a time
+   while(len > 0)
+   {
+      crc = crc32_step(crc, *str++);
+      len--;
+   }
+
+   return crc ^ 0xFFFFFFFF;
+}
+
+uint32_t crc32_register(const char * str, size_t len)
+{
+   uint32_t anID = crc32_runtime(str, len);
+
+#if defined(AGE_DEBUG)
+   sf::Lock anLock(AGE::getRegistryMutex());
+   std::map<uint32_t, std::string>& anRegistry = AGE::getRegistry();
+   std::map<uint32_t, std::string>::iterator iter = anRegistry.find(anID);
+   if(iter == anRegistry.end())
+   {
+      anRegistry.insert(std::pair<uint32_t, std::string>(anID, std::string(str, len)));
+   }
+   else if(iter->second.size() != len || 0 != memcmp(iter->second.data(), str, len))
+   {
+      ELOG() << "crc32_register(" << std::string(str, len) << ") has the same ID("
+        << anID << ") as (" << iter->second << ")!" << std::endl;
+   }
+#endif
+
+   return anID;
+}
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
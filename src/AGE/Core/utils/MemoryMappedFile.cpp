@@ -0,0 +1,207 @@
+/**
+ * Provides the MemoryMappedFile class in the AGE namespace which is
+ * responsible for mapping the contents of a file read-only into memory.
+ *
+ * @file src/AGE/Core/utils/MemoryMappedFile.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Added GetModifiedTime for cache validation
+ */
+
+#include <AGE/Core/utils/MemoryMappedFile.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+#if defined(AGE_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AGE
+{
+  MemoryMappedFile::MemoryMappedFile() :
+    mData(NULL),
+    mSize(0),
+    mModified(0),
+    mOpen(false)
+#if defined(AGE_WINDOWS)
+    , mFile(INVALID_HANDLE_VALUE),
+    mMapping(NULL)
+#endif
+  {
+  }
+
+  MemoryMappedFile::~MemoryMappedFile()
+  {
+    close();
+  }
+
+  bool MemoryMappedFile::open(const std::string& theFilename)
+  {
+    // Close any file previously opened
+    close();
+
+#if defined(AGE_WINDOWS)
+    mFile = CreateFileA(theFilename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(INVALID_HANDLE_VALUE == mFile)
+    {
+      ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    LARGE_INTEGER anSize;
+    if(!GetFileSizeEx(mFile, &anSize))
+    {
+      ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to get size" << std::endl;
+      CloseHandle(mFile);
+      mFile = INVALID_HANDLE_VALUE;
+      return false;
+    }
+    mSize = (size_t)anSize.QuadPart;
+
+    FILETIME anWriteTime;
+    if(GetFileTime(mFile, NULL, NULL, &anWriteTime))
+    {
+      // FILETIME is in 100 nanosecond units
+      mModified = (((Int64)anWriteTime.dwHighDateTime << 32) |
+          anWriteTime.dwLowDateTime) * 100;
+    }
+
+    // Empty files can't be mapped but are still valid
+    if(0 < mSize)
+    {
+      mMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+      if(NULL != mMapping)
+      {
+        mData = (const char*)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+      }
+      if(NULL == mData)
+      {
+        ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to map file" << std::endl;
+        close();
+        return false;
+      }
+    }
+#else
+    int anFile = ::open(theFilename.c_str(), O_RDONLY);
+    if(-1 == anFile)
+    {
+      ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    struct stat anStat;
+    if(-1 == fstat(anFile, &anStat))
+    {
+      ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to get size" << std::endl;
+      ::close(anFile);
+      return false;
+    }
+    mSize = (size_t)anStat.st_size;
+#if defined(AGE_LINUX)
+    mModified = (Int64)anStat.st_mtim.tv_sec * 1000000000 + anStat.st_mtim.tv_nsec;
+#elif defined(AGE_MACOS)
+    mModified = (Int64)anStat.st_mtimespec.tv_sec * 1000000000 + anStat.st_mtimespec.tv_nsec;
+#else
+    mModified = (Int64)anStat.st_mtime * 1000000000;
+#endif
+
+    // Empty files can't be mapped but are still valid
+    if(0 < mSize)
+    {
+      void* anData = mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, anFile, 0);
+      if(MAP_FAILED == anData)
+      {
+        ELOG() << "MemoryMappedFile::open(" << theFilename << ") unable to map file" << std::endl;
+        ::close(anFile);
+        mSize = 0;
+        return false;
+      }
+      mData = (const char*)anData;
+
+      // We will read the file from front to back
+      madvise(anData, mSize, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    ::close(anFile);
+#endif
+
+    mOpen = true;
+
+    return true;
+  }
+
+  void MemoryMappedFile::close(void)
+  {
+#if defined(AGE_WINDOWS)
+    if(NULL != mData)
+    {
+      UnmapViewOfFile(mData);
+    }
+    if(NULL != mMapping)
+    {
+      CloseHandle(mMapping);
+      mMapping = NULL;
+    }
+    if(INVALID_HANDLE_VALUE != mFile)
+    {
+      CloseHandle(mFile);
+      mFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if(NULL != mData)
+    {
+      munmap((void*)mData, mSize);
+    }
+#endif
+    mData = NULL;
+    mSize = 0;
+    mModified = 0;
+    mOpen = false;
+  }
+
+  bool MemoryMappedFile::isOpen(void) const
+  {
+    return mOpen;
+  }
+
+  const char* MemoryMappedFile::getData(void) const
+  {
+    return mData;
+  }
+
+  size_t MemoryMappedFile::getSize(void) const
+  {
+    return mSize;
+  }
+
+  Int64 MemoryMappedFile::getModifiedTime(void) const
+  {
+    return mModified;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,126 @@
+/**
+ * Provides the MemoryStream class in the AGE namespace which is responsible
+ * for providing an sf::InputStream over a memory mapped region of a file.
+ *
+ * @file src/AGE/Core/utils/MemoryStream.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cstring>
+#include <AGE/Core/utils/MemoryStream.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  MemoryStream::MemoryStream() :
+    mData(NULL),
+    mSize(-1),
+    mPosition(-1)
+  {
+  }
+
+  MemoryStream::~MemoryStream()
+  {
+    close();
+  }
+
+  bool MemoryStream::open(const std::string& theFilename, const Uint64 theOffset,
+    const Uint64 theSize)
+  {
+    close();
+
+    if(!mFile.open(theFilename))
+    {
+      return false;
+    }
+
+    // Make sure the region fits inside the file
+    const Uint64 anFileSize = (Uint64)mFile.getSize();
+    if(theOffset > anFileSize || theSize > anFileSize - theOffset)
+    {
+      ELOG() << "MemoryStream::open(" << theFilename << ") region " << theOffset
+        << "+" << theSize << " is outside the file" << std::endl;
+      mFile.close();
+      return false;
+    }
+
+    mData = mFile.getData() + theOffset;
+    mSize = (sf::Int64)((0 == theSize) ? anFileSize - theOffset : theSize);
+    mPosition = 0;
+
+    return true;
+  }
+
+  void MemoryStream::close(void)
+  {
+    mFile.close();
+    mData = NULL;
+    mSize = -1;
+    mPosition = -1;
+  }
+
+  sf::Int64 MemoryStream::read(void* theData, sf::Int64 theSize)
+  {
+    if(0 > mPosition || 0 > theSize)
+    {
+      return -1;
+    }
+
+    sf::Int64 anCount = mSize - mPosition;
+    if(theSize < anCount)
+    {
+      anCount = theSize;
+    }
+    if(0 < anCount)
+    {
+      memcpy(theData, mData + mPosition, (size_t)anCount);
+      mPosition += anCount;
+    }
+
+    return anCount;
+  }
+
+  sf::Int64 MemoryStream::seek(sf::Int64 thePosition)
+  {
+    if(0 > mPosition || 0 > thePosition)
+    {
+      return -1;
+    }
+
+    mPosition = (thePosition < mSize) ? thePosition : mSize;
+
+    return mPosition;
+  }
+
+  sf::Int64 MemoryStream::tell(void)
+  {
+    return mPosition;
+  }
+
+  sf::Int64 MemoryStream::getSize(void)
+  {
+    return mSize;
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
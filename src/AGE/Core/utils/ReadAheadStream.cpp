@@ -0,0 +1,344 @@
+/**
+ * Provides the ReadAheadStream class in the AGE namespace which is
+ * responsible for providing an sf::InputStream over a region of a file that
+ * is read in chunks ahead of time by a background thread.
+ *
+ * @file src/AGE/Core/utils/ReadAheadStream.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+
+#include <cstring>
+#include <AGE/Core/utils/ReadAheadStream.hpp>
+#include <AGE/Core/loggers/Log_macros.hpp>
+
+namespace AGE
+{
+  /**
+   * SeekFile will move theFile provided to thePosition using 64 bit offsets
+   * so regions of bundled data files larger than 2GB can be read.
+   * @param[in] theFile to move
+   * @param[in] thePosition from the start of the file or -1 for the end
+   * @return true if successful, false otherwise
+   */
+  static bool seekFile(std::FILE* theFile, const sf::Int64 thePosition)
+  {
+    int anWhence = (0 > thePosition) ? SEEK_END : SEEK_SET;
+    sf::Int64 anPosition = (0 > thePosition) ? 0 : thePosition;
+#if defined(AGE_WINDOWS)
+    return 0 == _fseeki64(theFile, anPosition, anWhence);
+#else
+    return 0 == fseeko(theFile, (off_t)anPosition, anWhence);
+#endif
+  }
+
+  /**
+   * TellFile will return the current position of theFile provided using 64
+   * bit offsets.
+   * @param[in] theFile to query
+   * @return the current position or -1 on error
+   */
+  static sf::Int64 tellFile(std::FILE* theFile)
+  {
+#if defined(AGE_WINDOWS)
+    return (sf::Int64)_ftelli64(theFile);
+#else
+    return (sf::Int64)ftello(theFile);
+#endif
+  }
+
+  ReadAheadStream::ReadAheadStream() :
+    mFile(NULL),
+    mOffset(0),
+    mSize(-1),
+    mPosition(-1),
+    mStalls(0),
+    mStopping(false)
+  {
+    for(Uint32 iloop = 0; iloop < CHUNK_COUNT; iloop++)
+    {
+      mChunks[iloop].data.resize(CHUNK_SIZE);
+      mChunks[iloop].start = 0;
+      mChunks[iloop].size = 0;
+      mChunks[iloop].state = ChunkEmpty;
+    }
+  }
+
+  ReadAheadStream::~ReadAheadStream()
+  {
+    close();
+  }
+
+  bool ReadAheadStream::open(const std::string& theFilename, const Uint64 theOffset,
+    const Uint64 theSize)
+  {
+    close();
+
+    mFile = std::fopen(theFilename.c_str(), "rb");
+    if(NULL == mFile)
+    {
+      ELOG() << "ReadAheadStream::open(" << theFilename << ") unable to open file" << std::endl;
+      return false;
+    }
+
+    // Make sure the region fits inside the file
+    sf::Int64 anFileSize = seekFile(mFile, -1) ? tellFile(mFile) : -1;
+    if(0 > anFileSize || theOffset > (Uint64)anFileSize ||
+      theSize > (Uint64)anFileSize - theOffset)
+    {
+      ELOG() << "ReadAheadStream::open(" << theFilename << ") region " << theOffset
+        << "+" << theSize << " is outside the file" << std::endl;
+      std::fclose(mFile);
+      mFile = NULL;
+      return false;
+    }
+
+    mOffset = (sf::Int64)theOffset;
+    mSize = (0 == theSize) ? anFileSize - mOffset : (sf::Int64)theSize;
+    mPosition = 0;
+    mStalls = 0;
+    mStopping = false;
+    for(Uint32 iloop = 0; iloop < CHUNK_COUNT; iloop++)
+    {
+      mChunks[iloop].state = ChunkEmpty;
+    }
+
+    // Start reading the first chunk right away
+    request(0, 0);
+    mThread = std::thread(&ReadAheadStream::run, this);
+
+    return true;
+  }
+
+  void ReadAheadStream::close(void)
+  {
+    if(mThread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> anLock(mMutex);
+        mStopping = true;
+      }
+      mWake.notify_all();
+      mThread.join();
+    }
+
+    if(NULL != mFile)
+    {
+      std::fclose(mFile);
+      mFile = NULL;
+    }
+    mSize = -1;
+    mPosition = -1;
+  }
+
+  sf::Int64 ReadAheadStream::read(void* theData, sf::Int64 theSize)
+  {
+    std::unique_lock<std::mutex> anLock(mMutex);
+
+    if(0 > mPosition || 0 > theSize)
+    {
+      return -1;
+    }
+
+    sf::Int64 anCopied = 0;
+    bool anStalled = false;
+    while(anCopied < theSize && mPosition < mSize)
+    {
+      sf::Int64 anStart = mPosition - (mPosition % CHUNK_SIZE);
+
+      // Look for the chunk covering the current position
+      typeChunk* anChunk = NULL;
+      for(Uint32 iloop = 0; iloop < CHUNK_COUNT; iloop++)
+      {
+        if(ChunkReady == mChunks[iloop].state && anStart == mChunks[iloop].start)
+        {
+          anChunk = &mChunks[iloop];
+          break;
+        }
+      }
+
+      if(NULL == anChunk)
+      {
+        // Wait for the background thread to read it for us
+        request(anStart, -1);
+        if(!anStalled)
+        {
+          anStalled = true;
+          mStalls++;
+        }
+        mReady.wait(anLock);
+        continue;
+      }
+
+      // A short chunk means the file could not be read
+      sf::Int64 anIndex = mPosition - anChunk->start;
+      if(anIndex >= anChunk->size)
+      {
+        ELOG() << "ReadAheadStream::read() unable to read at " << mPosition << std::endl;
+        return (0 < anCopied) ? anCopied : -1;
+      }
+
+      sf::Int64 anCount = anChunk->size - anIndex;
+      if(theSize - anCopied < anCount)
+      {
+        anCount = theSize - anCopied;
+      }
+      memcpy((char*)theData + anCopied, &anChunk->data[(size_t)anIndex], (size_t)anCount);
+      anCopied += anCount;
+      mPosition += anCount;
+      anStalled = false;
+
+      // Make sure the next chunk is on its way
+      sf::Int64 anNext = anChunk->start + CHUNK_SIZE;
+      if(anNext < mSize)
+      {
+        request(anNext, mPosition);
+      }
+    }
+
+    return anCopied;
+  }
+
+  sf::Int64 ReadAheadStream::seek(sf::Int64 thePosition)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+
+    if(0 > mPosition || 0 > thePosition)
+    {
+      return -1;
+    }
+
+    mPosition = (thePosition < mSize) ? thePosition : mSize;
+
+    // Start reading the chunk for the new position before it is needed
+    if(mPosition < mSize)
+    {
+      request(mPosition - (mPosition % CHUNK_SIZE), -1);
+    }
+
+    return mPosition;
+  }
+
+  sf::Int64 ReadAheadStream::tell(void)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return mPosition;
+  }
+
+  sf::Int64 ReadAheadStream::getSize(void)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return mSize;
+  }
+
+  Uint32 ReadAheadStream::getStalls(void) const
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return mStalls;
+  }
+
+  bool ReadAheadStream::request(const sf::Int64 theStart, const sf::Int64 theKeep)
+  {
+    // Caller holds mMutex
+    typeChunk* anVictim = NULL;
+    for(Uint32 iloop = 0; iloop < CHUNK_COUNT; iloop++)
+    {
+      typeChunk& anChunk = mChunks[iloop];
+      if(ChunkEmpty != anChunk.state && theStart == anChunk.start)
+      {
+        // Already available or on its way
+        return true;
+      }
+      if(ChunkFilling == anChunk.state)
+      {
+        continue;
+      }
+      if(ChunkReady == anChunk.state && anChunk.start <= theKeep &&
+        theKeep < anChunk.start + anChunk.size)
+      {
+        continue;
+      }
+      if(NULL == anVictim || ChunkEmpty == anChunk.state)
+      {
+        anVictim = &anChunk;
+      }
+    }
+
+    if(NULL == anVictim)
+    {
+      return false;
+    }
+
+    anVictim->start = theStart;
+    anVictim->size = 0;
+    anVictim->state = ChunkRequested;
+    mWake.notify_one();
+
+    return true;
+  }
+
+  void ReadAheadStream::run(void)
+  {
+    std::unique_lock<std::mutex> anLock(mMutex);
+    while(!mStopping)
+    {
+      typeChunk* anChunk = NULL;
+      for(Uint32 iloop = 0; iloop < CHUNK_COUNT; iloop++)
+      {
+        if(ChunkRequested == mChunks[iloop].state)
+        {
+          anChunk = &mChunks[iloop];
+          break;
+        }
+      }
+
+      if(NULL == anChunk)
+      {
+        mWake.wait(anLock);
+        continue;
+      }
+
+      anChunk->state = ChunkFilling;
+      sf::Int64 anStart = anChunk->start;
+      sf::Int64 anCount = mSize - anStart;
+      if(CHUNK_SIZE < anCount)
+      {
+        anCount = CHUNK_SIZE;
+      }
+
+      // Read without holding the mutex so Read can use the other chunks
+      anLock.unlock();
+      size_t anRead = 0;
+      if(seekFile(mFile, mOffset + anStart))
+      {
+        anRead = std::fread(&anChunk->data[0], 1, (size_t)anCount, mFile);
+      }
+      anLock.lock();
+
+      anChunk->size = (sf::Int64)anRead;
+      anChunk->state = ChunkReady;
+      mReady.notify_all();
+    }
+  }
+} // namespace AGE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -8,298 +8,654 @@
  * @date 20110906 - Moved Util.cpp from Entities to here
  * @date 20120720 - Added several new Convert and Parse functions
  * @date 20120904 - Fix SFML v1.6 issues
+ * @date 20261018 - Locale-free parse/format methods using StringRef
+ * @date 20261018 - ScanDouble falls back to strtod on a stack copy
  */
 
-#include <sstream>
-#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <clocale>
+#include <limits>
 #include <AGE/Core/utils/StringUtil.hpp>
 
 namespace AGE
 {
-  std::string convertBool(const bool theBoolean)
-  {
-    // Use StringStream class to convert theBoolean to a string
-    std::stringstream anResult;
+  /// Powers of 10 that are exactly representable by a double
+  static const double gPowersOf10[] =
+  {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  /// Largest integer that is exactly representable by a double
+  static const Uint64 MAX_EXACT_MANTISSA = 9007199254740992ULL;
+  /// Maximum number of significant digits collected into a Uint64 mantissa
+  static const Int32 MAX_MANTISSA_DIGITS = 19;
+  /// Maximum number of significant digits passed to strtod by ScanDouble
+  static const Int32 MAX_STRTOD_DIGITS = 40;
+
+  /**
+   * IsDigit will return true if theCharacter is 0-9 regardless of locale.
+   * @param[in] theCharacter to test
+   * @return true if theCharacter is a decimal digit, false otherwise
+   */
+  static inline bool isDigit(const char theCharacter)
+  {
+    return (unsigned)(theCharacter - '0') < 10;
+  }
+
+  /**
+   * SkipSpace will return a pointer to the first character at or after
+   * theBegin that is not whitespace (like std::istream does).
+   * @param[in] theBegin of the characters to skip
+   * @param[in] theEnd of the characters to skip
+   * @return pointer to the first non whitespace character or theEnd
+   */
+  static inline const char* skipSpace(const char* theBegin, const char* theEnd)
+  {
+    while(theBegin < theEnd && (' ' == *theBegin ||
+        ('\t' <= *theBegin && '\r' >= *theBegin)))
+    {
+      theBegin++;
+    }
+    return theBegin;
+  }
+
+  /**
+   * ScanDigits will parse the decimal digits at theBegin into theResult
+   * and advance theBegin past them.
+   * @param[in,out] theBegin of the digits to parse
+   * @param[in] theEnd of the characters available
+   * @param[in] theMaximum value allowed for theResult
+   * @param[out] theResult to store the value found
+   * @return true if at least one digit was found and in range
+   */
+  static bool scanDigits(const char*& theBegin, const char* theEnd,
+      const Uint64 theMaximum, Uint64& theResult)
+  {
+    if(theBegin == theEnd || !isDigit(*theBegin))
+    {
+      return false;
+    }
 
-    // Add theBoolean to the stringstream
-    if(theBoolean)
+    Uint64 anResult = 0;
+    while(theBegin < theEnd && isDigit(*theBegin))
     {
-      anResult << "true";
+      Uint32 anDigit = (Uint32)(*theBegin - '0');
+      if(anResult > (theMaximum - anDigit) / 10)
+      {
+        return false;
+      }
+      anResult = anResult * 10 + anDigit;
+      theBegin++;
     }
-    else
+    theResult = anResult;
+
+    return true;
+  }
+
+  /**
+   * EqualNoCase will return true if theValue matches the lower case
+   * theLower string provided while ignoring the case of theValue.
+   * @param[in] theValue to compare
+   * @param[in] theLower null terminated lower case string to compare against
+   * @return true if they match, false otherwise
+   */
+  static bool equalNoCase(const StringRef theValue, const char* theLower)
+  {
+    size_t iloop = 0;
+    for(; iloop < theValue.size(); iloop++)
     {
-      anResult << "false";
+      char anCharacter = theValue[iloop];
+      if('A' <= anCharacter && 'Z' >= anCharacter)
+      {
+        anCharacter = (char)(anCharacter - 'A' + 'a');
+      }
+      if('\0' == theLower[iloop] || anCharacter != theLower[iloop])
+      {
+        return false;
+      }
     }
+    return '\0' == theLower[iloop];
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  /**
+   * FindComma will return the offset of the next comma in theValue at or
+   * after theOffset provided.
+   * @param[in] theValue to search
+   * @param[in] theOffset to start searching at
+   * @return the offset of the comma or theValue.size() if none was found
+   */
+  static size_t findComma(const StringRef theValue, size_t theOffset)
+  {
+    while(theOffset < theValue.size() && ',' != theValue[theOffset])
+    {
+      theOffset++;
+    }
+    return theOffset;
+  }
+
+  /**
+   * ScanSigned will parse theValue and return theDefault if it is not a
+   * number between the minimum and maximum values of TYPE.
+   * @param[in] theValue to parse
+   * @param[in] theDefault to return if the parser fails
+   * @return the value found or theDefault
+   */
+  template<typename TYPE>
+  static TYPE scanSigned(const StringRef theValue, const TYPE theDefault)
+  {
+    Int64 anResult;
+    if(scanInt64(theValue, anResult) &&
+        anResult >= (Int64)std::numeric_limits<TYPE>::min() &&
+        anResult <= (Int64)std::numeric_limits<TYPE>::max())
+    {
+      return (TYPE)anResult;
+    }
+    return theDefault;
+  }
+
+  /**
+   * ScanUnsigned will parse theValue and return theDefault if it is not a
+   * number between 0 and the maximum value of TYPE.
+   * @param[in] theValue to parse
+   * @param[in] theDefault to return if the parser fails
+   * @return the value found or theDefault
+   */
+  template<typename TYPE>
+  static TYPE scanUnsigned(const StringRef theValue, const TYPE theDefault)
+  {
+    Uint64 anResult;
+    if(scanUint64(theValue, anResult) &&
+        anResult <= (Uint64)std::numeric_limits<TYPE>::max())
+    {
+      return (TYPE)anResult;
+    }
+    return theDefault;
   }
 
-  std::string convertColor(const sf::Color theColor)
+  size_t formatDouble(char* theBuffer, const double theNumber)
   {
-    // Use StringStream class to convert theColor to a string
-    std::stringstream anResult;
+    int anLength = snprintf(theBuffer, FORMAT_BUFFER_SIZE, "%g", theNumber);
+    if(0 > anLength)
+    {
+      theBuffer[0] = '\0';
+      return 0;
+    }
 
-    // Add theColor to the stringstream
-    anResult << theColor.r << ", ";
-    anResult << theColor.g << ", ";
-    anResult << theColor.b << ", ";
-    anResult << theColor.a;
+    // Replace the decimal point of the current locale with '.'
+    char anPoint = localeconv()->decimal_point[0];
+    if('.' != anPoint)
+    {
+      for(int iloop = 0; iloop < anLength; iloop++)
+      {
+        if(anPoint == theBuffer[iloop])
+        {
+          theBuffer[iloop] = '.';
+        }
+      }
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return (size_t)anLength;
   }
 
-  std::string convertDouble(const double theDouble)
+  size_t formatInt64(char* theBuffer, const Int64 theNumber)
+  {
+    if(0 > theNumber)
+    {
+      // Negate as unsigned so the minimum value doesn't overflow
+      theBuffer[0] = '-';
+      return 1 + formatUint64(theBuffer + 1, 0 - (Uint64)theNumber);
+    }
+    return formatUint64(theBuffer, (Uint64)theNumber);
+  }
+
+  size_t formatUint64(char* theBuffer, const Uint64 theNumber)
   {
-    // Use StringStream class to convert theDouble to a string
-    std::stringstream anResult;
+    // Write the digits backwards and then copy them in order
+    char anDigits[20];
+    size_t anLength = 0;
+    Uint64 anNumber = theNumber;
+    do
+    {
+      anDigits[anLength++] = (char)('0' + anNumber % 10);
+      anNumber /= 10;
+    } while(0 < anNumber);
 
-    // Add theDouble to the stringstream
-    anResult << theDouble;
+    for(size_t iloop = 0; iloop < anLength; iloop++)
+    {
+      theBuffer[iloop] = anDigits[anLength - 1 - iloop];
+    }
+    theBuffer[anLength] = '\0';
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return anLength;
   }
 
-  std::string convertFloat(const float theFloat)
+  std::string convertBool(const bool theBoolean)
   {
-    // Use StringStream class to convert theFloat to a string
-    std::stringstream anResult;
+    return theBoolean ? std::string("true") : std::string("false");
+  }
 
-    // Add theFloat to the stringstream
-    anResult << theFloat;
+  std::string convertColor(const sf::Color theColor)
+  {
+    char anBuffer[4 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatUint64(anBuffer, theColor.r);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatUint64(&anBuffer[anLength], theColor.g);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatUint64(&anBuffer[anLength], theColor.b);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatUint64(&anBuffer[anLength], theColor.a);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
-  std::string convertInt8(const Int8 theNumber)
+  std::string convertDouble(const double theDouble)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatDouble(anBuffer, theDouble));
+  }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  std::string convertFloat(const float theFloat)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatDouble(anBuffer, theFloat));
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  std::string convertInt8(const Int8 theNumber)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatInt64(anBuffer, theNumber));
   }
 
   std::string convertInt16(const Int16 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatInt64(anBuffer, theNumber));
   }
 
   std::string convertInt32(const Int32 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatInt64(anBuffer, theNumber));
   }
 
   std::string convertInt64(const Int64 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatInt64(anBuffer, theNumber));
   }
 
   std::string convertIntRect(const sf::IntRect theRect)
   {
-    // Use StringStream class to convert theRect to a string
-    std::stringstream anResult;
-
-    // Add theRect to the stringstream
-
-    anResult << theRect.top << ", ";
-    anResult << theRect.left << ", ";
-    anResult << theRect.width << ", ";
-    anResult << theRect.height;
-
+    char anBuffer[4 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatInt64(anBuffer, theRect.top);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theRect.left);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theRect.width);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theRect.height);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
   std::string convertUint8(const Uint8 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatUint64(anBuffer, theNumber));
   }
 
   std::string convertUint16(const Uint16 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatUint64(anBuffer, theNumber));
   }
 
   std::string convertUint32(const Uint32 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatUint64(anBuffer, theNumber));
   }
 
   std::string convertUint64(const Uint64 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
-
-    // Add theNumber to the stringstream
-    anResult << theNumber;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, formatUint64(anBuffer, theNumber));
   }
 
   std::string convertVector2f(const sf::Vector2f theVector)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
-
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
+    char anBuffer[2 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatDouble(anBuffer, theVector.x);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatDouble(&anBuffer[anLength], theVector.y);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
   std::string convertVector2i(const sf::Vector2i theVector)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
-
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
+    char anBuffer[2 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatInt64(anBuffer, theVector.x);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theVector.y);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
   std::string convertVector2u(const sf::Vector2u theVector)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    char anBuffer[2 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatUint64(anBuffer, theVector.x);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatUint64(&anBuffer[anLength], theVector.y);
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
-
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
   std::string convertVector3f(const sf::Vector3f theVector)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
-
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y << ", ";
-    anResult << theVector.z;
+    char anBuffer[3 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatDouble(anBuffer, theVector.x);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatDouble(&anBuffer[anLength], theVector.y);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatDouble(&anBuffer[anLength], theVector.z);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return std::string(anBuffer, anLength);
   }
 
   std::string convertVector3i(const sf::Vector3i theVector)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    char anBuffer[3 * (FORMAT_BUFFER_SIZE + 2)];
+    size_t anLength = formatInt64(anBuffer, theVector.x);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theVector.y);
+    anBuffer[anLength++] = ',';
+    anBuffer[anLength++] = ' ';
+    anLength += formatInt64(&anBuffer[anLength], theVector.z);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  bool scanBool(const StringRef theValue, bool& theResult)
+  {
+    // Look for true/1/on results
+    if(equalNoCase(theValue, "true") || equalNoCase(theValue, "1") ||
+        equalNoCase(theValue, "on"))
+    {
+      theResult = true;
+      return true;
+    }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y << ", ";
-    anResult << theVector.z;
+    // Look for false/0/off results
+    if(equalNoCase(theValue, "false") || equalNoCase(theValue, "0") ||
+        equalNoCase(theValue, "off"))
+    {
+      theResult = false;
+      return true;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return false;
   }
 
-  bool parseBool(std::string theValue, const bool theDefault)
+  bool scanDouble(const StringRef theValue, double& theResult)
   {
-    bool anResult = theDefault;
+    const char* anEnd = theValue.data() + theValue.size();
+    const char* anBegin = skipSpace(theValue.data(), anEnd);
+    const char* anIter = anBegin;
 
-    // First convert theValue provided into lower case
-    std::transform(theValue.begin(), theValue.end(), theValue.begin(), tolower);
+    // Parse the optional sign
+    bool anNegative = false;
+    if(anIter < anEnd && ('-' == *anIter || '+' == *anIter))
+    {
+      anNegative = ('-' == *anIter);
+      anIter++;
+    }
 
-    // Look for true/1/on results
-    if(theValue == "true" || theValue == "1" || theValue == "on")
+    // Collect up to 19 significant digits from the integer and fraction
+    const char* anDigitsBegin = anIter;
+    Uint64 anMantissa = 0;
+    Int32 anDigits = 0;
+    Int32 anExponent = 0;
+    bool anFound = false;
+    bool anExact = true;
+    while(anIter < anEnd && isDigit(*anIter))
+    {
+      anFound = true;
+      if(anDigits < MAX_MANTISSA_DIGITS)
+      {
+        anMantissa = anMantissa * 10 + (Uint64)(*anIter - '0');
+        anDigits += (0 < anMantissa) ? 1 : 0;
+      }
+      else
+      {
+        anExponent++;
+        anExact = anExact && '0' == *anIter;
+      }
+      anIter++;
+    }
+    if(anIter < anEnd && '.' == *anIter)
+    {
+      anIter++;
+      while(anIter < anEnd && isDigit(*anIter))
+      {
+        anFound = true;
+        if(anDigits < MAX_MANTISSA_DIGITS)
+        {
+          anMantissa = anMantissa * 10 + (Uint64)(*anIter - '0');
+          anDigits += (0 < anMantissa) ? 1 : 0;
+          anExponent--;
+        }
+        else
+        {
+          anExact = anExact && '0' == *anIter;
+        }
+        anIter++;
+      }
+    }
+    if(!anFound)
     {
-      anResult = true;
+      return false;
     }
+    const char* anDigitsEnd = anIter;
 
-    // Look for false results
-    if(theValue == "false" || theValue == "0" || theValue == "off")
+    // Parse the optional exponent (an 'e' without digits is not part of it)
+    Int32 anExplicit = 0;
+    if(anIter < anEnd && ('e' == *anIter || 'E' == *anIter))
     {
-      anResult = false;
+      const char* anMark = anIter++;
+      bool anNegativeExponent = false;
+      if(anIter < anEnd && ('-' == *anIter || '+' == *anIter))
+      {
+        anNegativeExponent = ('-' == *anIter);
+        anIter++;
+      }
+      Uint64 anValue;
+      if(scanDigits(anIter, anEnd, 100000, anValue))
+      {
+        anExplicit = anNegativeExponent ? -(Int32)anValue : (Int32)anValue;
+        anExponent += anExplicit;
+      }
+      else if(anIter < anEnd && isDigit(*anIter))
+      {
+        // Exponent is far too large for any double
+        return false;
+      }
+      else
+      {
+        anIter = anMark;
+      }
+    }
+
+    // Both the mantissa and power of 10 are exact so the result is rounded
+    // only once, otherwise let strtod round the digits correctly
+    if(anExact && MAX_EXACT_MANTISSA >= anMantissa &&
+        -22 <= anExponent && 22 >= anExponent)
+    {
+      double anResult = (double)anMantissa;
+      if(0 > anExponent)
+      {
+        anResult /= gPowersOf10[-anExponent];
+      }
+      else
+      {
+        anResult *= gPowersOf10[anExponent];
+      }
+      theResult = anNegative ? -anResult : anResult;
+    }
+    else
+    {
+      // Copy the significant digits followed by an exponent (never a
+      // decimal point, so the locale doesn't matter) onto the stack. Any
+      // digits past MAX_STRTOD_DIGITS are replaced by a single 1 if any of
+      // them are not 0 so the copy still rounds the same way.
+      char anBuffer[MAX_STRTOD_DIGITS + 32];
+      Int32 anLength = 0;
+      Int32 anCopied = 0;
+      Int64 anPower = anExplicit;
+      bool anFraction = false;
+      bool anSticky = false;
+      if(anNegative)
+      {
+        anBuffer[anLength++] = '-';
+      }
+      for(const char* anDigit = anDigitsBegin; anDigit < anDigitsEnd; anDigit++)
+      {
+        if('.' == *anDigit)
+        {
+          anFraction = true;
+        }
+        else if(0 == anCopied && '0' == *anDigit)
+        {
+          anPower -= anFraction ? 1 : 0;
+        }
+        else if(anCopied < MAX_STRTOD_DIGITS)
+        {
+          anBuffer[anLength++] = *anDigit;
+          anCopied++;
+          anPower -= anFraction ? 1 : 0;
+        }
+        else
+        {
+          anPower += anFraction ? 0 : 1;
+          anSticky = anSticky || '0' != *anDigit;
+        }
+      }
+      if(0 == anCopied)
+      {
+        theResult = anNegative ? -0.0 : 0.0;
+        return true;
+      }
+      if(anSticky)
+      {
+        anBuffer[anLength++] = '1';
+        anPower--;
+      }
+      snprintf(anBuffer + anLength, sizeof(anBuffer) - anLength, "e%lld",
+        (long long)anPower);
+
+      errno = 0;
+      double anResult = strtod(anBuffer, NULL);
+      if(ERANGE == errno && HUGE_VAL == std::fabs(anResult))
+      {
+        return false;
+      }
+      theResult = anResult;
+    }
+
+    return true;
+  }
+
+  bool scanInt64(const StringRef theValue, Int64& theResult)
+  {
+    const char* anEnd = theValue.data() + theValue.size();
+    const char* anIter = skipSpace(theValue.data(), anEnd);
+
+    // Parse the optional sign
+    bool anNegative = false;
+    if(anIter < anEnd && ('-' == *anIter || '+' == *anIter))
+    {
+      anNegative = ('-' == *anIter);
+      anIter++;
+    }
+
+    // The magnitude of the minimum value is one larger than the maximum
+    Uint64 anMaximum = (Uint64)std::numeric_limits<Int64>::max() +
+      (anNegative ? 1 : 0);
+    Uint64 anValue;
+    if(!scanDigits(anIter, anEnd, anMaximum, anValue))
+    {
+      return false;
+    }
+    theResult = anNegative ? (Int64)(0 - anValue) : (Int64)anValue;
+
+    return true;
+  }
+
+  bool scanUint64(const StringRef theValue, Uint64& theResult)
+  {
+    const char* anEnd = theValue.data() + theValue.size();
+    const char* anIter = skipSpace(theValue.data(), anEnd);
+
+    // Parse the optional sign (negative values are out of range)
+    if(anIter < anEnd && '+' == *anIter)
+    {
+      anIter++;
     }
 
+    return scanDigits(anIter, anEnd, std::numeric_limits<Uint64>::max(),
+      theResult);
+  }
+
+  bool parseBool(const StringRef theValue, const bool theDefault)
+  {
+    bool anResult = theDefault;
+
+    // Look for true/1/on or false/0/off results
+    scanBool(theValue, anResult);
+
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  sf::Color parseColor(const std::string theValue, const sf::Color theDefault)
+  sf::Color parseColor(const StringRef theValue, const sf::Color theDefault)
   {
     sf::Color anResult = theDefault;
 
     // Try to find the first comma
-    size_t anComma1Offset = theValue.find_first_of(',');
-    if(anComma1Offset != std::string::npos)
+    size_t anComma1Offset = findComma(theValue, 0);
+    if(anComma1Offset < theValue.size())
     {
-      sf::Uint8 anRed = parseUint8(theValue.substr(0,anComma1Offset), theDefault.r);
+      Uint8 anRed = parseUint8(StringRef(theValue.data(), anComma1Offset), theDefault.r);
       // Try to find the next comma
-      size_t anComma2Offset = theValue.find_first_of(',',anComma1Offset+1);
-      if(anComma2Offset != std::string::npos)
+      size_t anComma2Offset = findComma(theValue, anComma1Offset+1);
+      if(anComma2Offset < theValue.size())
       {
-        sf::Uint8 anGreen = parseUint8(
-          theValue.substr(anComma1Offset+1,anComma2Offset), theDefault.g);
+        Uint8 anGreen = parseUint8(StringRef(theValue.data() + anComma1Offset+1,
+          anComma2Offset - anComma1Offset - 1), theDefault.g);
         // Try to find the next comma
-        size_t anComma3Offset = theValue.find_first_of(',',anComma2Offset+1);
-        if(anComma3Offset != std::string::npos)
+        size_t anComma3Offset = findComma(theValue, anComma2Offset+1);
+        if(anComma3Offset < theValue.size())
         {
-          sf::Uint8 anBlue = parseUint8(
-            theValue.substr(anComma2Offset+1,anComma3Offset), theDefault.b);
-          sf::Uint8 anAlpha = parseUint8(
-            theValue.substr(anComma3Offset+1), theDefault.a);
+          Uint8 anBlue = parseUint8(StringRef(theValue.data() + anComma2Offset+1,
+            anComma3Offset - anComma2Offset - 1), theDefault.b);
+          Uint8 anAlpha = parseUint8(StringRef(theValue.data() + anComma3Offset+1,
+            theValue.size() - anComma3Offset - 1), theDefault.a);
 
           // Now that all 4 values have been parsed, return the color found
           anResult.r = anRed;
@@ -314,111 +670,89 @@ namespace AGE
     return anResult;
   }
 
-  double parseDouble(const std::string theValue, const double theDefault)
+  double parseDouble(const StringRef theValue, const double theDefault)
   {
     double anResult = theDefault;
-    std::istringstream iss(theValue);
 
     // Convert the string to a double floating point number
-    iss >> anResult;
+    scanDouble(theValue, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  float parseFloat(const std::string theValue, const float theDefault)
+  float parseFloat(const StringRef theValue, const float theDefault)
   {
-    float anResult = theDefault;
-    std::istringstream iss(theValue);
+    double anResult;
 
-    // Convert the string to a floating point number
-    iss >> anResult;
+    // Convert the string to a floating point number that fits in a float
+    if(scanDouble(theValue, anResult) &&
+        anResult <= std::numeric_limits<float>::max() &&
+        anResult >= -std::numeric_limits<float>::max())
+    {
+      return (float)anResult;
+    }
 
-    // Return the result found or theDefault assigned above
-    return anResult;
+    // Return theDefault if the parser failed
+    return theDefault;
   }
 
-  Int8 parseInt8(const std::string theValue, const Int8 theDefault)
+  Int8 parseInt8(const StringRef theValue, const Int8 theDefault)
   {
-    Int8 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to a signed 8 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanSigned<Int8>(theValue, theDefault);
   }
 
-  Int16 parseInt16(const std::string theValue, const Int16 theDefault)
+  Int16 parseInt16(const StringRef theValue, const Int16 theDefault)
   {
-    Int16 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to a signed 16 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanSigned<Int16>(theValue, theDefault);
   }
 
-  Int32 parseInt32(const std::string theValue, const Int32 theDefault)
+  Int32 parseInt32(const StringRef theValue, const Int32 theDefault)
   {
-    Int32 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to a signed 32 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanSigned<Int32>(theValue, theDefault);
   }
 
-  Int64 parseInt64(const std::string theValue, const Int64 theDefault)
+  Int64 parseInt64(const StringRef theValue, const Int64 theDefault)
   {
-    Int64 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to a signed 64 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanSigned<Int64>(theValue, theDefault);
   }
 
-  sf::IntRect parseIntRect(const std::string theValue, const sf::IntRect theDefault)
+  sf::IntRect parseIntRect(const StringRef theValue, const sf::IntRect theDefault)
   {
     sf::IntRect anResult = theDefault;
 
     // Try to find the first comma
-    size_t anComma1Offset = theValue.find_first_of(',');
-    if(anComma1Offset != std::string::npos)
+    size_t anComma1Offset = findComma(theValue, 0);
+    if(anComma1Offset < theValue.size())
     {
-
-      sf::Int32 anLeft = parseInt32(theValue.substr(0,anComma1Offset), theDefault.left);
+      Int32 anLeft = parseInt32(StringRef(theValue.data(), anComma1Offset), theDefault.left);
 
       // Try to find the next comma
-      size_t anComma2Offset = theValue.find_first_of(',',anComma1Offset+1);
-      if(anComma2Offset != std::string::npos)
+      size_t anComma2Offset = findComma(theValue, anComma1Offset+1);
+      if(anComma2Offset < theValue.size())
       {
-
-        sf::Int32 anTop = parseInt32(theValue.substr(anComma1Offset+1,anComma2Offset), theDefault.top);
+        Int32 anTop = parseInt32(StringRef(theValue.data() + anComma1Offset+1,
+          anComma2Offset - anComma1Offset - 1), theDefault.top);
 
         // Try to find the next comma
-        size_t anComma3Offset = theValue.find_first_of(',',anComma2Offset+1);
-        if(anComma3Offset != std::string::npos)
+        size_t anComma3Offset = findComma(theValue, anComma2Offset+1);
+        if(anComma3Offset < theValue.size())
         {
-
           // Get the width and height values
-          sf::Int32 anWidth = parseInt32(theValue.substr(anComma2Offset+1,anComma3Offset), theDefault.width);
-          sf::Int32 anHeight = parseInt32(theValue.substr(anComma3Offset+1), theDefault.height);
+          Int32 anWidth = parseInt32(StringRef(theValue.data() + anComma2Offset+1,
+            anComma3Offset - anComma2Offset - 1), theDefault.width);
+          Int32 anHeight = parseInt32(StringRef(theValue.data() + anComma3Offset+1,
+            theValue.size() - anComma3Offset - 1), theDefault.height);
 
-          // Now that all 4 values have been parsed, return the color found
+          // Now that all 4 values have been parsed, return the rect found
           anResult.left = anLeft;
           anResult.top = anTop;
           anResult.width = anWidth;
           anResult.height = anHeight;
-
         }
       }
     }
@@ -427,64 +761,41 @@ namespace AGE
     return anResult;
   }
 
-  Uint8 parseUint8(const std::string theValue, const Uint8 theDefault)
+  Uint8 parseUint8(const StringRef theValue, const Uint8 theDefault)
   {
-    Uint8 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to an unsigned 8 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanUnsigned<Uint8>(theValue, theDefault);
   }
 
-  Uint16 parseUint16(const std::string theValue, const Uint16 theDefault)
+  Uint16 parseUint16(const StringRef theValue, const Uint16 theDefault)
   {
-    Uint16 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to an unsigned 16 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanUnsigned<Uint16>(theValue, theDefault);
   }
 
-  Uint32 parseUint32(const std::string theValue, const Uint32 theDefault)
+  Uint32 parseUint32(const StringRef theValue, const Uint32 theDefault)
   {
-    Uint32 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to an unsigned 32 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanUnsigned<Uint32>(theValue, theDefault);
   }
 
-  Uint64 parseUint64(const std::string theValue, const Uint64 theDefault)
+  Uint64 parseUint64(const StringRef theValue, const Uint64 theDefault)
   {
-    Uint64 anResult = theDefault;
-    std::istringstream iss(theValue);
-
     // Convert the string to an unsigned 64 bit integer
-    iss >> anResult;
-
-    // Return the result found or theDefault assigned above
-    return anResult;
+    return scanUnsigned<Uint64>(theValue, theDefault);
   }
 
-  sf::Vector2f parseVector2f(const std::string theValue, const sf::Vector2f theDefault)
+  sf::Vector2f parseVector2f(const StringRef theValue, const sf::Vector2f theDefault)
   {
     sf::Vector2f anResult = theDefault;
 
     // Try to find the first comma
-    size_t anCommaOffset = theValue.find_first_of(',');
-    if(anCommaOffset != std::string::npos)
+    size_t anCommaOffset = findComma(theValue, 0);
+    if(anCommaOffset < theValue.size())
     {
-      float anX = parseFloat(theValue.substr(0,anCommaOffset), theDefault.x);
-      float anY = parseFloat(theValue.substr(anCommaOffset+1), theDefault.y);
+      float anX = parseFloat(StringRef(theValue.data(), anCommaOffset), theDefault.x);
+      float anY = parseFloat(StringRef(theValue.data() + anCommaOffset+1,
+        theValue.size() - anCommaOffset - 1), theDefault.y);
 
       // Now that both values have been parsed, return the vector found
       anResult.x = anX;
@@ -495,16 +806,17 @@ namespace AGE
     return anResult;
   }
 
-  sf::Vector2i parseVector2i(const std::string theValue, const sf::Vector2i theDefault)
+  sf::Vector2i parseVector2i(const StringRef theValue, const sf::Vector2i theDefault)
   {
     sf::Vector2i anResult = theDefault;
 
     // Try to find the first comma
-    size_t anCommaOffset = theValue.find_first_of(',');
-    if(anCommaOffset != std::string::npos)
+    size_t anCommaOffset = findComma(theValue, 0);
+    if(anCommaOffset < theValue.size())
     {
-      Int32 anX = parseInt32(theValue.substr(0,anCommaOffset), theDefault.x);
-      Int32 anY = parseInt32(theValue.substr(anCommaOffset+1), theDefault.y);
+      Int32 anX = parseInt32(StringRef(theValue.data(), anCommaOffset), theDefault.x);
+      Int32 anY = parseInt32(StringRef(theValue.data() + anCommaOffset+1,
+        theValue.size() - anCommaOffset - 1), theDefault.y);
 
       // Now that both values have been parsed, return the vector found
       anResult.x = anX;
@@ -515,16 +827,17 @@ namespace AGE
     return anResult;
   }
 
-  sf::Vector2u parseVector2u(const std::string theValue, const sf::Vector2u theDefault)
+  sf::Vector2u parseVector2u(const StringRef theValue, const sf::Vector2u theDefault)
   {
     sf::Vector2u anResult = theDefault;
 
     // Try to find the first comma
-    size_t anCommaOffset = theValue.find_first_of(',');
-    if(anCommaOffset != std::string::npos)
+    size_t anCommaOffset = findComma(theValue, 0);
+    if(anCommaOffset < theValue.size())
     {
-      Uint32 anX = parseUint32(theValue.substr(0, anCommaOffset), theDefault.x);
-      Uint32 anY = parseUint32(theValue.substr(anCommaOffset+1), theDefault.y);
+      Uint32 anX = parseUint32(StringRef(theValue.data(), anCommaOffset), theDefault.x);
+      Uint32 anY = parseUint32(StringRef(theValue.data() + anCommaOffset+1,
+        theValue.size() - anCommaOffset - 1), theDefault.y);
 
       // Now that both values have been parsed, return the vector found
       anResult.x = anX;
@@ -535,23 +848,25 @@ namespace AGE
     return anResult;
   }
 
-  sf::Vector3f parseVector3f(const std::string theValue, const sf::Vector3f theDefault)
+  sf::Vector3f parseVector3f(const StringRef theValue, const sf::Vector3f theDefault)
   {
     sf::Vector3f anResult = theDefault;
 
     // Try to find the first comma
-    size_t anComma1Offset = theValue.find_first_of(',', 0);
-    if(anComma1Offset != std::string::npos)
+    size_t anComma1Offset = findComma(theValue, 0);
+    if(anComma1Offset < theValue.size())
     {
-      float anX = parseFloat(theValue.substr(0, anComma1Offset), theDefault.x);
+      float anX = parseFloat(StringRef(theValue.data(), anComma1Offset), theDefault.x);
 
       // Try to find the next comma
-      size_t anComma2Offset = theValue.find_first_of(',',anComma1Offset+1);
-      if(anComma2Offset != std::string::npos)
+      size_t anComma2Offset = findComma(theValue, anComma1Offset+1);
+      if(anComma2Offset < theValue.size())
       {
-        float anY = parseFloat(theValue.substr(anComma1Offset+1, anComma2Offset), theDefault.y);
-        float anZ = parseFloat(theValue.substr(anComma2Offset+1), theDefault.z);
-        
+        float anY = parseFloat(StringRef(theValue.data() + anComma1Offset+1,
+          anComma2Offset - anComma1Offset - 1), theDefault.y);
+        float anZ = parseFloat(StringRef(theValue.data() + anComma2Offset+1,
+          theValue.size() - anComma2Offset - 1), theDefault.z);
+
         // Now that all 3 values have been parsed, return the Vector3f found
         anResult.x = anX;
         anResult.y = anY;
@@ -563,24 +878,26 @@ namespace AGE
     return anResult;
   }
 
-  sf::Vector3i parseVector3i(const std::string theValue, const sf::Vector3i theDefault)
+  sf::Vector3i parseVector3i(const StringRef theValue, const sf::Vector3i theDefault)
   {
     sf::Vector3i anResult = theDefault;
 
     // Try to find the first comma
-    size_t anComma1Offset = theValue.find_first_of(',', 0);
-    if(anComma1Offset != std::string::npos)
+    size_t anComma1Offset = findComma(theValue, 0);
+    if(anComma1Offset < theValue.size())
     {
-      Int32 anX = parseInt32(theValue.substr(0, anComma1Offset), theDefault.x);
+      Int32 anX = parseInt32(StringRef(theValue.data(), anComma1Offset), theDefault.x);
 
       // Try to find the next comma
-      size_t anComma2Offset = theValue.find_first_of(',',anComma1Offset+1);
-      if(anComma2Offset != std::string::npos)
+      size_t anComma2Offset = findComma(theValue, anComma1Offset+1);
+      if(anComma2Offset < theValue.size())
       {
-        Int32 anY = parseInt32(theValue.substr(anComma1Offset+1, anComma2Offset), theDefault.y);
-        Int32 anZ = parseInt32(theValue.substr(anComma2Offset+1), theDefault.z);
-        
-        // Now that all 3 values have been parsed, return the Vector3f found
+        Int32 anY = parseInt32(StringRef(theValue.data() + anComma1Offset+1,
+          anComma2Offset - anComma1Offset - 1), theDefault.y);
+        Int32 anZ = parseInt32(StringRef(theValue.data() + anComma2Offset+1,
+          theValue.size() - anComma2Offset - 1), theDefault.z);
+
+        // Now that all 3 values have been parsed, return the Vector3i found
         anResult.x = anX;
         anResult.y = anY;
         anResult.z = anZ;